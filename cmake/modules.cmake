@@ -142,4 +142,17 @@ macro(add_peridyno_test TEST_NAME LIB_DEPENDENCY)
                 RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/bin/Release")
         endif()
     endif()
-endmacro()
\ No newline at end of file
+endmacro()
+
+
+#Compile the .cu files in SRC_LIST as C++ for the NoGPU backend, where kernels run on the ThreadPool
+macro(compile_cuda_as_cxx SRC_LIST)
+    set(CU_SRC ${${SRC_LIST}})
+    list(FILTER CU_SRC INCLUDE REGEX "\\.cu$")
+
+    if(MSVC)
+        set_source_files_properties(${CU_SRC} PROPERTIES LANGUAGE CXX COMPILE_OPTIONS "/TP")
+    else()
+        set_source_files_properties(${CU_SRC} PROPERTIES LANGUAGE CXX COMPILE_OPTIONS "-xc++")
+    endif()
+endmacro()
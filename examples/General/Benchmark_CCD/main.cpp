@@ -0,0 +1,197 @@
+/**
+ * Throughput and false negative rate of BatchedCCD with TightCCD and AdditiveCCD.
+ *
+ * Usage: Benchmark_CCD [number of candidates] [number of threads]
+ *
+ * The candidates mix a known fraction of constructed impacts, with their exact time of impact, and random nearby pairs
+ * 	as a broad phase would report them. An impact is missed if it is not detected or detected after its exact time.
+ */
+#include "CCD/BatchedCCD.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace dyno;
+
+struct Scene
+{
+	CArray<Vec3f> x0;
+	CArray<Vec3f> x1;
+
+	CArray<VertexFacePair> vf;
+	CArray<EdgeEdgePair> ee;
+
+	//Exact time of impact of the first candidates, 1 for the others
+	std::vector<float> vfImpact;
+	std::vector<float> eeImpact;
+};
+
+static uint addVertex(Scene& scene, const Vec3f& p0, const Vec3f& p1)
+{
+	scene.x0.pushBack(p0);
+	scene.x1.pushBack(p1);
+	return scene.x0.size() - 1;
+}
+
+static void buildScene(Scene& scene, uint num, float impactRatio, std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> u01(0.0f, 1.0f);
+	auto random3 = [&](float scale) { return scale * Vec3f(u01(rng) - 0.5f, u01(rng) - 0.5f, u01(rng) - 0.5f); };
+
+	const float edge = 0.05f;
+	const float motion = 0.05f;
+
+	uint impacts = uint(num * impactRatio);
+
+	//Vertex-face impacts: a translating triangle hit by a vertex at time t
+	for (uint i = 0; i < num; i++)
+	{
+		Vec3f o = random3(1.0f);
+		Vec3f a0 = o, b0 = o + random3(2 * edge), c0 = o + random3(2 * edge);
+		Vec3f d = random3(motion);
+
+		if (i < impacts)
+		{
+			float t = 0.05f + 0.85f * u01(rng);
+			float wb = u01(rng), wc = u01(rng);
+			if (wb + wc > 1.0f) { wb = 1.0f - wb; wc = 1.0f - wc; }
+
+			Vec3f c = a0 + d * t + wb * (b0 - a0) + wc * (c0 - a0);
+			Vec3f v = random3(2 * motion);
+
+			uint p = addVertex(scene, c - t * v, c + (1.0f - t) * v);
+			uint a = addVertex(scene, a0, a0 + d);
+			uint b = addVertex(scene, b0, b0 + d);
+			uint cc = addVertex(scene, c0, c0 + d);
+
+			scene.vf.pushBack(VertexFacePair(p, a, b, cc));
+			scene.vfImpact.push_back(t);
+		}
+		else
+		{
+			Vec3f p0 = o + random3(4 * edge);
+
+			uint p = addVertex(scene, p0, p0 + random3(2 * motion));
+			uint a = addVertex(scene, a0, a0 + d);
+			uint b = addVertex(scene, b0, b0 + d);
+			uint cc = addVertex(scene, c0, c0 + d);
+
+			scene.vf.pushBack(VertexFacePair(p, a, b, cc));
+			scene.vfImpact.push_back(1.0f);
+		}
+	}
+
+	//Edge-edge impacts: a translating edge crossed by another one at time t
+	for (uint i = 0; i < num; i++)
+	{
+		Vec3f o = random3(1.0f);
+		Vec3f a0 = o, b0 = o + random3(2 * edge);
+		Vec3f d = random3(motion);
+		Vec3f dir = random3(2 * edge);
+
+		if (i < impacts)
+		{
+			float t = 0.05f + 0.85f * u01(rng);
+			float w = u01(rng), s = u01(rng);
+
+			Vec3f c = a0 + d * t + w * (b0 - a0);
+			Vec3f v = random3(2 * motion);
+			Vec3f c0 = c - s * dir - t * v, d0 = c + (1.0f - s) * dir - t * v;
+
+			uint a = addVertex(scene, a0, a0 + d);
+			uint b = addVertex(scene, b0, b0 + d);
+			uint e = addVertex(scene, c0, c0 + v);
+			uint f = addVertex(scene, d0, d0 + v);
+
+			scene.ee.pushBack(EdgeEdgePair(a, b, e, f));
+			scene.eeImpact.push_back(t);
+		}
+		else
+		{
+			Vec3f c0 = o + random3(4 * edge), d0 = c0 + dir;
+			Vec3f v = random3(2 * motion);
+
+			uint a = addVertex(scene, a0, a0 + d);
+			uint b = addVertex(scene, b0, b0 + d);
+			uint e = addVertex(scene, c0, c0 + v);
+			uint f = addVertex(scene, d0, d0 + v);
+
+			scene.ee.pushBack(EdgeEdgePair(a, b, e, f));
+			scene.eeImpact.push_back(1.0f);
+		}
+	}
+}
+
+static uint countMisses(const CArray<float>& toi, const std::vector<float>& impact)
+{
+	uint missed = 0;
+	for (uint i = 0; i < impact.size(); i++)
+	{
+		if (impact[i] < 1.0f && toi[i] > impact[i] + 1e-4f)
+			missed++;
+	}
+	return missed;
+}
+
+static void run(const char* name, BatchedCCD<float>& ccd, const Scene& scene, uint impacts)
+{
+	CArray<float> vfToi, eeToi, vertexToi;
+
+	//Warm up
+	ccd.vertexFace(scene.x0, scene.x1, scene.vf, vfToi, vertexToi);
+	ccd.resetStatistics();
+
+	auto start = std::chrono::steady_clock::now();
+	ccd.vertexFace(scene.x0, scene.x1, scene.vf, vfToi, vertexToi);
+	ccd.edgeEdge(scene.x0, scene.x1, scene.ee, eeToi, vertexToi);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	const BatchedCCD<float>::Statistics& stat = ccd.statistics();
+	uint missed = countMisses(vfToi, scene.vfImpact) + countMisses(eeToi, scene.eeImpact);
+
+	printf("%-24s %12.3e %10.2f%% %10.2f%% %10.2f%% %12.4f%%\n",
+		name,
+		stat.pairs / seconds,
+		100.0 * stat.culledByBounds / stat.pairs,
+		100.0 * stat.culledBySign / stat.pairs,
+		100.0 * stat.collisions / stat.pairs,
+		100.0 * missed / (2 * impacts));
+}
+
+int main(int argc, char** argv)
+{
+	uint num = argc > 1 ? uint(atoi(argv[1])) : 200000;
+	uint threads = argc > 2 ? uint(atoi(argv[2])) : 0;
+
+	ThreadPool::instance()->setThreadNumber(threads);
+
+	const float impactRatio = 0.05f;
+
+	std::mt19937 rng(2024);
+	Scene scene;
+	buildScene(scene, num, impactRatio, rng);
+
+	uint impacts = uint(num * impactRatio);
+
+	printf("%u vertex-face and %u edge-edge candidates, %u impacts each, %u threads\n\n", num, num, impacts, ThreadPool::instance()->threadNumber());
+	printf("%-24s %12s %11s %11s %11s %13s\n", "method", "pairs/s", "AABB cull", "sign cull", "collisions", "false neg.");
+
+	BatchedCCD<float> tight(BatchedCCD<float>::TIGHT);
+	run("TightCCD", tight, scene, impacts);
+
+	tight.setFilters(false, false);
+	run("TightCCD, no filter", tight, scene, impacts);
+
+	BatchedCCD<float> additive(BatchedCCD<float>::ADDITIVE);
+	additive.setAdditiveParameters(0.0f, 0.2f, 0.95f);
+	run("AdditiveCCD", additive, scene, impacts);
+
+	additive.setFilters(false, false);
+	run("AdditiveCCD, no filter", additive, scene, impacts);
+
+	return 0;
+}
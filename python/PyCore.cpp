@@ -8,6 +8,34 @@ void pybind_core(py::module& m)
 		.def("stop", &dyno::CTimer::stop)
 		.def("get_elapsed_time", &dyno::CTimer::getElapsedTime);
 
+	py::enum_<dyno::ProfileCategory>(m, "ProfileCategory")
+		.value("Frame", dyno::ProfileCategory::Frame)
+		.value("Node", dyno::ProfileCategory::Node)
+		.value("Module", dyno::ProfileCategory::Module)
+		.value("Kernel", dyno::ProfileCategory::Kernel)
+		.value("IO", dyno::ProfileCategory::IO)
+		.value("User", dyno::ProfileCategory::User);
+
+	py::class_<dyno::ProfileStatistics>(m, "ProfileStatistics")
+		.def_readonly("name", &dyno::ProfileStatistics::name)
+		.def_readonly("category", &dyno::ProfileStatistics::category)
+		.def_readonly("instance", &dyno::ProfileStatistics::instance)
+		.def_readonly("count", &dyno::ProfileStatistics::count)
+		.def_readonly("total", &dyno::ProfileStatistics::total)
+		.def_readonly("mean", &dyno::ProfileStatistics::mean)
+		.def_readonly("min", &dyno::ProfileStatistics::min)
+		.def_readonly("max", &dyno::ProfileStatistics::max)
+		.def_readonly("p50", &dyno::ProfileStatistics::p50)
+		.def_readonly("p99", &dyno::ProfileStatistics::p99);
+
+	py::class_<dyno::Profiler, std::unique_ptr<dyno::Profiler, py::nodelete>>(m, "Profiler")
+		.def_static("instance", &dyno::Profiler::instance, py::return_value_policy::reference)
+		.def_static("is_enabled", &dyno::Profiler::isEnabled)
+		.def_static("set_enabled", &dyno::Profiler::setEnabled)
+		.def("statistics", &dyno::Profiler::statistics, py::arg("per_instance") = false)
+		.def("export_chrome_trace", &dyno::Profiler::exportChromeTrace)
+		.def("clear", &dyno::Profiler::clear);
+
 	declare_vector<float, 2>(m, "2f");
 	declare_vector<float, 3>(m, "3f");
 	declare_vector<float, 4>(m, "4f");
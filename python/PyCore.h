@@ -7,6 +7,7 @@
 #include "Platform.h"
 
 #include "Timer.h"
+#include "Profiler.h"
 #include "Vector.h"
 #include "Matrix.h"
 
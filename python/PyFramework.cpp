@@ -133,6 +133,8 @@ void pybind_framework(py::module& m)
 		.def("set_auto_sync", &Node::setAutoSync)
 		.def("is_active", &Node::isActive)
 		.def("set_active", &Node::setActive)
+		.def("is_thread_safe", &Node::isThreadSafe)
+		.def("set_thread_safe", &Node::setThreadSafe)
 		.def("is_visible", &Node::isVisible)
 		.def("set_visible", &Node::setVisible)
 		.def("get_dt", &Node::getDt)
@@ -233,7 +235,10 @@ void pybind_framework(py::module& m)
 		.def("instance", &dyno::PluginManager::instance, py::return_value_policy::reference)
 		.def("get_extension", &dyno::PluginManager::getExtension)
 		.def("load_plugin", &dyno::PluginManager::loadPlugin)
-		.def("load_plugin_by_path", &dyno::PluginManager::loadPluginByPath)
+		.def("load_plugin_by_path", &dyno::PluginManager::loadPluginByPath, py::arg("path_name"), py::arg("lazy") = false)
+		.def("register_plugin", &dyno::PluginManager::registerPlugin)
+		.def("load_plugin_of_class", &dyno::PluginManager::loadPluginOfClass)
+		.def("provider_of", &dyno::PluginManager::providerOf)
 		.def("get_plugin", &dyno::PluginManager::getPlugin);
 
 	py::class_<dyno::PluginEntry, std::shared_ptr<dyno::PluginEntry >>(m, "PluginEntry")
@@ -411,6 +416,8 @@ void pybind_framework(py::module& m)
 		.def("all_modules", &Pipeline::allModules, py::return_value_policy::reference)
 		.def("enable", &Pipeline::enable)
 		.def("disable", &Pipeline::disable)
+		.def("is_concurrent_execution", &Pipeline::isConcurrentExecution)
+		.def("set_concurrent_execution", &Pipeline::setConcurrentExecution)
 		.def("update_execution_queue", &Pipeline::updateExecutionQueue)
 		.def("force_update", &Pipeline::forceUpdate)
 		.def("promote_putput_to_node", &Pipeline::promoteOutputToNode, py::return_value_policy::reference)
@@ -619,9 +626,21 @@ void pybind_framework(py::module& m)
 		.def("var_end_frame", &OutputModule::varEndFrame, py::return_value_policy::reference)
 		.def("var_stride", &OutputModule::varStride, py::return_value_policy::reference)
 		.def("var_reordering", &OutputModule::varReordering, py::return_value_policy::reference)
+		.def("var_asynchronous", &OutputModule::varAsynchronous, py::return_value_policy::reference)
 		.def("in_frame_number", &OutputModule::inFrameNumber, py::return_value_policy::reference)
+		.def("flush", &OutputModule::flush)
+		.def("set_snapshot_number", &OutputModule::setSnapshotNumber)
 		.def("get_module_type", &OutputModule::getModuleType);
 
+	py::class_<OutputQueue, std::unique_ptr<OutputQueue, py::nodelete>>(m, "OutputQueue")
+		.def_static("instance", &OutputQueue::instance, py::return_value_policy::reference)
+		.def("set_worker_number", &OutputQueue::setWorkerNumber)
+		.def("worker_number", &OutputQueue::workerNumber)
+		.def("set_capacity", &OutputQueue::setCapacity)
+		.def("capacity", &OutputQueue::capacity)
+		.def("flush", &OutputQueue::flush, py::call_guard<py::gil_scoped_release>())
+		.def("pending_jobs", &OutputQueue::pendingJobs);
+
 	py::class_<DataSource, Module, std::shared_ptr<DataSource>>(m, "DataSource")
 		.def(py::init<>())
 		.def("captionVisible", &DataSource::captionVisible)
@@ -714,8 +733,16 @@ void pybind_framework(py::module& m)
 		.def("get_timecost_perframe", &SceneGraph::getTimeCostPerFrame)
 		.def("get_frame_interval", &SceneGraph::getFrameInterval)
 		.def("get_frame_number", &SceneGraph::getFrameNumber)
+		.def("get_elapsed_time", &SceneGraph::getElapsedTime)
+		.def("save_checkpoint", &SceneGraph::saveCheckpoint, py::arg("filename"), py::arg("compressed") = false)
+		.def("load_checkpoint", &SceneGraph::loadCheckpoint)
+		.def("set_checkpoint_interval", &SceneGraph::setCheckpointInterval, py::arg("interval"), py::arg("prefix") = "checkpoint_", py::arg("compressed") = true)
+		.def("get_checkpoint_interval", &SceneGraph::getCheckpointInterval)
+		.def("wait_for_checkpoint", &SceneGraph::waitForCheckpoint)
 		.def("is_interval_adaptive", &SceneGraph::isIntervalAdaptive)
 		.def("set_adaptive_interval", &SceneGraph::setAdaptiveInterval)
+		.def("is_concurrent_execution", &SceneGraph::isConcurrentExecution)
+		.def("set_concurrent_execution", &SceneGraph::setConcurrentExecution)
 		.def("set_gravity", &SceneGraph::setGravity)
 		.def("get_gravity", &SceneGraph::getGravity)
 		.def("set_upper_bound", &SceneGraph::setUpperBound)
@@ -746,6 +773,15 @@ void pybind_framework(py::module& m)
 		.value("EDIT_MODE", SceneGraph::EWorkMode::EDIT_MODE)
 		.value("RUNNING_MODE", SceneGraph::EWorkMode::RUNNING_MODE);
 
+	py::class_<SceneGraphEnsemble, std::shared_ptr<SceneGraphEnsemble>>(m, "SceneGraphEnsemble")
+		.def(py::init<>())
+		.def("add_scene", &SceneGraphEnsemble::addScene)
+		.def("get_scene", &SceneGraphEnsemble::getScene)
+		.def("size", &SceneGraphEnsemble::size)
+		.def("reset", &SceneGraphEnsemble::reset, py::call_guard<py::gil_scoped_release>())
+		.def("take_one_frame", &SceneGraphEnsemble::takeOneFrame, py::call_guard<py::gil_scoped_release>())
+		.def("run", &SceneGraphEnsemble::run, py::call_guard<py::gil_scoped_release>());
+
 
 	//py::class_<dyno::SceneGraphFactory>(m, "SceneGraphFactory");
 	//.def("instance", &dyno::SceneGraphFactory::instance, py::return_value_policy::reference)
@@ -10,6 +10,7 @@
 #include "Module/GraphicsPipeline.h"
 #include "Module/MouseInputModule.h"
 #include "Module/OutputModule.h"
+#include "Module/OutputQueue.h"
 #include "Module/ConstraintModule.h"
 
 #include "Module/CalculateNorm.h"
@@ -71,6 +72,7 @@
 #include "DirectedAcyclicGraph.h"
 #include "NodeFactory.h"
 #include "SceneGraphFactory.h"
+#include "SceneGraphEnsemble.h"
 #include "SceneLoaderFactory.h"
 #include "SceneLoaderXML.h"
 
@@ -0,0 +1,173 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+
+#include "Array/Array.h"
+#include "ThreadPool.h"
+
+namespace dyno
+{
+	//Number of flags counted and scattered by a single task
+	#define HC_BLOCK_SIZE 16384
+
+	/**
+	 * @brief Stream compaction and stable partition over host memory.
+	 *
+	 * Both run in two passes over blocks of the flags: the selected elements of every block are counted in parallel,
+	 * 	the counts are scanned, then every block writes its elements starting at its offset. The block counts are kept between calls.
+	 * 	Any flag type convertible to bool can be used.
+	 */
+	class HostCompaction
+	{
+	public:
+		HostCompaction() {};
+		~HostCompaction() {};
+
+		/**
+		 * @brief Write the indices of the set flags in increasing order
+		 *
+		 * @return the number of set flags
+		 */
+		template<typename TFlag>
+		uint compact(uint* indices, const TFlag* flags, size_t num)
+		{
+			uint count = this->count(flags, num);
+			this->scatter(flags, num, [&](size_t i, size_t pos) { indices[pos] = (uint)i; }, HC_Skip());
+			return count;
+		}
+
+		/**
+		 * @brief Copy the elements of input whose flags are set to the front of output, keeping their order
+		 */
+		template<typename T, typename TFlag>
+		uint compact(T* output, const T* input, const TFlag* flags, size_t num)
+		{
+			uint count = this->count(flags, num);
+			this->scatter(flags, num, [&](size_t i, size_t pos) { output[pos] = input[i]; }, HC_Skip());
+			return count;
+		}
+
+		/**
+		 * @brief Stable partition, order receives the indices of the set flags followed by the indices of the others
+		 *
+		 * @return the number of set flags
+		 */
+		template<typename TFlag>
+		uint partition(uint* order, const TFlag* flags, size_t num)
+		{
+			uint count = this->count(flags, num);
+			this->scatter(flags, num,
+				[&](size_t i, size_t pos) { order[pos] = (uint)i; },
+				[&](size_t i, size_t pos) { order[count + pos] = (uint)i; });
+			return count;
+		}
+
+		template<typename TFlag>
+		uint compact(CArray<uint>& indices, const CArray<TFlag>& flags)
+		{
+			uint count = this->count(flags.begin(), flags.size());
+			indices.resize(count);
+			this->scatter(flags.begin(), flags.size(), [&](size_t i, size_t pos) { indices[pos] = (uint)i; }, HC_Skip());
+			return count;
+		}
+
+		template<typename T, typename TFlag>
+		uint compact(CArray<T>& output, const CArray<T>& input, const CArray<TFlag>& flags)
+		{
+			assert(input.size() == flags.size());
+
+			uint count = this->count(flags.begin(), flags.size());
+			output.resize(count);
+			this->scatter(flags.begin(), flags.size(), [&](size_t i, size_t pos) { output[pos] = input[i]; }, HC_Skip());
+			return count;
+		}
+
+		template<typename TFlag>
+		uint partition(CArray<uint>& order, const CArray<TFlag>& flags)
+		{
+			order.resize(flags.size());
+			return this->partition(order.begin(), flags.begin(), flags.size());
+		}
+
+		/**
+		 * @brief First pass, count the set flags of every block and return the total.
+		 * 	Use together with scatter() when the output has to be sized in between.
+		 */
+		template<typename TFlag>
+		uint count(const TFlag* flags, size_t num)
+		{
+			size_t blocks = (num + HC_BLOCK_SIZE - 1) / HC_BLOCK_SIZE;
+			mCounts.resize(blocks + 1);
+
+			ThreadPool::instance()->parallelFor(0, (uint)blocks, [&](uint first, uint last) {
+				for (uint b = first; b < last; b++)
+				{
+					size_t end = std::min(num, size_t(b + 1) * HC_BLOCK_SIZE);
+
+					uint n = 0;
+					for (size_t i = size_t(b) * HC_BLOCK_SIZE; i < end; i++)
+						n += flags[i] ? 1 : 0;
+
+					mCounts[b + 1] = n;
+				}
+			}, 1);
+
+			mCounts[0] = 0;
+			for (size_t b = 0; b < blocks; b++)
+				mCounts[b + 1] += mCounts[b];
+
+			return mCounts[blocks];
+		}
+
+		/**
+		 * @brief Call selected(i, pos) for every set flag and rejected(i, pos) for every other one, pos counts from zero for both.
+		 * 	Second pass, requires the block counts of the same flags computed by count().
+		 */
+		template<typename TFlag, typename Selected, typename Rejected>
+		void scatter(const TFlag* flags, size_t num, Selected selected, Rejected rejected)
+		{
+			size_t blocks = (num + HC_BLOCK_SIZE - 1) / HC_BLOCK_SIZE;
+
+			ThreadPool::instance()->parallelFor(0, (uint)blocks, [&](uint first, uint last) {
+				for (uint b = first; b < last; b++)
+				{
+					size_t begin = size_t(b) * HC_BLOCK_SIZE;
+					size_t end = std::min(num, begin + HC_BLOCK_SIZE);
+
+					size_t posT = mCounts[b];
+					size_t posF = begin - mCounts[b];
+					for (size_t i = begin; i < end; i++)
+					{
+						if (flags[i])
+							selected(i, posT++);
+						else
+							rejected(i, posF++);
+					}
+				}
+			}, 1);
+		}
+
+		struct HC_Skip
+		{
+			void operator()(size_t, size_t) const {}
+		};
+
+	private:
+		std::vector<uint> mCounts;
+	};
+}
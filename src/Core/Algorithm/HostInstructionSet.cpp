@@ -0,0 +1,43 @@
+#include "HostInstructionSet.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace dyno
+{
+	namespace simd
+	{
+		bool supports(InstructionSet isa)
+		{
+			if (isa == ISA_SCALAR)
+				return true;
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+			__builtin_cpu_init();
+			if (isa == ISA_AVX2)
+				return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+			if (isa == ISA_AVX512)
+				return __builtin_cpu_supports("avx512f");
+			return false;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			int info[4];
+			__cpuid(info, 1);
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool fma = (info[2] & (1 << 12)) != 0;
+			if (!osxsave)
+				return false;
+
+			unsigned long long xcr0 = _xgetbv(0);
+			__cpuidx(info, 7, 0);
+			if (isa == ISA_AVX2)
+				return fma && (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+			if (isa == ISA_AVX512)
+				return (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+			return false;
+#else
+			return false;
+#endif
+		}
+	}
+}
@@ -0,0 +1,38 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+namespace dyno
+{
+	namespace simd
+	{
+		/**
+		 * @brief Instruction sets of the host kernels that are compiled several times and selected at runtime
+		 */
+		enum InstructionSet
+		{
+			ISA_AUTO,
+			ISA_SCALAR,
+			ISA_AVX2,
+			ISA_AVX512
+		};
+
+		/**
+		 * @brief Whether the processor and the operating system support the instruction set, ISA_AVX2 includes FMA
+		 */
+		bool supports(InstructionSet isa);
+	}
+}
@@ -0,0 +1,134 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Lane types of the host kernels written once and compiled for several instruction sets, see HostSVD and PrimitivePacket.
+ *
+ * A lane type L provides: the register type V, the mask type M, the width W, load/store/set1, add/sub/mul/div/sqrt/min/max/abs,
+ * 	rsqrt, the comparisons lt/le returning masks, land/lor combining masks, any testing whether a mask is set in some lane and blend(m, a, b) selecting a where m is set and b elsewhere.
+ * 	Except rsqrt, which is a refined estimate in the SIMD lanes, all operations are IEEE exact so the lanes agree bit for bit
+ * 	as long as the compiler does not contract multiplications and additions.
+ *
+ * LaneAvx2 and LaneAvx512 only exist in translation units compiled for their instruction sets. Everything lives in an anonymous
+ * 	namespace, otherwise the linker may merge inline functions compiled for different instruction sets.
+ */
+#pragma once
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	struct LaneScalar
+	{
+		typedef float V;
+		typedef bool M;
+		static const int W = 1;
+
+		static inline V load(const float* p) { return *p; }
+		static inline void store(float* p, V a) { *p = a; }
+		static inline V set1(float a) { return a; }
+		static inline V add(V a, V b) { return a + b; }
+		static inline V sub(V a, V b) { return a - b; }
+		static inline V mul(V a, V b) { return a * b; }
+		static inline V div(V a, V b) { return a / b; }
+		static inline V sqrt(V a) { return std::sqrt(a); }
+		static inline V rsqrt(V a) { return 1.0f / std::sqrt(a); }
+		static inline V abs(V a) { return std::fabs(a); }
+		static inline V min(V a, V b) { return a < b ? a : b; }
+		static inline V max(V a, V b) { return a > b ? a : b; }
+		static inline M lt(V a, V b) { return a < b; }
+		static inline M le(V a, V b) { return a <= b; }
+		static inline M land(M a, M b) { return a && b; }
+		static inline M lor(M a, M b) { return a || b; }
+		static inline bool any(M a) { return a; }
+		static inline V blend(M m, V a, V b) { return m ? a : b; }
+	};
+
+#if defined(__AVX2__)
+	struct LaneAvx2
+	{
+		typedef __m256 V;
+		typedef __m256 M;
+		static const int W = 8;
+
+		static inline V load(const float* p) { return _mm256_loadu_ps(p); }
+		static inline void store(float* p, V a) { _mm256_storeu_ps(p, a); }
+		static inline V set1(float a) { return _mm256_set1_ps(a); }
+		static inline V add(V a, V b) { return _mm256_add_ps(a, b); }
+		static inline V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+		static inline V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+		static inline V div(V a, V b) { return _mm256_div_ps(a, b); }
+		static inline V sqrt(V a) { return _mm256_sqrt_ps(a); }
+		static inline V abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+		static inline V min(V a, V b) { return _mm256_min_ps(a, b); }
+		static inline V max(V a, V b) { return _mm256_max_ps(a, b); }
+		static inline M lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		static inline M le(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		static inline M land(M a, M b) { return _mm256_and_ps(a, b); }
+		static inline M lor(M a, M b) { return _mm256_or_ps(a, b); }
+		static inline bool any(M a) { return _mm256_movemask_ps(a) != 0; }
+		static inline V blend(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+
+		//Estimate refined by one Newton step
+		static inline V rsqrt(V a)
+		{
+			V y = _mm256_rsqrt_ps(a);
+			V hy = _mm256_mul_ps(_mm256_set1_ps(0.5f), y);
+			V ayy = _mm256_mul_ps(_mm256_mul_ps(a, y), y);
+			return _mm256_mul_ps(hy, _mm256_sub_ps(_mm256_set1_ps(3.0f), ayy));
+		}
+	};
+#endif
+
+#if defined(__AVX512F__)
+	struct LaneAvx512
+	{
+		typedef __m512 V;
+		typedef __mmask16 M;
+		static const int W = 16;
+
+		static inline V load(const float* p) { return _mm512_loadu_ps(p); }
+		static inline void store(float* p, V a) { _mm512_storeu_ps(p, a); }
+		static inline V set1(float a) { return _mm512_set1_ps(a); }
+		static inline V add(V a, V b) { return _mm512_add_ps(a, b); }
+		static inline V sub(V a, V b) { return _mm512_sub_ps(a, b); }
+		static inline V mul(V a, V b) { return _mm512_mul_ps(a, b); }
+		static inline V div(V a, V b) { return _mm512_div_ps(a, b); }
+		static inline V sqrt(V a) { return _mm512_sqrt_ps(a); }
+		static inline V abs(V a) { return _mm512_abs_ps(a); }
+		static inline V min(V a, V b) { return _mm512_min_ps(a, b); }
+		static inline V max(V a, V b) { return _mm512_max_ps(a, b); }
+		static inline M lt(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+		static inline M le(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+		static inline M land(M a, M b) { return (M)(a & b); }
+		static inline M lor(M a, M b) { return (M)(a | b); }
+		static inline bool any(M a) { return a != 0; }
+		static inline V blend(M m, V a, V b) { return _mm512_mask_blend_ps(m, b, a); }
+
+		//Estimate refined by one Newton step
+		static inline V rsqrt(V a)
+		{
+			V y = _mm512_rsqrt14_ps(a);
+			V hy = _mm512_mul_ps(_mm512_set1_ps(0.5f), y);
+			V ayy = _mm512_mul_ps(_mm512_mul_ps(a, y), y);
+			return _mm512_mul_ps(hy, _mm512_sub_ps(_mm512_set1_ps(3.0f), ayy));
+		}
+	};
+#endif
+}
@@ -0,0 +1,190 @@
+#include "HostReduction.h"
+#include "HostSimd.h"
+
+#include "ThreadPool.h"
+
+#include <limits>
+
+namespace dyno
+{
+	//Inputs with fewer scalars than this are reduced by the calling thread
+	#define HR_BLOCK_SIZE 32768
+
+	/**
+	 * A reduction runs over the scalars of the input, C is the number of scalars per element.
+	 * 	Vectors are reduced component-wise, padding scalars (if any) are reduced as well but never read.
+	 */
+	template<typename T>
+	struct HR_Traits
+	{
+		typedef T Scalar;
+		static const int C = 1;
+
+		static T make(const Scalar* r) { return r[0]; }
+	};
+
+	template<typename Real>
+	struct HR_Traits<Vector<Real, 3>>
+	{
+		typedef Real Scalar;
+		static const int C = sizeof(Vector<Real, 3>) / sizeof(Real);
+
+		static Vector<Real, 3> make(const Scalar* r) { return Vector<Real, 3>(r[0], r[1], r[2]); }
+	};
+
+	template<simd::ReduceOp Op, typename S>
+	S HR_Identity()
+	{
+		return Op == simd::SIMD_SUM ? S(0) : (Op == simd::SIMD_MIN ? std::numeric_limits<S>::max() : std::numeric_limits<S>::lowest());
+	}
+
+	template<simd::ReduceOp Op, typename S, int C>
+	void HR_ReduceBlock(const S* p, size_t n, S* result)
+	{
+		for (size_t i = 0; i < n; i += C)
+		{
+			for (int c = 0; c < C; c++)
+				result[c] = simd::combine<Op>(result[c], p[i + c]);
+		}
+	}
+
+#ifdef DYN_SIMD
+	template<simd::ReduceOp Op, typename S, int C>
+	DYN_SIMD_FUNC void HR_ReduceBlockSimd(const S* p, size_t n, S* result)
+	{
+		typedef simd::Pack<S> P;
+
+		//U registers cover a whole number of elements, lane j of register u holds component (u * W + j) % C
+		const int U = C == 1 ? 4 : C;
+		const size_t step = U * P::W;
+
+		typename P::V acc[U];
+		for (int u = 0; u < U; u++)
+			acc[u] = P::set1(HR_Identity<Op, S>());
+
+		size_t i = 0;
+		for (; i + step <= n; i += step)
+		{
+			for (int u = 0; u < U; u++)
+				acc[u] = simd::vcombine<Op, P>(acc[u], P::load(p + i + u * P::W));
+		}
+
+		S lanes[U * P::W];
+		for (int u = 0; u < U; u++)
+			P::store(lanes + u * P::W, acc[u]);
+
+		for (int j = 0; j < U * P::W; j++)
+			result[j % C] = simd::combine<Op>(result[j % C], lanes[j]);
+
+		HR_ReduceBlock<Op, S, C>(p + i, n - i, result);
+	}
+#endif
+
+	template<simd::ReduceOp Op, typename T>
+	T HR_Reduce(const T* val, const uint num)
+	{
+		typedef HR_Traits<T> Traits;
+		typedef typename Traits::Scalar S;
+		const int C = Traits::C;
+
+		const S* p = (const S*)val;
+
+		S result[C];
+		for (int c = 0; c < C; c++)
+			result[c] = HR_Identity<Op, S>();
+
+		ThreadPool* pool = ThreadPool::instance();
+
+		size_t n = (size_t)num * C;
+		size_t blockNum = (n + HR_BLOCK_SIZE - 1) / HR_BLOCK_SIZE;
+		size_t maxBlockNum = 4 * (size_t)pool->threadNumber();
+		blockNum = blockNum < maxBlockNum ? blockNum : maxBlockNum;
+		blockNum = blockNum < 1 ? 1 : blockNum;
+
+		//Blocks contain whole elements
+		size_t blockSize = ((size_t)num + blockNum - 1) / blockNum * C;
+
+		std::vector<S> partial(blockNum * C, HR_Identity<Op, S>());
+
+		auto reduceBlocks = [&](unsigned int first, unsigned int last) {
+			for (unsigned int b = first; b < last; b++)
+			{
+				size_t begin = b * blockSize;
+				size_t end = begin + blockSize < n ? begin + blockSize : n;
+				if (begin >= end) continue;
+#ifdef DYN_SIMD
+				if (simd::available())
+				{
+					HR_ReduceBlockSimd<Op, S, C>(p + begin, end - begin, &partial[b * C]);
+					continue;
+				}
+#endif
+				HR_ReduceBlock<Op, S, C>(p + begin, end - begin, &partial[b * C]);
+			}
+		};
+
+		if (blockNum == 1)
+			reduceBlocks(0, 1);
+		else
+			pool->parallelFor(0, (unsigned int)blockNum, reduceBlocks, 1);
+
+		for (size_t b = 0; b < blockNum; b++)
+		{
+			for (int c = 0; c < C; c++)
+				result[c] = simd::combine<Op>(result[c], partial[b * C + c]);
+		}
+
+		return Traits::make(result);
+	}
+
+	template<typename T>
+	HostReduction<T>::HostReduction()
+	{
+	}
+
+	template<typename T>
+	HostReduction<T>::~HostReduction()
+	{
+	}
+
+	template<typename T>
+	HostReduction<T>* HostReduction<T>::Create(const uint n)
+	{
+		return new HostReduction<T>();
+	}
+
+	template<typename T>
+	T HostReduction<T>::accumulate(const T* val, const uint num)
+	{
+		return HR_Reduce<simd::SIMD_SUM>(val, num);
+	}
+
+	template<typename T>
+	T HostReduction<T>::maximum(const T* val, const uint num)
+	{
+		return HR_Reduce<simd::SIMD_MAX>(val, num);
+	}
+
+	template<typename T>
+	T HostReduction<T>::minimum(const T* val, const uint num)
+	{
+		return HR_Reduce<simd::SIMD_MIN>(val, num);
+	}
+
+	template<typename T>
+	T HostReduction<T>::average(const T* val, const uint num)
+	{
+		typedef typename HR_Traits<T>::Scalar S;
+
+		T sum = this->accumulate(val, num);
+
+		return num == 0 ? sum : sum / (S)num;
+	}
+
+	template class HostReduction<int>;
+	template class HostReduction<uint>;
+	template class HostReduction<float>;
+	template class HostReduction<double>;
+	template class HostReduction<Vec3f>;
+	template class HostReduction<Vec3d>;
+}
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+#include "Vector.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Reduction over host memory, the counterpart of Reduction<T> for CArray.
+	 *
+	 * Supports int, uint, float, double, Vec3f and Vec3d. Large inputs are split into blocks reduced by the ThreadPool,
+	 * 	the inner loops use AVX2 or NEON. Vectors are reduced component-wise.
+	 */
+	template<typename T>
+	class HostReduction
+	{
+	public:
+		HostReduction();
+		~HostReduction();
+
+		static HostReduction* Create(const uint n);
+
+		T accumulate(const T* val, const uint num);
+
+		T maximum(const T* val, const uint num);
+
+		T minimum(const T* val, const uint num);
+
+		T average(const T* val, const uint num);
+
+		T accumulate(const CArray<T>& arr) { return this->accumulate(arr.begin(), arr.size()); }
+		T maximum(const CArray<T>& arr) { return this->maximum(arr.begin(), arr.size()); }
+		T minimum(const CArray<T>& arr) { return this->minimum(arr.begin(), arr.size()); }
+		T average(const CArray<T>& arr) { return this->average(arr.begin(), arr.size()); }
+	};
+}
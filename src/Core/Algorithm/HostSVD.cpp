@@ -0,0 +1,193 @@
+#include "HostSVD.h"
+
+#include "ThreadPool.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "HostLanes.h"
+#include "HostSVDKernel.inl"
+
+namespace dyno
+{
+	typedef void (*HSVD_Kernel)(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num);
+
+	//Defined in HostSVDAvx2.cpp and HostSVDAvx512.cpp, return nullptr if the compiler could not target the instruction set
+	HSVD_Kernel HSVD_Avx2Kernel();
+	HSVD_Kernel HSVD_Avx512Kernel();
+
+#define HSVD_BLOCK_SIZE 256
+#define HSVD_CHUNK_SIZE 16
+
+	static void HSVD_ScalarKernel(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num)
+	{
+		HSVD_DecomposeAll<LaneScalar>(A, U, S, V, num);
+	}
+
+	static HSVD_Kernel HSVD_Select(simd::InstructionSet isa)
+	{
+		if (isa == simd::ISA_AUTO)
+			isa = HostSVD::instructionSet();
+
+		HSVD_Kernel kernel = nullptr;
+		if (isa == simd::ISA_AVX512 && simd::supports(isa))
+			kernel = HSVD_Avx512Kernel();
+		else if (isa == simd::ISA_AVX2 && simd::supports(isa))
+			kernel = HSVD_Avx2Kernel();
+
+		return kernel == nullptr ? HSVD_ScalarKernel : kernel;
+	}
+
+	simd::InstructionSet HostSVD::instructionSet()
+	{
+		static simd::InstructionSet best = []() -> simd::InstructionSet {
+			if (HSVD_Avx512Kernel() != nullptr && simd::supports(simd::ISA_AVX512))
+				return simd::ISA_AVX512;
+			if (HSVD_Avx2Kernel() != nullptr && simd::supports(simd::ISA_AVX2))
+				return simd::ISA_AVX2;
+			return simd::ISA_SCALAR;
+		}();
+
+		return best;
+	}
+
+	void HostSVD::svd(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num, simd::InstructionSet isa)
+	{
+		if (num == 0)
+			return;
+
+		HSVD_Kernel kernel = HSVD_Select(isa);
+
+		if (num <= HSVD_BLOCK_SIZE)
+		{
+			kernel(A, U, S, V, num);
+			return;
+		}
+
+		unsigned int blockNum = (unsigned int)((num + HSVD_BLOCK_SIZE - 1) / HSVD_BLOCK_SIZE);
+		ThreadPool::instance()->parallelFor(0, blockNum, [&](unsigned int first, unsigned int last) {
+			size_t begin = (size_t)first * HSVD_BLOCK_SIZE;
+			size_t end = std::min(num, (size_t)last * HSVD_BLOCK_SIZE);
+
+			const float* a[9];
+			float* u[9];
+			float* s[3];
+			float* v[9];
+			for (int k = 0; k < 9; k++)
+			{
+				a[k] = A[k] + begin;
+				u[k] = U[k] + begin;
+				v[k] = V[k] + begin;
+			}
+			for (int k = 0; k < 3; k++)
+				s[k] = S[k] + begin;
+
+			kernel(a, u, s, v, end - begin);
+		}, 1);
+	}
+
+	/**
+	 * @brief Transpose the matrices [begin, end) into planes chunk by chunk, decompose them and hand each result to the callback.
+	 * 	A chunk holds as many matrices as the widest lane type, so the planes stay small enough for the stack.
+	 */
+	template<typename Callback>
+	static void HSVD_DecomposeRange(HSVD_Kernel kernel, const Mat3f* A, size_t begin, size_t end, Callback& callback)
+	{
+		float a[9][HSVD_CHUNK_SIZE], u[9][HSVD_CHUNK_SIZE], s[3][HSVD_CHUNK_SIZE], v[9][HSVD_CHUNK_SIZE];
+		const float* pa[9];
+		float* pu[9];
+		float* ps[3];
+		float* pv[9];
+		for (int k = 0; k < 9; k++)
+		{
+			pa[k] = a[k];
+			pu[k] = u[k];
+			pv[k] = v[k];
+		}
+		for (int k = 0; k < 3; k++)
+			ps[k] = s[k];
+
+		for (size_t first = begin; first < end; first += HSVD_CHUNK_SIZE)
+		{
+			size_t n = std::min(end - first, (size_t)HSVD_CHUNK_SIZE);
+
+			for (size_t l = 0; l < n; l++)
+			{
+				const Mat3f& m = A[first + l];
+				for (int i = 0; i < 3; i++)
+					for (int j = 0; j < 3; j++)
+						a[3 * i + j][l] = m(i, j);
+			}
+
+			kernel(pa, pu, ps, pv, n);
+
+			for (size_t l = 0; l < n; l++)
+			{
+				Mat3f mu, mv;
+				for (int i = 0; i < 3; i++)
+				{
+					for (int j = 0; j < 3; j++)
+					{
+						mu(i, j) = u[3 * i + j][l];
+						mv(i, j) = v[3 * i + j][l];
+					}
+				}
+
+				callback(first + l, mu, Vec3f(s[0][l], s[1][l], s[2][l]), mv);
+			}
+		}
+	}
+
+	/**
+	 * @brief Decompose all matrices, batches larger than one block are split over the ThreadPool
+	 */
+	template<typename Callback>
+	static void HSVD_ForEachBlock(const Mat3f* A, size_t num, simd::InstructionSet isa, Callback callback)
+	{
+		if (num == 0)
+			return;
+
+		HSVD_Kernel kernel = HSVD_Select(isa);
+
+		//Small batches, e.g. the single matrices of polarDecomposition() in MatrixFunc, run in the calling thread
+		if (num <= HSVD_BLOCK_SIZE)
+		{
+			HSVD_DecomposeRange(kernel, A, 0, num, callback);
+			return;
+		}
+
+		unsigned int blockNum = (unsigned int)((num + HSVD_BLOCK_SIZE - 1) / HSVD_BLOCK_SIZE);
+		ThreadPool::instance()->parallelFor(0, blockNum, [&](unsigned int first, unsigned int last) {
+			HSVD_DecomposeRange(kernel, A, (size_t)first * HSVD_BLOCK_SIZE, std::min(num, (size_t)last * HSVD_BLOCK_SIZE), callback);
+		}, 1);
+	}
+
+	void HostSVD::svd(const Mat3f* A, Mat3f* U, Vec3f* S, Mat3f* V, size_t num, simd::InstructionSet isa)
+	{
+		HSVD_ForEachBlock(A, num, isa, [=](size_t i, const Mat3f& u, const Vec3f& s, const Mat3f& v) {
+			U[i] = u;
+			S[i] = s;
+			V[i] = v;
+		});
+	}
+
+	void HostSVD::polarDecomposition(const Mat3f* A, Mat3f* R, Mat3f* U, Mat3f* D, Mat3f* V, size_t num, simd::InstructionSet isa)
+	{
+		HSVD_ForEachBlock(A, num, isa, [=](size_t i, const Mat3f& u, const Vec3f& s, const Mat3f& v) {
+			R[i] = u * v.transpose();
+
+			if (U != nullptr)
+				U[i] = u;
+			if (D != nullptr)
+			{
+				Mat3f d(0.0f);
+				d(0, 0) = s[0];
+				d(1, 1) = s[1];
+				d(2, 2) = s[2];
+				D[i] = d;
+			}
+			if (V != nullptr)
+				V[i] = v;
+		});
+	}
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Vector.h"
+#include "Matrix.h"
+#include "HostInstructionSet.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Batched singular value and polar decomposition of 3x3 matrices in host memory.
+	 *
+	 * Follows McAdams et al., "Computing the Singular Value Decomposition of 3x3 matrices with minimal branching and elementary
+	 * 	floating point operations", with Jacobi sweeps repeated until A^T * A is diagonal up to 1e-6 of its trace. The kernel runs
+	 * 	on 8 matrices at once with AVX2 or 16 with AVX-512, selected at runtime, and large batches are split over the ThreadPool.
+	 *
+	 * A = U * diag(S) * V^T, where U and V are rotations and S is sorted in decreasing order of magnitude,
+	 * 	so S[2] is negative for matrices with a negative determinant.
+	 */
+	class HostSVD
+	{
+	public:
+		/**
+		 * @brief The best instruction set supported by both the binary and the processor
+		 */
+		static simd::InstructionSet instructionSet();
+
+		static void svd(const Mat3f* A, Mat3f* U, Vec3f* S, Mat3f* V, size_t num, simd::InstructionSet isa = simd::ISA_AUTO);
+
+		/**
+		 * @brief Structure of arrays variant, A[3 * i + j] points to the num entries (i, j) of the matrices, same for U and V
+		 */
+		static void svd(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num, simd::InstructionSet isa = simd::ISA_AUTO);
+
+		/**
+		 * @brief A = R * (V * D * V^T) with the rotation R = U * V^T, same outputs as polarDecomposition(A, R, U, D, V).
+		 * 	U, D and V can be nullptr if not needed.
+		 */
+		static void polarDecomposition(const Mat3f* A, Mat3f* R, Mat3f* U, Mat3f* D, Mat3f* V, size_t num, simd::InstructionSet isa = simd::ISA_AUTO);
+	};
+}
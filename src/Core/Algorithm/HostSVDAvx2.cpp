@@ -0,0 +1,25 @@
+/**
+ * Compiled with AVX2 and FMA enabled (see src/Core/CMakeLists.txt), only called after a runtime check of the processor.
+ */
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include "HostLanes.h"
+#include "HostSVDKernel.inl"
+#endif
+
+namespace dyno
+{
+	typedef void (*HSVD_Kernel)(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num);
+
+#if defined(__AVX2__)
+	static void HSVD_Avx2DecomposeAll(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num)
+	{
+		HSVD_DecomposeAll<LaneAvx2>(A, U, S, V, num);
+	}
+
+	HSVD_Kernel HSVD_Avx2Kernel() { return HSVD_Avx2DecomposeAll; }
+#else
+	HSVD_Kernel HSVD_Avx2Kernel() { return nullptr; }
+#endif
+}
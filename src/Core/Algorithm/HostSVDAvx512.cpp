@@ -0,0 +1,25 @@
+/**
+ * Compiled with AVX-512F enabled (see src/Core/CMakeLists.txt), only called after a runtime check of the processor.
+ */
+#include <cstddef>
+
+#if defined(__AVX512F__)
+#include "HostLanes.h"
+#include "HostSVDKernel.inl"
+#endif
+
+namespace dyno
+{
+	typedef void (*HSVD_Kernel)(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num);
+
+#if defined(__AVX512F__)
+	static void HSVD_Avx512DecomposeAll(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num)
+	{
+		HSVD_DecomposeAll<LaneAvx512>(A, U, S, V, num);
+	}
+
+	HSVD_Kernel HSVD_Avx512Kernel() { return HSVD_Avx512DecomposeAll; }
+#else
+	HSVD_Kernel HSVD_Avx512Kernel() { return nullptr; }
+#endif
+}
@@ -0,0 +1,277 @@
+/**
+ * The lane-generic kernel of HostSVD, included by HostSVD.cpp, HostSVDAvx2.cpp and HostSVDAvx512.cpp, each compiled for its own
+ * 	instruction set. Everything lives in an anonymous namespace so the instantiations of different translation units never merge.
+ *
+ * The lane types are those of HostLanes.h.
+ */
+#include <cstddef>
+
+namespace
+{
+	#define HSVD_GAMMA		5.828427124f	// 3 + 2 * sqrt(2)
+	#define HSVD_CSTAR		0.923879532f	// cos(pi / 8)
+	#define HSVD_SSTAR		0.3826834323f	// sin(pi / 8)
+	#define HSVD_TOLERANCE	1e-6f		// relative to the trace of A^T * A
+	#define HSVD_MAX_SWEEPS	10
+
+	/**
+	 * @brief Approximate Jacobi rotation in the (p, q) plane, S = Q^T * S * Q and V = V * Q.
+	 * 	Off-diagonal entries below tol are left as they are, rotating by their rounding noise would make the
+	 * 	null space of rank deficient matrices depend on the instruction set.
+	 */
+	template<typename L, int p, int q>
+	inline void HSVD_Jacobi(typename L::V s[3][3], typename L::V v[3][3], typename L::V tol)
+	{
+		typedef typename L::V V;
+		typedef typename L::M M;
+
+		V ch = L::mul(L::set1(2.0f), L::sub(s[p][p], s[q][q]));
+		V sh = s[p][q];
+
+		M b = L::lt(L::mul(L::set1(HSVD_GAMMA), L::mul(sh, sh)), L::mul(ch, ch));
+		V w = L::rsqrt(L::add(L::mul(ch, ch), L::mul(sh, sh)));
+
+		ch = L::blend(b, L::mul(w, ch), L::set1(HSVD_CSTAR));
+		sh = L::blend(b, L::mul(w, sh), L::set1(HSVD_SSTAR));
+
+		M rot = L::lt(tol, L::abs(s[p][q]));
+		ch = L::blend(rot, ch, L::set1(1.0f));
+		sh = L::blend(rot, sh, L::set1(0.0f));
+
+		V c = L::sub(L::mul(ch, ch), L::mul(sh, sh));
+		V sn = L::mul(L::set1(2.0f), L::mul(ch, sh));
+
+		for (int k = 0; k < 3; k++)
+		{
+			V tp = L::add(L::mul(c, s[k][p]), L::mul(sn, s[k][q]));
+			V tq = L::sub(L::mul(c, s[k][q]), L::mul(sn, s[k][p]));
+			s[k][p] = tp;
+			s[k][q] = tq;
+
+			V vp = L::add(L::mul(c, v[k][p]), L::mul(sn, v[k][q]));
+			V vq = L::sub(L::mul(c, v[k][q]), L::mul(sn, v[k][p]));
+			v[k][p] = vp;
+			v[k][q] = vq;
+		}
+
+		for (int k = 0; k < 3; k++)
+		{
+			V tp = L::add(L::mul(c, s[p][k]), L::mul(sn, s[q][k]));
+			V tq = L::sub(L::mul(c, s[q][k]), L::mul(sn, s[p][k]));
+			s[p][k] = tp;
+			s[q][k] = tq;
+		}
+	}
+
+	/**
+	 * @brief Swap the columns p and q of B and V where m is set, negating one of them to keep V a rotation
+	 */
+	template<typename L, int p, int q>
+	inline void HSVD_CondSwap(typename L::M m, typename L::V b[3][3], typename L::V v[3][3], typename L::V rho[3])
+	{
+		typedef typename L::V V;
+
+		for (int k = 0; k < 3; k++)
+		{
+			V bp = b[k][p];
+			b[k][p] = L::blend(m, b[k][q], bp);
+			b[k][q] = L::blend(m, L::sub(L::set1(0.0f), bp), b[k][q]);
+
+			V vp = v[k][p];
+			v[k][p] = L::blend(m, v[k][q], vp);
+			v[k][q] = L::blend(m, L::sub(L::set1(0.0f), vp), v[k][q]);
+		}
+
+		V rp = rho[p];
+		rho[p] = L::blend(m, rho[q], rp);
+		rho[q] = L::blend(m, rp, rho[q]);
+	}
+
+	/**
+	 * @brief Givens rotation in the (p, q) plane zeroing B(q, p), B = G * B and U = U * G^T.
+	 * 	Columns shorter than eps are not rotated, for the same reason as in HSVD_Jacobi.
+	 */
+	template<typename L, int p, int q>
+	inline void HSVD_QRGivens(typename L::V b[3][3], typename L::V u[3][3], typename L::V eps)
+	{
+		typedef typename L::V V;
+		typedef typename L::M M;
+
+		V a1 = b[p][p];
+		V a2 = b[q][p];
+
+		V rho = L::sqrt(L::add(L::mul(a1, a1), L::mul(a2, a2)));
+
+		M valid = L::lt(eps, rho);
+		V sh = L::blend(valid, a2, L::set1(0.0f));
+		V ch = L::add(L::abs(a1), L::max(rho, eps));
+
+		M neg = L::land(valid, L::lt(a1, L::set1(0.0f)));
+		V t = ch;
+		ch = L::blend(neg, sh, ch);
+		sh = L::blend(neg, t, sh);
+
+		V w = L::rsqrt(L::add(L::mul(ch, ch), L::mul(sh, sh)));
+		ch = L::mul(ch, w);
+		sh = L::mul(sh, w);
+
+		V c = L::sub(L::mul(ch, ch), L::mul(sh, sh));
+		V sn = L::mul(L::set1(2.0f), L::mul(ch, sh));
+
+		for (int k = 0; k < 3; k++)
+		{
+			V bp = L::add(L::mul(c, b[p][k]), L::mul(sn, b[q][k]));
+			V bq = L::sub(L::mul(c, b[q][k]), L::mul(sn, b[p][k]));
+			b[p][k] = bp;
+			b[q][k] = bq;
+
+			V up = L::add(L::mul(c, u[k][p]), L::mul(sn, u[k][q]));
+			V uq = L::sub(L::mul(c, u[k][q]), L::mul(sn, u[k][p]));
+			u[k][p] = up;
+			u[k][q] = uq;
+		}
+	}
+
+	/**
+	 * @brief Decompose the L::W matrices starting at offset of the planes A
+	 */
+	template<typename L>
+	inline void HSVD_Decompose(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t offset)
+	{
+		typedef typename L::V VT;
+		typedef typename L::M M;
+
+		VT a[3][3];
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				a[i][j] = L::load(A[3 * i + j] + offset);
+
+		//S = A^T * A
+		VT s[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = i; j < 3; j++)
+			{
+				VT sum = L::mul(a[0][i], a[0][j]);
+				sum = L::add(sum, L::mul(a[1][i], a[1][j]));
+				sum = L::add(sum, L::mul(a[2][i], a[2][j]));
+				s[i][j] = sum;
+				s[j][i] = sum;
+			}
+		}
+
+		VT v[3][3];
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				v[i][j] = L::set1(i == j ? 1.0f : 0.0f);
+
+		//All thresholds are relative to the trace so that the result does not depend on the scale of A
+		VT trace = L::add(L::add(s[0][0], s[1][1]), s[2][2]);
+		VT tol = L::mul(L::set1(HSVD_TOLERANCE), trace);
+
+		//Sweep until the off-diagonal entries of all lanes are negligible
+		for (int sweep = 0; sweep < HSVD_MAX_SWEEPS; sweep++)
+		{
+			M offDiagonal = L::lor(L::lt(tol, L::abs(s[0][1])), L::lor(L::lt(tol, L::abs(s[0][2])), L::lt(tol, L::abs(s[1][2]))));
+			if (!L::any(offDiagonal))
+				break;
+
+			HSVD_Jacobi<L, 0, 1>(s, v, tol);
+			HSVD_Jacobi<L, 0, 2>(s, v, tol);
+			HSVD_Jacobi<L, 1, 2>(s, v, tol);
+		}
+
+		//B = A * V
+		VT b[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				VT sum = L::mul(a[i][0], v[0][j]);
+				sum = L::add(sum, L::mul(a[i][1], v[1][j]));
+				sum = L::add(sum, L::mul(a[i][2], v[2][j]));
+				b[i][j] = sum;
+			}
+		}
+
+		//Sort the columns of B by decreasing norm, columns of nearly equal norms keep their order
+		VT rho[3];
+		for (int j = 0; j < 3; j++)
+			rho[j] = L::add(L::add(L::mul(b[0][j], b[0][j]), L::mul(b[1][j], b[1][j])), L::mul(b[2][j], b[2][j]));
+
+		HSVD_CondSwap<L, 0, 1>(L::lt(L::add(rho[0], tol), rho[1]), b, v, rho);
+		HSVD_CondSwap<L, 0, 2>(L::lt(L::add(rho[0], tol), rho[2]), b, v, rho);
+		HSVD_CondSwap<L, 1, 2>(L::lt(L::add(rho[1], tol), rho[2]), b, v, rho);
+
+		//B = U * diag(S)
+		VT u[3][3];
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				u[i][j] = L::set1(i == j ? 1.0f : 0.0f);
+
+		//Never zero, rsqrt in HSVD_QRGivens relies on it
+		VT eps = L::max(L::mul(L::set1(HSVD_TOLERANCE), L::sqrt(trace)), L::set1(1e-18f));
+
+		HSVD_QRGivens<L, 0, 1>(b, u, eps);
+		HSVD_QRGivens<L, 0, 2>(b, u, eps);
+		HSVD_QRGivens<L, 1, 2>(b, u, eps);
+
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				L::store(U[3 * i + j] + offset, u[i][j]);
+				L::store(V[3 * i + j] + offset, v[i][j]);
+			}
+			L::store(S[i] + offset, b[i][i]);
+		}
+	}
+
+	/**
+	 * @brief Decompose num matrices given as planes, the tail is padded with identity matrices
+	 */
+	template<typename L>
+	inline void HSVD_DecomposeAll(const float* const A[9], float* const U[9], float* const S[3], float* const V[9], size_t num)
+	{
+		const size_t W = L::W;
+
+		size_t i = 0;
+		for (; i + W <= num; i += W)
+			HSVD_Decompose<L>(A, U, S, V, i);
+
+		if (i < num)
+		{
+			float a[9][W], u[9][W], s[3][W], v[9][W];
+			const float* pa[9];
+			float* pu[9];
+			float* ps[3];
+			float* pv[9];
+
+			size_t rest = num - i;
+			for (int k = 0; k < 9; k++)
+			{
+				for (size_t l = 0; l < W; l++)
+					a[k][l] = l < rest ? A[k][i + l] : (k % 4 == 0 ? 1.0f : 0.0f);
+
+				pa[k] = a[k];
+				pu[k] = u[k];
+				pv[k] = v[k];
+			}
+			for (int k = 0; k < 3; k++)
+				ps[k] = s[k];
+
+			HSVD_Decompose<L>(pa, pu, ps, pv, 0);
+
+			for (size_t l = 0; l < rest; l++)
+			{
+				for (int k = 0; k < 9; k++)
+				{
+					U[k][i + l] = u[k][l];
+					V[k][i + l] = v[k][l];
+				}
+				for (int k = 0; k < 3; k++)
+					S[k][i + l] = s[k][l];
+			}
+		}
+	}
+}
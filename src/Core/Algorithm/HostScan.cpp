@@ -0,0 +1,228 @@
+#include "HostScan.h"
+#include "HostSimd.h"
+
+#include "ThreadPool.h"
+
+namespace dyno
+{
+	//Inputs shorter than this are scanned by the calling thread
+	#define HS_BLOCK_SIZE 16384
+
+	template<typename T>
+	T HS_Sum(const T* input, size_t length)
+	{
+		T sum = 0;
+		for (size_t i = 0; i < length; i++)
+			sum += input[i];
+
+		return sum;
+	}
+
+	template<typename T>
+	void HS_ScanBlock(T* output, const T* input, size_t length, T offset, bool inclusive)
+	{
+		T sum = offset;
+		for (size_t i = 0; i < length; i++)
+		{
+			T val = input[i];
+			output[i] = inclusive ? sum + val : sum;
+			sum += val;
+		}
+	}
+
+#ifdef DYN_SIMD
+	template<typename T>
+	DYN_SIMD_FUNC T HS_SumSimd(const T* input, size_t length)
+	{
+		typedef simd::Pack<T> P;
+
+		typename P::V acc0 = P::set1(0);
+		typename P::V acc1 = P::set1(0);
+
+		size_t i = 0;
+		for (; i + 2 * P::W <= length; i += 2 * P::W)
+		{
+			acc0 = P::add(acc0, P::load(input + i));
+			acc1 = P::add(acc1, P::load(input + i + P::W));
+		}
+
+		T lanes[P::W];
+		P::store(lanes, P::add(acc0, acc1));
+
+		T sum = 0;
+		for (int k = 0; k < P::W; k++)
+			sum += lanes[k];
+
+		for (; i < length; i++)
+			sum += input[i];
+
+		return sum;
+	}
+
+	template<typename T>
+	DYN_SIMD_FUNC void HS_ScanBlockSimd(T* output, const T* input, size_t length, T offset, bool inclusive)
+	{
+		typedef simd::Pack<T> P;
+
+		typename P::V carry = P::set1(offset);
+
+		size_t i = 0;
+		for (; i + P::W <= length; i += P::W)
+		{
+			typename P::V x = P::load(input + i);
+			typename P::V s = P::add(P::prefix(x), carry);
+
+			P::store(output + i, inclusive ? s : P::sub(s, x));
+
+			carry = P::last(s);
+		}
+
+		T lanes[P::W];
+		P::store(lanes, carry);
+
+		HS_ScanBlock(output + i, input + i, length - i, lanes[0], inclusive);
+	}
+#endif
+
+	template<typename T>
+	T HS_BlockSum(const T* input, size_t length)
+	{
+#ifdef DYN_SIMD
+		if (simd::available())
+			return HS_SumSimd(input, length);
+#endif
+		return HS_Sum(input, length);
+	}
+
+	template<typename T>
+	void HS_BlockScan(T* output, const T* input, size_t length, T offset, bool inclusive)
+	{
+#ifdef DYN_SIMD
+		if (simd::available())
+		{
+			HS_ScanBlockSimd(output, input, length, offset, inclusive);
+			return;
+		}
+#endif
+		HS_ScanBlock(output, input, length, offset, inclusive);
+	}
+
+	template<typename T>
+	HostScan<T>::HostScan()
+	{
+	}
+
+	template<typename T>
+	HostScan<T>::~HostScan()
+	{
+	}
+
+	template<typename T>
+	void HostScan<T>::scan(T* output, const T* input, size_t length, bool inclusive)
+	{
+		if (length == 0)
+			return;
+
+		ThreadPool* pool = ThreadPool::instance();
+
+		size_t blockNum = (length + HS_BLOCK_SIZE - 1) / HS_BLOCK_SIZE;
+		size_t maxBlockNum = 4 * (size_t)pool->threadNumber();
+		blockNum = blockNum < maxBlockNum ? blockNum : maxBlockNum;
+
+		if (blockNum <= 1)
+		{
+			HS_BlockScan(output, input, length, T(0), inclusive);
+			return;
+		}
+
+		size_t blockSize = (length + blockNum - 1) / blockNum;
+
+		//First pass: the sum of each block
+		std::vector<T> offsets(blockNum);
+		pool->parallelFor(0, (unsigned int)blockNum, [&](unsigned int first, unsigned int last) {
+			for (unsigned int b = first; b < last; b++)
+			{
+				size_t begin = b * blockSize;
+				size_t end = begin + blockSize < length ? begin + blockSize : length;
+				offsets[b] = HS_BlockSum(input + begin, end - begin);
+			}
+		}, 1);
+
+		T total = 0;
+		for (size_t b = 0; b < blockNum; b++)
+		{
+			T sum = offsets[b];
+			offsets[b] = total;
+			total += sum;
+		}
+
+		//Second pass: scan each block starting from the sum of its predecessors
+		pool->parallelFor(0, (unsigned int)blockNum, [&](unsigned int first, unsigned int last) {
+			for (unsigned int b = first; b < last; b++)
+			{
+				size_t begin = b * blockSize;
+				size_t end = begin + blockSize < length ? begin + blockSize : length;
+				HS_BlockScan(output + begin, input + begin, end - begin, offsets[b], inclusive);
+			}
+		}, 1);
+	}
+
+	template<typename T>
+	void HostScan<T>::exclusive(T* output, const T* input, size_t length)
+	{
+		this->scan(output, input, length, false);
+	}
+
+	template<typename T>
+	void HostScan<T>::exclusive(T* data, size_t length)
+	{
+		this->scan(data, data, length, false);
+	}
+
+	template<typename T>
+	void HostScan<T>::exclusive(CArray<T>& output, const CArray<T>& input)
+	{
+		if (output.size() != input.size())
+			output.resize(input.size());
+
+		this->scan(output.begin(), input.begin(), input.size(), false);
+	}
+
+	template<typename T>
+	void HostScan<T>::exclusive(CArray<T>& data)
+	{
+		this->scan(data.begin(), data.begin(), data.size(), false);
+	}
+
+	template<typename T>
+	void HostScan<T>::inclusive(T* output, const T* input, size_t length)
+	{
+		this->scan(output, input, length, true);
+	}
+
+	template<typename T>
+	void HostScan<T>::inclusive(T* data, size_t length)
+	{
+		this->scan(data, data, length, true);
+	}
+
+	template<typename T>
+	void HostScan<T>::inclusive(CArray<T>& output, const CArray<T>& input)
+	{
+		if (output.size() != input.size())
+			output.resize(input.size());
+
+		this->scan(output.begin(), input.begin(), input.size(), true);
+	}
+
+	template<typename T>
+	void HostScan<T>::inclusive(CArray<T>& data)
+	{
+		this->scan(data.begin(), data.begin(), data.size(), true);
+	}
+
+	template class HostScan<int>;
+	template class HostScan<uint>;
+	template class HostScan<float>;
+	template class HostScan<double>;
+}
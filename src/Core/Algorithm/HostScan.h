@@ -0,0 +1,50 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Prefix sum over host memory, the counterpart of Scan<T> for CArray.
+	 *
+	 * Large inputs are split into blocks scanned by the ThreadPool in two passes: the block sums are computed first,
+	 * 	then every block is scanned with the sum of its predecessors as the offset. The inner loops use AVX2 or NEON.
+	 * 	Input and output may be the same array.
+	 */
+	template<typename T>
+	class HostScan
+	{
+	public:
+		HostScan();
+		~HostScan();
+
+		void exclusive(T* output, const T* input, size_t length);
+		void exclusive(T* data, size_t length);
+
+		void exclusive(CArray<T>& output, const CArray<T>& input);
+		void exclusive(CArray<T>& data);
+
+		void inclusive(T* output, const T* input, size_t length);
+		void inclusive(T* data, size_t length);
+
+		void inclusive(CArray<T>& output, const CArray<T>& input);
+		void inclusive(CArray<T>& data);
+
+	private:
+		void scan(T* output, const T* input, size_t length, bool inclusive);
+	};
+}
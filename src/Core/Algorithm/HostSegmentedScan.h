@@ -0,0 +1,201 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <vector>
+#include <functional>
+
+#include "Array/ArrayList.h"
+#include "ThreadPool.h"
+
+namespace dyno
+{
+	//Rows are processed by the calling thread if the list has fewer elements and rows than this
+	#define HSS_BLOCK_SIZE 8192
+
+	/**
+	 * @brief Segmented reduction and scan over the rows of an ArrayList in host memory.
+	 *
+	 * Rows are distributed over the ThreadPool in chunks of roughly equal cost, where the cost of a row is one plus its length,
+	 * 	so a few long rows do not serialize the work the way a one-thread-per-row loop does on skewed neighbor counts.
+	 *
+	 * Map is called as map(row, element) and Op as op(lhs, rhs), Op is expected to be associative.
+	 */
+	template<typename T>
+	class HostSegmentedScan
+	{
+	public:
+		HostSegmentedScan() {};
+		~HostSegmentedScan() {};
+
+		/**
+		 * @brief out[i] = op(init, op(map(i, e_0), op(map(i, e_1), ...))) for the elements e_k of row i, init for empty rows
+		 */
+		template<typename TE, typename Map, typename Op>
+		void transformReduce(T* out, const uint* index, const TE* elements, uint rows, size_t total, Map map, T init, Op op)
+		{
+			this->forEachRows(index, rows, total, [&](uint first, uint last) {
+				for (uint r = first; r < last; r++)
+				{
+					size_t end = r + 1 < rows ? index[r + 1] : total;
+
+					T acc = init;
+					for (size_t e = index[r]; e < end; e++)
+						acc = op(acc, map(r, elements[e]));
+
+					out[r] = acc;
+				}
+			});
+		}
+
+		template<typename Op>
+		void reduce(T* out, const uint* index, const T* elements, uint rows, size_t total, T init, Op op)
+		{
+			this->transformReduce(out, index, elements, rows, total, HSS_Identity(), init, op);
+		}
+
+		/**
+		 * @brief Replace every element with the fold of its row up to and including itself
+		 */
+		template<typename Op>
+		void inclusive(T* elements, const uint* index, uint rows, size_t total, Op op)
+		{
+			this->forEachRows(index, rows, total, [&](uint first, uint last) {
+				for (uint r = first; r < last; r++)
+				{
+					size_t end = r + 1 < rows ? index[r + 1] : total;
+					if (end == index[r])
+						continue;
+
+					T acc = elements[index[r]];
+					for (size_t e = index[r] + 1; e < end; e++)
+					{
+						acc = op(acc, elements[e]);
+						elements[e] = acc;
+					}
+				}
+			});
+		}
+
+		/**
+		 * @brief Replace every element with init folded with the elements of its row before itself
+		 */
+		template<typename Op>
+		void exclusive(T* elements, const uint* index, uint rows, size_t total, T init, Op op)
+		{
+			this->forEachRows(index, rows, total, [&](uint first, uint last) {
+				for (uint r = first; r < last; r++)
+				{
+					size_t end = r + 1 < rows ? index[r + 1] : total;
+
+					T acc = init;
+					for (size_t e = index[r]; e < end; e++)
+					{
+						T val = elements[e];
+						elements[e] = acc;
+						acc = op(acc, val);
+					}
+				}
+			});
+		}
+
+		template<typename TE, typename Map, typename Op>
+		void transformReduce(CArray<T>& out, const CArrayList<TE>& list, Map map, T init, Op op)
+		{
+			out.resize(list.size());
+			this->transformReduce(out.begin(), list.index().begin(), list.elements().begin(), list.size(), list.elements().size(), map, init, op);
+		}
+
+		template<typename Op>
+		void reduce(CArray<T>& out, const CArrayList<T>& list, T init, Op op)
+		{
+			this->transformReduce(out, list, HSS_Identity(), init, op);
+		}
+
+		void sum(CArray<T>& out, const CArrayList<T>& list)
+		{
+			this->reduce(out, list, T(0), std::plus<T>());
+		}
+
+		template<typename Op>
+		void inclusive(CArrayList<T>& list, Op op)
+		{
+			this->inclusive(const_cast<T*>(list.elements().begin()), list.index().begin(), list.size(), list.elements().size(), op);
+		}
+
+		template<typename Op>
+		void exclusive(CArrayList<T>& list, T init, Op op)
+		{
+			this->exclusive(const_cast<T*>(list.elements().begin()), list.index().begin(), list.size(), list.elements().size(), init, op);
+		}
+
+		/**
+		 * @brief Split [0, rows) into chunks of similar cost and call body(first, last) for each of them in parallel
+		 */
+		void forEachRows(const uint* index, uint rows, size_t total, const std::function<void(uint, uint)>& body)
+		{
+			if (rows == 0)
+				return;
+
+			size_t cost = total + rows;
+
+			ThreadPool* pool = ThreadPool::instance();
+			if (cost < HSS_BLOCK_SIZE || pool->threadNumber() < 2)
+			{
+				body(0, rows);
+				return;
+			}
+
+			size_t chunks = std::min<size_t>(4 * pool->threadNumber(), cost / HSS_BLOCK_SIZE + 1);
+
+			//The cost of the rows before r is index[r] + r, which is strictly increasing in r
+			mBounds.resize(chunks + 1);
+			mBounds[0] = 0;
+			mBounds[chunks] = rows;
+			for (size_t c = 1; c < chunks; c++)
+			{
+				size_t target = c * cost / chunks;
+
+				uint lo = mBounds[c - 1], hi = rows;
+				while (lo < hi)
+				{
+					uint mid = lo + (hi - lo) / 2;
+					if (size_t(index[mid]) + mid < target)
+						lo = mid + 1;
+					else
+						hi = mid;
+				}
+				mBounds[c] = lo;
+			}
+
+			pool->parallelFor(0, (uint)chunks, [&](uint first, uint last) {
+				for (uint c = first; c < last; c++)
+				{
+					if (mBounds[c] < mBounds[c + 1])
+						body(mBounds[c], mBounds[c + 1]);
+				}
+			}, 1);
+		}
+
+	private:
+		struct HSS_Identity
+		{
+			template<typename TE>
+			const TE& operator()(uint, const TE& e) const { return e; }
+		};
+
+		std::vector<uint> mBounds;
+	};
+}
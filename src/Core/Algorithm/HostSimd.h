@@ -0,0 +1,269 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Thin wrappers over AVX2 and NEON registers used by the inner loops of the host algorithms.
+ *
+ * On x86, AVX2 code is compiled with the target attribute and selected at runtime by simd::available(),
+ * 	so the binaries still run on processors without AVX2. On AArch64, NEON is always available.
+ *
+ * Only include this file in translation units, it pulls in the intrinsic headers.
+ */
+#pragma once
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+	#define DYN_SIMD_AVX2
+	#define DYN_SIMD_FUNC __attribute__((target("avx2")))
+	#include <immintrin.h>
+#elif (defined(__x86_64__) || defined(_M_X64)) && defined(__AVX2__)
+	#define DYN_SIMD_AVX2
+	#define DYN_SIMD_FUNC
+	#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	#define DYN_SIMD_NEON
+	#define DYN_SIMD_FUNC
+	#include <arm_neon.h>
+#endif
+
+#if defined(DYN_SIMD_AVX2) || defined(DYN_SIMD_NEON)
+	#define DYN_SIMD
+#endif
+
+namespace dyno
+{
+	namespace simd
+	{
+		enum ReduceOp
+		{
+			SIMD_SUM,
+			SIMD_MIN,
+			SIMD_MAX
+		};
+
+		/**
+		 * @brief Whether the SIMD paths can be executed on the current processor
+		 */
+		inline bool available()
+		{
+#if defined(DYN_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__)) && !defined(__AVX2__)
+			static const bool avx2 = __builtin_cpu_supports("avx2") != 0;
+			return avx2;
+#elif defined(DYN_SIMD)
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/**
+		 * Pack<T> provides: the register type V, the number of lanes W, load/store/set1/add/sub/min/max,
+		 * 	prefix() computing the inclusive prefix sum over the lanes and last() broadcasting the last lane.
+		 */
+		template<typename T> struct Pack;
+
+#if defined(DYN_SIMD_AVX2)
+		template<> struct Pack<int>
+		{
+			typedef __m256i V;
+			static const int W = 8;
+
+			static DYN_SIMD_FUNC inline V load(const int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+			static DYN_SIMD_FUNC inline void store(int* p, V v) { _mm256_storeu_si256((__m256i*)p, v); }
+			static DYN_SIMD_FUNC inline V set1(int v) { return _mm256_set1_epi32(v); }
+			static DYN_SIMD_FUNC inline V add(V a, V b) { return _mm256_add_epi32(a, b); }
+			static DYN_SIMD_FUNC inline V sub(V a, V b) { return _mm256_sub_epi32(a, b); }
+			static DYN_SIMD_FUNC inline V min(V a, V b) { return _mm256_min_epi32(a, b); }
+			static DYN_SIMD_FUNC inline V max(V a, V b) { return _mm256_max_epi32(a, b); }
+
+			static DYN_SIMD_FUNC inline V prefix(V x)
+			{
+				x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+				x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+				//Carry the total of the lower 128 bits into the upper ones
+				V t = _mm256_shuffle_epi32(x, 0xFF);
+				return _mm256_add_epi32(x, _mm256_permute2x128_si256(t, t, 0x08));
+			}
+
+			static DYN_SIMD_FUNC inline V last(V x) { return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7)); }
+		};
+
+		template<> struct Pack<unsigned int>
+		{
+			typedef __m256i V;
+			static const int W = 8;
+
+			static DYN_SIMD_FUNC inline V load(const unsigned int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+			static DYN_SIMD_FUNC inline void store(unsigned int* p, V v) { _mm256_storeu_si256((__m256i*)p, v); }
+			static DYN_SIMD_FUNC inline V set1(unsigned int v) { return _mm256_set1_epi32((int)v); }
+			static DYN_SIMD_FUNC inline V add(V a, V b) { return _mm256_add_epi32(a, b); }
+			static DYN_SIMD_FUNC inline V sub(V a, V b) { return _mm256_sub_epi32(a, b); }
+			static DYN_SIMD_FUNC inline V min(V a, V b) { return _mm256_min_epu32(a, b); }
+			static DYN_SIMD_FUNC inline V max(V a, V b) { return _mm256_max_epu32(a, b); }
+			static DYN_SIMD_FUNC inline V prefix(V x) { return Pack<int>::prefix(x); }
+			static DYN_SIMD_FUNC inline V last(V x) { return Pack<int>::last(x); }
+		};
+
+		template<> struct Pack<float>
+		{
+			typedef __m256 V;
+			static const int W = 8;
+
+			static DYN_SIMD_FUNC inline V load(const float* p) { return _mm256_loadu_ps(p); }
+			static DYN_SIMD_FUNC inline void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+			static DYN_SIMD_FUNC inline V set1(float v) { return _mm256_set1_ps(v); }
+			static DYN_SIMD_FUNC inline V add(V a, V b) { return _mm256_add_ps(a, b); }
+			static DYN_SIMD_FUNC inline V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+			static DYN_SIMD_FUNC inline V min(V a, V b) { return _mm256_min_ps(a, b); }
+			static DYN_SIMD_FUNC inline V max(V a, V b) { return _mm256_max_ps(a, b); }
+
+			static DYN_SIMD_FUNC inline V prefix(V x)
+			{
+				x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+				x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+				V t = _mm256_permute_ps(x, 0xFF);
+				return _mm256_add_ps(x, _mm256_permute2f128_ps(t, t, 0x08));
+			}
+
+			static DYN_SIMD_FUNC inline V last(V x) { return _mm256_permutevar8x32_ps(x, _mm256_set1_epi32(7)); }
+		};
+
+		template<> struct Pack<double>
+		{
+			typedef __m256d V;
+			static const int W = 4;
+
+			static DYN_SIMD_FUNC inline V load(const double* p) { return _mm256_loadu_pd(p); }
+			static DYN_SIMD_FUNC inline void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+			static DYN_SIMD_FUNC inline V set1(double v) { return _mm256_set1_pd(v); }
+			static DYN_SIMD_FUNC inline V add(V a, V b) { return _mm256_add_pd(a, b); }
+			static DYN_SIMD_FUNC inline V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+			static DYN_SIMD_FUNC inline V min(V a, V b) { return _mm256_min_pd(a, b); }
+			static DYN_SIMD_FUNC inline V max(V a, V b) { return _mm256_max_pd(a, b); }
+
+			static DYN_SIMD_FUNC inline V prefix(V x)
+			{
+				x = _mm256_add_pd(x, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(x), 8)));
+				V t = _mm256_permute_pd(x, 0xF);
+				return _mm256_add_pd(x, _mm256_permute2f128_pd(t, t, 0x08));
+			}
+
+			static DYN_SIMD_FUNC inline V last(V x) { return _mm256_permute4x64_pd(x, 0xFF); }
+		};
+#elif defined(DYN_SIMD_NEON)
+		template<> struct Pack<int>
+		{
+			typedef int32x4_t V;
+			static const int W = 4;
+
+			static inline V load(const int* p) { return vld1q_s32(p); }
+			static inline void store(int* p, V v) { vst1q_s32(p, v); }
+			static inline V set1(int v) { return vdupq_n_s32(v); }
+			static inline V add(V a, V b) { return vaddq_s32(a, b); }
+			static inline V sub(V a, V b) { return vsubq_s32(a, b); }
+			static inline V min(V a, V b) { return vminq_s32(a, b); }
+			static inline V max(V a, V b) { return vmaxq_s32(a, b); }
+
+			static inline V prefix(V x)
+			{
+				V z = vdupq_n_s32(0);
+				x = vaddq_s32(x, vextq_s32(z, x, 3));
+				return vaddq_s32(x, vextq_s32(z, x, 2));
+			}
+
+			static inline V last(V x) { return vdupq_laneq_s32(x, 3); }
+		};
+
+		template<> struct Pack<unsigned int>
+		{
+			typedef uint32x4_t V;
+			static const int W = 4;
+
+			static inline V load(const unsigned int* p) { return vld1q_u32(p); }
+			static inline void store(unsigned int* p, V v) { vst1q_u32(p, v); }
+			static inline V set1(unsigned int v) { return vdupq_n_u32(v); }
+			static inline V add(V a, V b) { return vaddq_u32(a, b); }
+			static inline V sub(V a, V b) { return vsubq_u32(a, b); }
+			static inline V min(V a, V b) { return vminq_u32(a, b); }
+			static inline V max(V a, V b) { return vmaxq_u32(a, b); }
+
+			static inline V prefix(V x)
+			{
+				V z = vdupq_n_u32(0);
+				x = vaddq_u32(x, vextq_u32(z, x, 3));
+				return vaddq_u32(x, vextq_u32(z, x, 2));
+			}
+
+			static inline V last(V x) { return vdupq_laneq_u32(x, 3); }
+		};
+
+		template<> struct Pack<float>
+		{
+			typedef float32x4_t V;
+			static const int W = 4;
+
+			static inline V load(const float* p) { return vld1q_f32(p); }
+			static inline void store(float* p, V v) { vst1q_f32(p, v); }
+			static inline V set1(float v) { return vdupq_n_f32(v); }
+			static inline V add(V a, V b) { return vaddq_f32(a, b); }
+			static inline V sub(V a, V b) { return vsubq_f32(a, b); }
+			static inline V min(V a, V b) { return vminq_f32(a, b); }
+			static inline V max(V a, V b) { return vmaxq_f32(a, b); }
+
+			static inline V prefix(V x)
+			{
+				V z = vdupq_n_f32(0.0f);
+				x = vaddq_f32(x, vextq_f32(z, x, 3));
+				return vaddq_f32(x, vextq_f32(z, x, 2));
+			}
+
+			static inline V last(V x) { return vdupq_laneq_f32(x, 3); }
+		};
+
+		template<> struct Pack<double>
+		{
+			typedef float64x2_t V;
+			static const int W = 2;
+
+			static inline V load(const double* p) { return vld1q_f64(p); }
+			static inline void store(double* p, V v) { vst1q_f64(p, v); }
+			static inline V set1(double v) { return vdupq_n_f64(v); }
+			static inline V add(V a, V b) { return vaddq_f64(a, b); }
+			static inline V sub(V a, V b) { return vsubq_f64(a, b); }
+			static inline V min(V a, V b) { return vminq_f64(a, b); }
+			static inline V max(V a, V b) { return vmaxq_f64(a, b); }
+
+			static inline V prefix(V x) { return vaddq_f64(x, vextq_f64(vdupq_n_f64(0.0), x, 1)); }
+
+			static inline V last(V x) { return vdupq_laneq_f64(x, 1); }
+		};
+#endif
+
+#ifdef DYN_SIMD
+		template<ReduceOp Op, typename P>
+		DYN_SIMD_FUNC inline typename P::V vcombine(typename P::V a, typename P::V b)
+		{
+			return Op == SIMD_SUM ? P::add(a, b) : (Op == SIMD_MIN ? P::min(a, b) : P::max(a, b));
+		}
+#endif
+
+		template<ReduceOp Op, typename T>
+		inline T combine(T a, T b)
+		{
+			return Op == SIMD_SUM ? a + b : (Op == SIMD_MIN ? (b < a ? b : a) : (a < b ? b : a));
+		}
+	}
+}
@@ -0,0 +1,190 @@
+#include "HostSort.h"
+
+#include "ThreadPool.h"
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace dyno
+{
+	//Inputs with fewer keys than this are sorted by the calling thread
+	#define HSO_BLOCK_SIZE 65536
+
+	#define HSO_RADIX_BITS 8
+	#define HSO_RADIX (1 << HSO_RADIX_BITS)
+
+	/**
+	 * Keys are sorted as unsigned integers, the sign bit of signed keys is flipped so that negative keys come first.
+	 */
+	template<typename TKey>
+	struct HSO_Traits
+	{
+		typedef typename std::make_unsigned<TKey>::type U;
+
+		static const U flip = std::is_signed<TKey>::value ? (U(1) << (8 * sizeof(TKey) - 1)) : U(0);
+
+		static inline uint digit(const TKey key, const int shift)
+		{
+			return (uint)((((U)key ^ flip) >> shift) & (HSO_RADIX - 1));
+		}
+	};
+
+	template<typename TKey>
+	HostSort<TKey>::HostSort()
+	{
+	}
+
+	template<typename TKey>
+	HostSort<TKey>::~HostSort()
+	{
+	}
+
+	template<typename TKey>
+	void HostSort<TKey>::sort(TKey* keys, size_t num)
+	{
+		this->radixSort(keys, nullptr, num);
+	}
+
+	template<typename TKey>
+	void HostSort<TKey>::sortByKey(TKey* keys, void* values, size_t num, size_t valueSize)
+	{
+		if (num < 2)
+			return;
+
+		//32-bit values are moved along with the keys, others are gathered through the permutation
+		if (valueSize == sizeof(uint))
+		{
+			this->radixSort(keys, (uint*)values, num);
+			return;
+		}
+
+		mPermutation.resize(num);
+		for (size_t i = 0; i < num; i++)
+			mPermutation[i] = (uint)i;
+
+		this->radixSort(keys, mPermutation.data(), num);
+
+		mValueBuffer.resize(num * valueSize);
+
+		char* src = (char*)values;
+		char* dst = mValueBuffer.data();
+		ThreadPool::instance()->parallelFor(0, (unsigned int)num, [&](unsigned int first, unsigned int last) {
+			for (unsigned int i = first; i < last; i++)
+				memcpy(dst + i * valueSize, src + mPermutation[i] * valueSize, valueSize);
+		}, HSO_BLOCK_SIZE);
+
+		memcpy(values, mValueBuffer.data(), num * valueSize);
+	}
+
+	template<typename TKey>
+	void HostSort<TKey>::radixSort(TKey* keys, uint* payloads, size_t num)
+	{
+		typedef HSO_Traits<TKey> Traits;
+
+		if (num < 2)
+			return;
+
+		ThreadPool* pool = ThreadPool::instance();
+
+		size_t blockNum = (num + HSO_BLOCK_SIZE - 1) / HSO_BLOCK_SIZE;
+		size_t maxBlockNum = 4 * (size_t)pool->threadNumber();
+		blockNum = blockNum < maxBlockNum ? blockNum : maxBlockNum;
+		blockNum = blockNum < 1 ? 1 : blockNum;
+
+		size_t blockSize = (num + blockNum - 1) / blockNum;
+
+		mKeyBuffer.resize(num);
+		if (payloads != nullptr)
+			mPayloadBuffer.resize(num);
+
+		//Digit counts of each block, turned into the scatter offsets of each block in place
+		mCounts.resize(blockNum * HSO_RADIX);
+
+		TKey* srcKeys = keys;
+		TKey* dstKeys = mKeyBuffer.data();
+		uint* srcPayloads = payloads;
+		uint* dstPayloads = payloads == nullptr ? nullptr : mPayloadBuffer.data();
+
+		auto forBlocks = [&](std::function<void(size_t, size_t, size_t)> body) {
+			auto blocks = [&](unsigned int first, unsigned int last) {
+				for (unsigned int b = first; b < last; b++)
+				{
+					size_t begin = b * blockSize;
+					size_t end = begin + blockSize < num ? begin + blockSize : num;
+					body(b, begin, end);
+				}
+			};
+
+			if (blockNum == 1)
+				blocks(0, 1);
+			else
+				pool->parallelFor(0, (unsigned int)blockNum, blocks, 1);
+		};
+
+		for (int shift = 0; shift < 8 * (int)sizeof(TKey); shift += HSO_RADIX_BITS)
+		{
+			forBlocks([&](size_t b, size_t begin, size_t end) {
+				size_t* count = &mCounts[b * HSO_RADIX];
+				for (int d = 0; d < HSO_RADIX; d++)
+					count[d] = 0;
+
+				for (size_t i = begin; i < end; i++)
+					count[Traits::digit(srcKeys[i], shift)]++;
+			});
+
+			//Skip the pass if all keys share the same digit
+			bool trivial = false;
+			for (int d = 0; d < HSO_RADIX && !trivial; d++)
+			{
+				size_t total = 0;
+				for (size_t b = 0; b < blockNum; b++)
+					total += mCounts[b * HSO_RADIX + d];
+
+				trivial = total == num;
+			}
+
+			if (trivial)
+				continue;
+
+			//Keys of digit d from block b follow those of smaller digits and those of digit d from preceding blocks
+			size_t offset = 0;
+			for (int d = 0; d < HSO_RADIX; d++)
+			{
+				for (size_t b = 0; b < blockNum; b++)
+				{
+					size_t c = mCounts[b * HSO_RADIX + d];
+					mCounts[b * HSO_RADIX + d] = offset;
+					offset += c;
+				}
+			}
+
+			forBlocks([&](size_t b, size_t begin, size_t end) {
+				size_t* pos = &mCounts[b * HSO_RADIX];
+				for (size_t i = begin; i < end; i++)
+				{
+					size_t p = pos[Traits::digit(srcKeys[i], shift)]++;
+					dstKeys[p] = srcKeys[i];
+					if (srcPayloads != nullptr)
+						dstPayloads[p] = srcPayloads[i];
+				}
+			});
+
+			std::swap(srcKeys, dstKeys);
+			std::swap(srcPayloads, dstPayloads);
+		}
+
+		//After an odd number of passes the result lies in the scratch buffers
+		if (srcKeys != keys)
+		{
+			memcpy(keys, srcKeys, num * sizeof(TKey));
+			if (payloads != nullptr)
+				memcpy(payloads, srcPayloads, num * sizeof(uint));
+		}
+	}
+
+	template class HostSort<int>;
+	template class HostSort<uint>;
+	template class HostSort<unsigned long>;
+	template class HostSort<unsigned long long>;
+}
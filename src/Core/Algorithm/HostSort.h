@@ -0,0 +1,68 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <vector>
+
+#include "Array/Array.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Stable LSD radix sort over host memory, the counterpart of Sort<T> for CArray.
+	 *
+	 * Keys are sorted 8 bits per pass. Each pass counts the digits of the blocks in parallel and scatters them
+	 * 	with the ThreadPool, passes whose digit is the same for all keys are skipped. Scratch buffers are kept between calls,
+	 * 	so reuse one instance for repeated sorts of similar sizes.
+	 *
+	 * Supports int, uint and 64-bit unsigned keys. Values of any trivially copyable type are moved along with the keys.
+	 */
+	template<typename TKey>
+	class HostSort
+	{
+	public:
+		HostSort();
+		~HostSort();
+
+		void sort(TKey* keys, size_t num);
+
+		/**
+		 * @brief Sort keys and reorder values of valueSize bytes accordingly
+		 */
+		void sortByKey(TKey* keys, void* values, size_t num, size_t valueSize);
+
+		void sort(CArray<TKey>& keys) { this->sort(keys.begin(), keys.size()); }
+
+		template<typename TValue>
+		void sortByKey(CArray<TKey>& keys, CArray<TValue>& values)
+		{
+			assert(keys.size() == values.size());
+			this->sortByKey(keys.begin(), values.begin(), keys.size(), sizeof(TValue));
+		}
+
+	private:
+		/**
+		 * @brief Sort keys together with 32-bit payloads, payloads can be nullptr
+		 */
+		void radixSort(TKey* keys, uint* payloads, size_t num);
+
+		std::vector<TKey> mKeyBuffer;
+		std::vector<uint> mPayloadBuffer;
+		std::vector<uint> mPermutation;
+		std::vector<char> mValueBuffer;
+
+		std::vector<size_t> mCounts;
+	};
+}
@@ -0,0 +1,291 @@
+#include "Allocator.h"
+#include "Platform.h"
+
+#include <new>
+#include <cstdlib>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace dyno
+{
+	std::atomic<Allocator*> Allocator::pDevice(nullptr);
+	std::mutex Allocator::mDeviceMutex;
+
+	//All allocators ever installed by setDevice(), arrays may still hold memory from any of them
+	static std::vector<std::shared_ptr<Allocator>>& installedAllocators()
+	{
+		static std::vector<std::shared_ptr<Allocator>> allocators;
+		return allocators;
+	}
+
+	void* Allocator::allocate(size_t bytes)
+	{
+		if (bytes == 0)
+			return nullptr;
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		bool hit = false;
+		void* ptr = this->doAllocate(bytes, hit);
+
+		if (ptr == nullptr)
+			throw std::bad_alloc();
+
+		mStat.allocations++;
+		mStat.frameAllocations++;
+		mStat.hits += hit ? 1 : 0;
+		mStat.bytesLive += bytes;
+		mStat.bytesPeak = mStat.bytesLive > mStat.bytesPeak ? mStat.bytesLive : mStat.bytesPeak;
+
+		return ptr;
+	}
+
+	void Allocator::deallocate(void* ptr, size_t bytes)
+	{
+		if (ptr == nullptr)
+			return;
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		this->doDeallocate(ptr, bytes);
+
+		mStat.deallocations++;
+		mStat.bytesLive -= bytes;
+	}
+
+	AllocatorStatistics Allocator::statistics()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		AllocatorStatistics stat = mStat;
+		stat.bytesCached = this->cachedBytes();
+
+		return stat;
+	}
+
+	void Allocator::nextFrame()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mStat.lastFrameAllocations = mStat.frameAllocations;
+		mStat.frameAllocations = 0;
+	}
+
+	void Allocator::resetPeak()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mStat.bytesPeak = mStat.bytesLive;
+	}
+
+	Allocator* Allocator::device()
+	{
+		Allocator* ins = pDevice.load(std::memory_order_acquire);
+		if (!ins) {
+			std::lock_guard<std::mutex> tLock(mDeviceMutex);
+			ins = pDevice.load(std::memory_order_relaxed);
+			if (!ins) {
+#ifdef CUDA_BACKEND
+				std::shared_ptr<Allocator> alloc = std::make_shared<CachingAllocator>(std::make_shared<DeviceAllocator>());
+#else
+				std::shared_ptr<Allocator> alloc = std::make_shared<CachingAllocator>(std::make_shared<HostAllocator>());
+#endif
+				installedAllocators().push_back(alloc);
+
+				ins = alloc.get();
+				pDevice.store(ins, std::memory_order_release);
+			}
+		}
+
+		return ins;
+	}
+
+	void Allocator::setDevice(std::shared_ptr<Allocator> alloc)
+	{
+		if (alloc == nullptr)
+			return;
+
+		std::lock_guard<std::mutex> tLock(mDeviceMutex);
+
+		installedAllocators().push_back(alloc);
+		pDevice.store(alloc.get(), std::memory_order_release);
+	}
+
+	void Allocator::releaseAllCached()
+	{
+		std::lock_guard<std::mutex> tLock(mDeviceMutex);
+
+		for (auto& alloc : installedAllocators())
+			alloc->releaseCached();
+	}
+
+	Allocator* Allocator::host()
+	{
+		//Staging buffers are large and short-lived, huge pages pay off from 2MB on
+		static HostAllocator alloc(size_t(2) << 20);
+		return &alloc;
+	}
+
+	#define HOST_ALIGNMENT 64
+	#define HUGE_PAGE_SIZE (size_t(2) << 20)
+
+	void* HostAllocator::doAllocate(size_t bytes, bool& hit)
+	{
+		hit = false;
+
+		bool huge = mHugePageBytes > 0 && bytes >= mHugePageBytes;
+		size_t alignment = huge ? HUGE_PAGE_SIZE : HOST_ALIGNMENT;
+
+#if defined(_WIN32)
+		return _aligned_malloc(bytes, alignment);
+#else
+		void* ptr = nullptr;
+		if (posix_memalign(&ptr, alignment, bytes) != 0)
+			return nullptr;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		//Only a hint, the kernel falls back to normal pages if transparent huge pages are disabled
+		if (huge)
+			madvise(ptr, bytes / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE, MADV_HUGEPAGE);
+#endif
+		return ptr;
+#endif
+	}
+
+	void HostAllocator::doDeallocate(void* ptr, size_t bytes)
+	{
+#if defined(_WIN32)
+		_aligned_free(ptr);
+#else
+		free(ptr);
+#endif
+	}
+
+#ifdef CUDA_BACKEND
+	void* DeviceAllocator::doAllocate(size_t bytes, bool& hit)
+	{
+		hit = false;
+
+		void* ptr = nullptr;
+		if (cudaMalloc(&ptr, bytes) != cudaSuccess)
+		{
+			//Clear the error so that it is not reported by later cuda calls
+			cudaGetLastError();
+			return nullptr;
+		}
+
+		//The runtime registers its teardown when it is initialized, i.e., before this point. Exit handlers run in reverse order,
+		//	so the cached blocks are freed while the context is still alive instead of by the static destructors afterwards.
+		static bool registered = std::atexit([]() { Allocator::releaseAllCached(); }) == 0;
+		(void)registered;
+
+		return ptr;
+	}
+
+	void DeviceAllocator::doDeallocate(void* ptr, size_t bytes)
+	{
+		cuSafeCall(cudaFree(ptr));
+	}
+#endif
+
+	CachingAllocator::CachingAllocator(std::shared_ptr<Allocator> upstream)
+		: mUpstream(upstream)
+	{
+	}
+
+	CachingAllocator::~CachingAllocator()
+	{
+		this->releaseAll();
+	}
+
+	size_t CachingAllocator::sizeClass(size_t bytes)
+	{
+		size_t bound = 256;
+		while (bound < bytes)
+			bound <<= 1;
+
+		//Split each power-of-two interval into eight classes, so that at most 1/8 of a block is wasted
+		size_t step = bound >= 4096 ? bound / 16 : 256;
+
+		return (bytes + step - 1) / step * step;
+	}
+
+	void* CachingAllocator::doAllocate(size_t bytes, bool& hit)
+	{
+		size_t size = sizeClass(bytes);
+
+		auto it = mFreeBlocks.find(size);
+		if (it != mFreeBlocks.end() && !it->second.empty())
+		{
+			void* ptr = it->second.back();
+			it->second.pop_back();
+			mCachedBytes -= size;
+
+			hit = true;
+			return ptr;
+		}
+
+		hit = false;
+
+		void* ptr = nullptr;
+		try {
+			ptr = mUpstream->allocate(size);
+		}
+		catch (std::bad_alloc&) {
+			//Give the cached blocks back and try again
+			this->releaseAll();
+			try {
+				ptr = mUpstream->allocate(size);
+			}
+			catch (std::bad_alloc&) {
+				ptr = nullptr;
+			}
+		}
+
+		return ptr;
+	}
+
+	void CachingAllocator::doDeallocate(void* ptr, size_t bytes)
+	{
+		size_t size = sizeClass(bytes);
+
+		if (mCachedBytes + size > mMaxCachedBytes)
+		{
+			mUpstream->deallocate(ptr, size);
+			return;
+		}
+
+		mFreeBlocks[size].push_back(ptr);
+		mCachedBytes += size;
+	}
+
+	void CachingAllocator::releaseCached()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		this->releaseAll();
+	}
+
+	void CachingAllocator::setMaxCachedBytes(size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mMaxCachedBytes = bytes;
+	}
+
+	void CachingAllocator::releaseAll()
+	{
+		for (auto& blocks : mFreeBlocks)
+		{
+			for (auto ptr : blocks.second)
+				mUpstream->deallocate(ptr, blocks.first);
+		}
+
+		mFreeBlocks.clear();
+		mCachedBytes = 0;
+	}
+}
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+namespace dyno
+{
+	/**
+	 * @brief Counters of an allocator, all sizes are in bytes.
+	 */
+	struct AllocatorStatistics
+	{
+		//Memory currently handed out to arrays
+		size_t bytesLive = 0;
+		size_t bytesPeak = 0;
+
+		//Memory kept by a pool for reuse, not included in bytesLive
+		size_t bytesCached = 0;
+
+		size_t allocations = 0;
+		size_t deallocations = 0;
+
+		//Allocations served from the pool without calling the upstream allocator
+		size_t hits = 0;
+
+		size_t frameAllocations = 0;
+		size_t lastFrameAllocations = 0;
+
+		float hitRate() const { return allocations == 0 ? 0.0f : float(hits) / float(allocations); }
+	};
+
+	/**
+	 * @brief Interface of the memory allocators used by DArray, DArray2D, DArray3D and DArrayList.
+	 *
+	 * allocate() and deallocate() are thread-safe and keep the statistics up to date,
+	 * 	subclasses only implement doAllocate() and doDeallocate(), which are called with the allocator locked.
+	 */
+	class Allocator
+	{
+	public:
+		Allocator() {};
+		virtual ~Allocator() {};
+
+		/**
+		 * @brief Allocate at least bytes of memory, throws std::bad_alloc on failure
+		 */
+		void* allocate(size_t bytes);
+
+		/**
+		 * @brief Release memory returned by allocate(), bytes must be the same as the requested size
+		 */
+		void deallocate(void* ptr, size_t bytes);
+
+		AllocatorStatistics statistics();
+
+		/**
+		 * @brief Start counting allocations for a new frame, called by SceneGraph::takeOneFrame()
+		 */
+		void nextFrame();
+
+		void resetPeak();
+
+		/**
+		 * @brief Return cached memory to the upstream allocator
+		 */
+		virtual void releaseCached() {};
+
+		/**
+		 * @brief Default allocator of device arrays, host memory is used on the CPU backend
+		 */
+		static Allocator* device();
+
+		/**
+		 * @brief Replace the default allocator of device arrays.
+		 * 	Arrays allocated before keep releasing their memory to the previous allocator, which is kept alive.
+		 */
+		static void setDevice(std::shared_ptr<Allocator> alloc);
+
+		/**
+		 * @brief Return the cached memory of all allocators installed as the device allocator.
+		 * 	Registered to run at exit once device memory is allocated, so that the cache is released before the CUDA context is torn down.
+		 */
+		static void releaseAllCached();
+
+		/**
+		 * @brief Allocator of large host staging buffers (see HostArray), 64-byte aligned and backed by huge pages if available
+		 */
+		static Allocator* host();
+
+	protected:
+		/**
+		 * @brief Return nullptr if the memory is exhausted, set hit to true if no upstream allocation is performed
+		 */
+		virtual void* doAllocate(size_t bytes, bool& hit) = 0;
+		virtual void doDeallocate(void* ptr, size_t bytes) = 0;
+
+		virtual size_t cachedBytes() { return 0; }
+
+		std::mutex mMutex;
+
+	private:
+		Allocator(const Allocator&) = delete;
+		Allocator& operator=(const Allocator&) = delete;
+
+		AllocatorStatistics mStat;
+
+		static std::atomic<Allocator*> pDevice;
+		static std::mutex mDeviceMutex;
+	};
+
+	/**
+	 * @brief Host memory aligned to cache lines (64 bytes).
+	 *
+	 * Blocks of at least hugePageBytes are aligned to 2MB and advised to be backed by transparent huge pages on Linux,
+	 * 	which reduces the TLB misses when streaming through them. A value of 0 disables huge pages.
+	 */
+	class HostAllocator : public Allocator
+	{
+	public:
+		explicit HostAllocator(size_t hugePageBytes = 0) : mHugePageBytes(hugePageBytes) {};
+
+	protected:
+		void* doAllocate(size_t bytes, bool& hit) override;
+		void doDeallocate(void* ptr, size_t bytes) override;
+
+	private:
+		size_t mHugePageBytes;
+	};
+
+#ifdef CUDA_BACKEND
+	/**
+	 * @brief Plain device memory from cudaMalloc()
+	 */
+	class DeviceAllocator : public Allocator
+	{
+	protected:
+		void* doAllocate(size_t bytes, bool& hit) override;
+		void doDeallocate(void* ptr, size_t bytes) override;
+	};
+#endif
+
+	/**
+	 * @brief A pool that recycles freed blocks instead of returning them to the upstream allocator.
+	 *
+	 * Requests are rounded up to size classes with at most 1/8 relative overhead (multiples of 256 bytes),
+	 * 	freed blocks are kept in one free list per class. When the upstream allocator runs out of memory,
+	 * 	all cached blocks are released and the allocation is retried.
+	 */
+	class CachingAllocator : public Allocator
+	{
+	public:
+		explicit CachingAllocator(std::shared_ptr<Allocator> upstream);
+		~CachingAllocator() override;
+
+		void releaseCached() override;
+
+		/**
+		 * @brief Freed blocks exceeding this amount of cached memory are returned to the upstream allocator directly
+		 */
+		void setMaxCachedBytes(size_t bytes);
+
+		std::shared_ptr<Allocator> upstream() { return mUpstream; }
+
+		static size_t sizeClass(size_t bytes);
+
+	protected:
+		void* doAllocate(size_t bytes, bool& hit) override;
+		void doDeallocate(void* ptr, size_t bytes) override;
+
+		size_t cachedBytes() override { return mCachedBytes; }
+
+	private:
+		void releaseAll();
+
+		std::shared_ptr<Allocator> mUpstream;
+
+		std::unordered_map<size_t, std::vector<void*>> mFreeBlocks;
+
+		size_t mCachedBytes = 0;
+		size_t mMaxCachedBytes = size_t(-1);
+	};
+}
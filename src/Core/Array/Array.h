@@ -15,6 +15,7 @@
  */
 #pragma once
 #include "Platform.h"
+#include "Array/Allocator.h"
 #include <cassert>
 #include <vector>
 #include <iostream>
@@ -25,6 +26,8 @@ namespace dyno {
 
 	template<typename T, DeviceType deviceType> class Array;
 
+	template<typename T> class HostArray;
+
 	template<typename T>
 	class Array<T, DeviceType::CPU>
 	{
@@ -77,9 +80,7 @@ namespace dyno {
 		void assign(const T& val);
 		void assign(uint num, const T& val);
 
-	#ifndef NO_BACKEND
 		void assign(const Array<T, DeviceType::GPU>& src);
-	#endif
 
 		void assign(const Array<T, DeviceType::CPU>& src);
 		void assign(const std::vector<T>& src);
@@ -154,6 +155,10 @@ namespace dyno {
 	#include "Backend/Cuda/Array/Array.inl"
 #endif
 
+#ifdef CPU_BACKEND
+	#include "Backend/Cpu/Array/Array.inl"
+#endif
+
 #ifdef VK_BACKEND
 	#include "Backend/Vulkan/Array/Array.inl"
 #endif
\ No newline at end of file
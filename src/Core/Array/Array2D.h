@@ -15,6 +15,7 @@
  */
 #pragma once
 #include "Platform.h"
+#include "Array/Allocator.h"
 
 namespace dyno {
 	template<typename T, DeviceType deviceType> class Array2D;
@@ -79,9 +80,7 @@ namespace dyno {
 		inline bool isCPU() const { return false; }
 		inline bool isGPU() const { return true; }
 
-#ifndef NO_BACKEND
 		void assign(const Array2D<T, DeviceType::GPU>& src);
-#endif
 
 		void assign(const Array2D<T, DeviceType::CPU>& src);
 
@@ -135,6 +134,10 @@ namespace dyno {
 #include "Backend/Cuda/Array/Array2D.inl"
 #endif
 
+#ifdef CPU_BACKEND
+#include "Backend/Cpu/Array/Array2D.inl"
+#endif
+
 #ifdef VK_BACKEND
 #include "Backend/Vulkan/Array/Array2D.inl"
 #endif
@@ -1,5 +1,6 @@
 #pragma once
 #include "Platform.h"
+#include "Array/Allocator.h"
 #include <vector>
 
 namespace dyno {
@@ -68,9 +69,7 @@ namespace dyno {
 		void assign(const T& val);
 		void assign(uint nx, uint ny, uint nz, const T& val);
 
-#ifndef NO_BACKEND
 		void assign(const Array3D<T, DeviceType::GPU>& src);
-#endif
 
 		void assign(const Array3D<T, DeviceType::CPU>& src);
 
@@ -140,6 +139,10 @@ namespace dyno {
 #include "Backend/Cuda/Array/Array3D.inl"
 #endif
 
+#ifdef CPU_BACKEND
+#include "Backend/Cpu/Array/Array3D.inl"
+#endif
+
 #ifdef VK_BACKEND
 #include "Backend/Vulkan/Array/Array3D.inl"
 #endif
\ No newline at end of file
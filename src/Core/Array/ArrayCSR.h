@@ -0,0 +1,387 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <vector>
+#include <iostream>
+
+#include "Platform.h"
+
+#include "STL/List.h"
+#include "Array/Array.h"
+#include "Array/ArrayList.h"
+#include "Algorithm/HostScan.h"
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
+#endif
+
+namespace dyno
+{
+	/**
+	 * @brief A compact alternative to ArrayList storing the rows in compressed sparse row (CSR) format.
+	 *
+	 * Only the row offsets (one more than the number of rows) and the elements are stored, the List<T> of a row
+	 * 	is created on the fly by operator[]. Compared to ArrayList, it saves one List<T> descriptor per row
+	 * 	and the pass re-pointing the descriptors after each resize() or assign().
+	 *
+	 * Rows have a fixed size given by resize(), kernels fill them by index. Like ArrayList, the List<T> returned by operator[]
+	 * 	spans exactly the elements of a row, rows copied from an ArrayList only contain the inserted elements.
+	 * 	Since operator[] returns by value, kernels should write "List<T> row = csr[i];" instead of "List<T>& row = list[i];".
+	 */
+	template<class ElementType, DeviceType deviceType> class ArrayCSR;
+
+	template<class ElementType>
+	class ArrayCSR<ElementType, DeviceType::CPU>
+	{
+	public:
+		ArrayCSR()
+		{
+		};
+
+		~ArrayCSR() {};
+
+		bool resize(const CArray<uint>& counts);
+		bool resize(const uint arraySize, const uint eleSize);
+
+		inline uint size() const { return mIndex.size() == 0 ? 0 : mIndex.size() - 1; }
+		inline uint elementSize() const { return mElements.size(); }
+
+		inline uint size(uint id) const { return mIndex[id + 1] - mIndex[id]; }
+
+		inline List<ElementType> operator [] (unsigned int id) const
+		{
+			uint num = mIndex[id + 1] - mIndex[id];
+
+			List<ElementType> lst;
+			lst.assign(const_cast<ElementType*>(mElements.begin()) + mIndex[id], num, num);
+
+			return lst;
+		}
+
+		inline bool isCPU() const { return true; }
+		inline bool isGPU() const { return false; }
+		inline bool isEmpty() const { return mIndex.isEmpty(); }
+
+		void clear();
+
+		void assign(const ArrayCSR<ElementType, DeviceType::CPU>& src);
+		void assign(const ArrayCSR<ElementType, DeviceType::GPU>& src);
+
+		/**
+		 * @brief Copy an ArrayList, only the inserted elements of each list are kept
+		 */
+		void assign(const ArrayList<ElementType, DeviceType::CPU>& src);
+
+		friend std::ostream& operator<<(std::ostream &out, const ArrayCSR<ElementType, DeviceType::CPU>& csr)
+		{
+			out << std::endl;
+			for (uint i = 0; i < csr.size(); i++)
+			{
+				List<ElementType> lst = csr[i];
+				out << "List " << i << " (" << lst.size() << "):";
+				for (auto it = lst.begin(); it != lst.end(); it++)
+				{
+					out << " " << *it;
+				}
+				out << std::endl;
+			}
+			return out;
+		}
+
+		const CArray<uint>& index() const { return mIndex; }
+		const CArray<ElementType>& elements() const { return mElements; }
+
+	private:
+		//Offsets of the rows, the last entry equals the number of elements
+		CArray<uint> mIndex;
+		CArray<ElementType> mElements;
+	};
+
+	template<typename T>
+	using CArrayCSR = ArrayCSR<T, DeviceType::CPU>;
+
+	template<class ElementType>
+	bool ArrayCSR<ElementType, DeviceType::CPU>::resize(const CArray<uint>& counts)
+	{
+		if (counts.size() == 0)
+		{
+			this->clear();
+			return false;
+		}
+
+		uint num = counts.size();
+
+		mIndex.resize(num + 1);
+		mIndex[num] = 0;
+
+		HostScan<uint> scan;
+		scan.exclusive(mIndex.begin(), counts.begin(), num);
+
+		mIndex[num] = mIndex[num - 1] + counts[num - 1];
+
+		mElements.resize(mIndex[num]);
+
+		return true;
+	}
+
+	template<class ElementType>
+	bool ArrayCSR<ElementType, DeviceType::CPU>::resize(const uint arraySize, const uint eleSize)
+	{
+		assert(arraySize > 0);
+
+		mIndex.resize(arraySize + 1);
+		for (uint i = 0; i <= arraySize; i++)
+		{
+			mIndex[i] = i * eleSize;
+		}
+
+		mElements.resize(arraySize * eleSize);
+
+		return true;
+	}
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::CPU>::clear()
+	{
+		mIndex.clear();
+		mElements.clear();
+	}
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::CPU>::assign(const ArrayCSR<ElementType, DeviceType::CPU>& src)
+	{
+		mIndex.assign(src.index());
+		mElements.assign(src.elements());
+	}
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::CPU>::assign(const ArrayList<ElementType, DeviceType::CPU>& src)
+	{
+		uint num = src.size();
+
+		CArray<uint> counts(num);
+		for (uint i = 0; i < num; i++)
+		{
+			List<ElementType> lst = src[i];
+			counts[i] = lst.size();
+		}
+
+		this->resize(counts);
+
+		for (uint i = 0; i < num; i++)
+		{
+			List<ElementType> lst = src[i];
+
+			ElementType* dst = mElements.begin() + mIndex[i];
+			for (auto it = lst.begin(); it != lst.end(); it++)
+				*(dst++) = *it;
+		}
+	}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+	template<class ElementType>
+	class ArrayCSR<ElementType, DeviceType::GPU>
+	{
+	public:
+		ArrayCSR()
+		{
+		};
+
+		/*!
+		*	\brief	Do not release memory here, call clear() explicitly.
+		*/
+		~ArrayCSR() {};
+
+		bool resize(const DArray<uint>& counts);
+		bool resize(const uint arraySize, const uint eleSize);
+
+		DYN_FUNC inline uint size() const { return mIndex.size() == 0 ? 0 : mIndex.size() - 1; }
+		DYN_FUNC inline uint elementSize() const { return mElements.size(); }
+
+		GPU_FUNC inline uint size(unsigned int id) const { return mIndex[id + 1] - mIndex[id]; }
+
+		GPU_FUNC inline List<ElementType> operator [] (unsigned int id) const
+		{
+			uint num = mIndex[id + 1] - mIndex[id];
+
+			List<ElementType> lst;
+			lst.assign(const_cast<ElementType*>(mElements.begin()) + mIndex[id], num, num);
+
+			return lst;
+		}
+
+		DYN_FUNC inline bool isCPU() const { return false; }
+		DYN_FUNC inline bool isGPU() const { return true; }
+		DYN_FUNC inline bool isEmpty() const { return mIndex.size() == 0; }
+
+		void clear();
+
+		void assign(const ArrayCSR<ElementType, DeviceType::GPU>& src);
+		void assign(const ArrayCSR<ElementType, DeviceType::CPU>& src);
+		void assign(const std::vector<std::vector<ElementType>>& src);
+
+		/**
+		 * @brief Copy an ArrayList, only the inserted elements of each list are kept
+		 */
+		void assign(const ArrayList<ElementType, DeviceType::GPU>& src);
+
+		friend std::ostream& operator<<(std::ostream& out, const ArrayCSR<ElementType, DeviceType::GPU>& csr)
+		{
+			ArrayCSR<ElementType, DeviceType::CPU> hCsr;
+			hCsr.assign(csr);
+			out << hCsr;
+
+			return out;
+		}
+
+		const DArray<uint>& index() const { return mIndex; }
+		const DArray<ElementType>& elements() const { return mElements; }
+
+		/*!
+		*	\brief	To avoid erroneous shallow copy.
+		*/
+		ArrayCSR<ElementType, DeviceType::GPU>& operator=(const ArrayCSR<ElementType, DeviceType::GPU>&) = delete;
+
+	private:
+		//Offsets of the rows, the last entry equals the number of elements
+		DArray<uint> mIndex;
+		DArray<ElementType> mElements;
+	};
+
+	template<typename T>
+	using DArrayCSR = ArrayCSR<T, DeviceType::GPU>;
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::CPU>::assign(const ArrayCSR<ElementType, DeviceType::GPU>& src)
+	{
+		mIndex.assign(src.index());
+		mElements.assign(src.elements());
+	}
+
+	template<class ElementType>
+	bool ArrayCSR<ElementType, DeviceType::GPU>::resize(const DArray<uint>& counts)
+	{
+		if (counts.size() == 0)
+		{
+			this->clear();
+			return false;
+		}
+
+		uint num = counts.size();
+
+		Reduction<uint> reduce;
+		uint total = reduce.accumulate(counts.begin(), num);
+
+		//Scan the counts followed by a zero, so that the last offset is the total number of elements
+		CArray<uint> tail(1);
+		tail[0] = 0;
+
+		mIndex.resize(num + 1);
+		mIndex.assign(counts, num);
+		mIndex.assign(tail, 1, num);
+
+		Scan<uint> scan;
+		scan.exclusive(mIndex);
+
+		mElements.resize(total);
+
+		return true;
+	}
+
+	template<class ElementType>
+	bool ArrayCSR<ElementType, DeviceType::GPU>::resize(const uint arraySize, const uint eleSize)
+	{
+		assert(arraySize > 0);
+
+		CArray<uint> hIndex(arraySize + 1);
+		for (uint i = 0; i <= arraySize; i++)
+		{
+			hIndex[i] = i * eleSize;
+		}
+
+		mIndex.assign(hIndex);
+		mElements.resize(arraySize * eleSize);
+
+		return true;
+	}
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::GPU>::clear()
+	{
+		mIndex.clear();
+		mElements.clear();
+	}
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::GPU>::assign(const ArrayCSR<ElementType, DeviceType::GPU>& src)
+	{
+		mIndex.assign(src.index());
+		mElements.assign(src.elements());
+	}
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::GPU>::assign(const ArrayCSR<ElementType, DeviceType::CPU>& src)
+	{
+		mIndex.assign(src.index());
+		mElements.assign(src.elements());
+	}
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::GPU>::assign(const std::vector<std::vector<ElementType>>& src)
+	{
+		CArray<uint> hIndex(src.size() + 1);
+		CArray<ElementType> hElements;
+
+		uint eleNum = 0;
+		for (size_t i = 0; i < src.size(); i++)
+		{
+			hIndex[i] = eleNum;
+			eleNum += (uint)src[i].size();
+
+			for (size_t j = 0; j < src[i].size(); j++)
+			{
+				hElements.pushBack(src[i][j]);
+			}
+		}
+		hIndex[src.size()] = eleNum;
+
+		mIndex.assign(hIndex);
+		mElements.assign(hElements);
+	}
+
+	template<class ElementType>
+	void ArrayCSR<ElementType, DeviceType::GPU>::assign(const ArrayList<ElementType, DeviceType::GPU>& src)
+	{
+		if (src.size() == 0)
+		{
+			this->clear();
+			return;
+		}
+
+		uint num = src.size();
+		void* lists = (void*)src.lists().begin();
+
+		DArray<uint> counts(num);
+		parallel_count_for_list<sizeof(ElementType)>(lists, counts);
+
+		this->resize(counts);
+		parallel_compact_for_list<sizeof(ElementType)>(mElements.begin(), lists, mIndex);
+
+		counts.clear();
+	}
+#endif
+}
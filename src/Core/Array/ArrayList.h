@@ -21,6 +21,7 @@
 
 #include "STL/List.h"
 #include "Array/Array.h"
+#include "Algorithm/HostScan.h"
 
 namespace dyno {
 	template<class ElementType, DeviceType deviceType> class ArrayList;
@@ -70,9 +71,7 @@ namespace dyno {
 
 		void assign(const ArrayList<ElementType, DeviceType::CPU>& src);
 
-	#ifndef NO_BACKEND
 		void assign(const ArrayList<ElementType, DeviceType::GPU>& src);
-	#endif
 
 		friend std::ostream& operator<<(std::ostream &out, const ArrayList<ElementType, DeviceType::CPU>& aList)
 		{
@@ -136,19 +135,10 @@ namespace dyno {
 			mLists.resize(counts.size());
 		}
 
-		mIndex.assign(counts);
+		HostScan<uint> scan;
+		scan.exclusive(mIndex, counts);
 
-		uint total_num = 0;
-		for (uint i = 0; i < mIndex.size(); i++)
-		{
-			uint num = mIndex[i];
-			
-			//exclusive scan
-			mIndex[i] = total_num;	
-
-			//summation
-			total_num += num;
-		}
+		uint total_num = mIndex[mIndex.size() - 1] + counts[counts.size() - 1];
 
 		mElements.resize(total_num);
 
@@ -207,8 +197,8 @@ namespace dyno {
 	using CArrayList = ArrayList<T, DeviceType::CPU>;
 }
 
-#ifdef CUDA_BACKEND
-	#include "Backend/Cuda/Array/ArrayList.inl"
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+	#include "Array/ArrayList.inl"
 #endif
 
 #ifdef VK_BACKEND
@@ -1,4 +1,12 @@
-#include "ArrayTools.h"
+//Shared by the CUDA and CPU backends, only the kernel launchers in ArrayTools differ
+#ifdef CUDA_BACKEND
+#include "Backend/Cuda/Array/ArrayTools.h"
+#endif
+
+#ifdef CPU_BACKEND
+#include "Backend/Cpu/Array/ArrayTools.h"
+#endif
+
 #include "Algorithm/Scan.h"
 #include "Algorithm/Reduction.h"
 
@@ -123,15 +131,14 @@ namespace dyno
 			mLists.resize(counts.size());
 		}
 
-		mIndex.assign(counts);
-
-		Reduction<uint> reduce;
-		uint total_num = reduce.accumulate(mIndex.begin(), mIndex.size());
-
 		Scan<uint> scan;
-		scan.exclusive(mIndex);
+		scan.exclusive(mIndex.begin(), counts.begin(), counts.size());
 
-		//printf("total num 2 = %d\n", total_num);
+		//The total number is the last offset plus the last count, which saves a separate reduction pass
+		uint last[2];
+		cuSafeCall(cudaMemcpy(&last[0], mIndex.begin() + mIndex.size() - 1, sizeof(uint), cudaMemcpyDeviceToHost));
+		cuSafeCall(cudaMemcpy(&last[1], counts.begin() + counts.size() - 1, sizeof(uint), cudaMemcpyDeviceToHost));
+		uint total_num = last[0] + last[1];
 
 		mElements.resize(total_num);
 		
@@ -0,0 +1,480 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <vector>
+#include <cstring>
+#include <iostream>
+
+#include "Platform.h"
+#include "Vector.h"
+#include "Array/Array.h"
+
+namespace dyno
+{
+	//Planes start at multiples of this number of elements, i.e., 64 bytes for float
+	#define SOA_PLANE_ALIGNMENT 16
+
+	/**
+	 * @brief Reference to an element of an ArraySoA, converts from and to Vector<Real, 3>.
+	 *
+	 * Use "Coord v = soa[i];" to read an element and "soa[i] = v;" or "soa[i] += v;" to write it.
+	 */
+	template<typename Real>
+	class SoAElement
+	{
+	public:
+		DYN_FUNC SoAElement(Real* p, uint pitch) : mPtr(p), mPitch(pitch) {};
+
+		DYN_FUNC inline operator Vector<Real, 3>() const
+		{
+			return Vector<Real, 3>(mPtr[0], mPtr[mPitch], mPtr[2 * mPitch]);
+		}
+
+		DYN_FUNC inline Real& x() { return mPtr[0]; }
+		DYN_FUNC inline Real& y() { return mPtr[mPitch]; }
+		DYN_FUNC inline Real& z() { return mPtr[2 * mPitch]; }
+
+		DYN_FUNC inline SoAElement& operator = (const Vector<Real, 3>& v)
+		{
+			mPtr[0] = v[0];
+			mPtr[mPitch] = v[1];
+			mPtr[2 * mPitch] = v[2];
+			return *this;
+		}
+
+		DYN_FUNC inline SoAElement& operator = (const SoAElement& e)
+		{
+			return *this = Vector<Real, 3>(e);
+		}
+
+		DYN_FUNC inline SoAElement& operator += (const Vector<Real, 3>& v)
+		{
+			mPtr[0] += v[0];
+			mPtr[mPitch] += v[1];
+			mPtr[2 * mPitch] += v[2];
+			return *this;
+		}
+
+		DYN_FUNC inline SoAElement& operator -= (const Vector<Real, 3>& v)
+		{
+			mPtr[0] -= v[0];
+			mPtr[mPitch] -= v[1];
+			mPtr[2 * mPitch] -= v[2];
+			return *this;
+		}
+
+		DYN_FUNC inline SoAElement& operator *= (const Real s)
+		{
+			mPtr[0] *= s;
+			mPtr[mPitch] *= s;
+			mPtr[2 * mPitch] *= s;
+			return *this;
+		}
+
+	private:
+		Real* mPtr;
+		uint mPitch;
+	};
+
+	/**
+	 * @brief Vectors stored as structure of arrays (SoA), the x, y and z components lie in three separate planes.
+	 *
+	 * Compared to Array<Vector<Real, 3>>, loops over one component access contiguous memory, so that CPU loops can be
+	 * 	vectorized and GPU threads of a warp issue coalesced loads. Elements are accessed through SoAElement in kernels,
+	 * 	or the planes are accessed directly through x(), y() and z().
+	 *
+	 * Only Vector<Real, 3> is supported. The layout can not be viewed as an array of vectors, assign() and toAoS() copy between both layouts.
+	 */
+	template<typename T, DeviceType deviceType> class ArraySoA;
+
+	template<typename Real>
+	class ArraySoA<Vector<Real, 3>, DeviceType::CPU>
+	{
+	public:
+		typedef Vector<Real, 3> Coord;
+
+		ArraySoA()
+		{
+		};
+
+		ArraySoA(uint num)
+		{
+			this->resize(num);
+		}
+
+		~ArraySoA() {};
+
+		void resize(uint n)
+		{
+			mSize = n;
+			mPitch = (n + SOA_PLANE_ALIGNMENT - 1) / SOA_PLANE_ALIGNMENT * SOA_PLANE_ALIGNMENT;
+			mData.resize(3 * (size_t)mPitch);
+		}
+
+		/*!
+		*	\brief	Clear all data to zero.
+		*/
+		void reset()
+		{
+			std::fill(mData.begin(), mData.end(), Real(0));
+		}
+
+		void clear()
+		{
+			mData.clear();
+			mSize = 0;
+			mPitch = 0;
+		}
+
+		inline Real* x() { return mData.size() == 0 ? nullptr : &mData[0]; }
+		inline Real* y() { return mData.size() == 0 ? nullptr : &mData[mPitch]; }
+		inline Real* z() { return mData.size() == 0 ? nullptr : &mData[2 * (size_t)mPitch]; }
+
+		inline const Real* x() const { return mData.size() == 0 ? nullptr : &mData[0]; }
+		inline const Real* y() const { return mData.size() == 0 ? nullptr : &mData[mPitch]; }
+		inline const Real* z() const { return mData.size() == 0 ? nullptr : &mData[2 * (size_t)mPitch]; }
+
+		inline Real* begin() { return this->x(); }
+		inline const Real* begin() const { return this->x(); }
+
+		inline SoAElement<Real> operator [] (unsigned int id)
+		{
+			return SoAElement<Real>(&mData[id], mPitch);
+		}
+
+		inline Coord operator [] (unsigned int id) const
+		{
+			return Coord(mData[id], mData[mPitch + id], mData[2 * (size_t)mPitch + id]);
+		}
+
+		inline uint size() const { return mSize; }
+
+		/**
+		 * @brief Distance in elements between the planes
+		 */
+		inline uint pitch() const { return mPitch; }
+
+		inline bool isCPU() const { return true; }
+		inline bool isGPU() const { return false; }
+		inline bool isEmpty() const { return mSize == 0; }
+
+		void assign(const Coord& val)
+		{
+			for (int c = 0; c < 3; c++)
+				std::fill(mData.begin() + c * (size_t)mPitch, mData.begin() + c * (size_t)mPitch + mSize, val[c]);
+		}
+
+		void assign(const ArraySoA<Coord, DeviceType::CPU>& src)
+		{
+			mData = src.mData;
+			mSize = src.mSize;
+			mPitch = src.mPitch;
+		}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+		void assign(const ArraySoA<Coord, DeviceType::GPU>& src);
+#endif
+
+		/**
+		 * @brief Convert from the array of structures layout
+		 */
+		void assign(const Array<Coord, DeviceType::CPU>& src)
+		{
+			this->resize(src.size());
+
+			const Coord* p = src.begin();
+			for (uint i = 0; i < mSize; i++)
+			{
+				mData[i] = p[i][0];
+				mData[mPitch + i] = p[i][1];
+				mData[2 * (size_t)mPitch + i] = p[i][2];
+			}
+		}
+
+		/**
+		 * @brief Convert to the array of structures layout
+		 */
+		void toAoS(Array<Coord, DeviceType::CPU>& dst) const
+		{
+			dst.resize(mSize);
+
+			Coord* p = dst.begin();
+			for (uint i = 0; i < mSize; i++)
+			{
+				p[i] = (*this)[i];
+			}
+		}
+
+		friend std::ostream& operator<<(std::ostream &out, const ArraySoA<Coord, DeviceType::CPU>& array)
+		{
+			for (uint i = 0; i < array.size(); i++)
+			{
+				out << i << ": " << array[i] << std::endl;
+			}
+
+			return out;
+		}
+
+	private:
+		std::vector<Real> mData;
+
+		uint mSize = 0;
+		uint mPitch = 0;
+	};
+
+	template<typename T>
+	using CArraySoA = ArraySoA<T, DeviceType::CPU>;
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+	template<typename Real>
+	class ArraySoA<Vector<Real, 3>, DeviceType::GPU>
+	{
+	public:
+		typedef Vector<Real, 3> Coord;
+
+		ArraySoA()
+		{
+		};
+
+		ArraySoA(uint num)
+		{
+			this->resize(num);
+		}
+
+		/*!
+		*	\brief	Do not release memory here, call clear() explicitly.
+		*/
+		~ArraySoA() {};
+
+		void resize(const uint n);
+
+		/*!
+		*	\brief	Clear all data to zero.
+		*/
+		void reset();
+
+		void clear();
+
+		DYN_FUNC inline Real* x() const { return mData; }
+		DYN_FUNC inline Real* y() const { return mData == nullptr ? nullptr : mData + mPitch; }
+		DYN_FUNC inline Real* z() const { return mData == nullptr ? nullptr : mData + 2 * (size_t)mPitch; }
+
+		DYN_FUNC inline Real* begin() const { return mData; }
+
+		GPU_FUNC inline SoAElement<Real> operator [] (unsigned int id) const
+		{
+			return SoAElement<Real>(mData + id, mPitch);
+		}
+
+		DYN_FUNC inline uint size() const { return mSize; }
+
+		/**
+		 * @brief Distance in elements between the planes
+		 */
+		DYN_FUNC inline uint pitch() const { return mPitch; }
+
+		DYN_FUNC inline bool isCPU() const { return false; }
+		DYN_FUNC inline bool isGPU() const { return true; }
+		DYN_FUNC inline bool isEmpty() const { return mData == nullptr; }
+
+		void assign(const Coord& val);
+
+		void assign(const ArraySoA<Coord, DeviceType::GPU>& src);
+		void assign(const ArraySoA<Coord, DeviceType::CPU>& src);
+
+		/**
+		 * @brief Convert from the array of structures layout
+		 */
+		void assign(const Array<Coord, DeviceType::GPU>& src);
+
+		/**
+		 * @brief Convert to the array of structures layout
+		 */
+		void toAoS(Array<Coord, DeviceType::GPU>& dst) const;
+
+		friend std::ostream& operator<<(std::ostream &out, const ArraySoA<Coord, DeviceType::GPU>& dArray)
+		{
+			ArraySoA<Coord, DeviceType::CPU> hArray;
+			hArray.assign(dArray);
+
+			out << hArray;
+
+			return out;
+		}
+
+		/*!
+		*	\brief	To avoid erroneous shallow copy.
+		*/
+		ArraySoA<Coord, DeviceType::GPU>& operator=(const ArraySoA<Coord, DeviceType::GPU>&) = delete;
+
+	private:
+		/**
+		 * @brief Strided copy of width bytes per row, used to move components between the two layouts
+		 */
+		static void copy2D(void* dst, size_t dpitch, const void* src, size_t spitch, size_t width, size_t height, bool toDevice, bool fromDevice);
+
+		Real* mData = nullptr;
+
+		uint mSize = 0;
+		uint mPitch = 0;
+
+		Allocator* mAlloc = nullptr;
+	};
+
+	template<typename T>
+	using DArraySoA = ArraySoA<T, DeviceType::GPU>;
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::copy2D(void* dst, size_t dpitch, const void* src, size_t spitch, size_t width, size_t height, bool toDevice, bool fromDevice)
+	{
+		if (height == 0)
+			return;
+#ifdef CUDA_BACKEND
+		cudaMemcpyKind kind = toDevice ? (fromDevice ? cudaMemcpyDeviceToDevice : cudaMemcpyHostToDevice) : (fromDevice ? cudaMemcpyDeviceToHost : cudaMemcpyHostToHost);
+		cuSafeCall(cudaMemcpy2D(dst, dpitch, src, spitch, width, height, kind));
+#else
+		char* d = (char*)dst;
+		const char* s = (const char*)src;
+		if (dpitch == width && spitch == width)
+		{
+			memcpy(d, s, width * height);
+			return;
+		}
+
+		for (size_t i = 0; i < height; i++)
+		{
+			memcpy(d + i * dpitch, s + i * spitch, width);
+		}
+#endif
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::resize(const uint n)
+	{
+		uint pitch = (n + SOA_PLANE_ALIGNMENT - 1) / SOA_PLANE_ALIGNMENT * SOA_PLANE_ALIGNMENT;
+
+		if (mPitch == pitch)
+		{
+			mSize = n;
+			return;
+		}
+
+		this->clear();
+
+		if (n == 0)
+			return;
+
+		mAlloc = Allocator::device();
+		mData = (Real*)mAlloc->allocate(3 * (size_t)pitch * sizeof(Real));
+
+		mSize = n;
+		mPitch = pitch;
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::reset()
+	{
+		if (mData == nullptr)
+			return;
+#ifdef CUDA_BACKEND
+		cuSafeCall(cudaMemset((void*)mData, 0, 3 * (size_t)mPitch * sizeof(Real)));
+#else
+		memset((void*)mData, 0, 3 * (size_t)mPitch * sizeof(Real));
+#endif
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::clear()
+	{
+		if (mData != nullptr)
+		{
+			mAlloc->deallocate(mData, 3 * (size_t)mPitch * sizeof(Real));
+		}
+
+		mData = nullptr;
+		mSize = 0;
+		mPitch = 0;
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::assign(const Coord& val)
+	{
+		CArraySoA<Coord> hArray(mSize);
+		hArray.assign(val);
+
+		this->assign(hArray);
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::assign(const ArraySoA<Coord, DeviceType::GPU>& src)
+	{
+		this->resize(src.size());
+
+		//Both arrays have the same pitch
+		size_t bytes = 3 * (size_t)mPitch * sizeof(Real);
+		copy2D(mData, bytes, src.begin(), bytes, bytes, mSize == 0 ? 0 : 1, true, true);
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::assign(const ArraySoA<Coord, DeviceType::CPU>& src)
+	{
+		this->resize(src.size());
+
+		size_t bytes = 3 * (size_t)mPitch * sizeof(Real);
+		copy2D(mData, bytes, src.begin(), bytes, bytes, mSize == 0 ? 0 : 1, true, false);
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::assign(const Array<Coord, DeviceType::GPU>& src)
+	{
+		this->resize(src.size());
+
+		//Gather one component per copy, the source rows are the vectors
+		for (int c = 0; c < 3; c++)
+		{
+			copy2D(mData + c * (size_t)mPitch, sizeof(Real), (const Real*)src.begin() + c, sizeof(Coord), sizeof(Real), mSize, true, true);
+		}
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::GPU>::toAoS(Array<Coord, DeviceType::GPU>& dst) const
+	{
+		if (dst.size() != mSize)
+			dst.resize(mSize);
+
+		for (int c = 0; c < 3; c++)
+		{
+			copy2D((Real*)dst.begin() + c, sizeof(Coord), mData + c * (size_t)mPitch, sizeof(Real), sizeof(Real), mSize, true, true);
+		}
+	}
+
+	template<typename Real>
+	void ArraySoA<Vector<Real, 3>, DeviceType::CPU>::assign(const ArraySoA<Coord, DeviceType::GPU>& src)
+	{
+		mSize = src.size();
+		mPitch = src.pitch();
+		mData.resize(3 * (size_t)mPitch);
+
+		if (mPitch == 0)
+			return;
+#ifdef CUDA_BACKEND
+		cuSafeCall(cudaMemcpy(&mData[0], src.begin(), 3 * (size_t)mPitch * sizeof(Real), cudaMemcpyDeviceToHost));
+#else
+		memcpy(&mData[0], src.begin(), 3 * (size_t)mPitch * sizeof(Real));
+#endif
+	}
+#endif
+}
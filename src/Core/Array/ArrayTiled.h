@@ -0,0 +1,634 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <vector>
+#include <cstring>
+
+#include "Platform.h"
+#include "Array/Tiling.h"
+#include "Array/Array2D.h"
+#include "Array/Array3D.h"
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+#include "Array/ArrayTools.h"
+#endif
+
+namespace dyno
+{
+	/**
+	 * @brief A 3D grid stored in the tiled layout of Array/Tiling.h, with the same indexing operators as Array3D.
+	 *
+	 * Trilinear lookups touch 8 cells that lie on 2-4 cache lines (and possibly pages) in the linear layout of Array3D,
+	 * 	but mostly within one brick here. Prefer it for large grids sampled at arbitrary positions, e.g., signed distance fields.
+	 * 	Since cells are not linear in memory, operator[] addresses the storage, not the linear index.
+	 */
+	template<typename T, DeviceType deviceType> class ArrayTiled3D;
+
+	template<typename T>
+	class ArrayTiled3D<T, DeviceType::CPU>
+	{
+	public:
+		ArrayTiled3D()
+		{};
+
+		ArrayTiled3D(uint nx, uint ny, uint nz)
+		{
+			this->resize(nx, ny, nz);
+		};
+
+		~ArrayTiled3D() {};
+
+		void resize(uint nx, uint ny, uint nz)
+		{
+			m_nx = nx;	m_ny = ny;	m_nz = nz;
+			m_bx = tileCount3D(nx);	m_by = tileCount3D(ny);
+
+			m_data.resize((size_t)m_bx * m_by * tileCount3D(nz) * TILE_CELLS);
+		}
+
+		void reset() { std::fill(m_data.begin(), m_data.end(), T(0)); }
+
+		void clear()
+		{
+			m_nx = 0;	m_ny = 0;	m_nz = 0;
+			m_bx = 0;	m_by = 0;
+			m_data.clear();
+		}
+
+		inline const T* begin() const { return m_data.data(); }
+		inline T* begin() { return m_data.data(); }
+
+		inline uint nx() const { return m_nx; }
+		inline uint ny() const { return m_ny; }
+		inline uint nz() const { return m_nz; }
+
+		inline T operator () (const uint i, const uint j, const uint k) const
+		{
+			return m_data[tiledIndex3D(i, j, k, m_bx, m_by)];
+		}
+
+		inline T& operator () (const uint i, const uint j, const uint k)
+		{
+			return m_data[tiledIndex3D(i, j, k, m_bx, m_by)];
+		}
+
+		inline size_t index(const uint i, const uint j, const uint k) const
+		{
+			return tiledIndex3D(i, j, k, m_bx, m_by);
+		}
+
+		inline T operator [] (const uint id) const { return m_data[id]; }
+		inline T& operator [] (const uint id) { return m_data[id]; }
+
+		inline size_t size() const { return (size_t)m_nx * m_ny * m_nz; }
+
+		/**
+		 * @brief Number of stored elements including the padding of the boundary bricks
+		 */
+		inline size_t capacity() const { return m_data.size(); }
+
+		inline bool isCPU() const { return true; }
+		inline bool isGPU() const { return false; }
+
+		void assign(const T& val) { std::fill(m_data.begin(), m_data.end(), val); }
+
+		void assign(const ArrayTiled3D<T, DeviceType::CPU>& src)
+		{
+			this->resize(src.nx(), src.ny(), src.nz());
+			m_data.assign(src.m_data.begin(), src.m_data.end());
+		}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+		void assign(const ArrayTiled3D<T, DeviceType::GPU>& src);
+#endif
+
+		/**
+		 * @brief Convert from the linear layout
+		 */
+		void assign(const Array3D<T, DeviceType::CPU>& src)
+		{
+			this->resize(src.nx(), src.ny(), src.nz());
+
+			for (uint k = 0; k < m_nz; k++)
+				for (uint j = 0; j < m_ny; j++)
+					for (uint i = 0; i < m_nx; i++)
+						(*this)(i, j, k) = src(i, j, k);
+		}
+
+		/**
+		 * @brief Convert to the linear layout
+		 */
+		void toLinear(Array3D<T, DeviceType::CPU>& dst) const
+		{
+			dst.resize(m_nx, m_ny, m_nz);
+
+			for (uint k = 0; k < m_nz; k++)
+				for (uint j = 0; j < m_ny; j++)
+					for (uint i = 0; i < m_nx; i++)
+						dst(i, j, k) = (*this)(i, j, k);
+		}
+
+	private:
+		uint m_nx = 0;
+		uint m_ny = 0;
+		uint m_nz = 0;
+
+		//Number of bricks along x and y
+		uint m_bx = 0;
+		uint m_by = 0;
+
+		std::vector<T>	m_data;
+	};
+
+	template<typename T>
+	using CArrayTiled3D = ArrayTiled3D<T, DeviceType::CPU>;
+
+	/**
+	 * @brief A 2D grid stored in the tiled layout of Array/Tiling.h, with the same indexing operators as Array2D.
+	 */
+	template<typename T, DeviceType deviceType> class ArrayTiled2D;
+
+	template<typename T>
+	class ArrayTiled2D<T, DeviceType::CPU>
+	{
+	public:
+		ArrayTiled2D()
+		{};
+
+		ArrayTiled2D(uint nx, uint ny)
+		{
+			this->resize(nx, ny);
+		};
+
+		~ArrayTiled2D() {};
+
+		void resize(uint nx, uint ny)
+		{
+			m_nx = nx;	m_ny = ny;
+			m_bx = tileCount2D(nx);
+
+			m_data.resize((size_t)m_bx * tileCount2D(ny) * TILE_CELLS);
+		}
+
+		void reset() { std::fill(m_data.begin(), m_data.end(), T(0)); }
+
+		void clear()
+		{
+			m_nx = 0;	m_ny = 0;
+			m_bx = 0;
+			m_data.clear();
+		}
+
+		inline const T* begin() const { return m_data.data(); }
+		inline T* begin() { return m_data.data(); }
+
+		inline uint nx() const { return m_nx; }
+		inline uint ny() const { return m_ny; }
+
+		inline T operator () (const uint i, const uint j) const
+		{
+			return m_data[tiledIndex2D(i, j, m_bx)];
+		}
+
+		inline T& operator () (const uint i, const uint j)
+		{
+			return m_data[tiledIndex2D(i, j, m_bx)];
+		}
+
+		inline size_t index(const uint i, const uint j) const
+		{
+			return tiledIndex2D(i, j, m_bx);
+		}
+
+		inline T operator [] (const uint id) const { return m_data[id]; }
+		inline T& operator [] (const uint id) { return m_data[id]; }
+
+		inline size_t size() const { return (size_t)m_nx * m_ny; }
+
+		/**
+		 * @brief Number of stored elements including the padding of the boundary bricks
+		 */
+		inline size_t capacity() const { return m_data.size(); }
+
+		inline bool isCPU() const { return true; }
+		inline bool isGPU() const { return false; }
+
+		void assign(const T& val) { std::fill(m_data.begin(), m_data.end(), val); }
+
+		void assign(const ArrayTiled2D<T, DeviceType::CPU>& src)
+		{
+			this->resize(src.nx(), src.ny());
+			m_data.assign(src.m_data.begin(), src.m_data.end());
+		}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+		void assign(const ArrayTiled2D<T, DeviceType::GPU>& src);
+#endif
+
+		/**
+		 * @brief Convert from the linear layout
+		 */
+		void assign(const Array2D<T, DeviceType::CPU>& src)
+		{
+			this->resize(src.nx(), src.ny());
+
+			for (uint j = 0; j < m_ny; j++)
+				for (uint i = 0; i < m_nx; i++)
+					(*this)(i, j) = src(i, j);
+		}
+
+		/**
+		 * @brief Convert to the linear layout
+		 */
+		void toLinear(Array2D<T, DeviceType::CPU>& dst) const
+		{
+			dst.resize(m_nx, m_ny);
+
+			for (uint j = 0; j < m_ny; j++)
+				for (uint i = 0; i < m_nx; i++)
+					dst(i, j) = (*this)(i, j);
+		}
+
+	private:
+		uint m_nx = 0;
+		uint m_ny = 0;
+
+		//Number of bricks along x
+		uint m_bx = 0;
+
+		std::vector<T>	m_data;
+	};
+
+	template<typename T>
+	using CArrayTiled2D = ArrayTiled2D<T, DeviceType::CPU>;
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+	template<typename T>
+	class ArrayTiled3D<T, DeviceType::GPU>
+	{
+	public:
+		ArrayTiled3D()
+		{};
+
+		ArrayTiled3D(uint nx, uint ny, uint nz)
+		{
+			this->resize(nx, ny, nz);
+		};
+
+		/*!
+		*	\brief	Should not release data here, call clear() explicitly.
+		*/
+		~ArrayTiled3D() {};
+
+		void resize(const uint nx, const uint ny, const uint nz);
+
+		void reset();
+
+		void clear();
+
+		inline T* begin() const { return m_data; }
+
+		DYN_FUNC inline uint nx() const { return m_nx; }
+		DYN_FUNC inline uint ny() const { return m_ny; }
+		DYN_FUNC inline uint nz() const { return m_nz; }
+
+		DYN_FUNC inline T operator () (const int i, const int j, const int k) const
+		{
+			return m_data[tiledIndex3D(i, j, k, m_bx, m_by)];
+		}
+
+		DYN_FUNC inline T& operator () (const int i, const int j, const int k)
+		{
+			return m_data[tiledIndex3D(i, j, k, m_bx, m_by)];
+		}
+
+		DYN_FUNC inline size_t index(const uint i, const uint j, const uint k) const
+		{
+			return tiledIndex3D(i, j, k, m_bx, m_by);
+		}
+
+		DYN_FUNC inline T operator [] (const int id) const { return m_data[id]; }
+		DYN_FUNC inline T& operator [] (const int id) { return m_data[id]; }
+
+		DYN_FUNC inline size_t size() const { return (size_t)m_nx * m_ny * m_nz; }
+		DYN_FUNC inline size_t capacity() const { return (size_t)m_bx * m_by * tileCount3D(m_nz) * TILE_CELLS; }
+		DYN_FUNC inline bool isCPU() const { return false; }
+		DYN_FUNC inline bool isGPU() const { return true; }
+		DYN_FUNC inline bool isEmpty() const { return m_data == nullptr; }
+
+		void assign(const ArrayTiled3D<T, DeviceType::GPU>& src);
+		void assign(const ArrayTiled3D<T, DeviceType::CPU>& src);
+
+		/**
+		 * @brief Convert from the linear layout
+		 */
+		void assign(const Array3D<T, DeviceType::GPU>& src);
+
+		/**
+		 * @brief Convert to the linear layout
+		 */
+		void toLinear(Array3D<T, DeviceType::GPU>& dst) const;
+
+	private:
+		uint m_nx = 0;
+		uint m_ny = 0;
+		uint m_nz = 0;
+
+		uint m_bx = 0;
+		uint m_by = 0;
+
+		T* m_data = nullptr;
+
+		Allocator* m_alloc = nullptr;
+	};
+
+	template<typename T>
+	using DArrayTiled3D = ArrayTiled3D<T, DeviceType::GPU>;
+
+	template<typename T>
+	class ArrayTiled2D<T, DeviceType::GPU>
+	{
+	public:
+		ArrayTiled2D()
+		{};
+
+		ArrayTiled2D(uint nx, uint ny)
+		{
+			this->resize(nx, ny);
+		};
+
+		/*!
+		*	\brief	Should not release data here, call clear() explicitly.
+		*/
+		~ArrayTiled2D() {};
+
+		void resize(const uint nx, const uint ny);
+
+		void reset();
+
+		void clear();
+
+		inline T* begin() const { return m_data; }
+
+		DYN_FUNC inline uint nx() const { return m_nx; }
+		DYN_FUNC inline uint ny() const { return m_ny; }
+
+		GPU_FUNC inline T operator () (const uint i, const uint j) const
+		{
+			return m_data[tiledIndex2D(i, j, m_bx)];
+		}
+
+		GPU_FUNC inline T& operator () (const uint i, const uint j)
+		{
+			return m_data[tiledIndex2D(i, j, m_bx)];
+		}
+
+		DYN_FUNC inline size_t index(const uint i, const uint j) const
+		{
+			return tiledIndex2D(i, j, m_bx);
+		}
+
+		GPU_FUNC inline T operator [] (const uint id) const { return m_data[id]; }
+		GPU_FUNC inline T& operator [] (const uint id) { return m_data[id]; }
+
+		DYN_FUNC inline size_t size() const { return (size_t)m_nx * m_ny; }
+		DYN_FUNC inline size_t capacity() const { return (size_t)m_bx * tileCount2D(m_ny) * TILE_CELLS; }
+		DYN_FUNC inline bool isCPU() const { return false; }
+		DYN_FUNC inline bool isGPU() const { return true; }
+		DYN_FUNC inline bool isEmpty() const { return m_data == nullptr; }
+
+		void assign(const ArrayTiled2D<T, DeviceType::GPU>& src);
+		void assign(const ArrayTiled2D<T, DeviceType::CPU>& src);
+
+		/**
+		 * @brief Convert from the linear layout
+		 */
+		void assign(const Array2D<T, DeviceType::GPU>& src);
+
+		/**
+		 * @brief Convert to the linear layout
+		 */
+		void toLinear(Array2D<T, DeviceType::GPU>& dst) const;
+
+	private:
+		uint m_nx = 0;
+		uint m_ny = 0;
+
+		uint m_bx = 0;
+
+		T* m_data = nullptr;
+
+		Allocator* m_alloc = nullptr;
+	};
+
+	template<typename T>
+	using DArrayTiled2D = ArrayTiled2D<T, DeviceType::GPU>;
+
+	//Copy of the whole tiled storage, kind follows cudaMemcpyKind
+	inline void AT_CopyTiled(void* dst, const void* src, size_t bytes, bool toDevice, bool fromDevice)
+	{
+		if (bytes == 0)
+			return;
+#ifdef CUDA_BACKEND
+		cudaMemcpyKind kind = toDevice ? (fromDevice ? cudaMemcpyDeviceToDevice : cudaMemcpyHostToDevice) : (fromDevice ? cudaMemcpyDeviceToHost : cudaMemcpyHostToHost);
+		cuSafeCall(cudaMemcpy(dst, src, bytes, kind));
+#else
+		memcpy(dst, src, bytes);
+#endif
+	}
+
+	inline void AT_SetZero(void* dst, size_t bytes)
+	{
+		if (bytes == 0)
+			return;
+#ifdef CUDA_BACKEND
+		cuSafeCall(cudaMemset(dst, 0, bytes));
+#else
+		memset(dst, 0, bytes);
+#endif
+	}
+
+	template<typename T>
+	void ArrayTiled3D<T, DeviceType::GPU>::resize(const uint nx, const uint ny, const uint nz)
+	{
+		if (m_data != nullptr && tileCount3D(nx) == m_bx && tileCount3D(ny) == m_by && tileCount3D(nz) == tileCount3D(m_nz))
+		{
+			m_nx = nx;	m_ny = ny;	m_nz = nz;
+			return;
+		}
+
+		this->clear();
+
+		if (nx == 0 || ny == 0 || nz == 0)
+			return;
+
+		m_nx = nx;	m_ny = ny;	m_nz = nz;
+		m_bx = tileCount3D(nx);	m_by = tileCount3D(ny);
+
+		m_alloc = Allocator::device();
+		m_data = (T*)m_alloc->allocate(this->capacity() * sizeof(T));
+	}
+
+	template<typename T>
+	void ArrayTiled3D<T, DeviceType::GPU>::reset()
+	{
+		AT_SetZero(m_data, this->capacity() * sizeof(T));
+	}
+
+	template<typename T>
+	void ArrayTiled3D<T, DeviceType::GPU>::clear()
+	{
+		if (m_data != nullptr)
+			m_alloc->deallocate(m_data, this->capacity() * sizeof(T));
+
+		m_data = nullptr;
+		m_nx = 0;	m_ny = 0;	m_nz = 0;
+		m_bx = 0;	m_by = 0;
+	}
+
+	template<typename T>
+	void ArrayTiled3D<T, DeviceType::GPU>::assign(const ArrayTiled3D<T, DeviceType::GPU>& src)
+	{
+		this->resize(src.nx(), src.ny(), src.nz());
+
+		AT_CopyTiled(m_data, src.begin(), this->capacity() * sizeof(T), true, true);
+	}
+
+	template<typename T>
+	void ArrayTiled3D<T, DeviceType::GPU>::assign(const ArrayTiled3D<T, DeviceType::CPU>& src)
+	{
+		this->resize(src.nx(), src.ny(), src.nz());
+
+		AT_CopyTiled(m_data, src.begin(), this->capacity() * sizeof(T), true, false);
+	}
+
+	template<typename T>
+	void ArrayTiled3D<T, DeviceType::GPU>::assign(const Array3D<T, DeviceType::GPU>& src)
+	{
+		this->resize(src.nx(), src.ny(), src.nz());
+
+		if (m_data == nullptr)
+			return;
+
+		parallel_convert_tiled<sizeof(T)>(m_data, src.begin(), src.pitch(), (size_t)src.pitch() * src.ny(), m_nx, m_ny, m_nz, true, true);
+	}
+
+	template<typename T>
+	void ArrayTiled3D<T, DeviceType::GPU>::toLinear(Array3D<T, DeviceType::GPU>& dst) const
+	{
+		if (dst.nx() != m_nx || dst.ny() != m_ny || dst.nz() != m_nz)
+			dst.resize(m_nx, m_ny, m_nz);
+
+		if (m_data == nullptr)
+			return;
+
+		parallel_convert_tiled<sizeof(T)>(m_data, dst.begin(), dst.pitch(), (size_t)dst.pitch() * dst.ny(), m_nx, m_ny, m_nz, true, false);
+	}
+
+	template<typename T>
+	void ArrayTiled3D<T, DeviceType::CPU>::assign(const ArrayTiled3D<T, DeviceType::GPU>& src)
+	{
+		this->resize(src.nx(), src.ny(), src.nz());
+
+		AT_CopyTiled(m_data.data(), src.begin(), m_data.size() * sizeof(T), false, true);
+	}
+
+	template<typename T>
+	void ArrayTiled2D<T, DeviceType::GPU>::resize(const uint nx, const uint ny)
+	{
+		if (m_data != nullptr && tileCount2D(nx) == m_bx && tileCount2D(ny) == tileCount2D(m_ny))
+		{
+			m_nx = nx;	m_ny = ny;
+			return;
+		}
+
+		this->clear();
+
+		if (nx == 0 || ny == 0)
+			return;
+
+		m_nx = nx;	m_ny = ny;
+		m_bx = tileCount2D(nx);
+
+		m_alloc = Allocator::device();
+		m_data = (T*)m_alloc->allocate(this->capacity() * sizeof(T));
+	}
+
+	template<typename T>
+	void ArrayTiled2D<T, DeviceType::GPU>::reset()
+	{
+		AT_SetZero(m_data, this->capacity() * sizeof(T));
+	}
+
+	template<typename T>
+	void ArrayTiled2D<T, DeviceType::GPU>::clear()
+	{
+		if (m_data != nullptr)
+			m_alloc->deallocate(m_data, this->capacity() * sizeof(T));
+
+		m_data = nullptr;
+		m_nx = 0;	m_ny = 0;
+		m_bx = 0;
+	}
+
+	template<typename T>
+	void ArrayTiled2D<T, DeviceType::GPU>::assign(const ArrayTiled2D<T, DeviceType::GPU>& src)
+	{
+		this->resize(src.nx(), src.ny());
+
+		AT_CopyTiled(m_data, src.begin(), this->capacity() * sizeof(T), true, true);
+	}
+
+	template<typename T>
+	void ArrayTiled2D<T, DeviceType::GPU>::assign(const ArrayTiled2D<T, DeviceType::CPU>& src)
+	{
+		this->resize(src.nx(), src.ny());
+
+		AT_CopyTiled(m_data, src.begin(), this->capacity() * sizeof(T), true, false);
+	}
+
+	template<typename T>
+	void ArrayTiled2D<T, DeviceType::GPU>::assign(const Array2D<T, DeviceType::GPU>& src)
+	{
+		this->resize(src.nx(), src.ny());
+
+		if (m_data == nullptr)
+			return;
+
+		parallel_convert_tiled<sizeof(T)>(m_data, src.begin(), src.pitch(), 0, m_nx, m_ny, 1, false, true);
+	}
+
+	template<typename T>
+	void ArrayTiled2D<T, DeviceType::GPU>::toLinear(Array2D<T, DeviceType::GPU>& dst) const
+	{
+		if (dst.nx() != m_nx || dst.ny() != m_ny)
+			dst.resize(m_nx, m_ny);
+
+		if (m_data == nullptr)
+			return;
+
+		parallel_convert_tiled<sizeof(T)>(m_data, dst.begin(), dst.pitch(), 0, m_nx, m_ny, 1, false, false);
+	}
+
+	template<typename T>
+	void ArrayTiled2D<T, DeviceType::CPU>::assign(const ArrayTiled2D<T, DeviceType::GPU>& src)
+	{
+		this->resize(src.nx(), src.ny());
+
+		AT_CopyTiled(m_data.data(), src.begin(), m_data.size() * sizeof(T), false, true);
+	}
+#endif
+}
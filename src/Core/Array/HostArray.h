@@ -0,0 +1,235 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cstring>
+#include <utility>
+
+#include "Platform.h"
+#include "Array/Array.h"
+
+namespace dyno
+{
+	/**
+	 * @brief A host array for large staging buffers, e.g., the data read back from the device before writing to disk.
+	 *
+	 * Unlike CArray, which wraps std::vector, the elements are never initialized: resize() neither value-initializes
+	 * 	new elements nor copies when the capacity suffices. Memory comes from Allocator::host(), which aligns it to 64 bytes
+	 * 	and backs large buffers with huge pages. Only use it for trivially copyable types.
+	 */
+	template<typename T>
+	class HostArray
+	{
+	public:
+		HostArray()
+		{
+		};
+
+		HostArray(uint num)
+		{
+			this->resize(num);
+		}
+
+		HostArray(HostArray<T>&& src)
+		{
+			*this = std::move(src);
+		}
+
+		~HostArray() { this->clear(); };
+
+		HostArray<T>& operator=(HostArray<T>&& src)
+		{
+			if (this != &src)
+			{
+				this->clear();
+				std::swap(mData, src.mData);
+				std::swap(mSize, src.mSize);
+				std::swap(mCapacity, src.mCapacity);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Change the size, existing elements are kept while new elements are left uninitialized
+		 */
+		void resize(uint n)
+		{
+			if (n > mCapacity)
+				this->reallocate(n, mSize);
+
+			mSize = n;
+		}
+
+		/**
+		 * @brief Grow the capacity to at least n elements, existing elements are kept
+		 */
+		void reserve(uint n)
+		{
+			if (n > mCapacity)
+				this->reallocate(n, mSize);
+		}
+
+		/*!
+		*	\brief	Clear all data to zero.
+		*/
+		void reset()
+		{
+			if (mSize > 0)
+				memset((void*)mData, 0, (size_t)mSize * sizeof(T));
+		}
+
+		void clear()
+		{
+			Allocator::host()->deallocate(mData, (size_t)mCapacity * sizeof(T));
+
+			mData = nullptr;
+			mSize = 0;
+			mCapacity = 0;
+		}
+
+		inline const T*	begin() const { return mData; }
+		inline T*	begin() { return mData; }
+
+		inline const T*	end() const { return mData + mSize; }
+		inline T*	end() { return mData + mSize; }
+
+		DeviceType	deviceType() { return DeviceType::CPU; }
+
+		inline T& operator [] (unsigned int id)
+		{
+			return mData[id];
+		}
+
+		inline const T& operator [] (unsigned int id) const
+		{
+			return mData[id];
+		}
+
+		inline uint size() const { return mSize; }
+		inline uint capacity() const { return mCapacity; }
+		inline bool isCPU() const { return true; }
+		inline bool isGPU() const { return false; }
+		inline bool isEmpty() const { return mSize == 0; }
+
+		inline void pushBack(const T& ele)
+		{
+			if (mSize == mCapacity)
+				this->reallocate(mCapacity == 0 ? 16 : 2 * mCapacity, mSize);
+
+			mData[mSize++] = ele;
+		}
+
+		void assign(const T& val)
+		{
+			for (uint i = 0; i < mSize; i++)
+				mData[i] = val;
+		}
+
+		void assign(uint num, const T& val)
+		{
+			this->resize(num);
+			this->assign(val);
+		}
+
+		void assign(const HostArray<T>& src)
+		{
+			this->resize(src.size());
+			this->copy(src.begin(), src.size());
+		}
+
+		void assign(const CArray<T>& src)
+		{
+			this->resize(src.size());
+			this->copy(src.begin(), src.size());
+		}
+
+		void assign(const std::vector<T>& src)
+		{
+			this->resize((uint)src.size());
+			this->copy(src.data(), (uint)src.size());
+		}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+		void assign(const DArray<T>& src)
+		{
+			this->resize(src.size());
+
+			if (mSize == 0)
+				return;
+#ifdef CUDA_BACKEND
+			cuSafeCall(cudaMemcpy(mData, src.begin(), (size_t)mSize * sizeof(T), cudaMemcpyDeviceToHost));
+#else
+			memcpy((void*)mData, src.begin(), (size_t)mSize * sizeof(T));
+#endif
+		}
+#endif
+
+		friend std::ostream& operator<<(std::ostream &out, const HostArray<T>& array)
+		{
+			for (uint i = 0; i < array.size(); i++)
+			{
+				out << i << ": " << array[i] << std::endl;
+			}
+
+			return out;
+		}
+
+	private:
+		HostArray(const HostArray<T>&) = delete;
+		HostArray<T>& operator=(const HostArray<T>&) = delete;
+
+		void copy(const T* src, uint num)
+		{
+			if (num > 0)
+				memcpy((void*)mData, src, (size_t)num * sizeof(T));
+		}
+
+		void reallocate(uint n, uint keep)
+		{
+			T* data = (T*)Allocator::host()->allocate((size_t)n * sizeof(T));
+
+			if (keep > 0)
+				memcpy((void*)data, mData, (size_t)keep * sizeof(T));
+
+			uint size = mSize;
+			this->clear();
+
+			mData = data;
+			mSize = size;
+			mCapacity = n;
+		}
+
+		T* mData = nullptr;
+		uint mSize = 0;
+		uint mCapacity = 0;
+	};
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+	template<typename T>
+	void Array<T, DeviceType::GPU>::assign(const HostArray<T>& src)
+	{
+		if (mTotalNum != src.size())
+			this->resize(src.size());
+
+		if (src.size() == 0)
+			return;
+#ifdef CUDA_BACKEND
+		cuSafeCall(cudaMemcpy(mData, src.begin(), (size_t)src.size() * sizeof(T), cudaMemcpyHostToDevice));
+#else
+		memcpy(mData, src.begin(), (size_t)src.size() * sizeof(T));
+#endif
+	}
+#endif
+}
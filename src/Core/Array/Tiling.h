@@ -0,0 +1,66 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Platform.h"
+
+namespace dyno
+{
+	/**
+	 * Index computation of the tiled grid layout used by ArrayTiled2D and ArrayTiled3D.
+	 *
+	 * Grids are split into bricks of 64 cells (8x8 in 2D, 4x4x4 in 3D) stored one after another in x, y, z order.
+	 * 	Cells inside a brick are stored in Morton order, so that the 2x2(x2) stencil of a bilinear (trilinear) lookup
+	 * 	mostly falls into one brick, i.e., a few adjacent cache lines.
+	 */
+	#define TILE_SIZE_2D 8
+	#define TILE_SIZE_3D 4
+	#define TILE_CELLS 64
+
+	/**
+	 * @brief Number of bricks along an axis of n cells
+	 */
+	DYN_FUNC inline uint tileCount2D(const uint n) { return (n + TILE_SIZE_2D - 1) / TILE_SIZE_2D; }
+	DYN_FUNC inline uint tileCount3D(const uint n) { return (n + TILE_SIZE_3D - 1) / TILE_SIZE_3D; }
+
+	/**
+	 * @brief bx is the number of bricks along x
+	 */
+	DYN_FUNC inline size_t tiledIndex2D(const uint i, const uint j, const uint bx)
+	{
+		//Spread the lower three bits of a coordinate to bits 0, 2 and 4
+		uint li = (i & 1) | ((i & 2) << 1) | ((i & 4) << 2);
+		uint lj = (j & 1) | ((j & 2) << 1) | ((j & 4) << 2);
+
+		size_t brick = (size_t)(i >> 3) + (size_t)(j >> 3) * bx;
+
+		return brick * TILE_CELLS + (li | (lj << 1));
+	}
+
+	/**
+	 * @brief bx and by are the numbers of bricks along x and y
+	 */
+	DYN_FUNC inline size_t tiledIndex3D(const uint i, const uint j, const uint k, const uint bx, const uint by)
+	{
+		//Spread the lower two bits of a coordinate to bits 0 and 3
+		uint li = (i & 1) | ((i & 2) << 2);
+		uint lj = (j & 1) | ((j & 2) << 2);
+		uint lk = (k & 1) | ((k & 2) << 2);
+
+		size_t brick = (size_t)(i >> 2) + ((size_t)(j >> 2) + (size_t)(k >> 2) * by) * bx;
+
+		return brick * TILE_CELLS + (li | (lj << 1) | (lk << 2));
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "Array/Array.h"
+#include "Algorithm/HostCompaction.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Stream compaction and stable partition on the CPU backend, shares the interface with the CUDA implementation
+	 * 	and forwards to HostCompaction.
+	 */
+	class Compaction
+	{
+	public:
+		Compaction() {};
+		~Compaction() {};
+
+		/**
+		 * @brief Resize indices to the number of set flags and write their indices in increasing order
+		 *
+		 * @return the number of set flags
+		 */
+		template<typename TFlag>
+		uint compact(DArray<uint>& indices, const DArray<TFlag>& flags)
+		{
+			uint count = mHost.count(flags.begin(), flags.size());
+			indices.resize(count);
+
+			uint* ids = indices.begin();
+			mHost.scatter(flags.begin(), flags.size(), [=](size_t i, size_t pos) { ids[pos] = (uint)i; }, HostCompaction::HC_Skip());
+			return count;
+		}
+
+		/**
+		 * @brief Resize output to the number of set flags and copy the corresponding elements of input, keeping their order
+		 */
+		template<typename T, typename TFlag>
+		uint compact(DArray<T>& output, const DArray<T>& input, const DArray<TFlag>& flags)
+		{
+			assert(input.size() == flags.size());
+
+			uint count = mHost.count(flags.begin(), flags.size());
+			output.resize(count);
+
+			T* dst = output.begin();
+			const T* src = input.begin();
+			mHost.scatter(flags.begin(), flags.size(), [=](size_t i, size_t pos) { dst[pos] = src[i]; }, HostCompaction::HC_Skip());
+			return count;
+		}
+
+		/**
+		 * @brief Stable partition, order receives the indices of the set flags followed by the indices of the others
+		 *
+		 * @return the number of set flags
+		 */
+		template<typename TFlag>
+		uint partition(DArray<uint>& order, const DArray<TFlag>& flags)
+		{
+			order.resize(flags.size());
+			return mHost.partition(order.begin(), flags.begin(), flags.size());
+		}
+
+	private:
+		HostCompaction mHost;
+	};
+}
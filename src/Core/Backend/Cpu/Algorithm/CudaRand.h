@@ -0,0 +1,33 @@
+#pragma once
+#include "Platform.h"
+
+namespace dyno {
+
+#define DIV 10000
+
+	/**
+	 * @brief Random numbers on the CPU backend, shares the interface with the curand based implementation.
+	 * 	A linear congruential generator keeps the per-thread state as small as curandState is on the device.
+	 */
+	class RandNumber
+	{
+	public:
+		GPU_FUNC RandNumber(int seed)
+		{
+			s = (unsigned int)seed * 747796405u + 2891336453u;
+		}
+		GPU_FUNC ~RandNumber() {};
+
+		/*!
+		*	\brief	Generate a float number ranging from 0 to 1.
+		*/
+		GPU_FUNC float Generate()
+		{
+			s = s * 1664525u + 1013904223u;
+			return ((s >> 8) + 1) * (1.0f / 16777216.0f);
+		}
+
+	private:
+		unsigned int s;
+	};
+}
@@ -0,0 +1,77 @@
+#include "Function2Pt.h"
+#include "Algorithm/Functional.h"
+
+#include <cassert>
+
+namespace dyno
+{
+	namespace Function2Pt
+	{
+		template <typename T, typename Function>
+		void HostTwoPointFunc(DArray<T>& zArr, DArray<T>& xArr, DArray<T>& yArr, Function func)
+		{
+			assert(zArr.size() == xArr.size() && zArr.size() == yArr.size());
+
+			T* z = zArr.begin();
+			T* x = xArr.begin();
+			T* y = yArr.begin();
+			for (uint i = 0; i < zArr.size(); i++)
+				z[i] = func(x[i], y[i]);
+		}
+
+		template <typename T>
+		void plus(DArray<T>& zArr, DArray<T>& xArr, DArray<T>& yArr)
+		{
+			HostTwoPointFunc(zArr, xArr, yArr, PlusFunc<T>());
+		}
+
+		template <typename T>
+		void subtract(DArray<T>& zArr, DArray<T>& xArr, DArray<T>& yArr)
+		{
+			HostTwoPointFunc(zArr, xArr, yArr, MinusFunc<T>());
+		}
+
+		template <typename T>
+		void multiply(DArray<T>& zArr, DArray<T>& xArr, DArray<T>& yArr)
+		{
+			HostTwoPointFunc(zArr, xArr, yArr, MultiplyFunc<T>());
+		}
+
+		template <typename T>
+		void divide(DArray<T>& zArr, DArray<T>& xArr, DArray<T>& yArr)
+		{
+			HostTwoPointFunc(zArr, xArr, yArr, DivideFunc<T>());
+		}
+
+		template <typename T>
+		void saxpy(DArray<T>& zArr, DArray<T>& xArr, DArray<T>& yArr, T alpha)
+		{
+			assert(zArr.size() == xArr.size() && zArr.size() == yArr.size());
+
+			T* z = zArr.begin();
+			T* x = xArr.begin();
+			T* y = yArr.begin();
+			for (uint i = 0; i < zArr.size(); i++)
+				z[i] = alpha * x[i] + y[i];
+		}
+
+		template void plus(DArray<int>&, DArray<int>&, DArray<int>&);
+		template void plus(DArray<float>&, DArray<float>&, DArray<float>&);
+		template void plus(DArray<double>&, DArray<double>&, DArray<double>&);
+
+		template void subtract(DArray<int>&, DArray<int>&, DArray<int>&);
+		template void subtract(DArray<float>&, DArray<float>&, DArray<float>&);
+		template void subtract(DArray<double>&, DArray<double>&, DArray<double>&);
+
+		template void multiply(DArray<int>&, DArray<int>&, DArray<int>&);
+		template void multiply(DArray<float>&, DArray<float>&, DArray<float>&);
+		template void multiply(DArray<double>&, DArray<double>&, DArray<double>&);
+
+		template void divide(DArray<int>&, DArray<int>&, DArray<int>&);
+		template void divide(DArray<float>&, DArray<float>&, DArray<float>&);
+		template void divide(DArray<double>&, DArray<double>&, DArray<double>&);
+
+		template void saxpy(DArray<float>&, DArray<float>&, DArray<float>&, float);
+		template void saxpy(DArray<double>&, DArray<double>&, DArray<double>&, double);
+	}
+}
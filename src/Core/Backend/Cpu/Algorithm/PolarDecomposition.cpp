@@ -0,0 +1,49 @@
+#include "PolarDecomposition.h"
+#include "Algorithm/HostSVD.h"
+
+#include <vector>
+
+namespace dyno
+{
+	void polarDecomposition(DArray<Mat3f>& A, DArray<Mat3f>& R, DArray<Mat3f>& U, DArray<Mat3f>& D, DArray<Mat3f>& V)
+	{
+		R.resize(A.size());
+		U.resize(A.size());
+		D.resize(A.size());
+		V.resize(A.size());
+
+		HostSVD::polarDecomposition(A.begin(), R.begin(), U.begin(), D.begin(), V.begin(), A.size());
+	}
+
+	void polarDecomposition(DArray<Mat3d>& A, DArray<Mat3d>& R, DArray<Mat3d>& U, DArray<Mat3d>& D, DArray<Mat3d>& V)
+	{
+		size_t num = A.size();
+
+		R.resize(num);
+		U.resize(num);
+		D.resize(num);
+		V.resize(num);
+
+		std::vector<Mat3f> a(num), r(num), u(num), d(num), v(num);
+		for (size_t n = 0; n < num; n++)
+			for (int i = 0; i < 3; i++)
+				for (int j = 0; j < 3; j++)
+					a[n](i, j) = (float)A[n](i, j);
+
+		HostSVD::polarDecomposition(a.data(), r.data(), u.data(), d.data(), v.data(), num);
+
+		for (size_t n = 0; n < num; n++)
+		{
+			for (int i = 0; i < 3; i++)
+			{
+				for (int j = 0; j < 3; j++)
+				{
+					R[n](i, j) = r[n](i, j);
+					U[n](i, j) = u[n](i, j);
+					D[n](i, j) = d[n](i, j);
+					V[n](i, j) = v[n](i, j);
+				}
+			}
+		}
+	}
+}
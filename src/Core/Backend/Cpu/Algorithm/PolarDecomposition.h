@@ -0,0 +1,35 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+#include "Matrix.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Polar decompositions of all matrices of A, with the same outputs as polarDecomposition(A[i], R[i], U[i], D[i], V[i])
+	 * 	of MatrixFunc. Per-element code calling polarDecomposition() is better split around this function, the whole array
+	 * 	is decomposed by the batched kernel of HostSVD.
+	 *
+	 * R, U, D and V are resized to the size of A.
+	 */
+	void polarDecomposition(DArray<Mat3f>& A, DArray<Mat3f>& R, DArray<Mat3f>& U, DArray<Mat3f>& D, DArray<Mat3f>& V);
+
+	/**
+	 * @brief Double precision matrices are decomposed in single precision, as in MatrixFunc
+	 */
+	void polarDecomposition(DArray<Mat3d>& A, DArray<Mat3d>& R, DArray<Mat3d>& U, DArray<Mat3d>& D, DArray<Mat3d>& V);
+}
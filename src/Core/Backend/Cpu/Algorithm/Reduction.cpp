@@ -0,0 +1,70 @@
+#include "Reduction.h"
+#include "Algorithm/HostReduction.h"
+
+namespace dyno {
+
+	template<typename T>
+	Reduction<T>::Reduction()
+	{
+	}
+
+	template<typename T>
+	Reduction<T>::~Reduction()
+	{
+	}
+
+	template<typename T>
+	Reduction<T>* Reduction<T>::Create(const uint n)
+	{
+		return new Reduction<T>();
+	}
+
+	template<typename T>
+	T Reduction<T>::accumulate(const T* val, const uint num)
+	{
+		return HostReduction<T>().accumulate(val, num);
+	}
+
+	template<typename T>
+	T Reduction<T>::maximum(const T* val, const uint num)
+	{
+		return HostReduction<T>().maximum(val, num);
+	}
+
+	template<typename T>
+	T Reduction<T>::minimum(const T* val, const uint num)
+	{
+		return HostReduction<T>().minimum(val, num);
+	}
+
+	template<typename T>
+	T Reduction<T>::average(const T* val, const uint num)
+	{
+		return HostReduction<T>().average(val, num);
+	}
+
+	template class Reduction<int>;
+	template class Reduction<float>;
+	template class Reduction<double>;
+	template class Reduction<uint>;
+
+	Reduction<Vec3f>::Reduction() {}
+	Reduction<Vec3f>::~Reduction() {}
+
+	Reduction<Vec3f>* Reduction<Vec3f>::Create(const uint n) { return new Reduction<Vec3f>(); }
+
+	Vec3f Reduction<Vec3f>::accumulate(const Vec3f* val, const uint num) { return HostReduction<Vec3f>().accumulate(val, num); }
+	Vec3f Reduction<Vec3f>::maximum(const Vec3f* val, const uint num) { return HostReduction<Vec3f>().maximum(val, num); }
+	Vec3f Reduction<Vec3f>::minimum(const Vec3f* val, const uint num) { return HostReduction<Vec3f>().minimum(val, num); }
+	Vec3f Reduction<Vec3f>::average(const Vec3f* val, const uint num) { return HostReduction<Vec3f>().average(val, num); }
+
+	Reduction<Vec3d>::Reduction() {}
+	Reduction<Vec3d>::~Reduction() {}
+
+	Reduction<Vec3d>* Reduction<Vec3d>::Create(const uint n) { return new Reduction<Vec3d>(); }
+
+	Vec3d Reduction<Vec3d>::accumulate(const Vec3d* val, const uint num) { return HostReduction<Vec3d>().accumulate(val, num); }
+	Vec3d Reduction<Vec3d>::maximum(const Vec3d* val, const uint num) { return HostReduction<Vec3d>().maximum(val, num); }
+	Vec3d Reduction<Vec3d>::minimum(const Vec3d* val, const uint num) { return HostReduction<Vec3d>().minimum(val, num); }
+	Vec3d Reduction<Vec3d>::average(const Vec3d* val, const uint num) { return HostReduction<Vec3d>().average(val, num); }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Vector.h"
+
+namespace dyno {
+
+	/**
+	 * @brief Reduction on the CPU backend, shares the interface with the CUDA implementation and forwards to HostReduction.
+	 */
+	template<typename T>
+	class Reduction
+	{
+	public:
+		Reduction();
+
+		static Reduction* Create(const uint n);
+		~Reduction();
+
+		T accumulate(const T * val, const uint num);
+
+		T maximum(const T* val, const uint num);
+
+		T minimum(const T* val, const uint num);
+
+		T average(const T* val, const uint num);
+	};
+
+	template<>
+	class Reduction<Vec3f>
+	{
+	public:
+		Reduction();
+
+		static Reduction* Create(const uint n);
+		~Reduction();
+
+		Vec3f accumulate(const Vec3f * val, const uint num);
+
+		Vec3f maximum(const Vec3f* val, const uint num);
+
+		Vec3f minimum(const Vec3f* val, const uint num);
+
+		Vec3f average(const Vec3f* val, const uint num);
+	};
+
+	template<>
+	class Reduction<Vec3d>
+	{
+	public:
+		Reduction();
+
+		static Reduction* Create(const uint n);
+		~Reduction();
+
+		Vec3d accumulate(const Vec3d * val, const uint num);
+
+		Vec3d maximum(const Vec3d* val, const uint num);
+
+		Vec3d minimum(const Vec3d* val, const uint num);
+
+		Vec3d average(const Vec3d* val, const uint num);
+	};
+}
@@ -0,0 +1,45 @@
+#include "Scan.h"
+#include "Algorithm/HostScan.h"
+
+namespace dyno
+{
+	template<typename T>
+	Scan<T>::Scan()
+	{
+	}
+
+	template<typename T>
+	Scan<T>::~Scan()
+	{
+	}
+
+	template<typename T>
+	void Scan<T>::exclusive(T* output, const T* input, size_t length, bool bcao)
+	{
+		HostScan<T> scan;
+		scan.exclusive(output, input, length);
+	}
+
+	template<typename T>
+	void Scan<T>::exclusive(T* data, size_t length, bool bcao)
+	{
+		this->exclusive(data, data, length, bcao);
+	}
+
+	template<typename T>
+	void Scan<T>::exclusive(DArray<T>& output, DArray<T>& input, bool bcao)
+	{
+		assert(input.size() == output.size());
+
+		this->exclusive(output.begin(), input.begin(), input.size(), bcao);
+	}
+
+	template<typename T>
+	void Scan<T>::exclusive(DArray<T>& data, bool bcao)
+	{
+		this->exclusive(data.begin(), data.begin(), data.size(), bcao);
+	}
+
+	template class Scan<int>;
+	template class Scan<uint>;
+}
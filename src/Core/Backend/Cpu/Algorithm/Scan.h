@@ -0,0 +1,23 @@
+#pragma once
+#include "Array/Array.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Prefix sum on the CPU backend, shares the interface with the CUDA implementation and forwards to HostScan.
+	 * 	The bcao flag (bank conflict avoidance) is meaningless on the host and ignored.
+	 */
+	template<typename T>
+	class Scan
+	{
+	public:
+		Scan();
+		~Scan();
+
+		void exclusive(T* output, const T* input, size_t length, bool bcao = true);
+		void exclusive(T* data, size_t length, bool bcao = true);
+
+		void exclusive(DArray<T>& output, DArray<T>& input, bool bcao = true);
+		void exclusive(DArray<T>& data, bool bcao = true);
+	};
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "Array/ArrayList.h"
+#include "Algorithm/HostSegmentedScan.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Segmented reduction and scan over DArrayList rows on the CPU backend, shares the interface with the CUDA implementation
+	 * 	and forwards to HostSegmentedScan.
+	 */
+	template<typename T>
+	class SegmentedScan
+	{
+	public:
+		SegmentedScan() {};
+		~SegmentedScan() {};
+
+		/**
+		 * @brief out[i] = op(init, op(map(i, e_0), op(map(i, e_1), ...))) for the elements e_k of row i, init for empty rows
+		 */
+		template<typename TE, typename Map, typename Op>
+		void transformReduce(DArray<T>& out, const DArrayList<TE>& list, Map map, T init, Op op)
+		{
+			out.resize(list.size());
+			mHost.transformReduce(out.begin(), list.index().begin(), list.elements().begin(), list.size(), list.elementSize(), map, init, op);
+		}
+
+		template<typename Op>
+		void reduce(DArray<T>& out, const DArrayList<T>& list, T init, Op op)
+		{
+			out.resize(list.size());
+			mHost.reduce(out.begin(), list.index().begin(), list.elements().begin(), list.size(), list.elementSize(), init, op);
+		}
+
+		void sum(DArray<T>& out, const DArrayList<T>& list)
+		{
+			this->reduce(out, list, T(0), std::plus<T>());
+		}
+
+		template<typename Op>
+		void inclusive(DArrayList<T>& list, Op op)
+		{
+			mHost.inclusive(const_cast<T*>(list.elements().begin()), list.index().begin(), list.size(), list.elementSize(), op);
+		}
+
+		template<typename Op>
+		void exclusive(DArrayList<T>& list, T init, Op op)
+		{
+			mHost.exclusive(const_cast<T*>(list.elements().begin()), list.index().begin(), list.size(), list.elementSize(), init, op);
+		}
+
+	private:
+		HostSegmentedScan<T> mHost;
+	};
+}
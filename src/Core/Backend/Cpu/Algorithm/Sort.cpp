@@ -0,0 +1,37 @@
+#include "Sort.h"
+
+namespace dyno {
+
+	template<typename TKey>
+	Sort<TKey>::Sort()
+	{
+	}
+
+	template<typename TKey>
+	Sort<TKey>::~Sort()
+	{
+	}
+
+	template<typename TKey>
+	void Sort<TKey>::sort(TKey* keys, const uint num)
+	{
+		mSort.sort(keys, num);
+	}
+
+	template<typename TKey>
+	void Sort<TKey>::sort(DArray<TKey>& keys)
+	{
+		mSort.sort(keys.begin(), keys.size());
+	}
+
+	template<typename TKey>
+	void Sort<TKey>::sortByKey(TKey* keys, void* values, const uint num, const size_t valueSize)
+	{
+		mSort.sortByKey(keys, values, num, valueSize);
+	}
+
+	template class Sort<int>;
+	template class Sort<uint>;
+	template class Sort<unsigned long>;
+	template class Sort<unsigned long long>;
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+#include "Algorithm/HostSort.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Radix sort on the CPU backend, shares the interface with the CUDA implementation and forwards to HostSort.
+	 */
+	template<typename TKey>
+	class Sort
+	{
+	public:
+		Sort();
+		~Sort();
+
+		//The buffers are released in the destructor, copies would release them twice
+		Sort(const Sort&) = delete;
+		Sort& operator=(const Sort&) = delete;
+
+		void sort(TKey* keys, const uint num);
+		void sort(DArray<TKey>& keys);
+
+		/**
+		 * @brief Sort keys and reorder values of valueSize bytes accordingly
+		 */
+		void sortByKey(TKey* keys, void* values, const uint num, const size_t valueSize);
+
+		template<typename TValue>
+		void sortByKey(DArray<TKey>& keys, DArray<TValue>& values)
+		{
+			assert(keys.size() == values.size());
+			this->sortByKey(keys.begin(), values.begin(), keys.size(), sizeof(TValue));
+		}
+
+	private:
+		HostSort<TKey> mSort;
+	};
+}
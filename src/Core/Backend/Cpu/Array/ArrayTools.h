@@ -0,0 +1,53 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+#include "Array/Tiling.h"
+#include "STL/List.h"
+
+namespace dyno
+{
+	/**
+	 * On the CPU backend the kernels are compiled with the including translation unit,
+	 * 	so no explicit instantiation for each element size is required.
+	 */
+	template<uint N>
+	void parallel_allocate_for_list(void* lists, void* elements, size_t ele_size, DArray<uint>& index);
+
+	template<uint N>
+	void parallel_init_for_list(void* lists, void* elements, size_t ele_size, DArray<uint>& index);
+
+	/**
+	 * @brief Write the number of inserted elements of each list into counts, N is the element size
+	 */
+	template<uint N>
+	void parallel_count_for_list(void* lists, DArray<uint>& counts);
+
+	/**
+	 * @brief Copy the inserted elements of list i to elements + index[i], index holds one more entry than the number of lists
+	 */
+	template<uint N>
+	void parallel_compact_for_list(void* elements, void* lists, DArray<uint>& index);
+
+	/**
+	 * @brief Convert between a pitched linear grid and the tiled layout of Array/Tiling.h, N is the element size.
+	 * 	For 2D grids, set is3D to false and nz to 1.
+	 */
+	template<uint N>
+	void parallel_convert_tiled(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+}
+
+#include "ArrayTools.inl"
@@ -0,0 +1,181 @@
+namespace dyno
+{
+	template<uint N>
+	struct SpaceHolder
+	{
+		char data[N];
+	};
+
+	template<uint N>
+	__global__ void AT_Allocate(
+		void* lists,
+		void* elements,
+		size_t ele_size,
+		DArray<uint> index)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= index.size()) return;
+
+		List<SpaceHolder<N>>* listStartPtr = (List<SpaceHolder<N>>*)lists;
+		SpaceHolder<N>* elementsPtr = (SpaceHolder<N>*)elements;
+
+		uint count = tId == index.size() - 1 ? ele_size - index[index.size() - 1] : index[tId + 1] - index[tId];
+
+		List<SpaceHolder<N>> list;
+		list.reserve(elementsPtr + index[tId], count);
+
+		listStartPtr[tId] = list;
+	}
+
+	template<uint N>
+	void parallel_allocate_for_list(void* lists, void* elements, size_t ele_size, DArray<uint>& index)
+	{
+		cuExecute(index.size(),
+			AT_Allocate<N>,
+			lists,
+			elements,
+			ele_size,
+			index);
+	}
+
+	template<uint N>
+	__global__ void AT_Assign(
+		void* lists,
+		void* elements,
+		size_t ele_size,
+		DArray<uint> index)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= index.size()) return;
+
+		List<SpaceHolder<N>>* listStartPtr = (List<SpaceHolder<N>>*)lists;
+		SpaceHolder<N>* elementsPtr = (SpaceHolder<N>*)elements;
+
+		uint count = tId == index.size() - 1 ? ele_size - index[index.size() - 1] : index[tId + 1] - index[tId];
+
+		List<SpaceHolder<N>> list = *(listStartPtr + tId);
+		list.reserve(elementsPtr + index[tId], count);
+
+		listStartPtr[tId] = list;
+	}
+
+	template<uint N>
+	void parallel_init_for_list(void* lists, void* elements, size_t ele_size, DArray<uint>& index)
+	{
+		cuExecute(index.size(),
+			AT_Assign<N>,
+			lists,
+			elements,
+			ele_size,
+			index);
+	}
+
+	template<uint N>
+	__global__ void AT_CountList(
+		void* lists,
+		DArray<uint> counts)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= counts.size()) return;
+
+		List<SpaceHolder<N>> list = *((List<SpaceHolder<N>>*)lists + tId);
+		counts[tId] = list.size();
+	}
+
+	template<uint N>
+	void parallel_count_for_list(void* lists, DArray<uint>& counts)
+	{
+		cuExecute(counts.size(),
+			AT_CountList<N>,
+			lists,
+			counts);
+	}
+
+	template<uint N>
+	__global__ void AT_CompactList(
+		void* elements,
+		void* lists,
+		DArray<uint> index)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId + 1 >= index.size()) return;
+
+		List<SpaceHolder<N>> list = *((List<SpaceHolder<N>>*)lists + tId);
+		SpaceHolder<N>* dst = (SpaceHolder<N>*)elements + index[tId];
+
+		for (uint i = 0; i < list.size(); i++)
+			dst[i] = list[i];
+	}
+
+	template<uint N>
+	void parallel_compact_for_list(void* elements, void* lists, DArray<uint>& index)
+	{
+		cuExecute(index.size(),
+			AT_CompactList<N>,
+			elements,
+			lists,
+			index);
+	}
+
+	template<uint N>
+	__global__ void AT_ConvertTiled(
+		void* tiled,
+		void* linear,
+		size_t pitch,
+		size_t slice,
+		uint nx,
+		uint ny,
+		uint nz,
+		bool is3D,
+		bool toTiled)
+	{
+		uint i = threadIdx.x + (blockIdx.x * blockDim.x);
+		uint j = threadIdx.y + (blockIdx.y * blockDim.y);
+		uint k = threadIdx.z + (blockIdx.z * blockDim.z);
+
+		if (i >= nx || j >= ny || k >= nz) return;
+
+		size_t t = is3D ? tiledIndex3D(i, j, k, tileCount3D(nx), tileCount3D(ny)) : tiledIndex2D(i, j, tileCount2D(nx));
+
+		SpaceHolder<N>* tiledPtr = (SpaceHolder<N>*)tiled + t;
+		SpaceHolder<N>* linearPtr = (SpaceHolder<N>*)((char*)linear + j * pitch + k * slice) + i;
+
+		if (toTiled)
+			*tiledPtr = *linearPtr;
+		else
+			*linearPtr = *tiledPtr;
+	}
+
+	template<uint N>
+	void parallel_convert_tiled(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled)
+	{
+		if (is3D)
+		{
+			cuExecute3D(make_uint3(nx, ny, nz),
+				AT_ConvertTiled<N>,
+				tiled,
+				linear,
+				pitch,
+				slice,
+				nx,
+				ny,
+				nz,
+				is3D,
+				toTiled);
+		}
+		else
+		{
+			cuExecute2D(make_uint2(nx, ny),
+				AT_ConvertTiled<N>,
+				tiled,
+				linear,
+				pitch,
+				slice,
+				nx,
+				ny,
+				1,
+				is3D,
+				toTiled);
+		}
+	}
+}
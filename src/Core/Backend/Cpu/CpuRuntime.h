@@ -0,0 +1,220 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * The CPU backend plays the role of cuda_runtime.h: it provides the CUDA keywords, built-in vector types,
+ * 	thread indices, atomic functions and the memory functions of the runtime API, so that kernels written for
+ * 	the CUDA backend can be compiled as plain C++ and dispatched over the ThreadPool by cuExecute, cuExecute2D and cuExecute3D.
+ *
+ * Kernels relying on __shared__ memory, __syncthreads() or warp intrinsics are not supported.
+ */
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+#define __global__
+#define __device__
+#define __host__
+#define __forceinline__ inline
+#define __constant__
+
+struct uint2 { unsigned int x, y; };
+struct uint3 { unsigned int x, y, z; };
+struct uint4 { unsigned int x, y, z, w; };
+struct int2 { int x, y; };
+struct int3 { int x, y, z; };
+struct int4 { int x, y, z, w; };
+struct float2 { float x, y; };
+struct float3 { float x, y, z; };
+struct float4 { float x, y, z, w; };
+struct double2 { double x, y; };
+struct double3 { double x, y, z; };
+
+struct dim3
+{
+	unsigned int x, y, z;
+
+	dim3(unsigned int vx = 1, unsigned int vy = 1, unsigned int vz = 1) : x(vx), y(vy), z(vz) {}
+	dim3(uint3 v) : x(v.x), y(v.y), z(v.z) {}
+
+	operator uint3() const { uint3 t; t.x = x; t.y = y; t.z = z; return t; }
+};
+
+inline uint2 make_uint2(unsigned int x, unsigned int y) { uint2 t; t.x = x; t.y = y; return t; }
+inline uint3 make_uint3(unsigned int x, unsigned int y, unsigned int z) { uint3 t; t.x = x; t.y = y; t.z = z; return t; }
+inline int2 make_int2(int x, int y) { int2 t; t.x = x; t.y = y; return t; }
+inline int3 make_int3(int x, int y, int z) { int3 t; t.x = x; t.y = y; t.z = z; return t; }
+inline float2 make_float2(float x, float y) { float2 t; t.x = x; t.y = y; return t; }
+inline float3 make_float3(float x, float y, float z) { float3 t; t.x = x; t.y = y; t.z = z; return t; }
+inline float4 make_float4(float x, float y, float z, float w) { float4 t; t.x = x; t.y = y; t.z = z; t.w = w; return t; }
+
+// The device functions min() and max() of CUDA are declared in the global namespace
+using std::min;
+using std::max;
+
+/**
+ * Device memory is host memory, copies of any kind are plain memcpy
+ */
+enum cudaError_t { cudaSuccess = 0 };
+
+enum cudaMemcpyKind
+{
+	cudaMemcpyHostToHost = 0,
+	cudaMemcpyHostToDevice = 1,
+	cudaMemcpyDeviceToHost = 2,
+	cudaMemcpyDeviceToDevice = 3,
+	cudaMemcpyDefault = 4
+};
+
+inline cudaError_t cudaMalloc(void** ptr, size_t size) { *ptr = malloc(size); return cudaSuccess; }
+inline cudaError_t cudaFree(void* ptr) { free(ptr); return cudaSuccess; }
+inline cudaError_t cudaMemset(void* ptr, int value, size_t size) { memset(ptr, value, size); return cudaSuccess; }
+inline cudaError_t cudaMemcpy(void* dst, const void* src, size_t size, cudaMemcpyKind) { memcpy(dst, src, size); return cudaSuccess; }
+
+template<typename T>
+inline cudaError_t cudaMemcpyToSymbol(T& symbol, const void* src, size_t size) { memcpy(&symbol, src, size); return cudaSuccess; }
+
+/**
+ * Built-in variables of the kernel being executed by the calling thread, set by dyno::cpuExecuteKernel
+ */
+extern thread_local uint3 threadIdx;
+extern thread_local uint3 blockIdx;
+extern thread_local dim3 blockDim;
+extern thread_local dim3 gridDim;
+
+namespace dyno
+{
+	template<typename T>
+	inline std::atomic<T>* cpuAtomicCast(T* address)
+	{
+		static_assert(sizeof(std::atomic<T>) == sizeof(T), "atomic operations are not supported for this type");
+		return reinterpret_cast<std::atomic<T>*>(address);
+	}
+
+	template<typename T>
+	inline T cpuAtomicAddFloat(T* address, T val)
+	{
+		std::atomic<T>* a = cpuAtomicCast(address);
+		T old = a->load(std::memory_order_relaxed);
+		while (!a->compare_exchange_weak(old, old + val, std::memory_order_relaxed)) {}
+		return old;
+	}
+
+	template<typename T>
+	inline T cpuAtomicMin(T* address, T val)
+	{
+		std::atomic<T>* a = cpuAtomicCast(address);
+		T old = a->load(std::memory_order_relaxed);
+		while (val < old && !a->compare_exchange_weak(old, val, std::memory_order_relaxed)) {}
+		return old;
+	}
+
+	template<typename T>
+	inline T cpuAtomicMax(T* address, T val)
+	{
+		std::atomic<T>* a = cpuAtomicCast(address);
+		T old = a->load(std::memory_order_relaxed);
+		while (old < val && !a->compare_exchange_weak(old, val, std::memory_order_relaxed)) {}
+		return old;
+	}
+
+	template<typename T>
+	inline T cpuAtomicCAS(T* address, T compare, T val)
+	{
+		cpuAtomicCast(address)->compare_exchange_strong(compare, val);
+		return compare;
+	}
+
+	/**
+	 * @brief Execute kernel() for every thread of a grid, blocks are distributed over the ThreadPool.
+	 *
+	 * @param grain number of blocks executed by one task, 0 means ThreadPool::grainSize() is used
+	 */
+	template<typename Kernel>
+	void cpuExecuteKernel(dim3 grid, dim3 block, const Kernel& kernel, unsigned int grain = 0)
+	{
+		unsigned int blockNum = grid.x * grid.y * grid.z;
+
+		ThreadPool::instance()->parallelFor(0, blockNum, [&](unsigned int first, unsigned int last) {
+			gridDim = grid;
+			blockDim = block;
+			for (unsigned int b = first; b < last; b++)
+			{
+				blockIdx = make_uint3(b % grid.x, (b / grid.x) % grid.y, b / (grid.x * grid.y));
+				for (unsigned int tz = 0; tz < block.z; tz++)
+				{
+					for (unsigned int ty = 0; ty < block.y; ty++)
+					{
+						for (unsigned int tx = 0; tx < block.x; tx++)
+						{
+							threadIdx = make_uint3(tx, ty, tz);
+							kernel();
+						}
+					}
+				}
+			}
+		}, grain);
+	}
+}
+
+inline int atomicAdd(int* address, int val) { return dyno::cpuAtomicCast(address)->fetch_add(val); }
+inline unsigned int atomicAdd(unsigned int* address, unsigned int val) { return dyno::cpuAtomicCast(address)->fetch_add(val); }
+inline unsigned long long atomicAdd(unsigned long long* address, unsigned long long val) { return dyno::cpuAtomicCast(address)->fetch_add(val); }
+inline float atomicAdd(float* address, float val) { return dyno::cpuAtomicAddFloat(address, val); }
+inline double atomicAdd(double* address, double val) { return dyno::cpuAtomicAddFloat(address, val); }
+
+inline int atomicSub(int* address, int val) { return dyno::cpuAtomicCast(address)->fetch_sub(val); }
+inline unsigned int atomicSub(unsigned int* address, unsigned int val) { return dyno::cpuAtomicCast(address)->fetch_sub(val); }
+
+inline int atomicExch(int* address, int val) { return dyno::cpuAtomicCast(address)->exchange(val); }
+inline unsigned int atomicExch(unsigned int* address, unsigned int val) { return dyno::cpuAtomicCast(address)->exchange(val); }
+inline unsigned long long atomicExch(unsigned long long* address, unsigned long long val) { return dyno::cpuAtomicCast(address)->exchange(val); }
+inline float atomicExch(float* address, float val) { return dyno::cpuAtomicCast(address)->exchange(val); }
+
+inline int atomicMin(int* address, int val) { return dyno::cpuAtomicMin(address, val); }
+inline unsigned int atomicMin(unsigned int* address, unsigned int val) { return dyno::cpuAtomicMin(address, val); }
+inline unsigned long long atomicMin(unsigned long long* address, unsigned long long val) { return dyno::cpuAtomicMin(address, val); }
+inline int atomicMax(int* address, int val) { return dyno::cpuAtomicMax(address, val); }
+inline unsigned int atomicMax(unsigned int* address, unsigned int val) { return dyno::cpuAtomicMax(address, val); }
+inline unsigned long long atomicMax(unsigned long long* address, unsigned long long val) { return dyno::cpuAtomicMax(address, val); }
+
+inline int atomicCAS(int* address, int compare, int val) { return dyno::cpuAtomicCAS(address, compare, val); }
+inline unsigned int atomicCAS(unsigned int* address, unsigned int compare, unsigned int val) { return dyno::cpuAtomicCAS(address, compare, val); }
+inline unsigned long long atomicCAS(unsigned long long* address, unsigned long long compare, unsigned long long val) { return dyno::cpuAtomicCAS(address, compare, val); }
+
+inline int atomicAnd(int* address, int val) { return dyno::cpuAtomicCast(address)->fetch_and(val); }
+inline unsigned int atomicAnd(unsigned int* address, unsigned int val) { return dyno::cpuAtomicCast(address)->fetch_and(val); }
+inline int atomicOr(int* address, int val) { return dyno::cpuAtomicCast(address)->fetch_or(val); }
+inline unsigned int atomicOr(unsigned int* address, unsigned int val) { return dyno::cpuAtomicCast(address)->fetch_or(val); }
+inline int atomicXor(int* address, int val) { return dyno::cpuAtomicCast(address)->fetch_xor(val); }
+inline unsigned int atomicXor(unsigned int* address, unsigned int val) { return dyno::cpuAtomicCast(address)->fetch_xor(val); }
+
+/**
+ * Integer intrinsics, the number of consecutive leading zero bits
+ */
+inline int __clzll(long long x)
+{
+	unsigned long long v = (unsigned long long)x;
+	int n = 64;
+	while (v != 0) { v >>= 1; n--; }
+	return n;
+}
+
+inline int __clz(int x) { return __clzll((unsigned int)x) - 32; }
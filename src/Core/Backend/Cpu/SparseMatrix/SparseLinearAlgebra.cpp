@@ -0,0 +1,31 @@
+#include "Matrix/SparseLinearAlgebra.inl"
+
+namespace dyno
+{
+	template class CSRMatrix<float>;
+	template class CSRMatrix<double>;
+
+	template class BSRMatrix<float>;
+	template class BSRMatrix<double>;
+
+	template class JacobiPreconditioner<float>;
+	template class JacobiPreconditioner<double>;
+
+	template class BlockJacobiPreconditioner<float>;
+	template class BlockJacobiPreconditioner<double>;
+
+	template class IncompleteCholeskyPreconditioner<float>;
+	template class IncompleteCholeskyPreconditioner<double>;
+
+	template class KrylovSolver<float>;
+	template class KrylovSolver<double>;
+
+	template class ConjugateGradient<float>;
+	template class ConjugateGradient<double>;
+
+	template class MINRES<float>;
+	template class MINRES<double>;
+
+	template class BiCGSTAB<float>;
+	template class BiCGSTAB<double>;
+}
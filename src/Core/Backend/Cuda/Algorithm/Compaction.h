@@ -0,0 +1,165 @@
+#pragma once
+#include "Array/Array.h"
+
+#include <cub/device/device_select.cuh>
+#include <cub/iterator/counting_input_iterator.cuh>
+#include <cub/iterator/transform_input_iterator.cuh>
+
+namespace dyno
+{
+	struct CompactionNot
+	{
+		template<typename TFlag>
+		DYN_FUNC bool operator()(const TFlag& flag) const { return !flag; }
+	};
+
+	template<typename T>
+	__global__ void CPT_Gather(
+		T* output,
+		const T* input,
+		const uint* ids,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		output[tId] = input[ids[tId]];
+	}
+
+	/**
+	 * @brief Stream compaction and stable partition built on cub::DeviceSelect.
+	 *
+	 * The temporary storage of cub is kept between calls and only grows. Any flag type convertible to bool can be used.
+	 * 	Being templated on the element and flag types, this header can only be included from .cu files.
+	 */
+	class Compaction
+	{
+	public:
+		Compaction()
+		{
+			mNum.resize(1);
+		};
+
+		~Compaction()
+		{
+			mTemp.clear();
+			mNum.clear();
+			mIds.clear();
+		}
+
+		/**
+		 * @brief Resize indices to the number of set flags and write their indices in increasing order
+		 *
+		 * @return the number of set flags
+		 */
+		template<typename TFlag>
+		uint compact(DArray<uint>& indices, const DArray<TFlag>& flags)
+		{
+			uint num = flags.size();
+			if (num == 0)
+			{
+				indices.clear();
+				return 0;
+			}
+
+			uint count = this->selectIds(flags.begin(), num);
+
+			indices.resize(count);
+			if (count > 0)
+				cuSafeCall(cudaMemcpy(indices.begin(), mIds.begin(), count * sizeof(uint), cudaMemcpyDeviceToDevice));
+
+			return count;
+		}
+
+		/**
+		 * @brief Resize output to the number of set flags and copy the corresponding elements of input, keeping their order
+		 */
+		template<typename T, typename TFlag>
+		uint compact(DArray<T>& output, const DArray<T>& input, const DArray<TFlag>& flags)
+		{
+			assert(input.size() == flags.size());
+
+			uint num = flags.size();
+			if (num == 0)
+			{
+				output.clear();
+				return 0;
+			}
+
+			uint count = this->selectIds(flags.begin(), num);
+
+			output.resize(count);
+			if (count > 0)
+			{
+				cuExecute(count,
+					CPT_Gather,
+					output.begin(),
+					input.begin(),
+					mIds.begin(),
+					count);
+			}
+
+			return count;
+		}
+
+		/**
+		 * @brief Stable partition, order receives the indices of the set flags followed by the indices of the others
+		 *
+		 * @return the number of set flags
+		 */
+		template<typename TFlag>
+		uint partition(DArray<uint>& order, const DArray<TFlag>& flags)
+		{
+			uint num = flags.size();
+			order.resize(num);
+			if (num == 0)
+				return 0;
+
+			cub::CountingInputIterator<uint> ids(0);
+			cub::TransformInputIterator<bool, CompactionNot, const TFlag*> rejected(flags.begin(), CompactionNot());
+
+			uint count = this->select(ids, flags.begin(), order.begin(), num);
+			if (count < num)
+				this->select(ids, rejected, order.begin() + count, num);
+
+			return count;
+		}
+
+	private:
+		/**
+		 * @brief Copy the items whose flags are set to output and return their number
+		 */
+		template<typename InputIt, typename FlagIt>
+		uint select(InputIt input, FlagIt flags, uint* output, uint num)
+		{
+			size_t bytes = 0;
+			cuSafeCall(cub::DeviceSelect::Flagged(nullptr, bytes, input, flags, output, mNum.begin(), num));
+
+			if (mTemp.size() < bytes)
+				mTemp.resize(bytes);
+
+			cuSafeCall(cub::DeviceSelect::Flagged(mTemp.begin(), bytes, input, flags, output, mNum.begin(), num));
+
+			uint count = 0;
+			cuSafeCall(cudaMemcpy(&count, mNum.begin(), sizeof(uint), cudaMemcpyDeviceToHost));
+
+			return count;
+		}
+
+		/**
+		 * @brief Select the indices of the set flags into mIds
+		 */
+		template<typename TFlag>
+		uint selectIds(const TFlag* flags, uint num)
+		{
+			if (mIds.size() < num)
+				mIds.resize(num);
+
+			return this->select(cub::CountingInputIterator<uint>(0), flags, mIds.begin(), num);
+		}
+
+		DArray<char> mTemp;
+		DArray<uint> mNum;
+		DArray<uint> mIds;
+	};
+}
@@ -1,6 +1,6 @@
 #include <cuda_runtime.h>
 #include <vector_types.h>
-#include "Functional.h"
+#include "Algorithm/Functional.h"
 #include "Function2Pt.h"
 
 namespace dyno
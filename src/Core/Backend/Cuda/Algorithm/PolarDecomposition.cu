@@ -0,0 +1,85 @@
+#include "PolarDecomposition.h"
+#include "Matrix/MatrixFunc.h"
+
+namespace dyno
+{
+	__global__ void PD_PolarDecomposition(
+		DArray<Mat3f> A,
+		DArray<Mat3f> R,
+		DArray<Mat3f> U,
+		DArray<Mat3f> D,
+		DArray<Mat3f> V)
+	{
+		int tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= A.size()) return;
+
+		Mat3f r, u, d, v;
+		polarDecomposition(A[tId], r, u, d, v);
+
+		R[tId] = r;
+		U[tId] = u;
+		D[tId] = d;
+		V[tId] = v;
+	}
+
+	__global__ void PD_PolarDecompositionDouble(
+		DArray<Mat3d> A,
+		DArray<Mat3d> R,
+		DArray<Mat3d> U,
+		DArray<Mat3d> D,
+		DArray<Mat3d> V)
+	{
+		int tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= A.size()) return;
+
+		Mat3f a, r, u, d, v;
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				a(i, j) = (float)A[tId](i, j);
+
+		polarDecomposition(a, r, u, d, v);
+
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				R[tId](i, j) = r(i, j);
+				U[tId](i, j) = u(i, j);
+				D[tId](i, j) = d(i, j);
+				V[tId](i, j) = v(i, j);
+			}
+		}
+	}
+
+	void polarDecomposition(DArray<Mat3f>& A, DArray<Mat3f>& R, DArray<Mat3f>& U, DArray<Mat3f>& D, DArray<Mat3f>& V)
+	{
+		R.resize(A.size());
+		U.resize(A.size());
+		D.resize(A.size());
+		V.resize(A.size());
+
+		cuExecute(A.size(),
+			PD_PolarDecomposition,
+			A,
+			R,
+			U,
+			D,
+			V);
+	}
+
+	void polarDecomposition(DArray<Mat3d>& A, DArray<Mat3d>& R, DArray<Mat3d>& U, DArray<Mat3d>& D, DArray<Mat3d>& V)
+	{
+		R.resize(A.size());
+		U.resize(A.size());
+		D.resize(A.size());
+		V.resize(A.size());
+
+		cuExecute(A.size(),
+			PD_PolarDecompositionDouble,
+			A,
+			R,
+			U,
+			D,
+			V);
+	}
+}
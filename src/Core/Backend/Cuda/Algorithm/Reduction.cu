@@ -2,7 +2,7 @@
 #include <cassert>
 #include <cfloat>
 #include "SharedMemory.h"
-#include "Functional.h"
+#include "Algorithm/Functional.h"
 
 namespace dyno {
 
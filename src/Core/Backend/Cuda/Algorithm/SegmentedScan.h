@@ -0,0 +1,239 @@
+#pragma once
+#include "Array/ArrayList.h"
+#include "Algorithm/Functional.h"
+
+#include <cub/device/device_scan.cuh>
+
+namespace dyno
+{
+	template<typename T>
+	struct SegmentedValue
+	{
+		T value;
+		uint head;
+	};
+
+	/**
+	 * @brief Turns an associative operator into one that restarts at every segment head
+	 */
+	template<typename T, typename Op>
+	struct SegmentedOp
+	{
+		Op op;
+
+		DYN_FUNC SegmentedValue<T> operator()(const SegmentedValue<T>& lhs, const SegmentedValue<T>& rhs) const
+		{
+			SegmentedValue<T> ret;
+			ret.value = rhs.head ? rhs.value : op(lhs.value, rhs.value);
+			ret.head = lhs.head | rhs.head;
+			return ret;
+		}
+	};
+
+	struct SegmentedIdentity
+	{
+		template<typename TE>
+		DYN_FUNC const TE& operator()(uint, const TE& e) const { return e; }
+	};
+
+	/**
+	 * @brief Index of the row containing element e, rows sharing a start are empty except the last one
+	 */
+	DYN_FUNC inline uint SEG_RowOf(const uint* index, uint rows, uint e)
+	{
+		uint lo = 0, hi = rows;
+		while (lo < hi)
+		{
+			uint mid = lo + (hi - lo) / 2;
+			if (index[mid] <= e)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo - 1;
+	}
+
+	template<typename T, typename TE, typename Map>
+	__global__ void SEG_Setup(
+		SegmentedValue<T>* values,
+		const TE* elements,
+		const uint* index,
+		uint rows,
+		uint total,
+		Map map)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= total) return;
+
+		uint row = SEG_RowOf(index, rows, tId);
+
+		SegmentedValue<T> v;
+		v.value = map(row, elements[tId]);
+		v.head = tId == index[row] ? 1 : 0;
+		values[tId] = v;
+	}
+
+	template<typename T, typename Op>
+	__global__ void SEG_Reduce(
+		T* out,
+		const SegmentedValue<T>* values,
+		const uint* index,
+		uint rows,
+		uint total,
+		T init,
+		Op op)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= rows) return;
+
+		uint end = tId + 1 < rows ? index[tId + 1] : total;
+
+		out[tId] = end > index[tId] ? op(init, values[end - 1].value) : init;
+	}
+
+	template<typename T, typename Op>
+	__global__ void SEG_Write(
+		T* elements,
+		const SegmentedValue<T>* values,
+		uint total,
+		bool inclusive,
+		T init,
+		Op op)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= total) return;
+
+		if (inclusive)
+			elements[tId] = values[tId].value;
+		else
+			elements[tId] = values[tId].head ? init : op(init, values[tId - 1].value);
+	}
+
+	/**
+	 * @brief Segmented reduction and scan over DArrayList rows.
+	 *
+	 * All rows are processed by a single flagged scan over the elements with cub::DeviceScan, one thread per element,
+	 * 	so the work does not depend on how the elements are distributed among the rows. The flagged values and the temporary
+	 * 	storage of cub are kept between calls and only grow.
+	 *
+	 * Map is called as map(row, element) and Op as op(lhs, rhs), both must be callable on the device and Op is expected to be associative.
+	 * 	Being templated on them, this header can only be included from .cu files.
+	 */
+	template<typename T>
+	class SegmentedScan
+	{
+	public:
+		SegmentedScan() {};
+
+		~SegmentedScan()
+		{
+			mValues.clear();
+			mTemp.clear();
+		}
+
+		/**
+		 * @brief out[i] = op(init, op(map(i, e_0), op(map(i, e_1), ...))) for the elements e_k of row i, init for empty rows
+		 */
+		template<typename TE, typename Map, typename Op>
+		void transformReduce(DArray<T>& out, const DArrayList<TE>& list, Map map, T init, Op op)
+		{
+			out.resize(list.size());
+			if (list.size() == 0)
+				return;
+
+			this->scan(list.index().begin(), list.elements().begin(), list.size(), list.elementSize(), map, op);
+
+			cuExecute(list.size(),
+				SEG_Reduce,
+				out.begin(),
+				mValues.begin(),
+				list.index().begin(),
+				list.size(),
+				list.elementSize(),
+				init,
+				op);
+		}
+
+		template<typename Op>
+		void reduce(DArray<T>& out, const DArrayList<T>& list, T init, Op op)
+		{
+			this->transformReduce(out, list, SegmentedIdentity(), init, op);
+		}
+
+		void sum(DArray<T>& out, const DArrayList<T>& list)
+		{
+			this->reduce(out, list, T(0), PlusFunc<T>());
+		}
+
+		/**
+		 * @brief Replace every element with the fold of its row up to and including itself
+		 */
+		template<typename Op>
+		void inclusive(DArrayList<T>& list, Op op)
+		{
+			this->write(list, true, T(0), op);
+		}
+
+		/**
+		 * @brief Replace every element with init folded with the elements of its row before itself
+		 */
+		template<typename Op>
+		void exclusive(DArrayList<T>& list, T init, Op op)
+		{
+			this->write(list, false, init, op);
+		}
+
+	private:
+		template<typename TE, typename Map, typename Op>
+		void scan(const uint* index, const TE* elements, uint rows, uint total, Map map, Op op)
+		{
+			if (total == 0)
+				return;
+
+			if (mValues.size() < total)
+				mValues.resize(total);
+
+			cuExecute(total,
+				SEG_Setup,
+				mValues.begin(),
+				elements,
+				index,
+				rows,
+				total,
+				map);
+
+			SegmentedOp<T, Op> segOp;
+			segOp.op = op;
+
+			size_t bytes = 0;
+			cuSafeCall(cub::DeviceScan::InclusiveScan(nullptr, bytes, mValues.begin(), mValues.begin(), segOp, total));
+
+			if (mTemp.size() < bytes)
+				mTemp.resize(bytes);
+
+			cuSafeCall(cub::DeviceScan::InclusiveScan(mTemp.begin(), bytes, mValues.begin(), mValues.begin(), segOp, total));
+		}
+
+		template<typename Op>
+		void write(DArrayList<T>& list, bool inclusive, T init, Op op)
+		{
+			uint total = list.elementSize();
+			if (total == 0)
+				return;
+
+			this->scan(list.index().begin(), list.elements().begin(), list.size(), total, SegmentedIdentity(), op);
+
+			cuExecute(total,
+				SEG_Write,
+				const_cast<T*>(list.elements().begin()),
+				mValues.begin(),
+				total,
+				inclusive,
+				init,
+				op);
+		}
+
+		DArray<SegmentedValue<T>> mValues;
+		DArray<char> mTemp;
+	};
+}
@@ -0,0 +1,144 @@
+#include "Sort.h"
+
+#include <cub/device/device_radix_sort.cuh>
+
+namespace dyno
+{
+	template<typename TKey>
+	Sort<TKey>::Sort()
+	{
+	}
+
+	template<typename TKey>
+	Sort<TKey>::~Sort()
+	{
+		mTemp.clear();
+		mKeyBuffer.clear();
+		mPayloadBuffer.clear();
+		mPermutation.clear();
+		mValueBuffer.clear();
+	}
+
+	template<typename TKey>
+	void Sort<TKey>::sort(TKey* keys, const uint num)
+	{
+		this->radixSort(keys, nullptr, num);
+	}
+
+	template<typename TKey>
+	void Sort<TKey>::sort(DArray<TKey>& keys)
+	{
+		this->radixSort(keys.begin(), nullptr, keys.size());
+	}
+
+	__global__ void SORT_Sequence(
+		uint* ids,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		ids[tId] = tId;
+	}
+
+	__global__ void SORT_Gather(
+		char* dst,
+		const char* src,
+		const uint* permutation,
+		size_t valueSize,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		const char* s = src + permutation[tId] * valueSize;
+		char* d = dst + tId * valueSize;
+		for (size_t b = 0; b < valueSize; b++)
+			d[b] = s[b];
+	}
+
+	template<typename TKey>
+	void Sort<TKey>::sortByKey(TKey* keys, void* values, const uint num, const size_t valueSize)
+	{
+		if (num < 2)
+			return;
+
+		if (valueSize == sizeof(uint))
+		{
+			this->radixSort(keys, (uint*)values, num);
+			return;
+		}
+
+		if (mPermutation.size() < num)
+			mPermutation.resize(num);
+
+		cuExecute(num,
+			SORT_Sequence,
+			mPermutation.begin(),
+			num);
+
+		this->radixSort(keys, mPermutation.begin(), num);
+
+		if (mValueBuffer.size() < num * valueSize)
+			mValueBuffer.resize(num * valueSize);
+
+		cuExecute(num,
+			SORT_Gather,
+			mValueBuffer.begin(),
+			(const char*)values,
+			mPermutation.begin(),
+			valueSize,
+			num);
+
+		cuSafeCall(cudaMemcpy(values, mValueBuffer.begin(), num * valueSize, cudaMemcpyDeviceToDevice));
+	}
+
+	template<typename TKey>
+	void Sort<TKey>::radixSort(TKey* keys, uint* payloads, const uint num)
+	{
+		if (num < 2)
+			return;
+
+		if (mKeyBuffer.size() < num)
+			mKeyBuffer.resize(num);
+
+		cub::DoubleBuffer<TKey> dKeys(keys, mKeyBuffer.begin());
+
+		size_t tempBytes = 0;
+		if (payloads == nullptr)
+		{
+			cub::DeviceRadixSort::SortKeys(nullptr, tempBytes, dKeys, num);
+
+			if (mTemp.size() < tempBytes)
+				mTemp.resize(tempBytes);
+
+			cuSafeCall(cub::DeviceRadixSort::SortKeys(mTemp.begin(), tempBytes, dKeys, num));
+		}
+		else
+		{
+			if (mPayloadBuffer.size() < num)
+				mPayloadBuffer.resize(num);
+
+			cub::DoubleBuffer<uint> dPayloads(payloads, mPayloadBuffer.begin());
+
+			cub::DeviceRadixSort::SortPairs(nullptr, tempBytes, dKeys, dPayloads, num);
+
+			if (mTemp.size() < tempBytes)
+				mTemp.resize(tempBytes);
+
+			cuSafeCall(cub::DeviceRadixSort::SortPairs(mTemp.begin(), tempBytes, dKeys, dPayloads, num));
+
+			if (dPayloads.Current() != payloads)
+				cuSafeCall(cudaMemcpy(payloads, dPayloads.Current(), num * sizeof(uint), cudaMemcpyDeviceToDevice));
+		}
+
+		//cub may leave the result in either buffer
+		if (dKeys.Current() != keys)
+			cuSafeCall(cudaMemcpy(keys, dKeys.Current(), num * sizeof(TKey), cudaMemcpyDeviceToDevice));
+	}
+
+	template class Sort<int>;
+	template class Sort<uint>;
+	template class Sort<unsigned long>;
+	template class Sort<unsigned long long>;
+}
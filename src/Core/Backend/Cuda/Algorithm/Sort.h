@@ -0,0 +1,67 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Device radix sort built on cub::DeviceRadixSort.
+	 *
+	 * The temporary storage of cub and the double buffers are kept between calls and only grow,
+	 * 	reuse one instance for repeated sorts instead of calling thrust::sort_by_key.
+	 *
+	 * Supports int, uint and 64-bit unsigned keys. Values of 4 bytes are moved along with the keys,
+	 * 	values of other sizes are gathered through the sorted permutation.
+	 */
+	template<typename TKey>
+	class Sort
+	{
+	public:
+		Sort();
+		~Sort();
+
+		//The buffers are released in the destructor, copies would release them twice
+		Sort(const Sort&) = delete;
+		Sort& operator=(const Sort&) = delete;
+
+		void sort(TKey* keys, const uint num);
+		void sort(DArray<TKey>& keys);
+
+		/**
+		 * @brief Sort keys and reorder values of valueSize bytes accordingly
+		 */
+		void sortByKey(TKey* keys, void* values, const uint num, const size_t valueSize);
+
+		template<typename TValue>
+		void sortByKey(DArray<TKey>& keys, DArray<TValue>& values)
+		{
+			assert(keys.size() == values.size());
+			this->sortByKey(keys.begin(), values.begin(), keys.size(), sizeof(TValue));
+		}
+
+	private:
+		void radixSort(TKey* keys, uint* payloads, const uint num);
+
+		DArray<char> mTemp;
+
+		DArray<TKey> mKeyBuffer;
+		DArray<uint> mPayloadBuffer;
+
+		DArray<uint> mPermutation;
+		DArray<char> mValueBuffer;
+	};
+}
@@ -65,6 +65,11 @@ namespace dyno
 		void assign(const Array<T, DeviceType::CPU>& src);
 		void assign(const std::vector<T>& src);
 
+		/**
+		 * @brief Upload a HostArray, defined in Array/HostArray.h
+		 */
+		void assign(const HostArray<T>& src);
+
 		void assign(const Array<T, DeviceType::GPU>& src, const uint count, const uint dstOffset = 0, const uint srcOffset = 0);
 		void assign(const Array<T, DeviceType::CPU>& src, const uint count, const uint dstOffset = 0, const uint srcOffset = 0);
 		void assign(const std::vector<T>& src, const uint count, const uint dstOffset = 0, const uint srcOffset = 0);
@@ -83,6 +88,8 @@ namespace dyno
 		T* mData = nullptr;
 		uint mTotalNum = 0;
 		uint mBufferNum = 0;
+
+		Allocator* mAlloc = nullptr;
 	};
 	
 	template<typename T>
@@ -108,7 +115,8 @@ namespace dyno
 			mTotalNum = n; 	
 			mBufferNum = bound;
 
-			cuSafeCall(cudaMalloc(&mData, bound * sizeof(T)));
+			mAlloc = Allocator::device();
+			mData = (T*)mAlloc->allocate((size_t)bound * sizeof(T));
 		}
 		else
 			mTotalNum = n;
@@ -119,7 +127,7 @@ namespace dyno
 	{
 		if (mData != nullptr)
 		{
-			cuSafeCall(cudaFree((void*)mData));
+			mAlloc->deallocate((void*)mData, (size_t)mBufferNum * sizeof(T));
 		}
 
 		mData = nullptr;
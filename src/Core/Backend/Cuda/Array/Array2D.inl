@@ -3,7 +3,7 @@ namespace dyno {
 	template<typename T>
 	void Array2D<T, DeviceType::CPU>::assign(const Array2D<T, DeviceType::GPU>& src)
 	{
-		if (m_nx != src.size() || m_ny != src.size()) {
+		if (m_nx != src.nx() || m_ny != src.ny()) {
 			this->resize(src.nx(), src.ny());
 		}
 
@@ -84,6 +84,8 @@ namespace dyno {
 		uint m_ny = 0;
 		uint m_pitch = 0;
 		T* m_data = nullptr;
+
+		Allocator* m_alloc = nullptr;
 	};
 
 	template<typename T>
@@ -94,7 +96,11 @@ namespace dyno {
 	{
 		if (nullptr != m_data) clear();
 
-		cuSafeCall(cudaMallocPitch((void**)&m_data, (size_t*)&m_pitch, (size_t)sizeof(T) * nx, (size_t)ny));
+		//Align rows to 128 bytes for coalesced access, as cudaMallocPitch does
+		m_pitch = (uint)((sizeof(T) * nx + 127) / 128 * 128);
+
+		m_alloc = Allocator::device();
+		m_data = (T*)m_alloc->allocate((size_t)m_pitch * ny);
 		
 		m_nx = nx;	
 		m_ny = ny;
@@ -110,7 +116,7 @@ namespace dyno {
 	void Array2D<T, DeviceType::GPU>::clear()
 	{
 		if (m_data != nullptr)
-			cuSafeCall(cudaFree((void*)m_data));
+			m_alloc->deallocate((void*)m_data, (size_t)m_pitch * m_ny);
 
 		m_nx = 0;
 		m_ny = 0;
@@ -121,7 +127,7 @@ namespace dyno {
 	template<typename T>
 	void Array2D<T, DeviceType::GPU>::assign(const Array2D<T, DeviceType::GPU>& src)
 	{
-		if (m_nx != src.size() || m_ny != src.size()){
+		if (m_nx != src.nx() || m_ny != src.ny()){
 			this->resize(src.nx(), src.ny());
 		}
 
@@ -131,7 +137,7 @@ namespace dyno {
 	template<typename T>
 	void Array2D<T, DeviceType::GPU>::assign(const Array2D<T, DeviceType::CPU>& src)
 	{
-		if (m_nx != src.size() || m_ny != src.size()) {
+		if (m_nx != src.nx() || m_ny != src.ny()) {
 			this->resize(src.nx(), src.ny());
 		}
 
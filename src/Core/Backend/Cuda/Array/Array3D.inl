@@ -84,6 +84,8 @@ namespace dyno {
 		uint m_nz = 0;
 		uint m_nxy = 0;
 		T* m_data = nullptr;
+
+		Allocator* m_alloc = nullptr;
 	};
 
 	template<typename T>
@@ -99,7 +101,11 @@ namespace dyno {
 	{
 		if (NULL != m_data) clear();
 		
-		cuSafeCall(cudaMallocPitch((void**)&m_data, (size_t*)&m_pitch_x, (size_t)sizeof(T) * nx, (size_t)ny*nz));
+		//Align rows to 128 bytes for coalesced access, as cudaMallocPitch does
+		m_pitch_x = (uint)((sizeof(T) * nx + 127) / 128 * 128);
+
+		m_alloc = Allocator::device();
+		m_data = (T*)m_alloc->allocate((size_t)m_pitch_x * ny * nz);
 
 		//TODO: check whether it has problem when m_pitch_x is not divisible by sizeof(T)
 		m_nx = nx;	m_ny = ny;	m_nz = nz;	
@@ -115,7 +121,7 @@ namespace dyno {
 	template<typename T>
 	void Array3D<T, DeviceType::GPU>::clear()
 	{
-		if(m_data != nullptr) cuSafeCall(cudaFree(m_data));
+		if(m_data != nullptr) m_alloc->deallocate((void*)m_data, (size_t)m_nxy * m_nz);
 
 		m_data = nullptr;
 		m_nx = 0;
@@ -449,4 +449,261 @@ namespace dyno
 	template void parallel_init_for_map<46>(void* maps, void* elements, size_t ele_size, DArray<uint>& index);
 	template void parallel_init_for_map<47>(void* maps, void* elements, size_t ele_size, DArray<uint>& index);
 	template void parallel_init_for_map<48>(void* maps, void* elements, size_t ele_size, DArray<uint>& index);
-}
\ No newline at end of file
+
+	template<uint N>
+	__global__ void AT_CountList(
+		void* lists,
+		DArray<uint> counts)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= counts.size()) return;
+
+		List<SpaceHolder<N>> list = *((List<SpaceHolder<N>>*)lists + tId);
+		counts[tId] = list.size();
+	}
+
+	template<uint N>
+	void parallel_count_for_list(void* lists, DArray<uint>& counts)
+	{
+		uint pDims = cudaGridSize(counts.size(), BLOCK_SIZE);
+		AT_CountList<N> << <pDims, BLOCK_SIZE >> > (
+			lists,
+			counts);
+		cuSynchronize();
+	}
+
+	template void parallel_count_for_list<1>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<2>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<3>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<4>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<5>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<6>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<7>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<8>(void* lists, DArray<uint>& counts);
+
+	template void parallel_count_for_list<9>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<10>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<11>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<12>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<13>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<14>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<15>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<16>(void* lists, DArray<uint>& counts);
+
+	template void parallel_count_for_list<17>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<18>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<19>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<20>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<21>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<22>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<23>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<24>(void* lists, DArray<uint>& counts);
+
+	template void parallel_count_for_list<25>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<26>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<27>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<28>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<29>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<30>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<31>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<32>(void* lists, DArray<uint>& counts);
+
+	template void parallel_count_for_list<33>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<34>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<35>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<36>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<37>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<38>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<39>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<40>(void* lists, DArray<uint>& counts);
+
+	template void parallel_count_for_list<41>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<42>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<43>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<44>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<45>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<46>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<47>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<48>(void* lists, DArray<uint>& counts);
+
+	template void parallel_count_for_list<49>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<50>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<51>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<52>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<53>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<54>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<55>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<56>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<57>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<58>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<59>(void* lists, DArray<uint>& counts);
+	template void parallel_count_for_list<60>(void* lists, DArray<uint>& counts);
+
+	template<uint N>
+	__global__ void AT_CompactList(
+		void* elements,
+		void* lists,
+		DArray<uint> index)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId + 1 >= index.size()) return;
+
+		List<SpaceHolder<N>> list = *((List<SpaceHolder<N>>*)lists + tId);
+		SpaceHolder<N>* dst = (SpaceHolder<N>*)elements + index[tId];
+
+		for (uint i = 0; i < list.size(); i++)
+			dst[i] = list[i];
+	}
+
+	template<uint N>
+	void parallel_compact_for_list(void* elements, void* lists, DArray<uint>& index)
+	{
+		uint pDims = cudaGridSize(index.size(), BLOCK_SIZE);
+		AT_CompactList<N> << <pDims, BLOCK_SIZE >> > (
+			elements,
+			lists,
+			index);
+		cuSynchronize();
+	}
+
+	template void parallel_compact_for_list<1>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<2>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<3>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<4>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<5>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<6>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<7>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<8>(void* elements, void* lists, DArray<uint>& index);
+
+	template void parallel_compact_for_list<9>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<10>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<11>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<12>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<13>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<14>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<15>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<16>(void* elements, void* lists, DArray<uint>& index);
+
+	template void parallel_compact_for_list<17>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<18>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<19>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<20>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<21>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<22>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<23>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<24>(void* elements, void* lists, DArray<uint>& index);
+
+	template void parallel_compact_for_list<25>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<26>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<27>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<28>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<29>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<30>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<31>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<32>(void* elements, void* lists, DArray<uint>& index);
+
+	template void parallel_compact_for_list<33>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<34>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<35>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<36>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<37>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<38>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<39>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<40>(void* elements, void* lists, DArray<uint>& index);
+
+	template void parallel_compact_for_list<41>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<42>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<43>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<44>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<45>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<46>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<47>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<48>(void* elements, void* lists, DArray<uint>& index);
+
+	template void parallel_compact_for_list<49>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<50>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<51>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<52>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<53>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<54>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<55>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<56>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<57>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<58>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<59>(void* elements, void* lists, DArray<uint>& index);
+	template void parallel_compact_for_list<60>(void* elements, void* lists, DArray<uint>& index);
+
+	template<uint N>
+	__global__ void AT_ConvertTiled(
+		void* tiled,
+		void* linear,
+		size_t pitch,
+		size_t slice,
+		uint nx,
+		uint ny,
+		uint nz,
+		bool is3D,
+		bool toTiled)
+	{
+		uint i = threadIdx.x + (blockIdx.x * blockDim.x);
+		uint j = threadIdx.y + (blockIdx.y * blockDim.y);
+		uint k = threadIdx.z + (blockIdx.z * blockDim.z);
+
+		if (i >= nx || j >= ny || k >= nz) return;
+
+		size_t t = is3D ? tiledIndex3D(i, j, k, tileCount3D(nx), tileCount3D(ny)) : tiledIndex2D(i, j, tileCount2D(nx));
+
+		SpaceHolder<N>* tiledPtr = (SpaceHolder<N>*)tiled + t;
+		SpaceHolder<N>* linearPtr = (SpaceHolder<N>*)((char*)linear + j * pitch + k * slice) + i;
+
+		if (toTiled)
+			*tiledPtr = *linearPtr;
+		else
+			*linearPtr = *tiledPtr;
+	}
+
+	template<uint N>
+	void parallel_convert_tiled(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled)
+	{
+		if (is3D)
+		{
+			cuExecute3D(make_uint3(nx, ny, nz),
+				AT_ConvertTiled<N>,
+				tiled,
+				linear,
+				pitch,
+				slice,
+				nx,
+				ny,
+				nz,
+				is3D,
+				toTiled);
+		}
+		else
+		{
+			cuExecute2D(make_uint2(nx, ny),
+				AT_ConvertTiled<N>,
+				tiled,
+				linear,
+				pitch,
+				slice,
+				nx,
+				ny,
+				1,
+				is3D,
+				toTiled);
+		}
+	}
+
+	//Element sizes of the scalars and vectors stored in grids
+	template void parallel_convert_tiled<1>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<2>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<4>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<8>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<12>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<16>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<24>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<32>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<48>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+	template void parallel_convert_tiled<64>(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
+}
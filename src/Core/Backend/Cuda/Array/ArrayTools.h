@@ -15,6 +15,7 @@
  */
 #pragma once
 #include "Array/Array.h"
+#include "Array/Tiling.h"
 
 namespace dyno
 {
@@ -24,9 +25,28 @@ namespace dyno
 	template<uint N>
 	void parallel_init_for_list(void* lists, void* elements, size_t ele_size, DArray<uint>& index);
 
+	/**
+	 * @brief Write the number of inserted elements of each list into counts, N is the element size
+	 */
+	template<uint N>
+	void parallel_count_for_list(void* lists, DArray<uint>& counts);
+
+	/**
+	 * @brief Copy the inserted elements of list i to elements + index[i], index holds one more entry than the number of lists
+	 */
+	template<uint N>
+	void parallel_compact_for_list(void* elements, void* lists, DArray<uint>& index);
+
 	template<uint N>
 	void parallel_allocate_for_map(void* maps, void* elements, size_t ele_size, DArray<uint>& index);
 
 	template<uint N>
 	void parallel_init_for_map(void* maps, void* elements, size_t ele_size, DArray<uint>& index);
+
+	/**
+	 * @brief Convert between a pitched linear grid and the tiled layout of Array/Tiling.h, N is the element size.
+	 * 	For 2D grids, set is3D to false and nz to 1.
+	 */
+	template<uint N>
+	void parallel_convert_tiled(void* tiled, void* linear, size_t pitch, size_t slice, uint nx, uint ny, uint nz, bool is3D, bool toTiled);
 }
\ No newline at end of file
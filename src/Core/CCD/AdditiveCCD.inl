@@ -14,7 +14,7 @@ namespace dyno
 	DYN_FUNC T getPoint2SegmentDistance( const Vector<T,3> &p, const Vector<T,3>& v0, const Vector<T,3>& v1){
 		T d0 = (p - v0).norm();
 		T d1 = (p - v1).norm();
-		T dv = min(d0, d1);
+		T dv = minimum(d0, d1);
 		if ((v1 - v0).norm() < 1e-7) return dv; //v0 = v1
 
 		Vector<T, 3> dir = (v0 - v1)/(v0-v1).norm();
@@ -53,7 +53,7 @@ namespace dyno
 		Vector<T, 3> y01 = y1 - y0;
 		Vector<T, 3> y12 = y2 - y1;
 		Vector<T, 3> n = y01.cross(y12); //norm of plane
-		T minLine = min(min(getPoint2SegmentDistance(x, y0, y1), getPoint2SegmentDistance(x, y1, y2)),
+		T minLine = minimum(minimum(getPoint2SegmentDistance(x, y0, y1), getPoint2SegmentDistance(x, y1, y2)),
 			getPoint2SegmentDistance(x, y2, y0));
 		if (n.norm() < 1e-6) // in line
 			return minLine;
@@ -88,7 +88,7 @@ namespace dyno
 		T b0 = e0.dot(d);
 		T b1 = e1.dot(d);
 		T f = d.dot(d);
-		T det = max(a00 * a11 - a01 * a01, 0.0);
+		T det = maximum(a00 * a11 - a01 * a01, T(0));
 		T s = a01 * b1 - a11 * b0;
 		T t = a01 * b0 - a00 * b1;
 		if (s + t <= det) {
@@ -339,7 +339,7 @@ namespace dyno
 						//reigon 7
 						t = 0.0;
 						nd = -d;
-						if (REAL_LESS(nd, 0.0) || REAL_EQUAL(0.0)) {
+						if (REAL_LESS(nd, 0.0) || REAL_EQUAL(nd, 0.0)) {
 							s = 0.0;
 						}
 						else if(REAL_GREAT(nd,a)||REAL_EQUAL(nd,a)){
@@ -484,7 +484,7 @@ namespace dyno
 		for (int i = 0; i < 4; ++i) {
 			p[i] -= p_bar;
 		}
-		T lp = max(max(p[0].norm(), p[1].norm()), p[2].norm()) + p[3].norm();
+		T lp = maximum(maximum(p[0].norm(), p[1].norm()), p[2].norm()) + p[3].norm();
 		if (lp == 0.0) return false;
 		T dsqr = SquareDistanceVF(x[0], x[1], x[2], x[3]);
 		//printf("dsqrVF:%f\n", sqrt(dsqr));
@@ -548,8 +548,8 @@ namespace dyno
 			p[i] -= p_bar;
 		}
 
-		T lp =	max(p[0].norm(), p[1].norm()) +
-				max(p[2].norm(), p[3].norm());
+		T lp =	maximum(p[0].norm(), p[1].norm()) +
+				maximum(p[2].norm(), p[3].norm());
 
 		if (lp ==0.0) return false;
 
@@ -679,8 +679,8 @@ namespace dyno
 				ret |= collided;
 			}
 		}
-		toi = max(toi, 0.0);
-		toi = min(toi, 1.0);
+		toi = maximum(toi, Real(0));
+		toi = minimum(toi, Real(1));
 		return ret;
 	}
 
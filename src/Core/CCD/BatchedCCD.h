@@ -0,0 +1,113 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Vector.h"
+#include "Array/Array.h"
+#include "TightCCD.h"
+#include "AdditiveCCD.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Candidate pairs of BatchedCCD, given as indices into the vertex arrays
+	 */
+	typedef Vector<uint, 4> VertexFacePair;		// vertex, followed by the three vertices of the triangle
+	typedef Vector<uint, 4> EdgeEdgePair;		// two vertices of the first edge, followed by two vertices of the second edge
+
+	/**
+	 * @brief Continuous collision detection for arrays of vertex-face and edge-edge candidates in host memory.
+	 *
+	 * Each candidate first goes through conservative filters, a swept AABB test and, for TightCCD, a sign test on the Bernstein
+	 * 	coefficients of the coplanarity cubic. Only the survivors run the exact per-pair test of TightCCD or AdditiveCCD.
+	 * 	Candidates are processed in parallel by the ThreadPool, the earliest time of impact is reported per pair and per vertex.
+	 */
+	template<typename T>
+	class BatchedCCD
+	{
+	public:
+		typedef Vector<T, 3> Coord;
+
+		enum Method
+		{
+			TIGHT,
+			ADDITIVE
+		};
+
+		struct Statistics
+		{
+			size_t pairs = 0;
+			size_t culledByBounds = 0;		// rejected by the swept AABB test
+			size_t culledBySign = 0;		// rejected by the coplanarity sign test
+			size_t collisions = 0;
+		};
+
+		BatchedCCD(Method method = TIGHT);
+
+		void setMethod(Method method) { mMethod = method; }
+		Method method() const { return mMethod; }
+
+		/**
+		 * @brief Parameters of AdditiveCCD, the thickness also widens the swept AABBs
+		 */
+		void setAdditiveParameters(T thickness, T s, T tc);
+
+		/**
+		 * @brief Turn the conservative filters on or off, mostly for benchmarking
+		 */
+		void setFilters(bool bounds, bool sign) { mBoundsFilter = bounds; mSignFilter = sign; }
+
+		/**
+		 * @brief Test the vertex-face candidates moving linearly from x0 to x1.
+		 *
+		 * @param pairToi time of impact of each pair, 1 if no collision, can be nullptr
+		 * @param vertexToi one entry per vertex, only lowered so that several calls can accumulate into it, can be nullptr
+		 */
+		void vertexFace(const Coord* x0, const Coord* x1, const VertexFacePair* pairs, size_t num, T* pairToi, T* vertexToi);
+
+		void edgeEdge(const Coord* x0, const Coord* x1, const EdgeEdgePair* pairs, size_t num, T* pairToi, T* vertexToi);
+
+		/**
+		 * @brief pairToi is resized to the number of pairs, vertexToi is reset to 1 if its size does not match x0
+		 */
+		void vertexFace(const CArray<Coord>& x0, const CArray<Coord>& x1, const CArray<VertexFacePair>& pairs, CArray<T>& pairToi, CArray<T>& vertexToi);
+
+		void edgeEdge(const CArray<Coord>& x0, const CArray<Coord>& x1, const CArray<EdgeEdgePair>& pairs, CArray<T>& pairToi, CArray<T>& vertexToi);
+
+		/**
+		 * @brief Counters accumulated over all calls since the last resetStatistics()
+		 */
+		const Statistics& statistics() const { return mStatistics; }
+		void resetStatistics() { mStatistics = Statistics(); }
+
+	private:
+		template<bool isVF>
+		void detect(const Coord* x0, const Coord* x1, const Vector<uint, 4>* pairs, size_t num, T* pairToi, T* vertexToi);
+
+		Method mMethod;
+
+		AdditiveCCD<T> mAdditive;
+		T mThickness = T(0);
+
+		bool mBoundsFilter = true;
+		bool mSignFilter = true;
+
+		Statistics mStatistics;
+
+		CArray<T> mToi;
+	};
+}
+
+#include "BatchedCCD.inl"
@@ -0,0 +1,262 @@
+#include "ThreadPool.h"
+
+#include <atomic>
+
+namespace dyno
+{
+#define BCCD_GRAIN_SIZE 256
+
+	template<typename T>
+	inline void BCCD_Expand(Vector<T, 3>& lo, Vector<T, 3>& hi, const Vector<T, 3>& p)
+	{
+		lo = lo.minimum(p);
+		hi = hi.maximum(p);
+	}
+
+	/**
+	 * @brief Whether the boxes swept by the primitives {p[0], ..., p[n - 1]} and {p[n], ..., p[3]} overlap, p at t0 and q at t1
+	 */
+	template<typename T, int n>
+	inline bool BCCD_SweptBoundsOverlap(const Vector<T, 3> p[4], const Vector<T, 3> q[4], T margin)
+	{
+		Vector<T, 3> lo0 = p[0], hi0 = p[0];
+		Vector<T, 3> lo1 = p[n], hi1 = p[n];
+		for (int i = 0; i < 4; i++)
+		{
+			if (i < n)
+			{
+				BCCD_Expand(lo0, hi0, p[i]);
+				BCCD_Expand(lo0, hi0, q[i]);
+			}
+			else
+			{
+				BCCD_Expand(lo1, hi1, p[i]);
+				BCCD_Expand(lo1, hi1, q[i]);
+			}
+		}
+
+		for (int k = 0; k < 3; k++)
+		{
+			if (lo0[k] > hi1[k] + margin || lo1[k] > hi0[k] + margin)
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Conservative test whether the four points moving linearly from p to q can be coplanar within [0, 1].
+	 *
+	 * The volume spanned by the points is the cubic of CollisionTest(), it has no root in [0, 1] if its Bernstein coefficients
+	 * 	share a strict sign.
+	 */
+	template<typename T>
+	inline bool BCCD_MayBeCoplanar(const Vector<T, 3> p[4], const Vector<T, 3> q[4])
+	{
+		Vector<T, 3> x1 = p[1] - p[0], x2 = p[2] - p[0], x3 = p[3] - p[0];
+		Vector<T, 3> v1 = q[1] - q[0] - x1, v2 = q[2] - q[0] - x2, v3 = q[3] - q[0] - x3;
+
+		T a0 = STP(x1, x2, x3);
+		T a1 = STP(v1, x2, x3) + STP(x1, v2, x3) + STP(x1, x2, v3);
+		T a2 = STP(x1, v2, v3) + STP(v1, x2, v3) + STP(v1, v2, x3);
+		T a3 = STP(v1, v2, v3);
+
+		T b[4];
+		b[0] = a0;
+		b[1] = a0 + a1 / T(3);
+		b[2] = a0 + T(2) * a1 / T(3) + a2 / T(3);
+		b[3] = a0 + a1 + a2 + a3;
+
+		//Leave some room for the rounding errors of the root finder in the exact test
+		T eps = T(1e-6) * (glm::abs(a0) + glm::abs(a1) + glm::abs(a2) + glm::abs(a3));
+
+		bool positive = b[0] > eps && b[1] > eps && b[2] > eps && b[3] > eps;
+		bool negative = b[0] < -eps && b[1] < -eps && b[2] < -eps && b[3] < -eps;
+
+		return !(positive || negative);
+	}
+
+	template<typename T>
+	BatchedCCD<T>::BatchedCCD(Method method)
+		: mMethod(method)
+	{
+	}
+
+	template<typename T>
+	void BatchedCCD<T>::setAdditiveParameters(T thickness, T s, T tc)
+	{
+		mAdditive = AdditiveCCD<T>(thickness, s, tc);
+		mThickness = thickness;
+	}
+
+	template<typename T>
+	void BatchedCCD<T>::vertexFace(const Coord* x0, const Coord* x1, const VertexFacePair* pairs, size_t num, T* pairToi, T* vertexToi)
+	{
+		detect<true>(x0, x1, pairs, num, pairToi, vertexToi);
+	}
+
+	template<typename T>
+	void BatchedCCD<T>::edgeEdge(const Coord* x0, const Coord* x1, const EdgeEdgePair* pairs, size_t num, T* pairToi, T* vertexToi)
+	{
+		detect<false>(x0, x1, pairs, num, pairToi, vertexToi);
+	}
+
+	template<typename T>
+	void BatchedCCD<T>::vertexFace(const CArray<Coord>& x0, const CArray<Coord>& x1, const CArray<VertexFacePair>& pairs, CArray<T>& pairToi, CArray<T>& vertexToi)
+	{
+		assert(x0.size() == x1.size());
+
+		pairToi.resize(pairs.size());
+		if (vertexToi.size() != x0.size())
+		{
+			vertexToi.resize(x0.size());
+			for (uint i = 0; i < vertexToi.size(); i++)
+				vertexToi[i] = T(1);
+		}
+
+		detect<true>(x0.begin(), x1.begin(), pairs.begin(), pairs.size(), pairToi.begin(), vertexToi.begin());
+	}
+
+	template<typename T>
+	void BatchedCCD<T>::edgeEdge(const CArray<Coord>& x0, const CArray<Coord>& x1, const CArray<EdgeEdgePair>& pairs, CArray<T>& pairToi, CArray<T>& vertexToi)
+	{
+		assert(x0.size() == x1.size());
+
+		pairToi.resize(pairs.size());
+		if (vertexToi.size() != x0.size())
+		{
+			vertexToi.resize(x0.size());
+			for (uint i = 0; i < vertexToi.size(); i++)
+				vertexToi[i] = T(1);
+		}
+
+		detect<false>(x0.begin(), x1.begin(), pairs.begin(), pairs.size(), pairToi.begin(), vertexToi.begin());
+	}
+
+	template<typename T>
+	template<bool isVF>
+	void BatchedCCD<T>::detect(const Coord* x0, const Coord* x1, const Vector<uint, 4>* pairs, size_t num, T* pairToi, T* vertexToi)
+	{
+		if (num == 0)
+			return;
+
+		if (pairToi == nullptr)
+		{
+			if (mToi.size() < num)
+				mToi.resize(num);
+			pairToi = mToi.begin();
+		}
+
+		std::atomic<size_t> culledByBounds(0);
+		std::atomic<size_t> culledBySign(0);
+		std::atomic<size_t> collisions(0);
+
+		//Vertex-face: the vertex against the triangle, edge-edge: the first edge against the second one
+		const int n = isVF ? 1 : 2;
+		T margin = mMethod == ADDITIVE ? mThickness : T(0);
+
+		ThreadPool::instance()->parallelFor(0, (unsigned int)num, [&](unsigned int first, unsigned int last) {
+			size_t nBounds = 0, nSign = 0, nCollisions = 0;
+
+			AdditiveCCD<T> additive = mAdditive;
+
+			for (unsigned int i = first; i < last; i++)
+			{
+				const Vector<uint, 4>& pair = pairs[i];
+
+				Coord p[4], q[4];
+				for (int k = 0; k < 4; k++)
+				{
+					p[k] = x0[pair[k]];
+					q[k] = x1[pair[k]];
+				}
+
+				pairToi[i] = T(1);
+
+				if (mBoundsFilter && !BCCD_SweptBoundsOverlap<T, n>(p, q, margin))
+				{
+					nBounds++;
+					continue;
+				}
+
+				if (mMethod == TIGHT)
+				{
+					if (mSignFilter && !BCCD_MayBeCoplanar(p, q))
+					{
+						nSign++;
+						continue;
+					}
+
+					T time = T(1);
+					bool collided = isVF ?
+						TightCCD<T>::VertexFaceCCD(p[0], p[1], p[2], p[3], q[0], q[1], q[2], q[3], time) :
+						TightCCD<T>::EdgeEdgeCCD(p[0], p[1], p[2], p[3], q[0], q[1], q[2], q[3], time);
+
+					if (collided)
+					{
+						pairToi[i] = time;
+						nCollisions++;
+					}
+				}
+				else
+				{
+					//Normalize by the longest edge as in AdditiveCCD::TriangleCCD()
+					const int vfEdges[3][2] = { { 1, 2 }, { 2, 3 }, { 3, 1 } };
+					const int eeEdges[2][2] = { { 0, 1 }, { 2, 3 } };
+
+					T lmax = T(0);
+					for (int e = 0; e < (isVF ? 3 : 2); e++)
+					{
+						int a = isVF ? vfEdges[e][0] : eeEdges[e][0];
+						int b = isVF ? vfEdges[e][1] : eeEdges[e][1];
+						lmax = maximum(lmax, maximum((p[a] - p[b]).norm(), (q[a] - q[b]).norm()));
+					}
+
+					if (lmax < REAL_EPSILON)
+						continue;
+
+					T invL = T(1) / lmax;
+					for (int k = 0; k < 4; k++)
+					{
+						p[k] *= invL;
+						q[k] *= invL;
+					}
+
+					T time = T(1);
+					bool collided = isVF ?
+						additive.VertexFaceCCD(p[1], p[2], p[3], p[0], q[1], q[2], q[3], q[0], time, invL) :
+						additive.EdgeEdgeCCD(p[0], p[1], p[2], p[3], q[0], q[1], q[2], q[3], time, invL);
+
+					if (collided)
+					{
+						pairToi[i] = minimum(maximum(time, T(0)), T(1));
+						nCollisions++;
+					}
+				}
+			}
+
+			culledByBounds += nBounds;
+			culledBySign += nSign;
+			collisions += nCollisions;
+		}, BCCD_GRAIN_SIZE);
+
+		//Collisions are rare, a sequential pass is cheaper than atomics on every vertex
+		if (vertexToi != nullptr && collisions > 0)
+		{
+			for (size_t i = 0; i < num; i++)
+			{
+				T t = pairToi[i];
+				if (t < T(1))
+				{
+					for (int k = 0; k < 4; k++)
+						vertexToi[pairs[i][k]] = minimum(vertexToi[pairs[i][k]], t);
+				}
+			}
+		}
+
+		mStatistics.pairs += num;
+		mStatistics.culledByBounds += culledByBounds;
+		mStatistics.culledBySign += culledBySign;
+		mStatistics.collisions += collisions;
+	}
+}
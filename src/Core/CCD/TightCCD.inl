@@ -140,7 +140,12 @@ namespace dyno
 	template<typename T>
 	inline DYN_FUNC	int SolveCubic(T a, T b, T c, T d, T x[3])
 	{
-		T xc[2];
+		// the derivative is degenerate when a and b vanish, solve the lower order equation directly
+		// instead of starting Newton's method from an unset critical point
+		if (a == 0)
+			return SolveQuadratic(b, c, d, x);
+
+		T xc[2] = { 0, 0 };
 		int ncrit = SolveQuadratic(3 * a, 2 * b, c, xc);
 		if (ncrit == 0) {
 			x[0] = NewtonsMethod(a, b, c, d, xc[0], 0);
@@ -156,7 +161,7 @@ namespace dyno
 			if (yc[0] * a >= 0)
 				x[i++] = NewtonsMethod(a, b, c, d, xc[0], -1);
 			if (yc[0] * yc[1] <= 0) {
-				int closer = abs(yc[0]) < abs(yc[1]) ? 0 : 1;
+				int closer = glm::abs(yc[0]) < glm::abs(yc[1]) ? 0 : 1;
 				x[i++] = NewtonsMethod(a, b, c, d, xc[closer], closer == 0 ? 1 : -1);
 			}
 			if (yc[1] * a <= 0)
@@ -176,7 +181,7 @@ namespace dyno
 		T a2 = STP(x1, v2, v3) + STP(v1, x2, v3) + STP(v1, v2, x3);
 		T a3 = STP(v1, v2, v3);
 
-		if (REAL_EQUAL(a1, 0) && REAL_EQUAL(a2, 0) && REAL_EQUAL(a1, 0))
+		if (REAL_EQUAL(a1, 0) && REAL_EQUAL(a2, 0) && REAL_EQUAL(a3, 0))
 		//if (a1 == 0 && a2 == 0 && a3 == 0)
 			return false;
 
@@ -52,8 +52,9 @@ namespace dyno
 		return w0 * array1d[i0] + w1 * array1d[i1];
 	};
 
-	template<typename T, DeviceType deviceType>
-	DYN_FUNC T bilinear(Array2D<T, deviceType>& array2d, float x, float y, LerpMode mode = LerpMode::REPEAT)
+	//Grid is either Array2D or ArrayTiled2D
+	template<typename T, DeviceType deviceType, template<typename, DeviceType> class Grid>
+	DYN_FUNC T bilinear(Grid<T, deviceType>& array2d, float x, float y, LerpMode mode = LerpMode::REPEAT)
 	{
 		const uint nx = array2d.nx();
 		const uint ny = array2d.ny();
@@ -82,7 +83,7 @@ namespace dyno
 	};
 
 	template<typename T, DeviceType deviceType>
-	DYN_FUNC T trilinear(Array3D<T, deviceType>& array3d, float x, float y, LerpMode mode = LerpMode::REPEAT)
+	DYN_FUNC T trilinear(Array3D<T, deviceType>& array3d, float x, float y, float z, LerpMode mode = LerpMode::REPEAT)
 	{
 		const uint nx = array3d.nx();
 		const uint ny = array3d.ny();
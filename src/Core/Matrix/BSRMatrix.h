@@ -0,0 +1,88 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+#include "Matrix.h"
+#include "LinearOperator.h"
+
+namespace dyno
+{
+	/**
+	 * @brief A sparse matrix made of 3x3 blocks in block compressed sparse row (BSR) format stored in device memory.
+	 *
+	 * Suited to systems coupling 3D vectors, e.g. the implicit integration of particles or vertices. Rows and columns count blocks,
+	 * 	the scalar dimension is three times the number of block rows. Assembly works as in CSRMatrix, blocks sharing the same position are summed.
+	 */
+	template<typename Real>
+	class BSRMatrix : public LinearOperator<Real>
+	{
+	public:
+		typedef Vector<Real, 3> Coord;
+		typedef SquareMatrix<Real, 3> Block;
+
+		BSRMatrix() {};
+
+		/*!
+		*	\brief	Do not release memory here, call clear() explicitly.
+		*/
+		~BSRMatrix() override {};
+
+		void clear();
+
+		/**
+		 * @brief Build a matrix of rows x cols blocks from block triplets, blocks sharing the same position are summed
+		 */
+		void assemble(uint rows, uint cols, const DArray<uint>& rowIds, const DArray<uint>& colIds, const DArray<Block>& blocks);
+
+		/**
+		 * @brief y = A * x, parallel over the block rows
+		 */
+		void multiply(DArray<Coord>& y, const DArray<Coord>& x) const;
+
+		/**
+		 * @brief y = A * x on flattened vectors of 3 * rows() scalars
+		 */
+		void multiply(DArray<Real>& y, const DArray<Real>& x) const;
+
+		void diagonal(DArray<Block>& diag) const;
+
+		uint dimension() const override { return 3 * mRows; }
+		void apply(DArray<Real>& y, const DArray<Real>& x) const override { this->multiply(y, x); }
+
+		uint rows() const { return mRows; }
+		uint cols() const { return mCols; }
+		uint nonZeroBlocks() const { return mBlocks.size(); }
+
+		const DArray<uint>& rowOffsets() const { return mRowOffsets; }
+		const DArray<uint>& columns() const { return mColumns; }
+
+		const DArray<Block>& blocks() const { return mBlocks; }
+		DArray<Block>& blocks() { return mBlocks; }
+
+		/*!
+		*	\brief	To avoid erroneous shallow copy.
+		*/
+		BSRMatrix<Real>& operator=(const BSRMatrix<Real>&) = delete;
+
+	private:
+		uint mRows = 0;
+		uint mCols = 0;
+
+		DArray<uint> mRowOffsets;
+		DArray<uint> mColumns;
+		DArray<Block> mBlocks;
+	};
+}
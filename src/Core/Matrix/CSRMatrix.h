@@ -0,0 +1,84 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+#include "LinearOperator.h"
+
+namespace dyno
+{
+	/**
+	 * @brief A sparse matrix in compressed sparse row (CSR) format stored in device memory.
+	 *
+	 * The matrix is assembled from unsorted (row, column, value) triplets with a radix sort, entries sharing the same position are summed.
+	 * 	Columns are sorted within every row. Once the pattern is fixed, values() can be refilled in place for the next step.
+	 */
+	template<typename Real>
+	class CSRMatrix : public LinearOperator<Real>
+	{
+	public:
+		CSRMatrix() {};
+
+		/*!
+		*	\brief	Do not release memory here, call clear() explicitly.
+		*/
+		~CSRMatrix() override {};
+
+		void clear();
+
+		/**
+		 * @brief Build a rows x cols matrix from triplets, entries sharing the same position are summed
+		 */
+		void assemble(uint rows, uint cols, const DArray<uint>& rowIds, const DArray<uint>& colIds, const DArray<Real>& values);
+
+		/**
+		 * @brief Upload a matrix given in CSR format, rowOffsets has one more element than the number of rows
+		 */
+		void assign(uint cols, const CArray<uint>& rowOffsets, const CArray<uint>& columns, const CArray<Real>& values);
+
+		/**
+		 * @brief y = A * x, parallel over the rows
+		 */
+		void multiply(DArray<Real>& y, const DArray<Real>& x) const;
+
+		void diagonal(DArray<Real>& diag) const;
+
+		uint dimension() const override { return mRows; }
+		void apply(DArray<Real>& y, const DArray<Real>& x) const override { this->multiply(y, x); }
+
+		uint rows() const { return mRows; }
+		uint cols() const { return mCols; }
+		uint nonZeros() const { return mValues.size(); }
+
+		const DArray<uint>& rowOffsets() const { return mRowOffsets; }
+		const DArray<uint>& columns() const { return mColumns; }
+
+		const DArray<Real>& values() const { return mValues; }
+		DArray<Real>& values() { return mValues; }
+
+		/*!
+		*	\brief	To avoid erroneous shallow copy.
+		*/
+		CSRMatrix<Real>& operator=(const CSRMatrix<Real>&) = delete;
+
+	private:
+		uint mRows = 0;
+		uint mCols = 0;
+
+		DArray<uint> mRowOffsets;
+		DArray<uint> mColumns;
+		DArray<Real> mValues;
+	};
+}
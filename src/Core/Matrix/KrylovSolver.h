@@ -0,0 +1,124 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "LinearOperator.h"
+#include "Preconditioner.h"
+
+#include "Algorithm/Reduction.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Base class of the Krylov subspace solvers for A * x = b.
+	 *
+	 * solve() starts from the content of x if its size matches b (warm start), from zero otherwise. Iterations stop once the residual
+	 * 	norm drops below max(tolerance * |b|, absoluteTolerance) or maxIterations is reached. The work vectors are kept between calls.
+	 */
+	template<typename Real>
+	class KrylovSolver
+	{
+	public:
+		KrylovSolver() {};
+		virtual ~KrylovSolver();
+
+		void setMaxIterations(uint n) { mMaxIterations = n; }
+		void setTolerance(Real tol) { mTolerance = tol; }
+		void setAbsoluteTolerance(Real tol) { mAbsoluteTolerance = tol; }
+
+		/**
+		 * @brief The preconditioner is not owned by the solver, nullptr disables preconditioning
+		 */
+		void setPreconditioner(Preconditioner<Real>* precond) { mPreconditioner = precond; }
+
+		/**
+		 * @return true if the stopping criterion is met
+		 */
+		virtual bool solve(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b) = 0;
+
+		uint iterations() const { return mIterations; }
+
+		/**
+		 * @brief Residual norm at the end of the last solve
+		 */
+		Real residual() const { return mResidual; }
+
+	protected:
+		Real dot(const DArray<Real>& a, const DArray<Real>& b);
+		Real norm(const DArray<Real>& a);
+
+		/**
+		 * @brief Resize the work vectors and x, and compute r = b - A * x
+		 */
+		void initialize(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b, DArray<Real>& r);
+
+		void precondition(DArray<Real>& z, const DArray<Real>& r);
+
+		bool converged(Real rNorm, Real bNorm) const;
+
+		/**
+		 * @brief Get the i-th work vector of size n
+		 */
+		DArray<Real>& vector(uint i, uint n);
+
+		uint mMaxIterations = 1000;
+		Real mTolerance = Real(1e-6);
+		Real mAbsoluteTolerance = Real(0);
+
+		uint mIterations = 0;
+		Real mResidual = Real(0);
+
+		Preconditioner<Real>* mPreconditioner = nullptr;
+
+	private:
+		static const uint WORK_VECTOR_NUM = 8;
+
+		DArray<Real> mVectors[WORK_VECTOR_NUM];
+		DArray<Real> mProduct;
+
+		Reduction<Real> mReduce;
+	};
+
+	/**
+	 * @brief Preconditioned conjugate gradient for symmetric positive definite systems
+	 */
+	template<typename Real>
+	class ConjugateGradient : public KrylovSolver<Real>
+	{
+	public:
+		bool solve(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b) override;
+	};
+
+	/**
+	 * @brief Preconditioned MINRES for symmetric, possibly indefinite systems, the preconditioner must be symmetric positive definite.
+	 * 	Iterations stop on the recurrence estimate of the preconditioned residual norm.
+	 */
+	template<typename Real>
+	class MINRES : public KrylovSolver<Real>
+	{
+	public:
+		bool solve(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b) override;
+	};
+
+	/**
+	 * @brief Right preconditioned BiCGSTAB for general nonsymmetric systems
+	 */
+	template<typename Real>
+	class BiCGSTAB : public KrylovSolver<Real>
+	{
+	public:
+		bool solve(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b) override;
+	};
+}
@@ -0,0 +1,38 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Array/Array.h"
+
+namespace dyno
+{
+	/**
+	 * @brief A square linear map y = A * x over device vectors, the interface accepted by the Krylov solvers
+	 */
+	template<typename Real>
+	class LinearOperator
+	{
+	public:
+		LinearOperator() {};
+		virtual ~LinearOperator() {};
+
+		/**
+		 * @brief Length of the vectors the operator is applied to
+		 */
+		virtual uint dimension() const = 0;
+
+		virtual void apply(DArray<Real>& y, const DArray<Real>& x) const = 0;
+	};
+}
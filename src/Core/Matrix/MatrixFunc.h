@@ -4,10 +4,10 @@
 
 namespace dyno
 {
-#ifdef CUDA_BACKEND
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
 	template<typename Real, int Dim>
 	DYN_FUNC void polarDecomposition(const SquareMatrix<Real, Dim>& A, SquareMatrix<Real, Dim>& R, SquareMatrix<Real, Dim>& U, SquareMatrix<Real, Dim>& D, SquareMatrix<Real, Dim>& V);
-#endif // CUDA_BACKEND
+#endif // CUDA_BACKEND || CPU_BACKEND
 
 	template<typename Real, int Dim>
 	DYN_FUNC void polarDecomposition(const SquareMatrix<Real, Dim> &A, SquareMatrix<Real, Dim> &R, SquareMatrix<Real, Dim> &U, SquareMatrix<Real, Dim> &D);
@@ -5,6 +5,10 @@
 	#include "SparseMatrix/svd3_cuda.h"
 #endif // CUDA_BACKEND
 
+#ifdef CPU_BACKEND
+	#include "Algorithm/HostSVD.h"
+#endif // CPU_BACKEND
+
 namespace dyno
 {
 	template<typename Real>
@@ -220,6 +224,29 @@ namespace dyno
 		*/
 
 	}
+#elif defined(CPU_BACKEND)
+	template<typename Real>
+	void polarDecomposition(const SquareMatrix<Real, 3> &A, SquareMatrix<Real, 3> &R, SquareMatrix<Real, 3> &U, SquareMatrix<Real, 3> &D, SquareMatrix<Real, 3> &V)
+	{
+		// Same single precision decomposition as the CUDA version, U and V are rotations so that R = U * V^T
+		Mat3f a, r, u, d, v;
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				a(i, j) = (float)A(i, j);
+
+		HostSVD::polarDecomposition(&a, &r, &u, &d, &v, 1, simd::ISA_SCALAR);
+
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				R(i, j) = r(i, j);
+				U(i, j) = u(i, j);
+				D(i, j) = d(i, j);
+				V(i, j) = v(i, j);
+			}
+		}
+	}
 #endif
 
 	template<typename Real>
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <vector>
+
+#include "CSRMatrix.h"
+#include "BSRMatrix.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Approximates the inverse of a matrix, z = M^-1 * r
+	 */
+	template<typename Real>
+	class Preconditioner
+	{
+	public:
+		Preconditioner() {};
+		virtual ~Preconditioner() {};
+
+		virtual void apply(DArray<Real>& z, const DArray<Real>& r) = 0;
+	};
+
+	/**
+	 * @brief Scales by the inverse diagonal, zero diagonal entries are left untouched
+	 */
+	template<typename Real>
+	class JacobiPreconditioner : public Preconditioner<Real>
+	{
+	public:
+		JacobiPreconditioner() {};
+		~JacobiPreconditioner() override;
+
+		void update(const CSRMatrix<Real>& A);
+		void update(const BSRMatrix<Real>& A);
+
+		void apply(DArray<Real>& z, const DArray<Real>& r) override;
+
+	private:
+		DArray<Real> mInvDiag;
+		DArray<typename BSRMatrix<Real>::Block> mBlocks;
+	};
+
+	/**
+	 * @brief Multiplies every 3D component by the inverse of its 3x3 diagonal block of a BSRMatrix
+	 */
+	template<typename Real>
+	class BlockJacobiPreconditioner : public Preconditioner<Real>
+	{
+	public:
+		BlockJacobiPreconditioner() {};
+		~BlockJacobiPreconditioner() override;
+
+		void update(const BSRMatrix<Real>& A);
+
+		void apply(DArray<Real>& z, const DArray<Real>& r) override;
+
+	private:
+		DArray<typename BSRMatrix<Real>::Block> mInvBlocks;
+	};
+
+	/**
+	 * @brief Zero fill-in incomplete Cholesky factorization A ~ L * L^T of a symmetric positive definite CSRMatrix.
+	 *
+	 * The factorization is computed on the host whenever update() is called. The two triangular solves of apply() run in parallel
+	 * 	level by level, every level holding the rows whose dependencies are solved by the previous levels. A diagonal shift is added
+	 * 	and the factorization restarted if a pivot is not positive.
+	 */
+	template<typename Real>
+	class IncompleteCholeskyPreconditioner : public Preconditioner<Real>
+	{
+	public:
+		IncompleteCholeskyPreconditioner() {};
+		~IncompleteCholeskyPreconditioner() override;
+
+		void update(const CSRMatrix<Real>& A);
+
+		void apply(DArray<Real>& z, const DArray<Real>& r) override;
+
+	private:
+		struct Triangle
+		{
+			DArray<uint> offsets;
+			DArray<uint> columns;
+			DArray<Real> values;
+
+			//Rows sorted by level, the rows of level l are in [levels[l], levels[l + 1])
+			DArray<uint> rows;
+			std::vector<uint> levels;
+
+			void clear();
+		};
+
+		void upload(Triangle& tri, const std::vector<uint>& offsets, const std::vector<uint>& columns, const std::vector<Real>& values, bool lower);
+		void solve(DArray<Real>& x, const DArray<Real>& b, Triangle& tri, bool lower);
+
+		Triangle mLower;
+		Triangle mUpper;
+
+		DArray<Real> mTemp;
+	};
+}
@@ -0,0 +1,1085 @@
+/**
+ * Implementation of CSRMatrix, BSRMatrix, the preconditioners and the Krylov solvers.
+ *
+ * The kernels only rely on cuExecute and the Sort, Scan, Reduction and Compaction primitives, so this file is compiled
+ * 	by Backend/Cuda/SparseMatrix/SparseLinearAlgebra.cu and Backend/Cpu/SparseMatrix/SparseLinearAlgebra.cpp alike.
+ */
+#include "Matrix/CSRMatrix.h"
+#include "Matrix/BSRMatrix.h"
+#include "Matrix/Preconditioner.h"
+#include "Matrix/KrylovSolver.h"
+
+#include "Algorithm/Sort.h"
+#include "Algorithm/Scan.h"
+#include "Algorithm/Compaction.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace dyno
+{
+	typedef unsigned long long SLA_Key;
+
+	static_assert(sizeof(Vector<float, 3>) == 3 * sizeof(float) && sizeof(Vector<double, 3>) == 3 * sizeof(double),
+		"BSRMatrix reinterprets scalar vectors as Vector<Real, 3>");
+
+	__global__ void SLA_SetupKeys(
+		SLA_Key* keys,
+		const uint* rowIds,
+		const uint* colIds,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		keys[tId] = (SLA_Key(rowIds[tId]) << 32) | SLA_Key(colIds[tId]);
+	}
+
+	__global__ void SLA_MarkHeads(
+		uint* flags,
+		const SLA_Key* keys,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		flags[tId] = (tId == 0 || keys[tId] != keys[tId - 1]) ? 1 : 0;
+	}
+
+	template<typename TValue>
+	__global__ void SLA_MergeDuplicates(
+		uint* columns,
+		TValue* values,
+		uint* rowCounts,
+		const uint* heads,
+		const SLA_Key* keys,
+		const TValue* sorted,
+		uint nonZeros,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= nonZeros) return;
+
+		uint begin = heads[tId];
+		uint end = tId + 1 < nonZeros ? heads[tId + 1] : num;
+
+		TValue sum = sorted[begin];
+		for (uint i = begin + 1; i < end; i++)
+			sum += sorted[i];
+
+		SLA_Key key = keys[begin];
+
+		columns[tId] = uint(key & 0xFFFFFFFFull);
+		values[tId] = sum;
+		atomicAdd(&rowCounts[uint(key >> 32)], 1u);
+	}
+
+	/**
+	 * @brief Sort triplets by (row, column), sum the duplicates and build the row offsets
+	 */
+	template<typename TValue>
+	void SLA_Assemble(
+		DArray<uint>& rowOffsets,
+		DArray<uint>& columns,
+		DArray<TValue>& values,
+		uint rows,
+		const DArray<uint>& rowIds,
+		const DArray<uint>& colIds,
+		const DArray<TValue>& triplets)
+	{
+		assert(rowIds.size() == colIds.size() && rowIds.size() == triplets.size());
+
+		uint num = triplets.size();
+
+		rowOffsets.resize(rows + 1);
+		rowOffsets.reset();
+
+		if (num == 0)
+		{
+			columns.clear();
+			values.clear();
+			return;
+		}
+
+		DArray<SLA_Key> keys(num);
+		cuExecute(num,
+			SLA_SetupKeys,
+			keys.begin(),
+			rowIds.begin(),
+			colIds.begin(),
+			num);
+
+		DArray<TValue> sorted;
+		sorted.assign(triplets);
+
+		Sort<SLA_Key> sort;
+		sort.sortByKey(keys, sorted);
+
+		DArray<uint> flags(num);
+		cuExecute(num,
+			SLA_MarkHeads,
+			flags.begin(),
+			keys.begin(),
+			num);
+
+		DArray<uint> heads;
+		Compaction compaction;
+		uint nonZeros = compaction.compact(heads, flags);
+
+		columns.resize(nonZeros);
+		values.resize(nonZeros);
+		cuExecute(nonZeros,
+			SLA_MergeDuplicates,
+			columns.begin(),
+			values.begin(),
+			rowOffsets.begin(),
+			heads.begin(),
+			keys.begin(),
+			sorted.begin(),
+			nonZeros,
+			num);
+
+		//The last counter is zero, so it receives the total after the exclusive scan
+		Scan<uint> scan;
+		scan.exclusive(rowOffsets);
+
+		keys.clear();
+		sorted.clear();
+		flags.clear();
+		heads.clear();
+	}
+
+	template<typename Real>
+	__global__ void SLA_CSRMultiply(
+		Real* y,
+		const Real* x,
+		const uint* offsets,
+		const uint* columns,
+		const Real* values,
+		uint rows)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= rows) return;
+
+		Real sum = 0;
+		for (uint k = offsets[tId]; k < offsets[tId + 1]; k++)
+			sum += values[k] * x[columns[k]];
+
+		y[tId] = sum;
+	}
+
+	template<typename TValue>
+	__global__ void SLA_ExtractDiagonal(
+		TValue* diag,
+		const uint* offsets,
+		const uint* columns,
+		const TValue* values,
+		uint rows)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= rows) return;
+
+		TValue d = TValue(0);
+		for (uint k = offsets[tId]; k < offsets[tId + 1]; k++)
+		{
+			if (columns[k] == tId)
+				d = values[k];
+		}
+
+		diag[tId] = d;
+	}
+
+	template<typename Real>
+	void CSRMatrix<Real>::clear()
+	{
+		mRows = 0;
+		mCols = 0;
+
+		mRowOffsets.clear();
+		mColumns.clear();
+		mValues.clear();
+	}
+
+	template<typename Real>
+	void CSRMatrix<Real>::assemble(uint rows, uint cols, const DArray<uint>& rowIds, const DArray<uint>& colIds, const DArray<Real>& values)
+	{
+		mRows = rows;
+		mCols = cols;
+
+		SLA_Assemble(mRowOffsets, mColumns, mValues, rows, rowIds, colIds, values);
+	}
+
+	template<typename Real>
+	void CSRMatrix<Real>::assign(uint cols, const CArray<uint>& rowOffsets, const CArray<uint>& columns, const CArray<Real>& values)
+	{
+		assert(rowOffsets.size() > 0 && columns.size() == values.size());
+
+		mRows = rowOffsets.size() - 1;
+		mCols = cols;
+
+		mRowOffsets.assign(rowOffsets);
+		mColumns.assign(columns);
+		mValues.assign(values);
+	}
+
+	template<typename Real>
+	void CSRMatrix<Real>::multiply(DArray<Real>& y, const DArray<Real>& x) const
+	{
+		assert(x.size() == mCols);
+
+		y.resize(mRows);
+
+		cuExecute(mRows,
+			SLA_CSRMultiply,
+			y.begin(),
+			x.begin(),
+			mRowOffsets.begin(),
+			mColumns.begin(),
+			mValues.begin(),
+			mRows);
+	}
+
+	template<typename Real>
+	void CSRMatrix<Real>::diagonal(DArray<Real>& diag) const
+	{
+		diag.resize(mRows);
+
+		cuExecute(mRows,
+			SLA_ExtractDiagonal,
+			diag.begin(),
+			mRowOffsets.begin(),
+			mColumns.begin(),
+			mValues.begin(),
+			mRows);
+	}
+
+	template<typename Real>
+	__global__ void SLA_BSRMultiply(
+		Vector<Real, 3>* y,
+		const Vector<Real, 3>* x,
+		const uint* offsets,
+		const uint* columns,
+		const SquareMatrix<Real, 3>* blocks,
+		uint rows)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= rows) return;
+
+		Vector<Real, 3> sum(0);
+		for (uint k = offsets[tId]; k < offsets[tId + 1]; k++)
+			sum += blocks[k] * x[columns[k]];
+
+		y[tId] = sum;
+	}
+
+	template<typename Real>
+	void BSRMatrix<Real>::clear()
+	{
+		mRows = 0;
+		mCols = 0;
+
+		mRowOffsets.clear();
+		mColumns.clear();
+		mBlocks.clear();
+	}
+
+	template<typename Real>
+	void BSRMatrix<Real>::assemble(uint rows, uint cols, const DArray<uint>& rowIds, const DArray<uint>& colIds, const DArray<Block>& blocks)
+	{
+		mRows = rows;
+		mCols = cols;
+
+		SLA_Assemble(mRowOffsets, mColumns, mBlocks, rows, rowIds, colIds, blocks);
+	}
+
+	template<typename Real>
+	void BSRMatrix<Real>::multiply(DArray<Coord>& y, const DArray<Coord>& x) const
+	{
+		assert(x.size() == mCols);
+
+		y.resize(mRows);
+
+		cuExecute(mRows,
+			SLA_BSRMultiply,
+			y.begin(),
+			x.begin(),
+			mRowOffsets.begin(),
+			mColumns.begin(),
+			mBlocks.begin(),
+			mRows);
+	}
+
+	template<typename Real>
+	void BSRMatrix<Real>::multiply(DArray<Real>& y, const DArray<Real>& x) const
+	{
+		assert(x.size() == 3 * mCols);
+
+		y.resize(3 * mRows);
+
+		//Vector<Real, 3> is stored as three consecutive scalars
+		cuExecute(mRows,
+			SLA_BSRMultiply,
+			(Coord*)y.begin(),
+			(const Coord*)x.begin(),
+			mRowOffsets.begin(),
+			mColumns.begin(),
+			mBlocks.begin(),
+			mRows);
+	}
+
+	template<typename Real>
+	void BSRMatrix<Real>::diagonal(DArray<Block>& diag) const
+	{
+		diag.resize(mRows);
+
+		cuExecute(mRows,
+			SLA_ExtractDiagonal,
+			diag.begin(),
+			mRowOffsets.begin(),
+			mColumns.begin(),
+			mBlocks.begin(),
+			mRows);
+	}
+
+	/************************************************************************/
+	/*                           Preconditioners                            */
+	/************************************************************************/
+
+	template<typename Real>
+	__global__ void SLA_InvertDiagonal(
+		Real* invDiag,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		Real d = invDiag[tId];
+		invDiag[tId] = d != Real(0) ? Real(1) / d : Real(1);
+	}
+
+	template<typename Real>
+	__global__ void SLA_BlockDiagonal(
+		Real* invDiag,
+		const SquareMatrix<Real, 3>* blocks,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		for (uint i = 0; i < 3; i++)
+		{
+			Real d = blocks[tId](i, i);
+			invDiag[3 * tId + i] = d != Real(0) ? Real(1) / d : Real(1);
+		}
+	}
+
+	template<typename Real>
+	__global__ void SLA_Scale(
+		Real* z,
+		const Real* r,
+		const Real* s,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		z[tId] = s[tId] * r[tId];
+	}
+
+	template<typename Real>
+	JacobiPreconditioner<Real>::~JacobiPreconditioner()
+	{
+		mInvDiag.clear();
+		mBlocks.clear();
+	}
+
+	template<typename Real>
+	void JacobiPreconditioner<Real>::update(const CSRMatrix<Real>& A)
+	{
+		A.diagonal(mInvDiag);
+
+		cuExecute(mInvDiag.size(),
+			SLA_InvertDiagonal,
+			mInvDiag.begin(),
+			mInvDiag.size());
+	}
+
+	template<typename Real>
+	void JacobiPreconditioner<Real>::update(const BSRMatrix<Real>& A)
+	{
+		A.diagonal(mBlocks);
+		mInvDiag.resize(3 * mBlocks.size());
+
+		cuExecute(mBlocks.size(),
+			SLA_BlockDiagonal,
+			mInvDiag.begin(),
+			mBlocks.begin(),
+			mBlocks.size());
+	}
+
+	template<typename Real>
+	void JacobiPreconditioner<Real>::apply(DArray<Real>& z, const DArray<Real>& r)
+	{
+		assert(r.size() == mInvDiag.size());
+
+		z.resize(r.size());
+
+		cuExecute(r.size(),
+			SLA_Scale,
+			z.begin(),
+			r.begin(),
+			mInvDiag.begin(),
+			r.size());
+	}
+
+	template<typename Real>
+	__global__ void SLA_InvertBlocks(
+		SquareMatrix<Real, 3>* blocks,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		SquareMatrix<Real, 3> b = blocks[tId];
+		Real det = b.determinant();
+
+		blocks[tId] = det != Real(0) ? b.inverse() : SquareMatrix<Real, 3>::identityMatrix();
+	}
+
+	template<typename Real>
+	__global__ void SLA_BlockScale(
+		Vector<Real, 3>* z,
+		const Vector<Real, 3>* r,
+		const SquareMatrix<Real, 3>* blocks,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		z[tId] = blocks[tId] * r[tId];
+	}
+
+	template<typename Real>
+	BlockJacobiPreconditioner<Real>::~BlockJacobiPreconditioner()
+	{
+		mInvBlocks.clear();
+	}
+
+	template<typename Real>
+	void BlockJacobiPreconditioner<Real>::update(const BSRMatrix<Real>& A)
+	{
+		A.diagonal(mInvBlocks);
+
+		cuExecute(mInvBlocks.size(),
+			SLA_InvertBlocks,
+			mInvBlocks.begin(),
+			mInvBlocks.size());
+	}
+
+	template<typename Real>
+	void BlockJacobiPreconditioner<Real>::apply(DArray<Real>& z, const DArray<Real>& r)
+	{
+		assert(r.size() == 3 * mInvBlocks.size());
+
+		z.resize(r.size());
+
+		cuExecute(mInvBlocks.size(),
+			SLA_BlockScale,
+			(Vector<Real, 3>*)z.begin(),
+			(const Vector<Real, 3>*)r.begin(),
+			mInvBlocks.begin(),
+			mInvBlocks.size());
+	}
+
+	template<typename Real>
+	void IncompleteCholeskyPreconditioner<Real>::Triangle::clear()
+	{
+		offsets.clear();
+		columns.clear();
+		values.clear();
+		rows.clear();
+		levels.clear();
+	}
+
+	template<typename Real>
+	IncompleteCholeskyPreconditioner<Real>::~IncompleteCholeskyPreconditioner()
+	{
+		mLower.clear();
+		mUpper.clear();
+		mTemp.clear();
+	}
+
+	template<typename Real>
+	void IncompleteCholeskyPreconditioner<Real>::update(const CSRMatrix<Real>& A)
+	{
+		assert(A.rows() == A.cols());
+
+		uint n = A.rows();
+
+		CArray<uint> hOffsets, hColumns;
+		CArray<Real> hValues;
+		hOffsets.assign(A.rowOffsets());
+		hColumns.assign(A.columns());
+		hValues.assign(A.values());
+
+		//Lower triangle of A, the diagonal is stored last in every row
+		std::vector<uint> offsets(n + 1, 0);
+		std::vector<uint> columns;
+		std::vector<Real> source;
+		for (uint i = 0; i < n; i++)
+		{
+			Real d = 0;
+			for (uint k = hOffsets[i]; k < hOffsets[i + 1]; k++)
+			{
+				uint j = hColumns[k];
+				if (j < i)
+				{
+					columns.push_back(j);
+					source.push_back(hValues[k]);
+				}
+				else if (j == i)
+					d = hValues[k];
+			}
+			columns.push_back(i);
+			source.push_back(d);
+			offsets[i + 1] = (uint)columns.size();
+		}
+
+		//IC(0) in row order, restarted with a growing diagonal shift on breakdown
+		std::vector<Real> values;
+		std::vector<Real> dense(n, Real(0));
+		Real shift = 0;
+		bool success = false;
+		while (!success)
+		{
+			values = source;
+			success = true;
+
+			for (uint i = 0; i < n && success; i++)
+			{
+				uint diag = offsets[i + 1] - 1;
+				values[diag] *= Real(1) + shift;
+
+				for (uint k = offsets[i]; k < diag; k++)
+				{
+					uint j = columns[k];
+
+					//l_ij = (a_ij - sum_{m<j} l_im * l_jm) / l_jj, with dense holding row j
+					for (uint m = offsets[j]; m < offsets[j + 1] - 1; m++)
+						dense[columns[m]] = values[m];
+
+					Real sum = values[k];
+					for (uint m = offsets[i]; m < k; m++)
+						sum -= values[m] * dense[columns[m]];
+
+					for (uint m = offsets[j]; m < offsets[j + 1] - 1; m++)
+						dense[columns[m]] = Real(0);
+
+					values[k] = sum / values[offsets[j + 1] - 1];
+				}
+
+				Real sum = values[diag];
+				for (uint k = offsets[i]; k < diag; k++)
+					sum -= values[k] * values[k];
+
+				if (sum <= Real(0) || !std::isfinite(sum))
+				{
+					success = false;
+					shift = shift == Real(0) ? Real(1e-3) : Real(2) * shift;
+				}
+				else
+					values[diag] = std::sqrt(sum);
+			}
+		}
+
+		//L^T in CSR format, the diagonal is stored first in every row
+		std::vector<uint> tOffsets(n + 1, 0);
+		for (uint k = 0; k < columns.size(); k++)
+			tOffsets[columns[k] + 1]++;
+		for (uint i = 0; i < n; i++)
+			tOffsets[i + 1] += tOffsets[i];
+
+		std::vector<uint> tColumns(columns.size());
+		std::vector<Real> tValues(columns.size());
+		std::vector<uint> cursor(tOffsets.begin(), tOffsets.end() - 1);
+		for (uint i = 0; i < n; i++)
+		{
+			//The diagonal comes last in row i of L, move it to the front of row i of L^T
+			uint diag = offsets[i + 1] - 1;
+			uint pos = cursor[i]++;
+			tColumns[pos] = i;
+			tValues[pos] = values[diag];
+		}
+		for (uint i = 0; i < n; i++)
+		{
+			for (uint k = offsets[i]; k < offsets[i + 1] - 1; k++)
+			{
+				uint pos = cursor[columns[k]]++;
+				tColumns[pos] = i;
+				tValues[pos] = values[k];
+			}
+		}
+
+		this->upload(mLower, offsets, columns, values, true);
+		this->upload(mUpper, tOffsets, tColumns, tValues, false);
+	}
+
+	template<typename Real>
+	void IncompleteCholeskyPreconditioner<Real>::upload(Triangle& tri, const std::vector<uint>& offsets, const std::vector<uint>& columns, const std::vector<Real>& values, bool lower)
+	{
+		uint n = (uint)offsets.size() - 1;
+
+		//The level of a row is one more than the highest level among the rows it depends on
+		std::vector<uint> level(n, 0);
+		uint levelNum = n > 0 ? 1 : 0;
+		for (uint t = 0; t < n; t++)
+		{
+			uint i = lower ? t : n - 1 - t;
+
+			uint l = 0;
+			for (uint k = offsets[i]; k < offsets[i + 1]; k++)
+			{
+				if (columns[k] != i)
+					l = std::max(l, level[columns[k]] + 1);
+			}
+			level[i] = l;
+			levelNum = std::max(levelNum, l + 1);
+		}
+
+		tri.levels.assign(levelNum + 1, 0);
+		for (uint i = 0; i < n; i++)
+			tri.levels[level[i] + 1]++;
+		for (uint l = 0; l < levelNum; l++)
+			tri.levels[l + 1] += tri.levels[l];
+
+		std::vector<uint> cursor(tri.levels.begin(), tri.levels.end() - 1);
+		CArray<uint> rows(n);
+		for (uint i = 0; i < n; i++)
+			rows[cursor[level[i]]++] = i;
+
+		tri.offsets.assign(offsets);
+		tri.columns.assign(columns);
+		tri.values.assign(values);
+		tri.rows.assign(rows);
+	}
+
+	template<typename Real>
+	__global__ void SLA_SolveLevel(
+		Real* x,
+		const Real* b,
+		const uint* rows,
+		const uint* offsets,
+		const uint* columns,
+		const Real* values,
+		uint first,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		uint i = rows[first + tId];
+
+		Real sum = b[i];
+		Real diag = Real(1);
+		for (uint k = offsets[i]; k < offsets[i + 1]; k++)
+		{
+			uint j = columns[k];
+			if (j == i)
+				diag = values[k];
+			else
+				sum -= values[k] * x[j];
+		}
+
+		x[i] = sum / diag;
+	}
+
+	template<typename Real>
+	void IncompleteCholeskyPreconditioner<Real>::solve(DArray<Real>& x, const DArray<Real>& b, Triangle& tri, bool lower)
+	{
+		for (uint l = 0; l + 1 < tri.levels.size(); l++)
+		{
+			uint first = tri.levels[l];
+			uint num = tri.levels[l + 1] - first;
+
+			cuExecute(num,
+				SLA_SolveLevel,
+				x.begin(),
+				b.begin(),
+				tri.rows.begin(),
+				tri.offsets.begin(),
+				tri.columns.begin(),
+				tri.values.begin(),
+				first,
+				num);
+		}
+	}
+
+	template<typename Real>
+	void IncompleteCholeskyPreconditioner<Real>::apply(DArray<Real>& z, const DArray<Real>& r)
+	{
+		assert(r.size() + 1 == mLower.offsets.size());
+
+		mTemp.resize(r.size());
+		z.resize(r.size());
+
+		this->solve(mTemp, r, mLower, true);
+		this->solve(z, mTemp, mUpper, false);
+	}
+
+	/************************************************************************/
+	/*                             Krylov solvers                           */
+	/************************************************************************/
+
+	template<typename Real>
+	__global__ void SLA_Multiply(
+		Real* c,
+		const Real* a,
+		const Real* b,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		c[tId] = a[tId] * b[tId];
+	}
+
+	//y = a * x + b * y
+	template<typename Real>
+	__global__ void SLA_Axpby(
+		Real* y,
+		const Real* x,
+		Real a,
+		Real b,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		y[tId] = a * x[tId] + b * y[tId];
+	}
+
+	//z = x + a * y
+	template<typename Real>
+	__global__ void SLA_Add(
+		Real* z,
+		const Real* x,
+		const Real* y,
+		Real a,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		z[tId] = x[tId] + a * y[tId];
+	}
+
+	template<typename Real>
+	KrylovSolver<Real>::~KrylovSolver()
+	{
+		for (uint i = 0; i < WORK_VECTOR_NUM; i++)
+			mVectors[i].clear();
+
+		mProduct.clear();
+	}
+
+	template<typename Real>
+	Real KrylovSolver<Real>::dot(const DArray<Real>& a, const DArray<Real>& b)
+	{
+		uint num = a.size();
+		if (num == 0)
+			return Real(0);
+
+		if (mProduct.size() < num)
+			mProduct.resize(num);
+
+		cuExecute(num,
+			SLA_Multiply,
+			mProduct.begin(),
+			a.begin(),
+			b.begin(),
+			num);
+
+		return mReduce.accumulate(mProduct.begin(), num);
+	}
+
+	template<typename Real>
+	Real KrylovSolver<Real>::norm(const DArray<Real>& a)
+	{
+		return std::sqrt(std::max(Real(0), this->dot(a, a)));
+	}
+
+	template<typename Real>
+	DArray<Real>& KrylovSolver<Real>::vector(uint i, uint n)
+	{
+		assert(i < WORK_VECTOR_NUM);
+
+		if (mVectors[i].size() != n)
+			mVectors[i].resize(n);
+
+		return mVectors[i];
+	}
+
+	template<typename Real>
+	void KrylovSolver<Real>::initialize(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b, DArray<Real>& r)
+	{
+		uint n = b.size();
+		assert(A.dimension() == n);
+
+		if (x.size() != n)
+		{
+			x.resize(n);
+			x.reset();
+		}
+
+		//r = b - A * x
+		A.apply(r, x);
+		cuExecute(n,
+			SLA_Axpby,
+			r.begin(),
+			b.begin(),
+			Real(1),
+			Real(-1),
+			n);
+
+		mIterations = 0;
+	}
+
+	template<typename Real>
+	void KrylovSolver<Real>::precondition(DArray<Real>& z, const DArray<Real>& r)
+	{
+		if (mPreconditioner != nullptr)
+			mPreconditioner->apply(z, r);
+		else
+			z.assign(r);
+	}
+
+	template<typename Real>
+	bool KrylovSolver<Real>::converged(Real rNorm, Real bNorm) const
+	{
+		return rNorm <= std::max(mTolerance * bNorm, mAbsoluteTolerance);
+	}
+
+	template<typename Real>
+	bool ConjugateGradient<Real>::solve(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b)
+	{
+		uint n = b.size();
+
+		DArray<Real>& r = this->vector(0, n);
+		DArray<Real>& z = this->vector(1, n);
+		DArray<Real>& p = this->vector(2, n);
+		DArray<Real>& q = this->vector(3, n);
+
+		this->initialize(A, x, b, r);
+
+		Real bNorm = this->norm(b);
+		Real rNorm = this->norm(r);
+		this->mResidual = rNorm;
+		if (this->converged(rNorm, bNorm))
+			return true;
+
+		this->precondition(z, r);
+		p.assign(z);
+
+		Real rz = this->dot(r, z);
+		while (this->mIterations < this->mMaxIterations)
+		{
+			A.apply(q, p);
+
+			Real pq = this->dot(p, q);
+			if (pq == Real(0))
+				break;
+
+			Real alpha = rz / pq;
+			cuExecute(n, SLA_Axpby, x.begin(), p.begin(), alpha, Real(1), n);
+			cuExecute(n, SLA_Axpby, r.begin(), q.begin(), -alpha, Real(1), n);
+
+			this->mIterations++;
+
+			rNorm = this->norm(r);
+			this->mResidual = rNorm;
+			if (this->converged(rNorm, bNorm))
+				return true;
+
+			this->precondition(z, r);
+
+			Real rzNew = this->dot(r, z);
+			Real beta = rzNew / rz;
+			rz = rzNew;
+
+			//p = z + beta * p
+			cuExecute(n, SLA_Axpby, p.begin(), z.begin(), Real(1), beta, n);
+		}
+
+		return false;
+	}
+
+	template<typename Real>
+	bool MINRES<Real>::solve(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b)
+	{
+		uint n = b.size();
+
+		DArray<Real>& r1 = this->vector(0, n);
+		DArray<Real>& r2 = this->vector(1, n);
+		DArray<Real>& y = this->vector(2, n);
+		DArray<Real>& v = this->vector(3, n);
+		DArray<Real>* w[3] = { &this->vector(4, n), &this->vector(5, n), &this->vector(6, n) };
+
+		this->initialize(A, x, b, r1);
+
+		this->precondition(y, r1);
+		Real beta1 = std::sqrt(std::max(Real(0), this->dot(r1, y)));
+
+		//The tolerance applies to the preconditioned residual norm, measure b the same way
+		this->precondition(v, b);
+		Real bNorm = std::sqrt(std::max(Real(0), this->dot(b, v)));
+
+		this->mResidual = beta1;
+		if (this->converged(beta1, bNorm))
+			return true;
+
+		r2.assign(r1);
+		w[0]->reset();
+		w[1]->reset();
+
+		Real oldb = 0, beta = beta1, dbar = 0, epsln = 0, phibar = beta1;
+		Real cs = -1, sn = 0;
+
+		while (this->mIterations < this->mMaxIterations)
+		{
+			//Lanczos step
+			Real s = Real(1) / beta;
+			cuExecute(n, SLA_Axpby, v.begin(), y.begin(), s, Real(0), n);
+
+			A.apply(y, v);
+			if (this->mIterations > 0)
+				cuExecute(n, SLA_Axpby, y.begin(), r1.begin(), -beta / oldb, Real(1), n);
+
+			Real alpha = this->dot(v, y);
+			cuExecute(n, SLA_Axpby, y.begin(), r2.begin(), -alpha / beta, Real(1), n);
+
+			r1.assign(r2);
+			r2.assign(y);
+			this->precondition(y, r2);
+
+			oldb = beta;
+			beta = std::sqrt(std::max(Real(0), this->dot(r2, y)));
+
+			//Apply the previous rotation and compute the next one
+			Real oldeps = epsln;
+			Real delta = cs * dbar + sn * alpha;
+			Real gbar = sn * dbar - cs * alpha;
+			epsln = sn * beta;
+			dbar = -cs * beta;
+
+			Real gamma = std::max(std::sqrt(gbar * gbar + beta * beta), std::numeric_limits<Real>::min());
+			cs = gbar / gamma;
+			sn = beta / gamma;
+
+			Real phi = cs * phibar;
+			phibar = sn * phibar;
+
+			//w_k = (v - oldeps * w_{k-2} - delta * w_{k-1}) / gamma, with w[0] = w_{k-2} and w[1] = w_{k-1}
+			DArray<Real>& wNew = *w[2];
+			cuExecute(n, SLA_Add, wNew.begin(), v.begin(), w[0]->begin(), -oldeps, n);
+			cuExecute(n, SLA_Axpby, wNew.begin(), w[1]->begin(), -delta / gamma, Real(1) / gamma, n);
+
+			cuExecute(n, SLA_Axpby, x.begin(), wNew.begin(), phi, Real(1), n);
+
+			std::swap(w[0], w[1]);
+			std::swap(w[1], w[2]);
+
+			this->mIterations++;
+
+			this->mResidual = phibar;
+			if (this->converged(phibar, bNorm))
+				return true;
+
+			if (beta == Real(0))
+				break;
+		}
+
+		return false;
+	}
+
+	template<typename Real>
+	bool BiCGSTAB<Real>::solve(const LinearOperator<Real>& A, DArray<Real>& x, const DArray<Real>& b)
+	{
+		uint n = b.size();
+
+		DArray<Real>& r = this->vector(0, n);
+		DArray<Real>& r0 = this->vector(1, n);
+		DArray<Real>& p = this->vector(2, n);
+		DArray<Real>& v = this->vector(3, n);
+		DArray<Real>& ph = this->vector(4, n);
+		DArray<Real>& s = this->vector(5, n);
+		DArray<Real>& sh = this->vector(6, n);
+		DArray<Real>& t = this->vector(7, n);
+
+		this->initialize(A, x, b, r);
+
+		Real bNorm = this->norm(b);
+		Real rNorm = this->norm(r);
+		this->mResidual = rNorm;
+		if (this->converged(rNorm, bNorm))
+			return true;
+
+		r0.assign(r);
+		p.reset();
+		v.reset();
+
+		Real rho = 1, alpha = 1, omega = 1;
+		while (this->mIterations < this->mMaxIterations)
+		{
+			Real rhoNew = this->dot(r0, r);
+			if (rhoNew == Real(0))
+				break;
+
+			//p = r + beta * (p - omega * v)
+			Real beta = (rhoNew / rho) * (alpha / omega);
+			cuExecute(n, SLA_Axpby, p.begin(), v.begin(), -omega, Real(1), n);
+			cuExecute(n, SLA_Axpby, p.begin(), r.begin(), Real(1), beta, n);
+			rho = rhoNew;
+
+			this->precondition(ph, p);
+			A.apply(v, ph);
+
+			Real r0v = this->dot(r0, v);
+			if (r0v == Real(0))
+				break;
+			alpha = rho / r0v;
+
+			cuExecute(n, SLA_Add, s.begin(), r.begin(), v.begin(), -alpha, n);
+
+			this->mIterations++;
+
+			Real sNorm = this->norm(s);
+			if (this->converged(sNorm, bNorm))
+			{
+				cuExecute(n, SLA_Axpby, x.begin(), ph.begin(), alpha, Real(1), n);
+				this->mResidual = sNorm;
+				return true;
+			}
+
+			this->precondition(sh, s);
+			A.apply(t, sh);
+
+			Real tt = this->dot(t, t);
+			omega = tt > Real(0) ? this->dot(t, s) / tt : Real(0);
+
+			cuExecute(n, SLA_Axpby, x.begin(), ph.begin(), alpha, Real(1), n);
+			cuExecute(n, SLA_Axpby, x.begin(), sh.begin(), omega, Real(1), n);
+			cuExecute(n, SLA_Add, r.begin(), s.begin(), t.begin(), -omega, n);
+
+			rNorm = this->norm(r);
+			this->mResidual = rNorm;
+			if (this->converged(rNorm, bNorm))
+				return true;
+
+			if (omega == Real(0))
+				break;
+		}
+
+		return false;
+	}
+}
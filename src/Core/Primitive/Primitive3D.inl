@@ -151,9 +151,17 @@ namespace dyno
 			{
 				if (t < 0)
 				{
-					//region 4
-					s = 0;
-					t = 0;
+					//region 4, the closest point lies on one of the edges adjacent to v[0]
+					if (d < 0)
+					{
+						s = (-d >= a ? 1 : -d / a);
+						t = 0;
+					}
+					else
+					{
+						s = 0;
+						t = (e >= 0 ? 0 : (-e >= c ? 1 : -e / c));
+					}
 				}
 				else
 				{
@@ -191,15 +199,39 @@ namespace dyno
 		{
 			if (s < 0)
 			{
-				//region 2
-				s = 0;
-				t = 1;
+				//region 2, the closest point lies on one of the edges adjacent to v[2]
+				Real tmp0 = b + d;
+				Real tmp1 = c + e;
+				if (tmp1 > tmp0)
+				{
+					Real numer = tmp1 - tmp0;
+					Real denom = a - 2 * b + c;
+					s = (numer >= denom ? 1 : numer / denom);
+					t = 1 - s;
+				}
+				else
+				{
+					s = 0;
+					t = (tmp1 <= 0 ? 1 : (e >= 0 ? 0 : -e / c));
+				}
 			}
 			else if (t < 0)
 			{
-				//region 6
-				s = 1;
-				t = 0;
+				//region 6, the closest point lies on one of the edges adjacent to v[1]
+				Real tmp0 = b + e;
+				Real tmp1 = a + d;
+				if (tmp1 > tmp0)
+				{
+					Real numer = tmp1 - tmp0;
+					Real denom = a - 2 * b + c;
+					t = (numer >= denom ? 1 : numer / denom);
+					s = 1 - t;
+				}
+				else
+				{
+					t = 0;
+					s = (tmp1 <= 0 ? 1 : (d >= 0 ? 0 : -d / a));
+				}
 			}
 			else
 			{
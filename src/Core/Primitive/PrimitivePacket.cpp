@@ -0,0 +1,139 @@
+#include "PrimitivePacket.h"
+
+#include "Algorithm/HostLanes.h"
+#include "PrimitivePacketKernel.inl"
+
+namespace dyno
+{
+	//Defined in PrimitivePacketAvx2.cpp and PrimitivePacketAvx512.cpp, return nullptr if the compiler could not target the instruction set
+	const PP_Kernels* PP_Avx2Kernels();
+	const PP_Kernels* PP_Avx512Kernels();
+
+#define PP_BLOCK_SIZE 256
+
+	static const PP_Kernels* PP_Select(simd::InstructionSet isa)
+	{
+		if (isa == simd::ISA_AUTO)
+			isa = PrimitivePacket::instructionSet();
+
+		const PP_Kernels* kernels = nullptr;
+		if (isa == simd::ISA_AVX512 && simd::supports(isa))
+			kernels = PP_Avx512Kernels();
+		else if (isa == simd::ISA_AVX2 && simd::supports(isa))
+			kernels = PP_Avx2Kernels();
+
+		return kernels == nullptr ? PPK_Kernels<LaneScalar>() : kernels;
+	}
+
+	static void PP_Planes(const TriangleSoA& triangles, size_t offset, const float* tri[9])
+	{
+		for (int k = 0; k < 3; k++)
+			for (int d = 0; d < 3; d++)
+				tri[3 * k + d] = triangles.v[k][d] + offset;
+	}
+
+	simd::InstructionSet PrimitivePacket::instructionSet()
+	{
+		static simd::InstructionSet best = []() -> simd::InstructionSet {
+			if (PP_Avx512Kernels() != nullptr && simd::supports(simd::ISA_AVX512))
+				return simd::ISA_AVX512;
+			if (PP_Avx2Kernels() != nullptr && simd::supports(simd::ISA_AVX2))
+				return simd::ISA_AVX2;
+			return simd::ISA_SCALAR;
+		}();
+
+		return best;
+	}
+
+	void PrimitivePacket::pointTriangles(const Vec3f& p, const TriangleSoA& triangles, size_t num, float* distSq, float* u, float* v, simd::InstructionSet isa)
+	{
+		const PP_Kernels* kernels = PP_Select(isa);
+
+		const float q[3] = { p[0], p[1], p[2] };
+		const float* tri[9];
+
+		if (u != nullptr && v != nullptr)
+		{
+			PP_Planes(triangles, 0, tri);
+			kernels->pointTriangles(q, tri, num, distSq, u, v);
+			return;
+		}
+
+		float bu[PP_BLOCK_SIZE], bv[PP_BLOCK_SIZE];
+		for (size_t i = 0; i < num; i += PP_BLOCK_SIZE)
+		{
+			size_t n = num - i < PP_BLOCK_SIZE ? num - i : PP_BLOCK_SIZE;
+
+			PP_Planes(triangles, i, tri);
+			kernels->pointTriangles(q, tri, n, distSq + i, u != nullptr ? u + i : bu, v != nullptr ? v + i : bv);
+		}
+	}
+
+	void PrimitivePacket::pointsTriangle(const PointSoA& points, const TTriangle3D<float>& triangle, size_t num, float* distSq, float* u, float* v, simd::InstructionSet isa)
+	{
+		const PP_Kernels* kernels = PP_Select(isa);
+
+		float tri[9];
+		for (int k = 0; k < 3; k++)
+			for (int d = 0; d < 3; d++)
+				tri[3 * k + d] = triangle.v[k][d];
+
+		if (u != nullptr && v != nullptr)
+		{
+			kernels->pointsTriangle(points.x, tri, num, distSq, u, v);
+			return;
+		}
+
+		float bu[PP_BLOCK_SIZE], bv[PP_BLOCK_SIZE];
+		for (size_t i = 0; i < num; i += PP_BLOCK_SIZE)
+		{
+			size_t n = num - i < PP_BLOCK_SIZE ? num - i : PP_BLOCK_SIZE;
+
+			const float* x[3] = { points.x[0] + i, points.x[1] + i, points.x[2] + i };
+			kernels->pointsTriangle(x, tri, n, distSq + i, u != nullptr ? u + i : bu, v != nullptr ? v + i : bv);
+		}
+	}
+
+	void PrimitivePacket::segmentTriangles(const Vec3f& p0, const Vec3f& p1, const TriangleSoA& triangles, size_t num, float* t, simd::InstructionSet isa)
+	{
+		const PP_Kernels* kernels = PP_Select(isa);
+
+		const float q0[3] = { p0[0], p0[1], p0[2] };
+		const float q1[3] = { p1[0], p1[1], p1[2] };
+		const float* tri[9];
+		PP_Planes(triangles, 0, tri);
+
+		kernels->segmentTriangles(q0, q1, tri, num, t);
+	}
+
+	size_t PrimitivePacket::closestTriangle(const Vec3f& p, const TriangleSoA& triangles, size_t num, float& distSq, simd::InstructionSet isa)
+	{
+		const PP_Kernels* kernels = PP_Select(isa);
+
+		const float q[3] = { p[0], p[1], p[2] };
+		const float* tri[9];
+
+		size_t closest = num;
+		distSq = INFINITY;
+
+		float d2[PP_BLOCK_SIZE], bu[PP_BLOCK_SIZE], bv[PP_BLOCK_SIZE];
+		for (size_t i = 0; i < num; i += PP_BLOCK_SIZE)
+		{
+			size_t n = num - i < PP_BLOCK_SIZE ? num - i : PP_BLOCK_SIZE;
+
+			PP_Planes(triangles, i, tri);
+			kernels->pointTriangles(q, tri, n, d2, bu, bv);
+
+			for (size_t l = 0; l < n; l++)
+			{
+				if (d2[l] < distSq)
+				{
+					distSq = d2[l];
+					closest = i + l;
+				}
+			}
+		}
+
+		return closest;
+	}
+}
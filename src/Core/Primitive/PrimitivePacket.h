@@ -0,0 +1,79 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Primitive3D.h"
+#include "Algorithm/HostInstructionSet.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Triangles in structure of arrays form, v[k][d] points to coordinate d of vertex k of every triangle
+	 */
+	struct TriangleSoA
+	{
+		const float* v[3][3];
+	};
+
+	/**
+	 * @brief Points in structure of arrays form, x[d] points to coordinate d of every point
+	 */
+	struct PointSoA
+	{
+		const float* x[3];
+	};
+
+	/**
+	 * @brief Packetized point-triangle distances and segment-triangle intersections in host memory, the building blocks of
+	 * 	CPU-side mesh proximity queries.
+	 *
+	 * One query is evaluated against 8 (AVX2) or 16 (AVX-512) primitives at once. The kernels are written once over the lanes
+	 * 	of Algorithm/HostLanes.h and compiled without contraction, so the scalar path returns the same bits as the SIMD ones
+	 * 	and serves as their reference. The instruction set is selected at runtime.
+	 */
+	class PrimitivePacket
+	{
+	public:
+		/**
+		 * @brief The best instruction set supported by both the binary and the processor
+		 */
+		static simd::InstructionSet instructionSet();
+
+		/**
+		 * @brief Squared distances from p to num triangles, the closest points are a + u * (b - a) + v * (c - a).
+		 * 	u and v can be nullptr.
+		 */
+		static void pointTriangles(const Vec3f& p, const TriangleSoA& triangles, size_t num,
+			float* distSq, float* u = nullptr, float* v = nullptr, simd::InstructionSet isa = simd::ISA_AUTO);
+
+		/**
+		 * @brief Squared distances from num points to one triangle, same outputs as pointTriangles()
+		 */
+		static void pointsTriangle(const PointSoA& points, const TTriangle3D<float>& triangle, size_t num,
+			float* distSq, float* u = nullptr, float* v = nullptr, simd::InstructionSet isa = simd::ISA_AUTO);
+
+		/**
+		 * @brief Parameters t in [0, 1] where the segment p0 + t * (p1 - p0) crosses the triangles, infinity where it misses
+		 */
+		static void segmentTriangles(const Vec3f& p0, const Vec3f& p1, const TriangleSoA& triangles, size_t num,
+			float* t, simd::InstructionSet isa = simd::ISA_AUTO);
+
+		/**
+		 * @brief Index of the triangle closest to p, num if there is no triangle
+		 */
+		static size_t closestTriangle(const Vec3f& p, const TriangleSoA& triangles, size_t num,
+			float& distSq, simd::InstructionSet isa = simd::ISA_AUTO);
+	};
+}
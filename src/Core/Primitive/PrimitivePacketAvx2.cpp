@@ -0,0 +1,20 @@
+/**
+ * Compiled with AVX2 and FMA enabled and without floating point contraction (see src/Core/CMakeLists.txt),
+ * 	only called after a runtime check of the processor.
+ */
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include "Algorithm/HostLanes.h"
+#endif
+
+#include "PrimitivePacketKernel.inl"
+
+namespace dyno
+{
+#if defined(__AVX2__)
+	const PP_Kernels* PP_Avx2Kernels() { return PPK_Kernels<LaneAvx2>(); }
+#else
+	const PP_Kernels* PP_Avx2Kernels() { return nullptr; }
+#endif
+}
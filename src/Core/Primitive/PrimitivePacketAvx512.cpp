@@ -0,0 +1,20 @@
+/**
+ * Compiled with AVX-512F enabled and without floating point contraction (see src/Core/CMakeLists.txt),
+ * 	only called after a runtime check of the processor.
+ */
+#include <cstddef>
+
+#if defined(__AVX512F__)
+#include "Algorithm/HostLanes.h"
+#endif
+
+#include "PrimitivePacketKernel.inl"
+
+namespace dyno
+{
+#if defined(__AVX512F__)
+	const PP_Kernels* PP_Avx512Kernels() { return PPK_Kernels<LaneAvx512>(); }
+#else
+	const PP_Kernels* PP_Avx512Kernels() { return nullptr; }
+#endif
+}
@@ -0,0 +1,273 @@
+/**
+ * The lane-generic kernels of PrimitivePacket, included by PrimitivePacket.cpp, PrimitivePacketAvx2.cpp and PrimitivePacketAvx512.cpp,
+ * 	each compiled for its own instruction set without contraction of multiplications and additions, so all of them return identical bits.
+ *
+ * The lane types are those of Algorithm/HostLanes.h.
+ */
+#include <cstddef>
+#include <cmath>
+
+namespace dyno
+{
+	//Shared by all instruction sets, tri[3 * k + d] is coordinate d of vertex k
+	struct PP_Kernels
+	{
+		void (*pointTriangles)(const float p[3], const float* const tri[9], size_t num, float* distSq, float* u, float* v);
+		void (*pointsTriangle)(const float* const points[3], const float tri[9], size_t num, float* distSq, float* u, float* v);
+		void (*segmentTriangles)(const float p0[3], const float p1[3], const float* const tri[9], size_t num, float* t);
+	};
+}
+
+namespace
+{
+	using dyno::PP_Kernels;
+
+	/**
+	 * @brief Load W entries starting at i, the last valid entry is repeated if less than W remain
+	 */
+	template<typename L>
+	inline typename L::V PPK_Load(const float* p, size_t i, size_t rest)
+	{
+		if (rest >= (size_t)L::W)
+			return L::load(p + i);
+
+		float buf[L::W];
+		for (int l = 0; l < L::W; l++)
+			buf[l] = p[i + ((size_t)l < rest ? l : rest - 1)];
+		return L::load(buf);
+	}
+
+	template<typename L>
+	inline void PPK_Store(float* p, size_t i, size_t rest, typename L::V a)
+	{
+		if (rest >= (size_t)L::W)
+		{
+			L::store(p + i, a);
+			return;
+		}
+
+		float buf[L::W];
+		L::store(buf, a);
+		for (size_t l = 0; l < rest; l++)
+			p[i + l] = buf[l];
+	}
+
+	template<typename L>
+	inline typename L::V PPK_Dot(const typename L::V a[3], const typename L::V b[3])
+	{
+		return L::add(L::add(L::mul(a[0], b[0]), L::mul(a[1], b[1])), L::mul(a[2], b[2]));
+	}
+
+	template<typename L>
+	inline void PPK_Sub(typename L::V r[3], const typename L::V a[3], const typename L::V b[3])
+	{
+		for (int d = 0; d < 3; d++)
+			r[d] = L::sub(a[d], b[d]);
+	}
+
+	template<typename L>
+	inline void PPK_Cross(typename L::V r[3], const typename L::V a[3], const typename L::V b[3])
+	{
+		r[0] = L::sub(L::mul(a[1], b[2]), L::mul(a[2], b[1]));
+		r[1] = L::sub(L::mul(a[2], b[0]), L::mul(a[0], b[2]));
+		r[2] = L::sub(L::mul(a[0], b[1]), L::mul(a[1], b[0]));
+	}
+
+	/**
+	 * @brief Closest point of the triangle abc to p, a + u * (b - a) + v * (c - a), see "Real-Time Collision Detection" by Ericson, 5.1.5.
+	 *
+	 * All Voronoi regions are evaluated and selected with masks, in the reverse order of Ericson's early exits so that the same region wins.
+	 */
+	template<typename L>
+	inline void PPK_PointTriangle(const typename L::V p[3], const typename L::V a[3], const typename L::V b[3], const typename L::V c[3],
+		typename L::V& distSq, typename L::V& u, typename L::V& v)
+	{
+		typedef typename L::V V;
+		typedef typename L::M M;
+
+		V ab[3], ac[3], ap[3], bp[3], cp[3];
+		PPK_Sub<L>(ab, b, a);
+		PPK_Sub<L>(ac, c, a);
+		PPK_Sub<L>(ap, p, a);
+		PPK_Sub<L>(bp, p, b);
+		PPK_Sub<L>(cp, p, c);
+
+		V d1 = PPK_Dot<L>(ab, ap);
+		V d2 = PPK_Dot<L>(ac, ap);
+		V d3 = PPK_Dot<L>(ab, bp);
+		V d4 = PPK_Dot<L>(ac, bp);
+		V d5 = PPK_Dot<L>(ab, cp);
+		V d6 = PPK_Dot<L>(ac, cp);
+
+		V va = L::sub(L::mul(d3, d6), L::mul(d5, d4));
+		V vb = L::sub(L::mul(d5, d2), L::mul(d1, d6));
+		V vc = L::sub(L::mul(d1, d4), L::mul(d3, d2));
+
+		V zero = L::set1(0.0f);
+		V one = L::set1(1.0f);
+
+		//Interior
+		V denom = L::div(one, L::add(L::add(va, vb), vc));
+		u = L::mul(vb, denom);
+		v = L::mul(vc, denom);
+
+		//Edge bc
+		V e43 = L::sub(d4, d3);
+		V e56 = L::sub(d5, d6);
+		M m = L::land(L::le(va, zero), L::land(L::le(zero, e43), L::le(zero, e56)));
+		V w = L::div(e43, L::add(e43, e56));
+		u = L::blend(m, L::sub(one, w), u);
+		v = L::blend(m, w, v);
+
+		//Edge ac
+		m = L::land(L::le(vb, zero), L::land(L::le(zero, d2), L::le(d6, zero)));
+		w = L::div(d2, L::sub(d2, d6));
+		u = L::blend(m, zero, u);
+		v = L::blend(m, w, v);
+
+		//Vertex c
+		m = L::land(L::le(zero, d6), L::le(d5, d6));
+		u = L::blend(m, zero, u);
+		v = L::blend(m, one, v);
+
+		//Edge ab
+		m = L::land(L::le(vc, zero), L::land(L::le(zero, d1), L::le(d3, zero)));
+		w = L::div(d1, L::sub(d1, d3));
+		u = L::blend(m, w, u);
+		v = L::blend(m, zero, v);
+
+		//Vertex b
+		m = L::land(L::le(zero, d3), L::le(d4, d3));
+		u = L::blend(m, one, u);
+		v = L::blend(m, zero, v);
+
+		//Vertex a
+		m = L::land(L::le(d1, zero), L::le(d2, zero));
+		u = L::blend(m, zero, u);
+		v = L::blend(m, zero, v);
+
+		V diff[3];
+		for (int d = 0; d < 3; d++)
+			diff[d] = L::sub(ap[d], L::add(L::mul(ab[d], u), L::mul(ac[d], v)));
+
+		distSq = PPK_Dot<L>(diff, diff);
+	}
+
+	/**
+	 * @brief Parameter t in [0, 1] where o + t * dir crosses the triangle abc, infinity if it misses (Moller-Trumbore).
+	 * 	Parallel configurations produce NaNs that fail all comparisons.
+	 */
+	template<typename L>
+	inline typename L::V PPK_SegmentTriangle(const typename L::V o[3], const typename L::V dir[3], const typename L::V a[3], const typename L::V b[3], const typename L::V c[3])
+	{
+		typedef typename L::V V;
+		typedef typename L::M M;
+
+		V e1[3], e2[3], pv[3], tv[3], qv[3];
+		PPK_Sub<L>(e1, b, a);
+		PPK_Sub<L>(e2, c, a);
+		PPK_Cross<L>(pv, dir, e2);
+
+		V inv = L::div(L::set1(1.0f), PPK_Dot<L>(e1, pv));
+
+		PPK_Sub<L>(tv, o, a);
+		V u = L::mul(PPK_Dot<L>(tv, pv), inv);
+
+		PPK_Cross<L>(qv, tv, e1);
+		V v = L::mul(PPK_Dot<L>(dir, qv), inv);
+		V t = L::mul(PPK_Dot<L>(e2, qv), inv);
+
+		V zero = L::set1(0.0f);
+		V one = L::set1(1.0f);
+
+		M hit = L::land(L::le(zero, u), L::le(zero, v));
+		hit = L::land(hit, L::le(L::add(u, v), one));
+		hit = L::land(hit, L::land(L::le(zero, t), L::le(t, one)));
+
+		return L::blend(hit, t, L::set1(INFINITY));
+	}
+
+	template<typename L>
+	void PPK_PointTriangles(const float p[3], const float* const tri[9], size_t num, float* distSq, float* u, float* v)
+	{
+		typedef typename L::V V;
+
+		V pv[3] = { L::set1(p[0]), L::set1(p[1]), L::set1(p[2]) };
+
+		for (size_t i = 0; i < num; i += L::W)
+		{
+			size_t rest = num - i;
+
+			V t[3][3];
+			for (int k = 0; k < 3; k++)
+				for (int d = 0; d < 3; d++)
+					t[k][d] = PPK_Load<L>(tri[3 * k + d], i, rest);
+
+			V d2, bu, bv;
+			PPK_PointTriangle<L>(pv, t[0], t[1], t[2], d2, bu, bv);
+
+			PPK_Store<L>(distSq, i, rest, d2);
+			PPK_Store<L>(u, i, rest, bu);
+			PPK_Store<L>(v, i, rest, bv);
+		}
+	}
+
+	template<typename L>
+	void PPK_PointsTriangle(const float* const points[3], const float tri[9], size_t num, float* distSq, float* u, float* v)
+	{
+		typedef typename L::V V;
+
+		V t[3][3];
+		for (int k = 0; k < 3; k++)
+			for (int d = 0; d < 3; d++)
+				t[k][d] = L::set1(tri[3 * k + d]);
+
+		for (size_t i = 0; i < num; i += L::W)
+		{
+			size_t rest = num - i;
+
+			V pv[3];
+			for (int d = 0; d < 3; d++)
+				pv[d] = PPK_Load<L>(points[d], i, rest);
+
+			V d2, bu, bv;
+			PPK_PointTriangle<L>(pv, t[0], t[1], t[2], d2, bu, bv);
+
+			PPK_Store<L>(distSq, i, rest, d2);
+			PPK_Store<L>(u, i, rest, bu);
+			PPK_Store<L>(v, i, rest, bv);
+		}
+	}
+
+	template<typename L>
+	void PPK_SegmentTriangles(const float p0[3], const float p1[3], const float* const tri[9], size_t num, float* t)
+	{
+		typedef typename L::V V;
+
+		V o[3], dir[3];
+		for (int d = 0; d < 3; d++)
+		{
+			o[d] = L::set1(p0[d]);
+			dir[d] = L::set1(p1[d] - p0[d]);
+		}
+
+		for (size_t i = 0; i < num; i += L::W)
+		{
+			size_t rest = num - i;
+
+			V v[3][3];
+			for (int k = 0; k < 3; k++)
+				for (int d = 0; d < 3; d++)
+					v[k][d] = PPK_Load<L>(tri[3 * k + d], i, rest);
+
+			PPK_Store<L>(t, i, rest, PPK_SegmentTriangle<L>(o, dir, v[0], v[1], v[2]));
+		}
+	}
+
+	template<typename L>
+	const PP_Kernels* PPK_Kernels()
+	{
+		static const PP_Kernels kernels = { PPK_PointTriangles<L>, PPK_PointsTriangle<L>, PPK_SegmentTriangles<L> };
+		return &kernels;
+	}
+}
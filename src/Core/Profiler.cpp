@@ -0,0 +1,353 @@
+#include "Profiler.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace dyno
+{
+	std::atomic<bool> Profiler::sEnabled(false);
+
+	const char* profileCategoryName(ProfileCategory category)
+	{
+		switch (category)
+		{
+		case ProfileCategory::Frame:
+			return "Frame";
+		case ProfileCategory::Node:
+			return "Node";
+		case ProfileCategory::Module:
+			return "Module";
+		case ProfileCategory::Kernel:
+			return "Kernel";
+		case ProfileCategory::IO:
+			return "IO";
+		default:
+			return "User";
+		}
+	}
+
+	static long long steadyNanoseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/**
+	 * Single producer buffer, only the owning thread appends events while any thread may read the published ones.
+	 */
+	struct Profiler::ThreadBuffer
+	{
+		static const size_t ChunkSize = 4096;
+
+		struct Chunk
+		{
+			ProfileEvent events[ChunkSize];
+			std::atomic<Chunk*> next{ nullptr };
+		};
+
+		explicit ThreadBuffer(unsigned int index)
+			: thread(index)
+			, head(new Chunk)
+			, size(0)
+		{
+			tail = head;
+		}
+
+		~ThreadBuffer()
+		{
+			Chunk* c = head;
+			while (c != nullptr)
+			{
+				Chunk* next = c->next.load(std::memory_order_relaxed);
+				delete c;
+				c = next;
+			}
+		}
+
+		void push(const ProfileEvent& e)
+		{
+			size_t n = size.load(std::memory_order_relaxed);
+			size_t offset = n % ChunkSize;
+
+			if (n > 0 && offset == 0)
+			{
+				// Chunks are kept after clear(), reuse them before allocating new ones
+				Chunk* next = tail->next.load(std::memory_order_relaxed);
+				if (next == nullptr)
+				{
+					next = new Chunk;
+					tail->next.store(next, std::memory_order_release);
+				}
+				tail = next;
+			}
+
+			tail->events[offset] = e;
+			tail->events[offset].thread = thread;
+
+			size.store(n + 1, std::memory_order_release);
+		}
+
+		template<typename Function>
+		void forEach(Function func) const
+		{
+			size_t n = size.load(std::memory_order_acquire);
+
+			const Chunk* c = head;
+			for (size_t i = 0; i < n; i++)
+			{
+				if (i > 0 && i % ChunkSize == 0)
+					c = c->next.load(std::memory_order_acquire);
+
+				func(c->events[i % ChunkSize]);
+			}
+		}
+
+		void clear()
+		{
+			size.store(0, std::memory_order_release);
+			tail = head;
+		}
+
+		unsigned int thread;
+
+		Chunk* head;
+		Chunk* tail;
+
+		std::atomic<size_t> size;
+	};
+
+	// Nesting depth of the zones opened by the calling thread
+	static thread_local unsigned int tDepth = 0;
+
+	Profiler* Profiler::instance()
+	{
+		// Never destroyed, worker threads may still record zones during static destruction
+		static Profiler* ins = new Profiler();
+		return ins;
+	}
+
+	Profiler::Profiler()
+	{
+		mEpoch = steadyNanoseconds();
+	}
+
+	Profiler::~Profiler()
+	{
+	}
+
+	Profiler::ThreadBuffer* Profiler::threadBuffer()
+	{
+		static thread_local ThreadBuffer* tBuffer = nullptr;
+
+		if (tBuffer == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mBuffers.emplace_back(new ThreadBuffer((unsigned int)mBuffers.size()));
+			tBuffer = mBuffers.back().get();
+		}
+
+		return tBuffer;
+	}
+
+	const char* Profiler::intern(const std::string& name)
+	{
+		static thread_local std::unordered_map<std::string, const char*> tCache;
+
+		auto it = tCache.find(name);
+		if (it != tCache.end())
+			return it->second;
+
+		const char* str = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			str = mNames.insert(name).first->c_str();
+		}
+
+		tCache[name] = str;
+
+		return str;
+	}
+
+	long long Profiler::now() const
+	{
+		return steadyNanoseconds() - mEpoch;
+	}
+
+	void Profiler::record(const char* name, ProfileCategory category, unsigned long long instance, long long begin, long long end, unsigned int depth)
+	{
+		ProfileEvent e;
+		e.name = name;
+		e.instance = instance;
+		e.begin = begin;
+		e.end = end;
+		e.thread = 0;
+		e.depth = depth;
+		e.category = category;
+
+		this->threadBuffer()->push(e);
+	}
+
+	std::vector<ProfileEvent> Profiler::events() const
+	{
+		std::vector<ProfileEvent> ret;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			for (auto& buffer : mBuffers)
+			{
+				buffer->forEach([&](const ProfileEvent& e) { ret.push_back(e); });
+			}
+		}
+
+		std::stable_sort(ret.begin(), ret.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+			return a.begin < b.begin;
+		});
+
+		return ret;
+	}
+
+	std::vector<ProfileStatistics> Profiler::statistics(bool perInstance) const
+	{
+		typedef std::tuple<std::string, ProfileCategory, unsigned long long> Key;
+		std::map<Key, std::vector<double>> durations;
+
+		for (auto& e : this->events())
+		{
+			Key key(e.name, e.category, perInstance ? e.instance : 0);
+			durations[key].push_back(double(e.end - e.begin) * 1e-6);
+		}
+
+		// Nearest-rank percentile of a sorted sequence
+		auto percentile = [](const std::vector<double>& sorted, double p) -> double {
+			size_t rank = (size_t)std::ceil(p * sorted.size());
+			return sorted[rank > 0 ? rank - 1 : 0];
+		};
+
+		std::vector<ProfileStatistics> ret;
+		for (auto& d : durations)
+		{
+			std::vector<double>& t = d.second;
+			std::sort(t.begin(), t.end());
+
+			ProfileStatistics stat;
+			stat.name = std::get<0>(d.first);
+			stat.category = std::get<1>(d.first);
+			stat.instance = std::get<2>(d.first);
+			stat.count = t.size();
+			for (auto v : t) stat.total += v;
+			stat.mean = stat.total / t.size();
+			stat.min = t.front();
+			stat.max = t.back();
+			stat.p50 = percentile(t, 0.5);
+			stat.p99 = percentile(t, 0.99);
+
+			ret.push_back(stat);
+		}
+
+		return ret;
+	}
+
+	static std::string escapeJson(const char* str)
+	{
+		std::string ret;
+		for (const char* c = str; *c != '\0'; c++)
+		{
+			switch (*c)
+			{
+			case '"':
+				ret += "\\\"";
+				break;
+			case '\\':
+				ret += "\\\\";
+				break;
+			case '\n':
+				ret += "\\n";
+				break;
+			case '\t':
+				ret += "\\t";
+				break;
+			default:
+				if ((unsigned char)*c >= 0x20)
+					ret += *c;
+			}
+		}
+		return ret;
+	}
+
+	bool Profiler::exportChromeTrace(const std::string& filename) const
+	{
+		std::ofstream output(filename, std::ios::out);
+		if (!output.is_open())
+			return false;
+
+		auto events = this->events();
+
+		output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		char buf[128];
+		for (size_t i = 0; i < events.size(); i++)
+		{
+			const ProfileEvent& e = events[i];
+
+			// Complete events, time stamps are in microseconds
+			snprintf(buf, sizeof(buf), "\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+				e.thread, e.begin * 1e-3, (e.end - e.begin) * 1e-3);
+
+			output << (i == 0 ? "\n" : ",\n")
+				<< "{\"name\":\"" << escapeJson(e.name) << "\",\"cat\":\"" << profileCategoryName(e.category) << "\","
+				<< buf
+				<< ",\"args\":{\"instance\":" << e.instance << ",\"depth\":" << e.depth << "}}";
+		}
+
+		output << "\n]}\n";
+
+		return output.good();
+	}
+
+	void Profiler::clear()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (auto& buffer : mBuffers)
+		{
+			buffer->clear();
+		}
+	}
+
+	ProfileZone::ProfileZone(const char* name, ProfileCategory category, unsigned long long instance)
+		: mName(name)
+		, mInstance(instance)
+		, mBegin(0)
+		, mDepth(0)
+		, mCategory(category)
+		, mActive(Profiler::isEnabled())
+	{
+		if (mActive)
+		{
+			mDepth = tDepth++;
+			mBegin = Profiler::instance()->now();
+		}
+	}
+
+	ProfileZone::ProfileZone(const std::string& name, ProfileCategory category, unsigned long long instance)
+		: ProfileZone((const char*)nullptr, category, instance)
+	{
+		if (mActive)
+			mName = Profiler::instance()->intern(name);
+	}
+
+	ProfileZone::~ProfileZone()
+	{
+		if (mActive)
+		{
+			Profiler* profiler = Profiler::instance();
+			profiler->record(mName, mCategory, mInstance, mBegin, profiler->now(), mDepth);
+			tDepth--;
+		}
+	}
+}
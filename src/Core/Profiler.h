@@ -0,0 +1,174 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_set>
+
+namespace dyno
+{
+	enum class ProfileCategory : unsigned char
+	{
+		Frame,
+		Node,
+		Module,
+		Kernel,
+		IO,
+		User
+	};
+
+	const char* profileCategoryName(ProfileCategory category);
+
+	/**
+	 * @brief A closed zone, time stamps are in nanoseconds since the profiler was created
+	 */
+	struct ProfileEvent
+	{
+		const char* name;
+		unsigned long long instance;
+		long long begin;
+		long long end;
+		unsigned int thread;
+		unsigned int depth;
+		ProfileCategory category;
+	};
+
+	/**
+	 * @brief Aggregated durations of all zones sharing the same name and category (and instance if requested), in milliseconds
+	 */
+	struct ProfileStatistics
+	{
+		std::string name;
+		ProfileCategory category;
+		unsigned long long instance = 0;
+
+		size_t count = 0;
+		double total = 0.0;
+		double mean = 0.0;
+		double min = 0.0;
+		double max = 0.0;
+		double p50 = 0.0;
+		double p99 = 0.0;
+	};
+
+	/**
+	 * @brief A hierarchical profiler recording scoped zones of all threads.
+	 *
+	 * Each thread appends its zones to its own buffer, recording does not take any lock once
+	 * the buffer of a thread has been registered. Buffers are made of fixed-size chunks that are
+	 * never moved, so the recorded events can be read while other threads keep recording.
+	 *
+	 * Recording is disabled by default, a disabled zone costs a single atomic load.
+	 *
+	 * Note: this header is included by Platform.h, do not include Platform.h here.
+	 */
+	class Profiler
+	{
+	public:
+		static Profiler* instance();
+
+		static bool isEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+		static void setEnabled(bool enabled) { sEnabled.store(enabled, std::memory_order_relaxed); }
+
+		/**
+		 * @brief Return a pointer to a copy of name that stays valid as long as the profiler, zones only keep the pointer of their names.
+		 */
+		const char* intern(const std::string& name);
+
+		/**
+		 * @brief Current time in nanoseconds since the profiler was created
+		 */
+		long long now() const;
+
+		void record(const char* name, ProfileCategory category, unsigned long long instance, long long begin, long long end, unsigned int depth);
+
+		/**
+		 * @brief Snapshot of all events recorded so far, sorted by begin time
+		 */
+		std::vector<ProfileEvent> events() const;
+
+		/**
+		 * @brief Aggregate the recorded zones per name and category.
+		 *
+		 * @param perInstance zones of different instances (e.g., two nodes of the same class) are reported separately
+		 */
+		std::vector<ProfileStatistics> statistics(bool perInstance = false) const;
+
+		/**
+		 * @brief Write all recorded zones in the Chrome trace event format, the file can be opened with chrome://tracing or Perfetto
+		 */
+		bool exportChromeTrace(const std::string& filename) const;
+
+		/**
+		 * @brief Discard all recorded events, must not be called while zones are being recorded.
+		 */
+		void clear();
+
+	private:
+		Profiler();
+		~Profiler();
+
+		struct ThreadBuffer;
+		ThreadBuffer* threadBuffer();
+
+		long long mEpoch;
+
+		mutable std::mutex mMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+		std::unordered_set<std::string> mNames;
+
+		static std::atomic<bool> sEnabled;
+	};
+
+	/**
+	 * @brief RAII zone, the time between construction and destruction is recorded if the profiler is enabled.
+	 *
+	 * name must stay valid as long as the profiler, use a string literal or Profiler::intern().
+	 */
+	class ProfileZone
+	{
+	public:
+		ProfileZone(const char* name, ProfileCategory category = ProfileCategory::User, unsigned long long instance = 0);
+
+		/**
+		 * @brief name is interned only if the profiler is enabled
+		 */
+		ProfileZone(const std::string& name, ProfileCategory category = ProfileCategory::User, unsigned long long instance = 0);
+		~ProfileZone();
+
+	private:
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+
+		const char* mName;
+		unsigned long long mInstance;
+		long long mBegin;
+		unsigned int mDepth;
+		ProfileCategory mCategory;
+		bool mActive;
+	};
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Profile the enclosing scope, e.g., PROFILE_ZONE("Solve", dyno::ProfileCategory::User)
+ */
+#define PROFILE_ZONE(...) dyno::ProfileZone PROFILE_CONCAT(_profileZone, __LINE__)(__VA_ARGS__)
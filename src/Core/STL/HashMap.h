@@ -0,0 +1,98 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include "HashTable.h"
+
+namespace dyno
+{
+	/**
+	 * @brief A lock-free hash map from integral keys to values, see HashTable for the requirements on the key buffer.
+	 *
+	 * Values are stored in a separate buffer of the same capacity and addressed by slot. insert() only claims the slot
+	 * 	of a key, values are written or accumulated atomically through the slot by the caller, e.g.,
+	 * 	"int slot = map.insert(key); atomicAdd(&map.value(slot), 1);".
+	 * 	A third buffer holds a ready flag per slot, insert(key, val) sets it with release semantics after writing the value
+	 * 	and get() reads it with acquire semantics, so a value published by insert() is never read before it is written.
+	 */
+	template <typename TKey, typename T>
+	class HashMap : public HashTable<TKey>
+	{
+	public:
+		DYN_FUNC HashMap() : HashTable<TKey>() {};
+
+		/**
+		 * @brief Attach the buffers, ready holds one flag per slot and must be zero-filled together with keys
+		 */
+		DYN_FUNC void reserve(TKey* keys, T* values, uint* ready, uint capacity)
+		{
+			HashTable<TKey>::reserve(keys, capacity);
+			m_values = values;
+			m_ready = ready;
+		}
+
+		/**
+		 * @brief Insert a key and write its value if the key is new, return the slot or -1 if the table is full
+		 */
+		DYN_FUNC int insert(const TKey key, const T val)
+		{
+			Slot s = (Slot)key + 1;
+
+			uint mask = this->m_capacity - 1;
+			uint id = HashTable<TKey>::hash(s) & mask;
+
+			for (uint i = 0; i < this->m_capacity; i++)
+			{
+				Slot prev = HT_AtomicCAS(this->m_slots + id, Slot(0), s);
+				if (prev == 0)
+				{
+					//The key is visible to other threads at this point, get() only hands out the value once it is ready
+					m_values[id] = val;
+					HT_AtomicStore(m_ready + id, 1u);
+					return (int)id;
+				}
+
+				if (prev == s)
+					return (int)id;
+
+				id = (id + 1) & mask;
+			}
+
+			return -1;
+		}
+
+		/**
+		 * @brief Insert a key only, its value keeps the content of the buffer, e.g., zero for counters updated atomically
+		 */
+		DYN_FUNC int insert(const TKey key)
+		{
+			int slot = HashTable<TKey>::insert(key);
+			if (slot >= 0 && HT_AtomicLoad(m_ready + slot) == 0)
+				HT_AtomicStore(m_ready + slot, 1u);
+
+			return slot;
+		}
+
+		DYN_FUNC inline T& value(const uint slot) { return m_values[slot]; }
+		DYN_FUNC inline const T& value(const uint slot) const { return m_values[slot]; }
+
+		/**
+		 * @brief Return a pointer to the value of a key, nullptr if not found or the value of a concurrent insertion is not written yet
+		 */
+		DYN_FUNC T* get(const TKey key)
+		{
+			int slot = this->find(key);
+			if (slot < 0 || HT_AtomicLoad(m_ready + slot) == 0)
+				return nullptr;
+
+			return m_values + slot;
+		}
+
+	private:
+		typedef typename HashTable<TKey>::Slot Slot;
+
+		T* m_values = nullptr;
+		uint* m_ready = nullptr;
+	};
+}
+
+#endif // HASHMAP_H
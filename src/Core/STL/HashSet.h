@@ -0,0 +1,49 @@
+#ifndef HASHSET_H
+#define HASHSET_H
+
+#include "HashTable.h"
+
+namespace dyno
+{
+	/**
+	 * @brief A lock-free hash set of integral keys, see HashTable for the requirements on the buffer.
+	 *
+	 * A typical use is to deduplicate keys in a single pass: each thread inserts its key and keeps the element
+	 * 	whose insertion claimed the slot, i.e., insertFirst() returned true.
+	 */
+	template <typename TKey>
+	class HashSet : public HashTable<TKey>
+	{
+	public:
+		typedef typename HashTable<TKey>::Slot Slot;
+
+		DYN_FUNC HashSet() : HashTable<TKey>() {};
+
+		/**
+		 * @brief Insert a key, return true only for the call that added it to the set
+		 */
+		DYN_FUNC bool insertFirst(const TKey key)
+		{
+			Slot s = (Slot)key + 1;
+
+			uint mask = this->m_capacity - 1;
+			uint id = HashTable<TKey>::hash(s) & mask;
+
+			for (uint i = 0; i < this->m_capacity; i++)
+			{
+				Slot prev = HT_AtomicCAS(this->m_slots + id, Slot(0), s);
+				if (prev == 0)
+					return true;
+
+				if (prev == s)
+					return false;
+
+				id = (id + 1) & mask;
+			}
+
+			return false;
+		}
+	};
+}
+
+#endif // HASHSET_H
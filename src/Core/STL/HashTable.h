@@ -0,0 +1,74 @@
+#ifndef HASHTABLE_H
+#define HASHTABLE_H
+
+#include "Platform.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Storage type of a key in a hash table, keys of 4 and 8 bytes are supported
+	 */
+	template<int Bytes> struct HashSlot;
+	template<> struct HashSlot<4> { typedef unsigned int Type; };
+	template<> struct HashSlot<8> { typedef unsigned long long Type; };
+
+	/**
+	 * @brief Base of HashSet and HashMap, a fixed-capacity open-addressing table with lock-free insertion.
+	 *
+	 * The table does not own memory, a buffer of capacity slots is attached by reserve() like the other containers in STL.
+	 * 	Slots store key + 1 so that a zero-filled buffer (e.g. after DArray::reset()) is an empty table,
+	 * 	as a result the key with all bits set (e.g., -1 for int) can not be inserted. The capacity must be a power of two,
+	 * 	use capacityFor() to size the buffer. Elements can not be erased.
+	 *
+	 * insert(), find() and contains() may be called concurrently from kernels or host threads.
+	 *
+	 * @tparam TKey an integral type of 4 or 8 bytes, e.g., uint, int or unsigned long long
+	 */
+	template <typename TKey>
+	class HashTable
+	{
+	public:
+		typedef typename HashSlot<sizeof(TKey)>::Type Slot;
+
+		DYN_FUNC HashTable() {};
+
+		DYN_FUNC void reserve(TKey* buf, uint capacity)
+		{
+			m_slots = (Slot*)buf;
+			m_capacity = capacity;
+		}
+
+		/**
+		 * @brief Insert a key, return its slot or -1 if the table is full. The slot of an existing key is returned if inserted before.
+		 */
+		DYN_FUNC int insert(const TKey key);
+
+		/**
+		 * @brief Return the slot of a key or -1 if not found
+		 */
+		DYN_FUNC int find(const TKey key) const;
+
+		DYN_FUNC inline bool contains(const TKey key) const { return this->find(key) >= 0; }
+
+		DYN_FUNC inline bool occupied(const uint slot) const { return m_slots[slot] != 0; }
+
+		DYN_FUNC inline TKey key(const uint slot) const { return (TKey)(m_slots[slot] - 1); }
+
+		DYN_FUNC inline uint capacity() const { return m_capacity; }
+
+		/**
+		 * @brief Smallest power of two capacity that keeps the load factor of n elements at most 1/2
+		 */
+		DYN_FUNC static uint capacityFor(const uint n);
+
+		DYN_FUNC static uint hash(const Slot s);
+
+	protected:
+		Slot* m_slots = nullptr;
+		uint m_capacity = 0;
+	};
+}
+
+#include "HashTable.inl"
+
+#endif // HASHTABLE_H
@@ -0,0 +1,129 @@
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace dyno
+{
+	/**
+	 * @brief Compare-and-swap usable from both kernels and host threads, return the value before the operation
+	 */
+	template<typename Slot>
+	DYN_FUNC inline Slot HT_AtomicCAS(Slot* address, Slot compare, Slot val)
+	{
+#if defined(__CUDA_ARCH__)
+		return atomicCAS(address, compare, val);
+#elif defined(_MSC_VER)
+		if (sizeof(Slot) == 4)
+			return (Slot)_InterlockedCompareExchange((volatile long*)address, (long)val, (long)compare);
+		else
+			return (Slot)_InterlockedCompareExchange64((volatile long long*)address, (long long)val, (long long)compare);
+#else
+		__atomic_compare_exchange_n(address, &compare, val, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+		return compare;
+#endif
+	}
+
+	/**
+	 * @brief Load with acquire semantics, writes made before the matching HT_AtomicStore are visible afterwards
+	 */
+	template<typename Slot>
+	DYN_FUNC inline Slot HT_AtomicLoad(const Slot* address)
+	{
+#if defined(__CUDA_ARCH__)
+		Slot val = *(const volatile Slot*)address;
+		__threadfence();
+		return val;
+#elif defined(_MSC_VER)
+		return *(const volatile Slot*)address;
+#else
+		return __atomic_load_n(address, __ATOMIC_ACQUIRE);
+#endif
+	}
+
+	/**
+	 * @brief Store with release semantics
+	 */
+	template<typename Slot>
+	DYN_FUNC inline void HT_AtomicStore(Slot* address, Slot val)
+	{
+#if defined(__CUDA_ARCH__)
+		__threadfence();
+		*(volatile Slot*)address = val;
+#elif defined(_MSC_VER)
+		*(volatile Slot*)address = val;
+#else
+		__atomic_store_n(address, val, __ATOMIC_RELEASE);
+#endif
+	}
+
+	template <typename TKey>
+	DYN_FUNC uint HashTable<TKey>::hash(const Slot s)
+	{
+		//Finalizer of MurmurHash3, the high bits of 64-bit keys are folded in first
+		unsigned long long h = (unsigned long long)s;
+		uint x = (uint)(h ^ (h >> 32));
+
+		x ^= x >> 16;
+		x *= 0x85ebca6bu;
+		x ^= x >> 13;
+		x *= 0xc2b2ae35u;
+		x ^= x >> 16;
+
+		return x;
+	}
+
+	template <typename TKey>
+	DYN_FUNC uint HashTable<TKey>::capacityFor(const uint n)
+	{
+		uint capacity = 16;
+		while (capacity < 2 * n)
+			capacity <<= 1;
+
+		return capacity;
+	}
+
+	template <typename TKey>
+	DYN_FUNC int HashTable<TKey>::insert(const TKey key)
+	{
+		Slot s = (Slot)key + 1;
+
+		uint mask = m_capacity - 1;
+		uint id = hash(s) & mask;
+
+		//Linear probing, at most one pass over the table
+		for (uint i = 0; i < m_capacity; i++)
+		{
+			Slot prev = HT_AtomicCAS(m_slots + id, Slot(0), s);
+			if (prev == 0 || prev == s)
+				return (int)id;
+
+			id = (id + 1) & mask;
+		}
+
+		return -1;
+	}
+
+	template <typename TKey>
+	DYN_FUNC int HashTable<TKey>::find(const TKey key) const
+	{
+		Slot s = (Slot)key + 1;
+
+		uint mask = m_capacity - 1;
+		uint id = hash(s) & mask;
+
+		for (uint i = 0; i < m_capacity; i++)
+		{
+			Slot cur = HT_AtomicLoad(m_slots + id);
+			if (cur == s)
+				return (int)id;
+
+			//Keys are never erased, an empty slot ends the probe sequence
+			if (cur == 0)
+				return -1;
+
+			id = (id + 1) & mask;
+		}
+
+		return -1;
+	}
+}
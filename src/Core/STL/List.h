@@ -54,7 +54,7 @@ namespace dyno
 
 		DYN_FUNC inline iterator insert(T val);
 
-#ifdef CUDA_BACKEND
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
 		GPU_FUNC inline iterator atomicInsert(T val);
 #endif
 
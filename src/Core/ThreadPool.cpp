@@ -0,0 +1,269 @@
+#include "ThreadPool.h"
+
+namespace dyno
+{
+	std::atomic<ThreadPool*> ThreadPool::pInstance;
+	std::mutex ThreadPool::mInstanceMutex;
+
+	// Worker identity of the calling thread
+	static thread_local const ThreadPool* tOwner = nullptr;
+	static thread_local int tWorkerId = -1;
+
+	//Thread-safe singleton mode
+	ThreadPool* ThreadPool::instance()
+	{
+		ThreadPool* ins = pInstance.load(std::memory_order_acquire);
+		if (!ins) {
+			std::lock_guard<std::mutex> tLock(mInstanceMutex);
+			ins = pInstance.load(std::memory_order_relaxed);
+			if (!ins) {
+				ins = new ThreadPool();
+				pInstance.store(ins, std::memory_order_release);
+			}
+		}
+
+		return ins;
+	}
+
+	ThreadPool::ThreadPool(unsigned int numThreads)
+		: mPending(0)
+		, mNextQueue(0)
+		, mRunning(false)
+	{
+		this->start(numThreads);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		this->stop();
+	}
+
+	void ThreadPool::setThreadNumber(unsigned int n)
+	{
+		this->stop();
+		this->start(n);
+	}
+
+	void ThreadPool::start(unsigned int n)
+	{
+		if (n == 0)
+			n = std::thread::hardware_concurrency();
+
+		n = n == 0 ? 1 : n;
+
+		mRunning = true;
+
+		mQueues.clear();
+		for (unsigned int i = 0; i < n; i++)
+			mQueues.emplace_back(new WorkQueue);
+
+		for (unsigned int i = 0; i < n; i++)
+			mThreads.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+
+	void ThreadPool::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mSleepMutex);
+			mRunning = false;
+		}
+		mWakeUp.notify_all();
+
+		for (auto& t : mThreads)
+		{
+			if (t.joinable())
+				t.join();
+		}
+
+		mThreads.clear();
+
+		// Execute the tasks left behind, so that no TaskGroup waits forever
+		Task task;
+		for (unsigned int i = 0; i < mQueues.size(); i++)
+		{
+			while (popTask(i, task))
+				task();
+		}
+	}
+
+	void ThreadPool::submit(Task task)
+	{
+		unsigned int n = (unsigned int)mQueues.size();
+		unsigned int id = tOwner == this && tWorkerId >= 0 ? (unsigned int)tWorkerId : mNextQueue++ % n;
+
+		{
+			std::lock_guard<std::mutex> lock(mQueues[id]->mtx);
+			mQueues[id]->tasks.push_back(std::move(task));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mSleepMutex);
+			mPending++;
+		}
+		mWakeUp.notify_one();
+	}
+
+	bool ThreadPool::popTask(unsigned int id, Task& task)
+	{
+		unsigned int n = (unsigned int)mQueues.size();
+
+		//Take the most recent task from the own queue
+		{
+			WorkQueue& q = *mQueues[id];
+			std::lock_guard<std::mutex> lock(q.mtx);
+			if (!q.tasks.empty())
+			{
+				task = std::move(q.tasks.back());
+				q.tasks.pop_back();
+				mPending--;
+				return true;
+			}
+		}
+
+		//Steal the oldest task from the others
+		for (unsigned int k = 1; k < n; k++)
+		{
+			WorkQueue& q = *mQueues[(id + k) % n];
+			std::lock_guard<std::mutex> lock(q.mtx);
+			if (!q.tasks.empty())
+			{
+				task = std::move(q.tasks.front());
+				q.tasks.pop_front();
+				mPending--;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool ThreadPool::tryRunOne()
+	{
+		if (mQueues.empty() || mPending.load() == 0)
+			return false;
+
+		unsigned int id = tOwner == this && tWorkerId >= 0 ? (unsigned int)tWorkerId : mNextQueue.load() % (unsigned int)mQueues.size();
+
+		Task task;
+		if (popTask(id, task))
+		{
+			task();
+			return true;
+		}
+
+		return false;
+	}
+
+	int ThreadPool::workerIndex() const
+	{
+		return tOwner == this ? tWorkerId : -1;
+	}
+
+	void ThreadPool::workerLoop(unsigned int id)
+	{
+		tOwner = this;
+		tWorkerId = (int)id;
+
+		Task task;
+		while (true)
+		{
+			if (popTask(id, task))
+			{
+				task();
+				task = nullptr;
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(mSleepMutex);
+			mWakeUp.wait(lock, [this] { return mPending.load() > 0 || !mRunning; });
+
+			if (!mRunning)
+				break;
+		}
+
+		tOwner = nullptr;
+		tWorkerId = -1;
+	}
+
+	void ThreadPool::parallelFor(unsigned int begin, unsigned int end, const std::function<void(unsigned int, unsigned int)>& body, unsigned int grain)
+	{
+		if (end <= begin)
+			return;
+
+		unsigned int total = end - begin;
+		unsigned int nThreads = this->threadNumber();
+
+		if (grain == 0)
+			grain = mGrainSize;
+
+		//By default, create about four tasks per worker to balance the load
+		if (grain == 0)
+			grain = (total + 4 * nThreads - 1) / (4 * nThreads);
+
+		grain = grain == 0 ? 1 : grain;
+
+		if (total <= grain || nThreads <= 1)
+		{
+			body(begin, end);
+			return;
+		}
+
+		TaskGroup group(this);
+		for (unsigned int first = begin; first < end; first += grain)
+		{
+			unsigned int last = end - first > grain ? first + grain : end;
+			group.run([&body, first, last]() { body(first, last); });
+		}
+		group.wait();
+	}
+
+	TaskGroup::TaskGroup(ThreadPool* pool)
+		: mPool(pool)
+		, mCount(0)
+	{
+	}
+
+	TaskGroup::~TaskGroup()
+	{
+		//Tasks reference this group, make sure all of them are finished
+		while (mCount.load() > 0)
+		{
+			if (!mPool->tryRunOne())
+				std::this_thread::yield();
+		}
+	}
+
+	void TaskGroup::run(ThreadPool::Task task)
+	{
+		mCount++;
+		mPool->submit([this, task]() {
+			try {
+				task();
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(mMutex);
+				if (!mException)
+					mException = std::current_exception();
+			}
+			mCount--;
+		});
+	}
+
+	void TaskGroup::wait()
+	{
+		while (mCount.load() > 0)
+		{
+			if (!mPool->tryRunOne())
+				std::this_thread::yield();
+		}
+
+		std::exception_ptr e;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			std::swap(e, mException);
+		}
+
+		if (e)
+			std::rethrow_exception(e);
+	}
+}
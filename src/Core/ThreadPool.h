@@ -0,0 +1,140 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+
+namespace dyno
+{
+	/**
+	 * @brief A work-stealing thread pool shared by all host-side parallel code.
+	 *
+	 * Each worker owns a task queue. Tasks submitted from a worker go to its own queue and are
+	 * executed in LIFO order, idle workers steal from the front of the other queues.
+	 * Threads waiting for a TaskGroup help executing pending tasks, so nested parallelism does not deadlock.
+	 *
+	 * Note: this header is included by Platform.h on the CPU backend, do not include Platform.h here.
+	 */
+	class ThreadPool
+	{
+	public:
+		typedef std::function<void()> Task;
+
+		static ThreadPool* instance();
+
+		/**
+		 * @brief Create a pool with numThreads workers, 0 means one worker per hardware thread.
+		 */
+		explicit ThreadPool(unsigned int numThreads = 0);
+		~ThreadPool();
+
+		/**
+		 * @brief Stop all workers and restart the pool with n workers, 0 means one worker per hardware thread.
+		 * 	Must not be called while tasks are running.
+		 */
+		void setThreadNumber(unsigned int n);
+		unsigned int threadNumber() const { return (unsigned int)mThreads.size(); }
+
+		/**
+		 * @brief Set the default number of iterations executed by a single task in parallelFor, 0 means automatic.
+		 */
+		void setGrainSize(unsigned int grain) { mGrainSize = grain; }
+		unsigned int grainSize() const { return mGrainSize; }
+
+		void submit(Task task);
+
+		/**
+		 * @brief Pop one pending task and execute it in the calling thread.
+		 *
+		 * @return false if no task is pending
+		 */
+		bool tryRunOne();
+
+		/**
+		 * @brief Execute body(first, last) over sub-ranges of [begin, end) and wait for all of them to finish.
+		 *
+		 * @param grain number of iterations per task, 0 means grainSize() is used
+		 */
+		void parallelFor(unsigned int begin, unsigned int end, const std::function<void(unsigned int, unsigned int)>& body, unsigned int grain = 0);
+
+		/**
+		 * @brief Index of the calling worker thread in this pool, -1 if it is not a worker thread of this pool.
+		 */
+		int workerIndex() const;
+
+	private:
+		struct WorkQueue
+		{
+			std::mutex mtx;
+			std::deque<Task> tasks;
+		};
+
+		void start(unsigned int n);
+		void stop();
+
+		void workerLoop(unsigned int id);
+
+		bool popTask(unsigned int id, Task& task);
+
+		std::vector<std::thread> mThreads;
+		std::vector<std::unique_ptr<WorkQueue>> mQueues;
+
+		std::mutex mSleepMutex;
+		std::condition_variable mWakeUp;
+
+		std::atomic<unsigned int> mPending;
+		std::atomic<unsigned int> mNextQueue;
+		std::atomic<bool> mRunning;
+
+		unsigned int mGrainSize = 0;
+
+		static std::atomic<ThreadPool*> pInstance;
+		static std::mutex mInstanceMutex;
+	};
+
+	/**
+	 * @brief A set of tasks that can be waited for as a whole.
+	 */
+	class TaskGroup
+	{
+	public:
+		explicit TaskGroup(ThreadPool* pool = ThreadPool::instance());
+		~TaskGroup();
+
+		void run(ThreadPool::Task task);
+
+		/**
+		 * @brief Block until all tasks finish, the calling thread executes pending tasks while waiting.
+		 * 	The first exception thrown by a task is rethrown here.
+		 */
+		void wait();
+
+	private:
+		ThreadPool* mPool;
+
+		std::atomic<unsigned int> mCount;
+
+		std::mutex mMutex;
+		std::exception_ptr mException;
+	};
+}
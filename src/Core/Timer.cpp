@@ -42,7 +42,7 @@ namespace dyno
 	{
 #if (defined __unix__) || (defined __APPLE__)
 		double elapsed_time = 1.0 * (stop_sec_ - start_sec_) + 1.0e-6 * (stop_micro_sec_ - start_micro_sec_);
-		return elapsed_time;
+		return 1000.0 * elapsed_time;
 #elif (defined _WIN32)
 		double elapsed_time = static_cast<double>(stop_count_.QuadPart - start_count_.QuadPart) / static_cast<double>(timer_frequency_.QuadPart);
 		return 1000.0 * elapsed_time;
@@ -13,10 +13,15 @@
 #include <vector_types.h>
 #include <vector_functions.h>
 #endif // CUDA_BACKEDN
+#ifdef CPU_BACKEND
+#include "Backend/Cpu/CpuRuntime.h"
+#endif // CPU_BACKEND
 #include <iostream>
 #include <stdexcept>
 #include <limits>
 
+#include "Profiler.h"
+
 #ifdef PRECISION_FLOAT
 typedef float Real;
 #else
@@ -40,7 +45,7 @@ namespace dyno {
 	constexpr Real REAL_MIN = (std::numeric_limits<Real>::min)();
 	constexpr uint BLOCK_SIZE = 64;
 
-#ifdef CUDA_BACKEND
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
 	static uint iDivUp(uint a, uint b)
 	{
 		return (a % b != 0) ? (a / b + 1) : (a / b);
@@ -93,7 +98,9 @@ namespace dyno {
 
 		return gridDims;
 	}
+#endif
 
+#ifdef CUDA_BACKEND
 	/** check whether cuda thinks there was an error and fail with msg, if this is the case
 	* @ingroup tools
 	*/
@@ -136,8 +143,11 @@ namespace dyno {
   *
   * size: indicate how many threads are required in total.
   * Func: kernel function
+  *
+  * Launches are recorded as Profiler zones, kernels run asynchronously so only debug builds include the execution time.
   */
 #define cuExecute(size, Func, ...){						\
+		dyno::ProfileZone _kernelZone(#Func, dyno::ProfileCategory::Kernel);	\
 		uint pDims = cudaGridSize((uint)size, BLOCK_SIZE);	\
 		Func << <pDims, BLOCK_SIZE >> > (				\
 		__VA_ARGS__);									\
@@ -145,6 +155,7 @@ namespace dyno {
 	}
 
 #define cuExecute2D(size, Func, ...){						\
+		dyno::ProfileZone _kernelZone(#Func, dyno::ProfileCategory::Kernel);	\
 		uint3 pDims = cudaGridSize2D(size, 8);				\
 		dim3 threadsPerBlock(8, 8, 1);		\
 		Func << <pDims, threadsPerBlock >> > (				\
@@ -153,6 +164,7 @@ namespace dyno {
 	}
 
 #define cuExecute3D(size, Func, ...){						\
+		dyno::ProfileZone _kernelZone(#Func, dyno::ProfileCategory::Kernel);	\
 		dim3 pDims = cudaGridSize3D(size, 8);		\
 		dim3 threadsPerBlock(8, 8, 8);		\
 		Func << <pDims, threadsPerBlock >> > (				\
@@ -162,6 +174,39 @@ namespace dyno {
 
 #endif
 
+#ifdef CPU_BACKEND
+	// Kernels are executed by the host, there is no asynchronous error to check
+#define cuSafeCall(X) X
+#define cuSynchronize() {}
+
+/**
+ * @brief Macro definition for execuation of kernels on the CPU backend, the blocks are distributed over the ThreadPool.
+ *
+ * size: indicate how many threads are required in total.
+ * Func: kernel function
+ */
+#define cuExecute(size, Func, ...){						\
+		dyno::ProfileZone _kernelZone(#Func, dyno::ProfileCategory::Kernel);	\
+		uint pDims = cudaGridSize((uint)size, BLOCK_SIZE);	\
+		dyno::cpuExecuteKernel(dim3(pDims), dim3(BLOCK_SIZE), [&]() {	\
+			Func(__VA_ARGS__); });						\
+	}
+
+#define cuExecute2D(size, Func, ...){						\
+		dyno::ProfileZone _kernelZone(#Func, dyno::ProfileCategory::Kernel);	\
+		uint3 pDims = cudaGridSize2D(size, 8);				\
+		dyno::cpuExecuteKernel(pDims, dim3(8, 8, 1), [&]() {	\
+			Func(__VA_ARGS__); });							\
+	}
+
+#define cuExecute3D(size, Func, ...){						\
+		dyno::ProfileZone _kernelZone(#Func, dyno::ProfileCategory::Kernel);	\
+		dim3 pDims = cudaGridSize3D(size, 8);				\
+		dyno::cpuExecuteKernel(pDims, dim3(8, 8, 8), [&]() {	\
+			Func(__VA_ARGS__); });							\
+	}
+#endif
+
 	class Bool
 	{
 	public:
@@ -19,6 +19,9 @@ namespace dyno
 	{
 		mDeviceGrid.clear();
 		mDeviceGridNext.clear();
+
+		mTiledGrid.clear();
+		mTiledGridNext.clear();
 	}
 
 	template <typename Coord3D, typename Coord4D>
@@ -54,10 +57,11 @@ namespace dyno
 		return sqrtf(2.0f) * h * vh / (sqrtf(h4 + max(h4, EPSILON)));
 	}
 
-	template <typename Coord>
+	//Grid is either Array2D or ArrayTiled2D, both are indexed by (i, j)
+	template <typename Coord, template<typename, DeviceType> class Grid>
 	__global__ void CW_MoveSimulatedRegion(
-		DArray2D<Coord> grid_next,
-		DArray2D<Coord> grid,
+		Grid<Coord, DeviceType::GPU> grid_next,
+		Grid<Coord, DeviceType::GPU> grid,
 		int width,
 		int height,
 		int dx,
@@ -93,6 +97,19 @@ namespace dyno
 
 	template<typename TDataType>
 	void CapillaryWave<TDataType>::moveDynamicRegion(int nx, int ny)
+	{
+		if (mTiled)
+			this->moveRegion(mTiledGrid, mTiledGridNext, nx, ny);
+		else
+			this->moveRegion(mDeviceGrid, mDeviceGridNext, nx, ny);
+
+		mOriginX += nx;
+		mOriginY += ny;
+	}
+
+	template<typename TDataType>
+	template<typename Grid>
+	void CapillaryWave<TDataType>::moveRegion(Grid& grid, Grid& gridNext, int nx, int ny)
 	{
 		auto res = this->varResolution()->getValue();
 
@@ -103,16 +120,13 @@ namespace dyno
 
 		cuExecute2D(make_uint2(extNx, extNy),
 			CW_MoveSimulatedRegion,
-			mDeviceGridNext,
-			mDeviceGrid,
+			gridNext,
+			grid,
 			res,
 			res,
 			nx,
 			ny,
 			level);
-
-		mOriginX += nx;
-		mOriginY += ny;
 	}
 
 	template<typename TDataType>
@@ -125,17 +139,49 @@ namespace dyno
 
 		mRealGridSize = length / res;
 
+		this->stateHeight()->resize(res, res);
+
+		auto topo = this->stateHeightField()->getDataPtr();
+		topo->setExtents(res, res);
+		topo->setGridSpacing(mRealGridSize);
+		topo->setOrigin(Coord3D(-0.5 * mRealGridSize * topo->width(), 0, -0.5 * mRealGridSize * topo->height()));
+
+		mTiled = this->varTiledLayout()->getValue();
+
+		if (mTiled)
+		{
+			mDeviceGrid.clear();
+			mDeviceGridNext.clear();
+
+			this->initialize(mTiledGrid, mTiledGridNext);
+		}
+		else
+		{
+			mTiledGrid.clear();
+			mTiledGridNext.clear();
+
+			this->initialize(mDeviceGrid, mDeviceGridNext);
+		}
+	}
+
+	template<typename TDataType>
+	template<typename Grid>
+	void CapillaryWave<TDataType>::initialize(Grid& grid, Grid& gridNext)
+	{
+		int res = this->varResolution()->getValue();
+
+		Real level = this->varWaterLevel()->getValue();
+
 		int extNx = res + 2;
 		int extNy = res + 2;
 
-		mDeviceGrid.resize(extNx, extNy);
-		mDeviceGridNext.resize(extNx, extNy);
-		this->stateHeight()->resize(res, res);
+		grid.resize(extNx, extNy);
+		gridNext.resize(extNx, extNy);
 
 		//init grid with initial values
 		cuExecute2D(make_uint2(extNx, extNy),
 			InitDynamicRegion,
-			mDeviceGrid,
+			grid,
 			extNx,
 			extNy,
 			level);
@@ -143,17 +189,12 @@ namespace dyno
 		//init grid_next with initial values
 		cuExecute2D(make_uint2(extNx, extNy),
 			InitDynamicRegion,
-			mDeviceGridNext,
+			gridNext,
 			extNx,
 			extNy,
 			level);
 
-		auto topo = this->stateHeightField()->getDataPtr();
-		topo->setExtents(res, res);
-		topo->setGridSpacing(mRealGridSize);
-		topo->setOrigin(Coord3D(-0.5 * mRealGridSize * topo->width(), 0, -0.5 * mRealGridSize * topo->height()));
-
-		auto& disp = topo->getDisplacement();
+		auto& disp = this->stateHeightField()->getDataPtr()->getDisplacement();
 
 		uint2 extent;
 		extent.x = disp.nx();
@@ -163,16 +204,45 @@ namespace dyno
 			CW_InitHeightDisp,
 			this->stateHeight()->getData(),
 			disp,
-			mDeviceGrid,
+			grid,
 			level);
 	}
 
 	template<typename TDataType>
 	void CapillaryWave<TDataType>::updateStates()
 	{
-		Real dt = this->stateTimeStep()->getValue();
+		uint res = this->varResolution()->getValue();
 
-		Real level = this->varWaterLevel()->getValue();
+		if (mTiled)
+			this->advance(mTiledGrid, mTiledGridNext);
+		else
+			this->advance(mDeviceGrid, mDeviceGridNext);
+
+		cuExecute2D(make_uint2(res, res),
+			CW_InitHeightGrad,
+			this->stateHeight()->getData(),
+			res);
+
+		//Update topology
+		auto topo = this->stateHeightField()->getDataPtr();
+
+		auto& disp = topo->getDisplacement();
+
+		uint2 extent;
+		extent.x = disp.nx();
+		extent.y = disp.ny();
+
+		cuExecute2D(extent,
+			CW_UpdateHeightDisp,
+			disp,
+			this->stateHeight()->getData());
+	}
+
+	template<typename TDataType>
+	template<typename Grid>
+	void CapillaryWave<TDataType>::advance(Grid& grid, Grid& gridNext)
+	{
+		Real dt = this->stateTimeStep()->getValue();
 
 		uint res = this->varResolution()->getValue();
 
@@ -189,15 +259,15 @@ namespace dyno
 		{
 			cuExecute2D(make_uint2(extNx, extNy),
 				CW_ImposeBC,
-				mDeviceGridNext,
-				mDeviceGrid,
+				gridNext,
+				grid,
 				extNx,
 				extNy);
 
 			cuExecute2D(make_uint2(res, res),
 				CW_OneWaveStep,
-				mDeviceGrid,
-				mDeviceGridNext,
+				grid,
+				gridNext,
 				res,
 				res,
 				GRAVITY,
@@ -207,32 +277,13 @@ namespace dyno
 		cuExecute2D(make_uint2(res, res),
 			CW_InitHeights,
 			this->stateHeight()->getData(),
-			mDeviceGrid,
+			grid,
 			res,
 			mRealGridSize);
-
-		cuExecute2D(make_uint2(res, res),
-			CW_InitHeightGrad,
-			this->stateHeight()->getData(),
-			res);
-
-		//Update topology
-		auto topo = this->stateHeightField()->getDataPtr();
-
-		auto& disp = topo->getDisplacement();
-
-		uint2 extent;
-		extent.x = disp.nx();
-		extent.y = disp.ny();
-
-		cuExecute2D(extent,
-			CW_UpdateHeightDisp,
-			disp,
-			this->stateHeight()->getData());
 	}
 
-	template <typename Coord4D>
-	__global__ void InitDynamicRegion(DArray2D<Coord4D> grid, int gridwidth, int gridheight, float level)
+	template <typename Coord4D, template<typename, DeviceType> class Grid>
+	__global__ void InitDynamicRegion(Grid<Coord4D, DeviceType::GPU> grid, int gridwidth, int gridheight, float level)
 	{
 		int x = threadIdx.x + blockIdx.x * blockDim.x;
 		int y = threadIdx.y + blockIdx.y * blockDim.y;
@@ -249,10 +300,10 @@ namespace dyno
 		}
 	}
 
-	template <typename Coord4D>
+	template <typename Coord4D, template<typename, DeviceType> class Grid>
 	__global__ void CW_ImposeBC(
-		DArray2D<Coord4D> grid_next, 
-		DArray2D<Coord4D> grid, 
+		Grid<Coord4D, DeviceType::GPU> grid_next, 
+		Grid<Coord4D, DeviceType::GPU> grid, 
 		int width, 
 		int height)
 	{
@@ -357,10 +408,10 @@ namespace dyno
 		return H;
 	}
 
-	template <typename Coord4D>
+	template <typename Coord4D, template<typename, DeviceType> class Grid>
 	__global__ void CW_OneWaveStep(
-		DArray2D<Coord4D> grid_next, 
-		DArray2D<Coord4D> grid, 
+		Grid<Coord4D, DeviceType::GPU> grid_next, 
+		Grid<Coord4D, DeviceType::GPU> grid, 
 		int width, 
 		int height, 
 		float GRAVITY, 
@@ -399,10 +450,10 @@ namespace dyno
 		}
 	}
 
-	template <typename Coord>
+	template <typename Coord, template<typename, DeviceType> class Grid>
 	__global__ void CW_InitHeights(
 		DArray2D<Coord> height,
-		DArray2D<Coord> grid,
+		Grid<Coord, DeviceType::GPU> grid,
 		int patchSize,
 		float realSize)
 	{
@@ -440,11 +491,11 @@ namespace dyno
 		}
 	}
 
-	template <typename Real, typename Coord3D, typename Coord4D>
+	template <typename Real, typename Coord3D, typename Coord4D, template<typename, DeviceType> class Grid>
 	__global__ void CW_InitHeightDisp(
 		DArray2D<Coord4D> heights,
 		DArray2D<Coord3D> displacement,
-		DArray2D<Coord4D> grid,
+		Grid<Coord4D, DeviceType::GPU> grid,
 		Real horizon)
 	{
 		unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
@@ -17,6 +17,8 @@
 #include "Node.h"
 #include "Topology/HeightField.h"
 
+#include "Array/ArrayTiled.h"
+
 namespace dyno
 {
 	/**
@@ -28,9 +30,9 @@ namespace dyno
 		DECLARE_TCLASS(CapillaryWave, TDataType)
 	public:
 		typedef typename TDataType::Real Real;
-		typedef typename Vector<Real, 2> Coord2D;
-		typedef typename Vector<Real, 3> Coord3D;
-		typedef typename Vector<Real, 4> Coord4D;
+		typedef typename ::dyno::Vector<Real, 2> Coord2D;
+		typedef typename ::dyno::Vector<Real, 3> Coord3D;
+		typedef typename ::dyno::Vector<Real, 4> Coord4D;
 
 		CapillaryWave();
 		~CapillaryWave() override;
@@ -44,6 +46,8 @@ namespace dyno
 
 		DEF_VAR(Real, Length, 512.0f, "The simulated region size in meters");
 
+		DEF_VAR(bool, TiledLayout, false, "Store the simulation grid in 8x8 bricks, takes effect on reset");
+
 	public:
 		DEF_ARRAY2D_STATE(Coord4D, Height, DeviceType::GPU, "");
 
@@ -58,6 +62,8 @@ namespace dyno
 
 		Real getRealGridSize() { return mRealGridSize; }
 
+		bool isTiledLayout() { return mTiled; }
+
 		Coord2D getOrigin() { return Coord2D(mOriginX * mRealGridSize, mOriginY * mRealGridSize); }
 
 		//TODO: make improvements
@@ -72,7 +78,25 @@ namespace dyno
 		DArray2D<Coord4D> mDeviceGrid;
 		DArray2D<Coord4D> mDeviceGridNext;
 
+		/**
+		 * @brief Replace mDeviceGrid and mDeviceGridNext if TiledLayout is enabled, the linear grids are left empty then.
+		 * 	Each 8x8 thread block of cuExecute2D covers one brick, so the five-point stencil mostly stays in the same brick.
+		 */
+		DArrayTiled2D<Coord4D> mTiledGrid;
+		DArrayTiled2D<Coord4D> mTiledGridNext;
+
 	private:
+		template<typename Grid>
+		void initialize(Grid& grid, Grid& gridNext);
+
+		template<typename Grid>
+		void advance(Grid& grid, Grid& gridNext);
+
+		template<typename Grid>
+		void moveRegion(Grid& grid, Grid& gridNext, int nx, int ny);
+
+		bool mTiled = false;
+
 		Real mRealGridSize;
 
 		int mOriginX = 0;
@@ -32,8 +32,8 @@ namespace dyno
 		DECLARE_TCLASS(GranularMedia, TDataType)
 	public:
 		typedef typename TDataType::Real Real;
-		typedef typename Vector<Real, 3> Coord3D;
-		typedef typename Vector<Real, 4> Coord4D;
+		typedef typename ::dyno::Vector<Real, 3> Coord3D;
+		typedef typename ::dyno::Vector<Real, 4> Coord4D;
 
 		GranularMedia();
 		~GranularMedia();
@@ -57,6 +57,7 @@ namespace dyno
 	public:
 		DEF_ARRAY2D_STATE(Real, LandScape, DeviceType::GPU, "");
 
+		//Grid and GridNext stay in the linear layout, coupling modules (RigidSandCoupling, SurfaceParticleTracking) index them directly
 		DEF_ARRAY2D_STATE(Coord4D, Grid, DeviceType::GPU, "");
 
 		DEF_ARRAY2D_STATE(Coord4D, GridNext, DeviceType::GPU, "");
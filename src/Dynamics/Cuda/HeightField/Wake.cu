@@ -19,11 +19,11 @@ namespace dyno
 	{
 	}
 
-	template <typename Real, typename Coord2D, typename Coord3D, typename Coord4D, typename TriangleIndex>
+	template <typename Real, typename Coord2D, typename Coord3D, typename Coord4D, typename TriangleIndex, template<typename, DeviceType> class Grid>
 	__global__ void W_AccumlateTrails(
 		DArray2D<Coord2D> sources,
 		DArray2D<Real> weights,
-		DArray2D<Coord4D> grid,
+		Grid<Coord4D, DeviceType::GPU> grid,
 		DArray<Coord3D> vertices,
 		DArray<TriangleIndex> indices,
 		Coord3D waveOrigin,
@@ -97,11 +97,11 @@ namespace dyno
 		atomicAdd(&weights(i1, j1), w11);
 	}
 
-	template <typename Real, typename Coord2D, typename Coord4D>
+	template <typename Real, typename Coord2D, typename Coord4D, template<typename, DeviceType> class Grid>
 	__global__ void W_AddTrails(
 		DArray2D<Coord2D> sources,
 		DArray2D<Real> weights,
-		DArray2D<Coord4D> grid,
+		Grid<Coord4D, DeviceType::GPU> grid,
 		Real mag)
 	{
 		int i = threadIdx.x + blockIdx.x * blockDim.x;
@@ -127,7 +127,8 @@ namespace dyno
 	}
 
 	template<typename TDataType>
-	void Wake<TDataType>::addTrails()
+	template<typename Grid>
+	void Wake<TDataType>::addTrails(Grid& grid, Grid& gridNext)
 	{
 		uint res = this->varResolution()->getValue();
 
@@ -151,10 +152,10 @@ namespace dyno
 
 			uint num = indices.size();
 
-			if (mDeviceGrid.nx() != mWeight.nx() || mDeviceGrid.ny() != mWeight.ny())
+			if (grid.nx() != mWeight.nx() || grid.ny() != mWeight.ny())
 			{
-				mWeight.resize(mDeviceGrid.nx(), mDeviceGrid.ny());
-				mSource.resize(mDeviceGrid.nx(), mDeviceGrid.ny());
+				mWeight.resize(grid.nx(), grid.ny());
+				mSource.resize(grid.nx(), grid.ny());
 			}
 
 			mWeight.reset();
@@ -164,7 +165,7 @@ namespace dyno
 				W_AccumlateTrails,
 				mSource,
 				mWeight,
-				mDeviceGrid,
+				grid,
 				vertices,
 				indices,
 				waveOrigin,
@@ -175,14 +176,14 @@ namespace dyno
 
 			Real mag = this->varMagnitude()->getValue();
 
-			cuExecute2D(make_uint2(mDeviceGrid.nx(), mDeviceGrid.ny()),
+			cuExecute2D(make_uint2(grid.nx(), grid.ny()),
 				W_AddTrails,
 				mSource,
 				mWeight,
-				mDeviceGrid,
+				grid,
 				mag);
 
-			mDeviceGridNext.assign(mDeviceGrid);
+			gridNext.assign(grid);
 		}
 	}
 
@@ -190,7 +191,12 @@ namespace dyno
 	void Wake<TDataType>::updateStates()
 	{
 		if (this->getVessel() != nullptr)
-			addTrails();
+		{
+			if (this->isTiledLayout())
+				this->addTrails(this->mTiledGrid, this->mTiledGridNext);
+			else
+				this->addTrails(this->mDeviceGrid, this->mDeviceGridNext);
+		}
 
 		CapillaryWave<TDataType>::updateStates();
 	}
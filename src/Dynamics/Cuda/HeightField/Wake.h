@@ -28,9 +28,9 @@ namespace dyno
 		DECLARE_TCLASS(Wake, TDataType)
 	public:
 		typedef typename TDataType::Real Real;
-		typedef typename Vector<Real, 2> Coord2D;
-		typedef typename Vector<Real, 3> Coord3D;
-		typedef typename Vector<Real, 4> Coord4D;
+		typedef typename ::dyno::Vector<Real, 2> Coord2D;
+		typedef typename ::dyno::Vector<Real, 3> Coord3D;
+		typedef typename ::dyno::Vector<Real, 4> Coord4D;
 
 		Wake();
 		~Wake() override;
@@ -44,7 +44,8 @@ namespace dyno
 		void updateStates() override;
 
 	private:
-		void addTrails();
+		template<typename Grid>
+		void addTrails(Grid& grid, Grid& gridNext);
 		
 		DArray2D<Real> mWeight;
 		DArray2D<Coord2D> mSource;
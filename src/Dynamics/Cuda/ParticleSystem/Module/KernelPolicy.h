@@ -0,0 +1,301 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Platform.h"
+#include "Array/Array.h"
+
+#include "Kernel.h"
+
+#include <vector>
+
+/**
+ * @brief Compile-time kernel policies for particle approximations.
+ *
+ * Each policy splits a kernel into a shape function of the normalized distance q = r / h, defined on [0, 1],
+ * and a normalization factor that only depends on h. Normalization constants are folded at compile time,
+ * so an evaluator instantiated on a policy inlines into the neighbor loop without any virtual call or branch
+ * on the kernel type.
+ */
+namespace dyno
+{
+	template<typename Real, typename Shape>
+	struct KernelPolicy
+	{
+		DYN_FUNC static inline Real weight(const Real r, const Real h, const Real scale)
+		{
+			const Real q = r / h;
+			if (q > Real(1)) return Real(0);
+			return scale * Shape::weightNorm(h) * Shape::weightShape(q);
+		}
+
+		DYN_FUNC static inline Real gradient(const Real r, const Real h, const Real scale)
+		{
+			const Real q = r / h;
+			if (q > Real(1)) return Real(0);
+			return scale * Shape::gradientNorm(h) * Shape::gradientShape(q);
+		}
+	};
+
+	/**
+	 * @brief W(q) = 1 - q^2, the same as SmoothKernel
+	 */
+	template<typename Real>
+	struct SmoothPolicy : public KernelPolicy<Real, SmoothPolicy<Real>>
+	{
+		typedef Real RealType;
+
+		DYN_FUNC static inline Real weightNorm(const Real h) { return Real(1); }
+		DYN_FUNC static inline Real gradientNorm(const Real h) { return Real(-1); }
+
+		DYN_FUNC static inline Real weightShape(const Real q) { return Real(1) - q * q; }
+		DYN_FUNC static inline Real gradientShape(const Real q) { return Real(1) - q * q; }
+
+		DYN_FUNC static inline Real integral(const Real r, const Real h, const Real scale)
+		{
+			return SmoothKernel<Real>::integral(r, h, scale);
+		}
+	};
+
+	/**
+	 * @brief W(q) = 15 / (pi h^3) (1 - q)^3, the same as SpikyKernel
+	 */
+	template<typename Real>
+	struct SpikyPolicy : public KernelPolicy<Real, SpikyPolicy<Real>>
+	{
+		typedef Real RealType;
+
+		DYN_FUNC static inline Real weightNorm(const Real h) { return Real(15.0 / M_PI) / (h * h * h); }
+		DYN_FUNC static inline Real gradientNorm(const Real h) { return Real(-45.0 / M_PI) / (h * h * h * h); }
+
+		DYN_FUNC static inline Real weightShape(const Real q) { const Real d = Real(1) - q; return d * d * d; }
+		DYN_FUNC static inline Real gradientShape(const Real q) { const Real d = Real(1) - q; return d * d; }
+
+		DYN_FUNC static inline Real integral(const Real r, const Real h, const Real scale)
+		{
+			return SpikyKernel<Real>::integral(r, h, scale);
+		}
+	};
+
+	/**
+	 * @brief Cubic B-spline with support h, the same as CubicKernel
+	 */
+	template<typename Real>
+	struct CubicPolicy : public KernelPolicy<Real, CubicPolicy<Real>>
+	{
+		typedef Real RealType;
+
+		DYN_FUNC static inline Real weightNorm(const Real h) { return Real(1.5 / M_PI) / (h * h * h); }
+		DYN_FUNC static inline Real gradientNorm(const Real h) { return Real(1.5 / M_PI) / (h * h * h); }
+
+		DYN_FUNC static inline Real weightShape(const Real q)
+		{
+			const Real s = Real(2) * q;
+			if (s >= Real(1))
+			{
+				const Real d = Real(2) - s;
+				return d * d * d / Real(6);
+			}
+			return Real(2) / Real(3) - s * s + Real(0.5) * s * s * s;
+		}
+
+		DYN_FUNC static inline Real gradientShape(const Real q)
+		{
+			const Real s = Real(2) * q;
+			if (s >= Real(1))
+			{
+				const Real d = Real(2) - s;
+				return Real(-0.5) * d * d;
+			}
+			return -Real(2) * s + Real(1.5) * s * s;
+		}
+	};
+
+	/**
+	 * @brief Quartic B-spline with support h, the same as QuarticKernel
+	 */
+	template<typename Real>
+	struct QuarticPolicy : public KernelPolicy<Real, QuarticPolicy<Real>>
+	{
+		typedef Real RealType;
+
+		DYN_FUNC static inline Real weightNorm(const Real h) { return Real(0.0255) / (h * h); }
+		DYN_FUNC static inline Real gradientNorm(const Real h) { return Real(-0.102) / (h * h); }
+
+		DYN_FUNC static inline Real weightShape(const Real q)
+		{
+			const Real s = Real(2.5) * q;
+			const Real d = Real(2.5) - s;
+			Real ret = d * d * d * d;
+			if (s <= Real(1.5)) { const Real t = Real(1.5) - s; ret -= Real(5) * t * t * t * t; }
+			if (s <= Real(0.5)) { const Real w = Real(0.5) - s; ret += Real(10) * w * w * w * w; }
+			return ret;
+		}
+
+		DYN_FUNC static inline Real gradientShape(const Real q)
+		{
+			const Real s = Real(2.5) * q;
+			const Real d = Real(2.5) - s;
+			Real ret = d * d * d;
+			if (s <= Real(1.5)) { const Real t = Real(1.5) - s; ret -= Real(5) * t * t * t; }
+			if (s <= Real(0.5)) { const Real w = Real(0.5) - s; ret += Real(10) * w * w * w; }
+			return ret;
+		}
+	};
+
+	/**
+	 * @brief Evaluators passed to kernels as functors, the signature is (r, h, scale)
+	 */
+	template<typename Policy>
+	struct KernelWeight
+	{
+		typedef typename Policy::RealType Real;
+
+		DYN_FUNC inline Real operator()(const Real r, const Real h, const Real scale) const
+		{
+			return Policy::weight(r, h, scale);
+		}
+	};
+
+	template<typename Policy>
+	struct KernelGradient
+	{
+		typedef typename Policy::RealType Real;
+
+		DYN_FUNC inline Real operator()(const Real r, const Real h, const Real scale) const
+		{
+			return Policy::gradient(r, h, scale);
+		}
+	};
+
+	template<typename Policy>
+	struct KernelIntegral
+	{
+		typedef typename Policy::RealType Real;
+
+		DYN_FUNC inline Real operator()(const Real r, const Real h, const Real scale) const
+		{
+			return Policy::integral(r, h, scale);
+		}
+	};
+
+	/**
+	 * @brief Evaluates a shape function from a uniformly sampled table with linear interpolation,
+	 *		the normalization factor is still evaluated analytically.
+	 */
+	template<typename Policy, bool Gradient>
+	struct TabulatedKernel
+	{
+		typedef typename Policy::RealType Real;
+
+		DYN_FUNC inline Real operator()(const Real r, const Real h, const Real scale) const
+		{
+			const Real q = r / h;
+			if (q > Real(1)) return Real(0);
+
+			const Real x = q * Real(resolution);
+			uint i = (uint)x;
+			i = i < resolution ? i : resolution - 1;
+			const Real t = x - Real(i);
+			const Real s = table[i] + t * (table[i + 1] - table[i]);
+
+			return scale * (Gradient ? Policy::gradientNorm(h) : Policy::weightNorm(h)) * s;
+		}
+
+		const Real* table = nullptr;
+		uint resolution = 0;
+	};
+
+	/**
+	 * @brief Owns the lookup tables of one kernel policy, tables are sampled on the host and stored in device memory.
+	 */
+	template<typename Real>
+	class KernelTable
+	{
+	public:
+		KernelTable() {};
+		~KernelTable() {
+			mWeight.clear();
+			mGradient.clear();
+		};
+
+		template<typename Policy>
+		void build(uint resolution)
+		{
+			std::vector<Real> w(resolution + 1);
+			std::vector<Real> g(resolution + 1);
+			for (uint i = 0; i <= resolution; i++)
+			{
+				Real q = Real(i) / Real(resolution);
+				w[i] = Policy::weightShape(q);
+				g[i] = Policy::gradientShape(q);
+			}
+
+			mWeight.assign(w);
+			mGradient.assign(g);
+			mResolution = resolution;
+		}
+
+		template<typename Policy>
+		TabulatedKernel<Policy, false> weight() const
+		{
+			TabulatedKernel<Policy, false> eval;
+			eval.table = mWeight.begin();
+			eval.resolution = mResolution;
+			return eval;
+		}
+
+		template<typename Policy>
+		TabulatedKernel<Policy, true> gradient() const
+		{
+			TabulatedKernel<Policy, true> eval;
+			eval.table = mGradient.begin();
+			eval.resolution = mResolution;
+			return eval;
+		}
+
+		bool isEmpty() const { return mResolution == 0; }
+
+	private:
+		DArray<Real> mWeight;
+		DArray<Real> mGradient;
+		uint mResolution = 0;
+	};
+
+	/**
+	 * @brief Sum of the kernel weights over a regular lattice with spacing d, used to normalize the kernel
+	 */
+	template<typename Policy>
+	typename Policy::RealType latticeWeightSum(const typename Policy::RealType d, const typename Policy::RealType h)
+	{
+		typedef typename Policy::RealType Real;
+
+		Real V = d * d * d;
+		Real total_weight(0);
+		int half_res = (int)(h / d + 1);
+		for (int i = -half_res; i <= half_res; i++)
+			for (int j = -half_res; j <= half_res; j++)
+				for (int k = -half_res; k <= half_res; k++)
+				{
+					Real x = i * d;
+					Real y = j * d;
+					Real z = k * d;
+					Real r = sqrt(x * x + y * y + z * z);
+					total_weight += V * Policy::weight(r, h, Real(1));
+				}
+
+		return total_weight;
+	}
+}
@@ -18,6 +18,13 @@ namespace dyno
 		this->inSmoothingLength()->attach(callback);
 		this->inSamplingDistance()->attach(callback);
 
+		auto tableCallback = std::make_shared<FCallBackFunc>(
+			std::bind(&ParticleApproximation<TDataType>::updateKernelTable, this));
+
+		this->varKernelType()->attach(tableCallback);
+		this->varTabulated()->attach(tableCallback);
+		this->varTableResolution()->attach(tableCallback);
+
 		//Should be called after above four parameters are all set, this function will recalculate m_factor
 		//calculateScalingFactor();
 	}
@@ -33,37 +40,40 @@ namespace dyno
 		Real d = this->inSamplingDistance()->getValue();
 		Real H = this->inSmoothingLength()->getValue();
 
-		Real V = d * d*d;
-
-		Kernel<Real>* kern;
+		Real total_weight(1);
 		switch (this->varKernelType()->currentKey())
 		{
 		case KT_Spiky:
-			kern = new SpikyKernel<Real>();
+			total_weight = latticeWeightSum<SpikyPolicy<Real>>(d, H);
 			break;
 		case KT_Smooth:
-			kern = new SmoothKernel<Real>();
+			total_weight = latticeWeightSum<SmoothPolicy<Real>>(d, H);
 			break;
 		default:
 			break;
 		}
 
-		Real total_weight(0);
-		int half_res = (int)(H / d + 1);
-		for (int i = -half_res; i <= half_res; i++)
-			for (int j = -half_res; j <= half_res; j++)
-				for (int k = -half_res; k <= half_res; k++)
-				{
-					Real x = i * d;
-					Real y = j * d;
-					Real z = k * d;
-					Real r = sqrt(x * x + y * y + z * z);
-					total_weight += V * kern->Weight(r, H);
-				}
-
 		mScalingFactor = Real(1) / total_weight;
+	}
 
-		delete kern;
+	template<typename TDataType>
+	void ParticleApproximation<TDataType>::updateKernelTable()
+	{
+		if (!this->varTabulated()->getValue())
+			return;
+
+		uint res = std::max(this->varTableResolution()->getValue(), uint(1));
+		switch (this->varKernelType()->currentKey())
+		{
+		case KT_Spiky:
+			mKernelTable.template build<SpikyPolicy<Real>>(res);
+			break;
+		case KT_Smooth:
+			mKernelTable.template build<SmoothPolicy<Real>>(res);
+			break;
+		default:
+			break;
+		}
 	}
 
 	DEFINE_CLASS(ParticleApproximation);
@@ -16,86 +16,52 @@
 #pragma once
 #include "Module/ComputeModule.h"
 
-#include "Kernel.h"
+#include "KernelPolicy.h"
 
 namespace dyno
 {
 
-#define cuIntegralAdh(size, type, scale, Func,...){					\
-		uint pDims = cudaGridSize((uint)size, BLOCK_SIZE);				\
-		if (type == KT_Smooth)											\
-		{																\
-			auto lambdaFunc = [=] __device__(Real r, Real h, Real s) -> Real {		\
-				return SmoothKernel<Real>::integral(r, h, s);	\
-			};																\
-			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, lambdaFunc, mScalingFactor);	\
-		}																\
-		else if (type == KT_Spiky)										\
-		{																\
-			auto lambdaFunc = [=] __device__(Real r, Real h, Real s) -> Real {		\
-				return SpikyKernel<Real>::integral(r, h, s);					\
-			};															\
-			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, lambdaFunc, mScalingFactor);	\
-		}																\
-		cuSynchronize();												\
+/**
+ * Launches Func with a kernel evaluator appended to its arguments. The kernel type is resolved once per launch,
+ * each branch instantiates Func on a different evaluator so that the neighbor loops are free of any kernel branch.
+ */
+#define cuKernelDispatch(size, type, scale, Evaluator, Func,...){									\
+		uint pDims = cudaGridSize((uint)size, BLOCK_SIZE);												\
+		if (type == this->KT_Smooth)																			\
+			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, Evaluator<SmoothPolicy<Real>>(), scale);		\
+		else if (type == this->KT_Spiky)																		\
+			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, Evaluator<SpikyPolicy<Real>>(), scale);		\
+		cuSynchronize();																				\
 	}
 
-#define cuIntegral(size, type, scale, Func,...){					\
-		uint pDims = cudaGridSize((uint)size, BLOCK_SIZE);				\
-		if (type == KT_Smooth)											\
-		{																\
-			auto lambdaFunc = [=] __device__(Real r, Real h, Real s) -> Real {		\
-				return SmoothKernel<Real>::integral(r, h, s);	\
-			};																\
-			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, lambdaFunc, mScalingFactor);	\
-		}																\
-		else if (type == KT_Spiky)										\
-		{																\
-			auto lambdaFunc = [=] __device__(Real r, Real h, Real s) -> Real {		\
-				return SpikyKernel<Real>::integral(r, h, s);					\
-			};															\
-			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, lambdaFunc, mScalingFactor);	\
-		}																\
-		cuSynchronize();												\
+/**
+ * Same as cuKernelDispatch, switches to the lookup tables of the current kernel type once they are enabled
+ */
+#define cuTabulatedDispatch(size, type, scale, Evaluator, Table, Func,...){							\
+		if (this->varTabulated()->getValue() && !this->mKernelTable.isEmpty())							\
+		{																								\
+			uint pDims = cudaGridSize((uint)size, BLOCK_SIZE);											\
+			if (type == this->KT_Smooth)																		\
+				Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, this->mKernelTable.template Table<SmoothPolicy<Real>>(), scale);	\
+			else if (type == this->KT_Spiky)																	\
+				Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, this->mKernelTable.template Table<SpikyPolicy<Real>>(), scale);	\
+			cuSynchronize();																			\
+		}																								\
+		else																							\
+			cuKernelDispatch(size, type, scale, Evaluator, Func, __VA_ARGS__);							\
 	}
 
-#define cuZerothOrder(size, type, scale, Func,...){					\
-		uint pDims = cudaGridSize((uint)size, BLOCK_SIZE);				\
-		if (type == 0)											\
-		{																\
-			auto lambdaFunc = [=] __device__(Real r, Real h, Real s) -> Real {		\
-				return SmoothKernel<Real>::weight(r, h, s);	\
-			};																\
-			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, lambdaFunc, scale);	\
-		}																\
-		else if (type == 1)										\
-		{																\
-			auto lambdaFunc = [=] __device__(Real r, Real h, Real s) -> Real {		\
-				return SpikyKernel<Real>::weight(r, h, s);					\
-			};															\
-			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, lambdaFunc, scale);	\
-		}																\
-		cuSynchronize();												\
-	}
+#define cuIntegralAdh(size, type, scale, Func,...)		\
+	cuKernelDispatch(size, type, mScalingFactor, KernelIntegral, Func, __VA_ARGS__)
 
-#define cuFirstOrder(size, type, scale, Func,...){					\
-		uint pDims = cudaGridSize((uint)size, BLOCK_SIZE);				\
-		if (type == 0)											\
-		{																\
-			auto lambdaFunc = [=] __device__(Real r, Real h, Real s) -> Real {		\
-				return SmoothKernel<Real>::gradient(r, h, s);	\
-			};																\
-			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, lambdaFunc, scale);	\
-		}																\
-		else if (type == 1)										\
-		{																\
-			auto lambdaFunc = [=] __device__(Real r, Real h, Real s) -> Real {		\
-				return SpikyKernel<Real>::gradient(r, h, s);					\
-			};															\
-			Func << <pDims, BLOCK_SIZE >> > (__VA_ARGS__, lambdaFunc, scale);	\
-		}																\
-		cuSynchronize();												\
-	}
+#define cuIntegral(size, type, scale, Func,...)			\
+	cuKernelDispatch(size, type, mScalingFactor, KernelIntegral, Func, __VA_ARGS__)
+
+#define cuZerothOrder(size, type, scale, Func,...)		\
+	cuTabulatedDispatch(size, type, scale, KernelWeight, weight, Func, __VA_ARGS__)
+
+#define cuFirstOrder(size, type, scale, Func,...)		\
+	cuTabulatedDispatch(size, type, scale, KernelGradient, gradient, Func, __VA_ARGS__)
 
 	template<typename TDataType>
 	class ParticleApproximation : public ComputeModule
@@ -119,10 +85,18 @@ namespace dyno
 
 		DEF_ENUM(EKernelType, KernelType, EKernelType::KT_Spiky, "Rendering mode");
 
+		DEF_VAR(bool, Tabulated, false, "Evaluate kernel weights and gradients from lookup tables");
+
+		DEF_VAR(uint, TableResolution, 1024, "Number of intervals of the lookup tables");
+
 	protected:
 		Real mScalingFactor = Real(1);
 
+		KernelTable<Real> mKernelTable;
+
 	private:
 		void calculateScalingFactor();
+
+		void updateKernelTable();
 	};
 }
\ No newline at end of file
@@ -1,7 +1,6 @@
-#include <cuda_runtime.h>
 #include "ParticleIntegrator.h"
 #include "Node.h"
-#include "SceneGraphFactory.h"
+#include "SceneGraph.h"
 
 namespace dyno
 {
@@ -55,8 +54,11 @@ namespace dyno
 	{
 		Real dt = this->inTimeStep()->getData();
 
-		auto scn = dyno::SceneGraphFactory::instance()->active();
-		Coord gravity = scn->getGravity();
+		//Use the gravity of the scene the module belongs to, several scenes may run in the same process
+		Coord gravity(0.0f, -9.8f, 0.0f);
+		auto scn = this->getSceneGraph();
+		if (scn != NULL)
+			gravity = scn->getGravity();
 
 		int total_num = this->inPosition()->size();
 
@@ -1,4 +1,3 @@
-#include <cuda_runtime.h>
 #include "SimpleVelocityConstraint.h"
 #include <string>
 #include "Algorithm/Function2Pt.h"
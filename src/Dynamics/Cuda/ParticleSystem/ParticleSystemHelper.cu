@@ -1,8 +1,7 @@
 #include "ParticleSystemHelper.h"
 
 #include "Algorithm/Reduction.h"
-
-#include <thrust/sort.h>
+#include "Algorithm/Sort.h"
 
 namespace dyno
 {
@@ -88,7 +87,8 @@ namespace dyno
 			PSH_InitParticleIds,
 			idsInOrder);
 
-		thrust::sort_by_key(thrust::device, morton.begin(), morton.begin() + morton.size(), idsInOrder.begin());
+		Sort<OcKey> sort;
+		sort.sortByKey(morton, idsInOrder);
 
 		DArray<Coord> buffer(pos.size());
 		buffer.assign(pos);
@@ -23,7 +23,7 @@ namespace dyno
 
 		typedef typename TDataType::Coord Coord;
 		typedef typename TDataType::Matrix Matrix;
-		typedef typename TBond<TDataType> Bond;
+		typedef typename ::dyno::TBond<TDataType> Bond;
 		typedef typename TopologyModule::Tetrahedron Tetrahedron;
 		
 		HyperelasticBody();
@@ -1,5 +1,6 @@
 #include "CoSemiImplicitHyperelasticitySolver.h"
 #include "Matrix/MatrixFunc.h"
+#include "Algorithm/PolarDecomposition.h"
 #include "ParticleSystem/Module/Kernel.h"
 #include "curand_kernel.h"
 #include "Algorithm/CudaRand.h"
@@ -311,61 +312,47 @@ namespace dyno
 		}
 	}
 
-	template <typename Real, typename Coord, typename Matrix, typename Bond>
-	__global__ void HM_ComputeF(
-		DArray<Matrix> F,
-		DArray<Coord> eigens,
-		DArray<Matrix> invK,
-		DArray<bool> validOfK,
-		DArray<Matrix> matU,
-		DArray<Matrix> matV,
-		DArray<Matrix> Rots,
+	template <typename Real, typename Coord, typename Bond>
+	__device__ Real HM_MaxBondLength(DArray<Coord>& X, List<Bond>& bonds_i, Coord x_i)
+	{
+		Real maxDist = Real(0);
+		for (int ne = 0; ne < bonds_i.size(); ne++)
+		{
+			Coord y_j = X[bonds_i[ne].idx];
+			maxDist = max(maxDist, (x_i - y_j).norm());
+		}
+		return maxDist < EPSILON ? Real(1) : maxDist;
+	}
+
+	template <typename Coord, typename Matrix, typename Bond>
+	__global__ void HM_ComputeShapeMatrices(
+		DArray<Matrix> matL,
+		DArray<Matrix> matK,
 		DArray<Coord> X,
 		DArray<Coord> Y,
 		DArrayList<Bond> bonds,
-		Real horizon,
-		Real const strainLimit,
-		DArray<Coord> restNorm, 
+		DArray<Coord> restNorm,
 		DArray<Coord> Norm)
 	{
+		typedef typename Coord::VarType Real;
+
 		int pId = threadIdx.x + (blockIdx.x * blockDim.x);
 		if (pId >= Y.size()) return;
 
 		Coord x_i = X[pId];
-		int size_i = bonds[pId].size();
+		List<Bond>& bonds_i = bonds[pId];
+		int size_i = bonds_i.size();
 		Real total_weight = Real(0);
 		Matrix matL_i(0);
 		Matrix matK_i(0);
 
 		Real t = 1;
 
-#ifdef DEBUG_INFO
-		if (pId == 497)
-		{
-			printf("Position in HM_ComputeF %d: %f %f %f \n", pId, Y[pId][0], Y[pId][1], Y[pId][2]);
-		}
-#endif // DEBUG_INFO
-		//printf("%d %d \n", pId, size_i);
+		Real maxDist = HM_MaxBondLength<Real>(X, bonds_i, x_i);
 
-		Real maxDist = Real(0);
 		for (int ne = 0; ne < size_i; ne++)
 		{
-			Bond bond_ij = bonds[pId][ne];
-			int j = bond_ij.idx;
-			Coord y_j = X[j];
-			Real r = (x_i - y_j).norm();
-
-			maxDist = max(maxDist, r);
-		}
-		maxDist = maxDist < EPSILON ? Real(1) : maxDist;
-
-#ifdef DEBUG_INFO
-		printf("Max distance %d: %f \n", pId, maxDist);
-#endif // DEBUG_INFO
-
-		for (int ne = 0; ne < size_i; ne++)
-		{
-			Bond bond_ij = bonds[pId][ne];
+			Bond bond_ij = bonds_i[ne];
 			int j = bond_ij.idx;
 			Coord x_j = X[j];
 			Real r = (x_i - x_j).norm();
@@ -376,7 +363,6 @@ namespace dyno
 
 				Coord p = (Y[j] - Y[pId]) / maxDist;
 				Coord q = (x_j - x_i) / maxDist;
-			
 
 				matL_i(0, 0) += p[0] * q[0] * weight; matL_i(0, 1) += p[0] * q[1] * weight; matL_i(0, 2) += p[0] * q[2] * weight;
 				matL_i(1, 0) += p[1] * q[0] * weight; matL_i(1, 1) += p[1] * q[1] * weight; matL_i(1, 2) += p[1] * q[2] * weight;
@@ -387,71 +373,59 @@ namespace dyno
 				matK_i(2, 0) += q[2] * q[0] * weight; matK_i(2, 1) += q[2] * q[1] * weight; matK_i(2, 2) += q[2] * q[2] * weight;
 
 				total_weight += weight;
-
-
-#ifdef DEBUG_INFO
-				if (pId == 497)
-				{
-					printf("%d Neighbor %d: %f %f %f \n", pId, j, Y[j][0], Y[j][1], Y[j][2]);
-				}
-#endif // DEBUG_INFO
 			}
 		}
-	
 
-			Coord n = Norm[pId];
-			Coord nr = restNorm[pId];
-			matK_i(0, 0) += t*nr[0] * nr[0]; matK_i(0, 1) += t*nr[0] * nr[1]; matK_i(0, 2) += t*nr[0] * nr[2];
-			matK_i(1, 0) += t*nr[1] * nr[0]; matK_i(1, 1) += t*nr[1] * nr[1]; matK_i(1, 2) += t*nr[1] * nr[2];
-			matK_i(2, 0) += t*nr[2] * nr[0]; matK_i(2, 1) += t*nr[2] * nr[1]; matK_i(2, 2) += t*nr[2] * nr[2];
-		
+		Coord n = Norm[pId];
+		Coord nr = restNorm[pId];
+		matK_i(0, 0) += t * nr[0] * nr[0]; matK_i(0, 1) += t * nr[0] * nr[1]; matK_i(0, 2) += t * nr[0] * nr[2];
+		matK_i(1, 0) += t * nr[1] * nr[0]; matK_i(1, 1) += t * nr[1] * nr[1]; matK_i(1, 2) += t * nr[1] * nr[2];
+		matK_i(2, 0) += t * nr[2] * nr[0]; matK_i(2, 1) += t * nr[2] * nr[1]; matK_i(2, 2) += t * nr[2] * nr[2];
 
-		
-				matL_i(0, 0) += t*n[0] * nr[0]; matL_i(0, 1) += t*n[0] * nr[1]; matL_i(0, 2) += t*n[0] * nr[2];
-				matL_i(1, 0) += t*n[1] * nr[0]; matL_i(1, 1) += t*n[1] * nr[1]; matL_i(1, 2) += t*n[1] * nr[2];
-				matL_i(2, 0) += t*n[2] * nr[0]; matL_i(2, 1) += t*n[2] * nr[1]; matL_i(2, 2) += t*n[2] * nr[2];
+		matL_i(0, 0) += t * n[0] * nr[0]; matL_i(0, 1) += t * n[0] * nr[1]; matL_i(0, 2) += t * n[0] * nr[2];
+		matL_i(1, 0) += t * n[1] * nr[0]; matL_i(1, 1) += t * n[1] * nr[1]; matL_i(1, 2) += t * n[1] * nr[2];
+		matL_i(2, 0) += t * n[2] * nr[0]; matL_i(2, 1) += t * n[2] * nr[1]; matL_i(2, 2) += t * n[2] * nr[2];
 
-				total_weight += 2 * t;
-				if (total_weight > EPSILON) 
-			{
-				matL_i *= (1.0f / total_weight);
-				matK_i *= (1.0f / total_weight);
-			}
-		
-
-		Matrix R, U, D, V;
-		polarDecomposition(matK_i, R, U, D, V);
-
-#ifdef DEBUG_INFO
-		if (pId == 497)
+		total_weight += 2 * t;
+		if (total_weight > EPSILON)
 		{
-			Matrix mat_out = matK_i;
-			printf("matK_i: \n %f %f %f \n %f %f %f \n %f %f %f \n\n",
-				mat_out(0, 0), mat_out(0, 1), mat_out(0, 2),
-				mat_out(1, 0), mat_out(1, 1), mat_out(1, 2),
-				mat_out(2, 0), mat_out(2, 1), mat_out(2, 2));
-
-			mat_out = matL_i;
-			printf("matL_i: \n %f %f %f \n %f %f %f \n %f %f %f \n\n",
-				mat_out(0, 0), mat_out(0, 1), mat_out(0, 2),
-				mat_out(1, 0), mat_out(1, 1), mat_out(1, 2),
-				mat_out(2, 0), mat_out(2, 1), mat_out(2, 2));
-
-			mat_out = U * D * V.transpose();
-			printf("matK polar: \n %f %f %f \n %f %f %f \n %f %f %f \n\n",
-				mat_out(0, 0), mat_out(0, 1), mat_out(0, 2),
-				mat_out(1, 0), mat_out(1, 1), mat_out(1, 2),
-				mat_out(2, 0), mat_out(2, 1), mat_out(2, 2));
-
-			printf("Horizon: %f; Det: %f \n", horizon, matK_i.determinant());
+			matL_i *= (1.0f / total_weight);
+			matK_i *= (1.0f / total_weight);
 		}
-#endif // DEBUG_INFO
 
-		Real maxK = maximum(abs(D(0, 0)), maximum(abs(D(1, 1)),abs(D(2,2))));
-		Real minK = minimum(abs(D(0, 0)), minimum(abs(D(1, 1)),abs(D(2,2))));
-		
+		matL[pId] = matL_i;
+		matK[pId] = matK_i;
+	}
+
+	/**
+	 * The polar decomposition of K is given by polarU, polarD and polarV, F is overwritten by L * K^-1
+	 */
+	template <typename Real, typename Matrix>
+	__global__ void HM_ComputeDeformationGradient(
+		DArray<Matrix> F,
+		DArray<Matrix> invK,
+		DArray<bool> validOfK,
+		DArray<Matrix> matL,
+		DArray<Matrix> matK,
+		DArray<Matrix> polarU,
+		DArray<Matrix> polarD,
+		DArray<Matrix> polarV,
+		Real horizon,
+		Real strainLimit)
+	{
+		int pId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (pId >= F.size()) return;
+
+		Matrix matL_i = matL[pId];
+		Matrix matK_i = matK[pId];
+		Matrix U = polarU[pId];
+		Matrix D = polarD[pId];
+		Matrix V = polarV[pId];
+
+		Real maxK = maximum(abs(D(0, 0)), maximum(abs(D(1, 1)), abs(D(2, 2))));
+		Real minK = minimum(abs(D(0, 0)), minimum(abs(D(1, 1)), abs(D(2, 2))));
 
-		bool valid_K = (minK < EPSILON || maxK / minK > Real(1/(strainLimit * strainLimit))) ? false : true;
+		bool valid_K = (minK < EPSILON || maxK / minK > Real(1 / (strainLimit * strainLimit))) ? false : true;
 		validOfK[pId] = valid_K;
 
 		Matrix F_i;
@@ -459,7 +433,6 @@ namespace dyno
 		{
 			invK[pId] = matK_i.inverse();
 			F_i = matL_i * matK_i.inverse();
-			
 		}
 		else
 		{
@@ -471,55 +444,41 @@ namespace dyno
 			F_i = matL_i * invK[pId];
 		}
 
-		polarDecomposition(F_i, R, U, D, V);
+		F[pId] = F_i;
+	}
 
-#ifdef DEBUG_INFO
-		if (pId == 497)
-		{
-			Matrix mat_out = F_i;
-			printf("matF_i: \n %f %f %f \n %f %f %f \n %f %f %f \n\n",
-				mat_out(0, 0), mat_out(0, 1), mat_out(0, 2),
-				mat_out(1, 0), mat_out(1, 1), mat_out(1, 2),
-				mat_out(2, 0), mat_out(2, 1), mat_out(2, 2));
-
-			mat_out = D;
-			printf("matD: \n %f %f %f \n %f %f %f \n %f %f %f \n\n",
-				mat_out(0, 0), mat_out(0, 1), mat_out(0, 2),
-				mat_out(1, 0), mat_out(1, 1), mat_out(1, 2),
-				mat_out(2, 0), mat_out(2, 1), mat_out(2, 2));
-
-			printf("Horizon: %f; Det: %f \n", horizon, F_i.determinant());
-		}
-#endif // DEBUG_INFO
-		if (F_i.determinant() < maxDist * EPSILON)
-		{
-			R = Rots[pId];
-		}
-		else
-			Rots[pId] = R;
-
-		//strain limit
-		Coord n0 = Coord(1, 0, 0);
-		Coord n1 = Coord(0, 1, 0);
-		Coord n2 = Coord(0, 0, 1);
-
-#ifdef DEBUG_INFO
-		Coord n0_rot = R * n0;
-		Coord n1_rot = R * n1;
-		Coord n2_rot = R * n2;
-
-		Real un0 = n0_rot.dot(n);
-		Real un1 = n1_rot.dot(n);
-		Real un2 = n2_rot.dot(n);
-		printf("U * N: %f,%f,%f\n",un0,un1,un2);
-		
+	/**
+	 * The polar decomposition of F is given by polarR, polarU, polarD and polarV, F is overwritten by the strain limited deformation gradient
+	 */
+	template <typename Real, typename Coord, typename Matrix, typename Bond>
+	__global__ void HM_LimitStrain(
+		DArray<Matrix> F,
+		DArray<Coord> eigens,
+		DArray<Matrix> matU,
+		DArray<Matrix> matV,
+		DArray<Matrix> Rots,
+		DArray<Matrix> polarR,
+		DArray<Matrix> polarU,
+		DArray<Matrix> polarD,
+		DArray<Matrix> polarV,
+		DArray<Coord> X,
+		DArrayList<Bond> bonds,
+		Real strainLimit)
+	{
+		int pId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (pId >= F.size()) return;
 
-		/*
-		Real l0 = n0_rot.dot(F_i * n0);
-		Real l1 = n1_rot.dot(F_i * n1);
-		Real l2 = n2_rot.dot(F_i * n2);
-		*/
-#endif
+		Matrix F_i = F[pId];
+		Matrix U = polarU[pId];
+		Matrix D = polarD[pId];
+		Matrix V = polarV[pId];
+
+		Real t = 1;
+
+		Real maxDist = HM_MaxBondLength<Real>(X, bonds[pId], X[pId]);
+
+		if (F_i.determinant() >= maxDist * EPSILON)
+			Rots[pId] = polarR[pId];
 
 		matU[pId] = U;
 		matV[pId] = V;
@@ -528,31 +487,16 @@ namespace dyno
 		Real l2 = D(2, 2);
 
 		const Real slimit = min(t, strainLimit);
-		l0 = clamp(l0, slimit, 1/slimit);
-		l1 = clamp(l1, slimit, 1/slimit);
-		l2 = clamp(l2, slimit, 1/slimit);
-		/*
-		if (l0 == slimit)
-			printf("l0 got low clamp, %f\n",l0);
-		else if(l0 == 1/slimit)
-			printf("l0 got high clamp, %f\n",l0);
-		if (l1 == slimit)
-			printf("l1 got low clamp, %f\n",l1);
-		else if (l1 == 1 / slimit)
-			printf("l1 got high clamp, %f\n",l1);
-		if (l2 == slimit)
-			printf("l2 got low clamp, %f\n",l2);
-		else if (l2 == 1 / slimit)
-			printf("l2 got high clamp, %f\n",l2);
-			*/
+		l0 = clamp(l0, slimit, 1 / slimit);
+		l1 = clamp(l1, slimit, 1 / slimit);
+		l2 = clamp(l2, slimit, 1 / slimit);
 
 		D(0, 0) = l0;
 		D(1, 1) = l1;
 		D(2, 2) = l2;
-		
-		eigens[pId] = Coord(D(0,0), D(1,1), D(2,2));
+
+		eigens[pId] = Coord(D(0, 0), D(1, 1), D(2, 2));
 		F[pId] = U * D * V.transpose();
-		
 	}
 
 
@@ -821,6 +765,53 @@ namespace dyno
 	}
 
 
+	template<typename TDataType>
+	void CoSemiImplicitHyperelasticitySolver<TDataType>::computeDeformationGradient()
+	{
+		//The polar decompositions are done for all particles at once between the kernels
+		cuExecute(y_current.size(),
+			HM_ComputeShapeMatrices,
+			mMatL,
+			mMatK,
+			this->inX()->getData(),
+			y_current,
+			this->inBonds()->getData(),
+			this->inRestNorm()->getData(),
+			this->inNorm()->getData());
+
+		polarDecomposition(mMatK, mPolarR, mPolarU, mPolarD, mPolarV);
+
+		cuExecute(m_F.size(),
+			HM_ComputeDeformationGradient,
+			m_F,
+			m_invK,
+			m_validOfK,
+			mMatL,
+			mMatK,
+			mPolarU,
+			mPolarD,
+			mPolarV,
+			this->inHorizon()->getData(),
+			Real(0.3));
+
+		polarDecomposition(m_F, mPolarR, mPolarU, mPolarD, mPolarV);
+
+		cuExecute(m_F.size(),
+			HM_LimitStrain,
+			m_F,
+			m_eigenValues,
+			m_matU,
+			m_matV,
+			m_matR,
+			mPolarR,
+			mPolarU,
+			mPolarD,
+			mPolarV,
+			this->inX()->getData(),
+			this->inBonds()->getData(),
+			Real(0.3));
+	}
+
 	template<typename TDataType>
 	void CoSemiImplicitHyperelasticitySolver<TDataType>::resizeAllFields()
 	{
@@ -841,6 +832,8 @@ namespace dyno
 		m_matU.resize(num);
 		m_matV.resize(num);
 		m_matR.resize(num);
+		mMatL.resize(num);
+		mMatK.resize(num);
 		m_volume.resize(num);
 
 		m_energy.resize(num);
@@ -914,22 +907,7 @@ namespace dyno
 				m_source.reset();
 				m_A.reset();
 
-				HM_ComputeF << <pDims, BLOCK_SIZE >> > (
-					m_F,
-					m_eigenValues,
-					m_invK,
-					m_validOfK,
-					m_matU,
-					m_matV,
-					m_matR,
-					this->inX()->getData(),
-					y_current,
-					this->inBonds()->getData(),
-					this->inHorizon()->getData(),
-					(Real const)0.3,
-					this->inRestNorm()->getData(),
-					this->inNorm()->getData());
-				cuSynchronize();
+				this->computeDeformationGradient();
 
 				HM_JacobiStepNonsymmetric << <pDims, BLOCK_SIZE >> > (
 					m_source,
@@ -1036,22 +1014,7 @@ namespace dyno
 			m_A.reset();
 			y_current.assign(cntPos);
 
-			HM_ComputeF << <pDims, BLOCK_SIZE >> > (
-				m_F,
-				m_eigenValues,
-				m_invK,
-				m_validOfK,
-				m_matU,
-				m_matV,
-				m_matR,
-				this->inX()->getData(),
-				y_current,
-				this->inBonds()->getData(),
-				this->inHorizon()->getData(),
-				(Real const)0.3,
-				this->inRestNorm()->getData(),
-				this->inNorm()->getData());
-			cuSynchronize();
+			this->computeDeformationGradient();
 
 			HM_JacobiStepNonsymmetric << <pDims, BLOCK_SIZE >> > (
 				m_source,
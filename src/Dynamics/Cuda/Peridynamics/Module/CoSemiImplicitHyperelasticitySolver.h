@@ -20,7 +20,7 @@ namespace dyno
 		typedef typename TDataType::Real Real;
 		typedef typename TDataType::Coord Coord;
 		typedef typename TDataType::Matrix Matrix;
-		typedef typename TBond<TDataType> Bond;
+		typedef typename ::dyno::TBond<TDataType> Bond;
 
 		CoSemiImplicitHyperelasticitySolver();
 		~CoSemiImplicitHyperelasticitySolver() override;
@@ -110,6 +110,11 @@ namespace dyno
 
 		void resizeAllFields();
 
+		/**
+		 * @brief Deformation gradients of y_current, strain limited, with their rotations
+		 */
+		void computeDeformationGradient();
+
 	private:
 		void connectContact();
 		Real E = 1e3;
@@ -135,6 +140,15 @@ namespace dyno
 		DArray<Matrix> m_matU;
 		DArray<Matrix> m_matV;
 		DArray<Matrix> m_matR;
+
+		//Shape matrices and their polar decompositions
+		DArray<Matrix> mMatL;
+		DArray<Matrix> mMatK;
+		DArray<Matrix> mPolarR;
+		DArray<Matrix> mPolarU;
+		DArray<Matrix> mPolarD;
+		DArray<Matrix> mPolarV;
+
 		DArray<Coord> y_current;
 		DArray<Coord> y_next;
 		DArray<Coord> y_pre;
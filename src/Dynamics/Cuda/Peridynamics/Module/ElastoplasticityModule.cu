@@ -1,5 +1,6 @@
 #include "ElastoplasticityModule.h"
 #include "Matrix/MatrixFunc.h"
+#include "Algorithm/PolarDecomposition.h"
 
 namespace dyno
 {
@@ -408,22 +409,23 @@ namespace dyno
 	}
 
 	template <typename Real, typename Coord, typename Matrix, typename Bond>
-	__global__ void PM_ComputeInverseDeformation(
-		DArray<Matrix> invF,
+	__global__ void PM_ComputeMomentMatrices(
+		DArray<Matrix> curM,
+		DArray<Matrix> refM,
 		DArray<Coord> X,
 		DArray<Coord> Y,
 		DArrayList<Bond> bonds,
 		Real horizon)
 	{
 		int i = threadIdx.x + (blockIdx.x * blockDim.x);
-		if (i >= invF.size()) return;
+		if (i >= refM.size()) return;
 
 		CorrectedKernel<Real> kernSmooth;
 
 		//reconstruct the rest shape as the yielding condition is violated.
 		Real total_weight = 0.0f;
-		Matrix curM(0);
-		Matrix refM(0);
+		Matrix curM_i(0);
+		Matrix refM_i(0);
 
 		List<Bond>& bonds_i = bonds[i];
 		Coord x_i = X[i];
@@ -442,13 +444,13 @@ namespace dyno
 				Coord p = (Y[j] - Y[i]) / horizon;
 				Coord q = (x_j - x_i) / horizon;
 
-				curM(0, 0) += p[0] * p[0] * weight; curM(0, 1) += p[0] * p[1] * weight; curM(0, 2) += p[0] * p[2] * weight;
-				curM(1, 0) += p[1] * p[0] * weight; curM(1, 1) += p[1] * p[1] * weight; curM(1, 2) += p[1] * p[2] * weight;
-				curM(2, 0) += p[2] * p[0] * weight; curM(2, 1) += p[2] * p[1] * weight; curM(2, 2) += p[2] * p[2] * weight;
+				curM_i(0, 0) += p[0] * p[0] * weight; curM_i(0, 1) += p[0] * p[1] * weight; curM_i(0, 2) += p[0] * p[2] * weight;
+				curM_i(1, 0) += p[1] * p[0] * weight; curM_i(1, 1) += p[1] * p[1] * weight; curM_i(1, 2) += p[1] * p[2] * weight;
+				curM_i(2, 0) += p[2] * p[0] * weight; curM_i(2, 1) += p[2] * p[1] * weight; curM_i(2, 2) += p[2] * p[2] * weight;
 
-				refM(0, 0) += q[0] * p[0] * weight; refM(0, 1) += q[0] * p[1] * weight; refM(0, 2) += q[0] * p[2] * weight;
-				refM(1, 0) += q[1] * p[0] * weight; refM(1, 1) += q[1] * p[1] * weight; refM(1, 2) += q[1] * p[2] * weight;
-				refM(2, 0) += q[2] * p[0] * weight; refM(2, 1) += q[2] * p[1] * weight; refM(2, 2) += q[2] * p[2] * weight;
+				refM_i(0, 0) += q[0] * p[0] * weight; refM_i(0, 1) += q[0] * p[1] * weight; refM_i(0, 2) += q[0] * p[2] * weight;
+				refM_i(1, 0) += q[1] * p[0] * weight; refM_i(1, 1) += q[1] * p[1] * weight; refM_i(1, 2) += q[1] * p[2] * weight;
+				refM_i(2, 0) += q[2] * p[0] * weight; refM_i(2, 1) += q[2] * p[1] * weight; refM_i(2, 2) += q[2] * p[2] * weight;
 
 				total_weight += weight;
 			}
@@ -459,23 +461,34 @@ namespace dyno
 		{
 			total_weight = Real(1);
 		}
-		refM *= (1.0f / total_weight);
-		curM *= (1.0f / total_weight);
+		refM_i *= (1.0f / total_weight);
+		curM_i *= (1.0f / total_weight);
 
-		Real threshold = Real(0.00001);
-		Matrix curR, curU, curD, curV;
+		curM[i] = curM_i;
+		refM[i] = refM_i;
+	}
 
-		polarDecomposition(curM, curR, curU, curD, curV);
+	/**
+	 * invF holds the reference moment matrices, the polar decomposition of the current ones is given by curU, curD and curV
+	 */
+	template <typename Real, typename Matrix>
+	__global__ void PM_ComputeInverseDeformation(
+		DArray<Matrix> invF,
+		DArray<Matrix> curU,
+		DArray<Matrix> curD,
+		DArray<Matrix> curV,
+		Real threshold)
+	{
+		int i = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (i >= invF.size()) return;
 
-		curD(0, 0) = curD(0, 0) > threshold ? 1.0 / curD(0, 0) : 1.0 / threshold;
-		curD(1, 1) = curD(1, 1) > threshold ? 1.0 / curD(1, 1) : 1.0 / threshold;
-		curD(2, 2) = curD(2, 2) > threshold ? 1.0 / curD(2, 2) : 1.0 / threshold;
-		refM *= curV*curD*curU.transpose();
+		Matrix refM = invF[i];
+		Matrix D = curD[i];
 
-		// 		if (abs(refM.determinant() - 1) > 0.05f)
-		// 		{
-		// 			refM = Matrix::identityMatrix();
-		// 		}
+		D(0, 0) = D(0, 0) > threshold ? 1.0 / D(0, 0) : 1.0 / threshold;
+		D(1, 1) = D(1, 1) > threshold ? 1.0 / D(1, 1) : 1.0 / threshold;
+		D(2, 2) = D(2, 2) > threshold ? 1.0 / D(2, 2) : 1.0 / threshold;
+		refM *= curV[i] * D * curU[i].transpose();
 
 		if (refM.determinant() < EPSILON)
 		{
@@ -520,14 +533,27 @@ namespace dyno
 		DArrayList<Bond> newBonds;
 		newBonds.resize(index);
 
+		mMatA.resize(m_invF.size());
+
 		cuExecute(m_invF.size(),
-			PM_ComputeInverseDeformation,
+			PM_ComputeMomentMatrices,
+			mMatA,
 			m_invF,
 			this->inX()->getData(),
 			this->inY()->getData(),
 			this->inBonds()->getData(),
 			this->inHorizon()->getData());
 
+		polarDecomposition(mMatA, mPolarR, mPolarU, mPolarD, mPolarV);
+
+		cuExecute(m_invF.size(),
+			PM_ComputeInverseDeformation,
+			m_invF,
+			mPolarU,
+			mPolarD,
+			mPolarV,
+			Real(0.00001));
+
 		cuExecute(newBonds.size(),
 			PM_ReconstructRestShape,
 			newBonds,
@@ -550,10 +576,11 @@ namespace dyno
 	}
 
 	template <typename Real, typename Coord, typename Matrix, typename Bond>
-	__global__ void EM_RotateRestShape(
+	__global__ void EM_ComputeShapeMatrices(
+		DArray<Matrix> matL,
+		DArray<Matrix> matK,
 		DArray<Coord> X,
 		DArray<Coord> Y,
-		DArray<bool> bYield,
 		DArrayList<Bond> bonds,
 		Real smoothingLength)
 	{
@@ -566,7 +593,6 @@ namespace dyno
 		Coord x_i = X[pId];
 		int size_i = bonds_i.size();
 
-		//			cout << i << " " << rids[shape_i.ids[shape_i.idx]] << endl;
 		Real total_weight = 0.0f;
 		Matrix mat_i(0);
 		Matrix invK_i(0);
@@ -582,7 +608,6 @@ namespace dyno
 				Real weight = kernSmooth.Weight(r, smoothingLength);
 
 				Coord p = (Y[j] - Y[pId]) / smoothingLength;
-				//Vec3f q = (shape_i.pos[ne] - rest_i)*(1.0f/r)*weight;
 				Coord q = (x_j - x_i) / smoothingLength;
 
 				mat_i(0, 0) += p[0] * q[0] * weight; mat_i(0, 1) += p[0] * q[1] * weight; mat_i(0, 2) += p[0] * q[2] * weight;
@@ -603,26 +628,59 @@ namespace dyno
 			invK_i *= (1.0f / total_weight);
 		}
 
-		Matrix R, U, D, V;
-		polarDecomposition(invK_i, R, U, D, V);
+		matL[pId] = mat_i;
+		matK[pId] = invK_i;
+	}
+
+	/**
+	 * The polar decomposition of K is given by polarU, polarD and polarV, L is overwritten by L * K^-1
+	 */
+	template <typename Real, typename Matrix>
+	__global__ void EM_ComputeDeformationGradient(
+		DArray<Matrix> matL,
+		DArray<Matrix> polarU,
+		DArray<Matrix> polarD,
+		DArray<Matrix> polarV,
+		Real smoothingLength)
+	{
+		int pId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (pId >= matL.size()) return;
+
+		Matrix D = polarD[pId];
 
 		Real threshold = 0.0001f*smoothingLength;
 		D(0, 0) = D(0, 0) > threshold ? 1.0 / D(0, 0) : 1.0;
 		D(1, 1) = D(1, 1) > threshold ? 1.0 / D(1, 1) : 1.0;
 		D(2, 2) = D(2, 2) > threshold ? 1.0 / D(2, 2) : 1.0;
 
-		invK_i = V*D*U.transpose();
+		Matrix invK_i = polarV[pId] * D * polarU[pId].transpose();
 
-		mat_i *= invK_i;
+		matL[pId] *= invK_i;
+	}
 
-		polarDecomposition(mat_i, R, U, D, V);
+	/**
+	 * Rotate the bonds by R, the rotation of the polar decomposition of the deformation gradient
+	 */
+	template <typename Coord, typename Matrix, typename Bond>
+	__global__ void EM_RotateRestShape(
+		DArray<Coord> X,
+		DArray<Matrix> R,
+		DArrayList<Bond> bonds)
+	{
+		int pId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (pId >= R.size()) return;
+
+		List<Bond>& bonds_i = bonds[pId];
+		Coord x_i = X[pId];
+		int size_i = bonds_i.size();
 
+		Matrix R_i = R[pId];
 		for (int ne = 0; ne < size_i; ne++)
 		{
 			Bond bond_ij = bonds_i[ne];
 			Coord rest_pos_j = X[bond_ij.idx];
 
-			Coord new_rest_pos_j = x_i + R*(rest_pos_j - x_i);
+			Coord new_rest_pos_j = x_i + R_i*(rest_pos_j - x_i);
 			bond_ij.xi = new_rest_pos_j - x_i;
 			bonds_i[ne] = bond_ij;
 		}
@@ -633,15 +691,37 @@ namespace dyno
 	void ElastoplasticityModule<TDataType>::rotateRestShape()
 	{
 		int num = this->inY()->size();
-		uint pDims = cudaGridSize(num, BLOCK_SIZE);
 
-		EM_RotateRestShape <Real, Coord, Matrix, Bond> << <pDims, BLOCK_SIZE >> > (
+		mMatA.resize(num);
+		mMatB.resize(num);
+
+		//The polar decompositions are done for all particles at once between the kernels
+		cuExecute(num,
+			EM_ComputeShapeMatrices,
+			mMatA,
+			mMatB,
 			this->inX()->getData(),
 			this->inY()->getData(),
-			m_bYield,
 			this->inBonds()->getData(),
 			this->inHorizon()->getData());
-		cuSynchronize();
+
+		polarDecomposition(mMatB, mPolarR, mPolarU, mPolarD, mPolarV);
+
+		cuExecute(num,
+			EM_ComputeDeformationGradient,
+			mMatA,
+			mPolarU,
+			mPolarD,
+			mPolarV,
+			this->inHorizon()->getData());
+
+		polarDecomposition(mMatA, mPolarR, mPolarU, mPolarD, mPolarV);
+
+		cuExecute(num,
+			EM_RotateRestShape,
+			this->inX()->getData(),
+			mPolarR,
+			this->inBonds()->getData());
 	}
 
 	DEFINE_CLASS(ElastoplasticityModule);
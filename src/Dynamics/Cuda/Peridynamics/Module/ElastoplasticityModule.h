@@ -24,7 +24,7 @@ namespace dyno {
 		typedef typename TDataType::Real Real;
 		typedef typename TDataType::Coord Coord;
 		typedef typename TDataType::Matrix Matrix;
-		typedef typename TBond<TDataType> Bond;
+		typedef typename ::dyno::TBond<TDataType> Bond;
 
 		ElastoplasticityModule();
 		~ElastoplasticityModule() override;
@@ -73,6 +73,14 @@ namespace dyno {
 		DArray<Real> m_yield_J2;
 		DArray<Real> m_I1;
 
+		//Shape matrices and their polar decompositions
+		DArray<Matrix> mMatA;
+		DArray<Matrix> mMatB;
+		DArray<Matrix> mPolarR;
+		DArray<Matrix> mPolarU;
+		DArray<Matrix> mPolarD;
+		DArray<Matrix> mPolarV;
+
 		std::shared_ptr<IterativeDensitySolver<TDataType>> mDensityPBD;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 ﻿#include "SemiImplicitHyperelasticitySolver.h"
 
 #include "Matrix/MatrixFunc.h"
+#include "Algorithm/PolarDecomposition.h"
 #include "ParticleSystem/Module/Kernel.h"
 #include "curand_kernel.h"
 #include "Algorithm/CudaRand.h"
@@ -342,25 +343,29 @@ namespace dyno
 		return ret;
 	}
 
-	template <typename Real, typename Coord, typename Matrix, typename Bond>
-	__global__ void HM_ComputeF(
-		DArray<Matrix> F,
-		DArray<Coord> eigens,
-		DArray<Matrix> invK,
-		DArray<bool> validOfK,
-		DArray<Matrix> matU,
-		DArray<Matrix> matV,
-		DArray<Matrix> Rots,
+	template <typename Real, typename Bond>
+	__device__ Real HM_MaxBondLength(List<Bond>& bonds_i)
+	{
+		Real maxDist = Real(0);
+		for (int ne = 0; ne < bonds_i.size(); ne++)
+		{
+			maxDist = max(maxDist, bonds_i[ne].xi.norm());
+		}
+		return maxDist < EPSILON ? Real(1) : maxDist;
+	}
+
+	template <typename Coord, typename Matrix, typename Bond>
+	__global__ void HM_ComputeShapeMatrices(
+		DArray<Matrix> matL,
+		DArray<Matrix> matK,
 		DArray<Coord> X,
 		DArray<Coord> Y,
-		DArrayList<Bond> bonds,
-		Real strainLimiting,
-		Real horizon)
+		DArrayList<Bond> bonds)
 	{
+		typedef typename Coord::VarType Real;
+
 		int pId = threadIdx.x + (blockIdx.x * blockDim.x);
 		if (pId >= Y.size()) return;
-		/*if (pId % 100 == 0)
-			printf("%d %d \n", pId, pId);*/
 
 		Coord x_i = X[pId];
 
@@ -368,31 +373,13 @@ namespace dyno
 		Matrix matL_i(0);
 		Matrix matK_i(0);
 
-#ifdef DEBUG_INFO
-		if (pId == 497)
-		{
-			printf("Position in HM_ComputeF %d: %f %f %f \n", pId, Y[pId][0], Y[pId][1], Y[pId][2]);
-		}
-#endif // DEBUG_INFO
-		
 		List<Bond>& bonds_i = bonds[pId];
 
-		Real maxDist = Real(0);
-		for (int ne = 0; ne < bonds_i.size(); ne++)
-		{
-			maxDist = max(maxDist, bonds_i[ne].xi.norm());
-		}
-		maxDist = maxDist < EPSILON ? Real(1) : maxDist;
-
-		//printf("maxdist %d: %f; \n\n", pId, maxDist);
-
-#ifdef DEBUG_INFO
-		printf("Max distance %d: %f \n", pId, maxDist);
-#endif // DEBUG_INFO
+		Real maxDist = HM_MaxBondLength<Real>(bonds_i);
 
 		for (int ne = 0; ne < bonds_i.size(); ne++)
 		{
-			Bond bond_ij = bonds[pId][ne];
+			Bond bond_ij = bonds_i[ne];
 			int j = bond_ij.idx;
 			Coord x_j = X[j];
 			Real r = (x_i - x_j).norm();
@@ -401,7 +388,6 @@ namespace dyno
 			{
 				Coord p = (Y[j] - Y[pId]) / maxDist;
 				Coord q = (x_j - x_i) / maxDist;
-				//Real weight = D_Weight(r, horizon);
 				Real weight = 1.;
 
 				matL_i(0, 0) += p[0] * q[0] * weight; matL_i(0, 1) += p[0] * q[1] * weight; matL_i(0, 2) += p[0] * q[2] * weight;
@@ -413,13 +399,6 @@ namespace dyno
 				matK_i(2, 0) += q[2] * q[0] * weight; matK_i(2, 1) += q[2] * q[1] * weight; matK_i(2, 2) += q[2] * q[2] * weight;
 
 				total_weight += weight;
-
-#ifdef DEBUG_INFO
-				if (pId == 497)
-				{
-					printf("%d Neighbor %d: %f %f %f \n", pId, j, Y[j][0], Y[j][1], Y[j][2]);
-				}
-#endif // DEBUG_INFO
 			}
 		}
 
@@ -429,33 +408,33 @@ namespace dyno
 			matK_i *= (1.0f / total_weight);
 		}
 
-		Matrix R, U, D, V;
-		polarDecomposition(matK_i, R, U, D, V);
+		matL[pId] = matL_i;
+		matK[pId] = matK_i;
+	}
 
-#ifdef DEBUG_INFO
-		if (pId == 497)
-		{
-			Matrix mat_out = matK_i;
-			printf("matK_i: \n %f %f %f \n %f %f %f \n %f %f %f \n\n",
-				mat_out(0, 0), mat_out(0, 1), mat_out(0, 2),
-				mat_out(1, 0), mat_out(1, 1), mat_out(1, 2),
-				mat_out(2, 0), mat_out(2, 1), mat_out(2, 2));
-
-			mat_out = matL_i;
-			printf("matL_i: \n %f %f %f \n %f %f %f \n %f %f %f \n\n",
-				mat_out(0, 0), mat_out(0, 1), mat_out(0, 2),
-				mat_out(1, 0), mat_out(1, 1), mat_out(1, 2),
-				mat_out(2, 0), mat_out(2, 1), mat_out(2, 2));
-
-			mat_out = U * D * V.transpose();
-			printf("matK polar: \n %f %f %f \n %f %f %f \n %f %f %f \n\n",
-				mat_out(0, 0), mat_out(0, 1), mat_out(0, 2),
-				mat_out(1, 0), mat_out(1, 1), mat_out(1, 2),
-				mat_out(2, 0), mat_out(2, 1), mat_out(2, 2));
-
-			printf("Horizon: %f; Det: %f \n", horizon, matK_i.determinant());
-		}
-#endif // DEBUG_INFO
+	/**
+	 * The polar decomposition of K is given by polarU, polarD and polarV, F is overwritten by L * K^-1
+	 */
+	template <typename Real, typename Matrix>
+	__global__ void HM_ComputeDeformationGradient(
+		DArray<Matrix> F,
+		DArray<Matrix> invK,
+		DArray<bool> validOfK,
+		DArray<Matrix> matL,
+		DArray<Matrix> matK,
+		DArray<Matrix> polarU,
+		DArray<Matrix> polarD,
+		DArray<Matrix> polarV,
+		Real horizon)
+	{
+		int pId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (pId >= F.size()) return;
+
+		Matrix matL_i = matL[pId];
+		Matrix matK_i = matK[pId];
+		Matrix U = polarU[pId];
+		Matrix D = polarD[pId];
+		Matrix V = polarV[pId];
 
 		Real maxK = maximum(abs(D(0, 0)), maximum(abs(D(1, 1)), abs(D(2, 2))));
 		Real minK = minimum(abs(D(0, 0)), minimum(abs(D(1, 1)), abs(D(2, 2))));
@@ -480,21 +459,33 @@ namespace dyno
 			F_i = matL_i * V * D * U.transpose();
 		}
 
-		polarDecomposition(F_i, R, U, D, V);
+		F[pId] = F_i;
+	}
 
-		// 		Real minDist = Real(1000.0f);
-		// 		for (int ne = 0; ne < size_i; ne++)
-		// 		{
-		// 			Bond np_j = restShapes[pId][ne];
-		// 			int j = np_j.index;
-		// 			Coord rest_pos_j = np_j.pos;
-		// 			Real r = (rest_pos_i - rest_pos_j).norm();
-		// 
-		// 			if(r > EPSILON)
-		// 				minDist = min(minDist, r);
-		// 		}
-		// 
-		// 		printf("ID %d: min value %f \n", pId, minDist);
+	/**
+	 * The polar decomposition of F is given by polarU, polarD and polarV, F is overwritten by the strain limited deformation gradient
+	 */
+	template <typename Real, typename Coord, typename Matrix, typename Bond>
+	__global__ void HM_LimitStrain(
+		DArray<Matrix> F,
+		DArray<Coord> eigens,
+		DArray<Matrix> matU,
+		DArray<Matrix> matV,
+		DArray<Matrix> polarU,
+		DArray<Matrix> polarD,
+		DArray<Matrix> polarV,
+		DArrayList<Bond> bonds,
+		Real strainLimiting)
+	{
+		int pId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (pId >= F.size()) return;
+
+		Matrix F_i = F[pId];
+		Matrix U = polarU[pId];
+		Matrix D = polarD[pId];
+		Matrix V = polarV[pId];
+
+		Real maxDist = HM_MaxBondLength<Real>(bonds[pId]);
 
 		if (F_i.determinant() < maxDist * EPSILON)
 		{
@@ -505,14 +496,6 @@ namespace dyno
 			matV[pId] = V;
 		}
 
-		// 		Coord n0 = Coord(1, 0, 0);
-		// 		Coord n1 = Coord(0, 1, 0);
-		// 		Coord n2 = Coord(0, 0, 1);
-		// 
-		// 		Coord n0_rot = R * n0;
-		// 		Coord n1_rot = R * n1;
-		// 		Coord n2_rot = R * n2;
-
 		Real l0 = D(0, 0);
 		Real l1 = D(1, 1);
 		Real l2 = D(2, 2);
@@ -530,44 +513,6 @@ namespace dyno
 		eigens[pId] = Coord(l0, l1, l2);
 
 		F[pId] = U * D * V.transpose();
-
-		// 		if (F_i.determinant() < maxDist*EPSILON)
-		// 		{
-		// 			R = Rots[pId];
-		// 		}
-		// 		else
-		// 		{
-		// 			Rots[pId] = R;
-		// 		}
-		// 			
-		// 		Coord n0 = Coord(1, 0, 0);
-		// 		Coord n1 = Coord(0, 1, 0);
-		// 		Coord n2 = Coord(0, 0, 1);
-		// 
-		// 		Coord n0_rot = R * n0;
-		// 		Coord n1_rot = R * n1;
-		// 		Coord n2_rot = R * n2;
-		// 
-		// 		Real l0 = n0_rot.dot(F_i*n0);
-		// 		Real l1 = n1_rot.dot(F_i*n1);
-		// 		Real l2 = n2_rot.dot(F_i*n2);
-		// 
-		// 		matU[pId] = R;
-		// 		matV[pId] = Matrix::identityMatrix();
-		// 
-		// 		const Real slimit = strainLimiting;
-		// 
-		// 		l0 = clamp(l0, slimit, 1 / slimit);
-		// 		l1 = clamp(l1, slimit, 1 / slimit);
-		// 		l2 = clamp(l2, slimit, 1 / slimit);
-		// 
-		// 		D(0, 0) = l0;
-		// 		D(1, 1) = l1;
-		// 		D(2, 2) = l2;
-		// 
-		// 		eigens[pId] = Coord(l0, l1, l2);
-		// 
-		// 		F[pId] = R * D;
 	}
 
 	template <typename Real, typename Coord, typename Matrix, typename Bond>
@@ -821,6 +766,9 @@ namespace dyno
 		m_matV.resize(num);
 		m_matR.resize(num);
 
+		mMatL.resize(num);
+		mMatK.resize(num);
+
 		m_energy.resize(num);
 		m_alpha.resize(num);
 		m_gradient.resize(num);
@@ -884,20 +832,42 @@ namespace dyno
 			
 			m_source.reset();
 			m_A.reset();
-			HM_ComputeF << <pDims, BLOCK_SIZE >> > (
+			//The polar decompositions are done for all particles at once between the kernels
+			cuExecute(y_current.size(),
+				HM_ComputeShapeMatrices,
+				mMatL,
+				mMatK,
+				this->inX()->getData(),
+				y_current,
+				this->inBonds()->getData());
+
+			polarDecomposition(mMatK, mPolarR, mPolarU, mPolarD, mPolarV);
+
+			cuExecute(m_F.size(),
+				HM_ComputeDeformationGradient,
 				m_F,
-				m_eigenValues,
 				m_invK,
 				m_validOfK,
+				mMatL,
+				mMatK,
+				mPolarU,
+				mPolarD,
+				mPolarV,
+				this->inHorizon()->getData());
+
+			polarDecomposition(m_F, mPolarR, mPolarU, mPolarD, mPolarV);
+
+			cuExecute(m_F.size(),
+				HM_LimitStrain,
+				m_F,
+				m_eigenValues,
 				m_matU,
 				m_matV,
-				m_matR,
-				this->inX()->getData(),
-				y_current,
+				mPolarU,
+				mPolarD,
+				mPolarV,
 				this->inBonds()->getData(),
-				this->varStrainLimiting()->getData(),
-				this->inHorizon()->getData());
-			cuSynchronize();
+				this->varStrainLimiting()->getData());
 			
 			HM_JacobiStepNonsymmetric << <pDims, BLOCK_SIZE >> > (
 				m_source,
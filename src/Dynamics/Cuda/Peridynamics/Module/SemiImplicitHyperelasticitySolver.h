@@ -17,7 +17,7 @@ namespace dyno
 		typedef typename TDataType::Real Real;
 		typedef typename TDataType::Coord Coord;
 		typedef typename TDataType::Matrix Matrix;
-		typedef typename TBond<TDataType> Bond;
+		typedef typename ::dyno::TBond<TDataType> Bond;
 
 		SemiImplicitHyperelasticitySolver();
 		~SemiImplicitHyperelasticitySolver() override;
@@ -61,6 +61,14 @@ namespace dyno
 		DArray<Matrix> m_matV;
 		DArray<Matrix> m_matR;
 
+		//Shape matrices and their polar decompositions
+		DArray<Matrix> mMatL;
+		DArray<Matrix> mMatK;
+		DArray<Matrix> mPolarR;
+		DArray<Matrix> mPolarU;
+		DArray<Matrix> mPolarD;
+		DArray<Matrix> mPolarV;
+
 		DArray<Coord> y_current;
 		DArray<Coord> y_next;
 		DArray<Coord> y_pre;
@@ -28,11 +28,11 @@ namespace dyno
 		typedef typename TDataType::Coord Coord;
 		typedef typename TDataType::Matrix Matrix;
 
-		typedef typename BallAndSocketJoint<Real> BallAndSocketJoint;
-		typedef typename SliderJoint<Real> SliderJoint;
-		typedef typename HingeJoint<Real> HingeJoint;
-		typedef typename FixedJoint<Real> FixedJoint;
-		typedef typename PointJoint<Real> PointJoint;
+		typedef typename ::dyno::BallAndSocketJoint<Real> BallAndSocketJoint;
+		typedef typename ::dyno::SliderJoint<Real> SliderJoint;
+		typedef typename ::dyno::HingeJoint<Real> HingeJoint;
+		typedef typename ::dyno::FixedJoint<Real> FixedJoint;
+		typedef typename ::dyno::PointJoint<Real> PointJoint;
 		typedef typename dyno::Quat<Real> TQuat;
 
 		CarDriver();
@@ -0,0 +1,322 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "Array/Array.h"
+#include "Array/Array2D.h"
+#include "Array/Array3D.h"
+#include "Array/ArrayList.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Append-only byte buffer used to snapshot field data, e.g., for checkpoints.
+	 *
+	 * Values are stored as raw bytes in the host byte order, device arrays are copied to the host first.
+	 * Element types are copied bitwise, the same way arrays are copied between the host and the device.
+	 */
+	class BinaryWriter
+	{
+	public:
+		BinaryWriter() : mBuffer(mStorage) {}
+
+		/**
+		 * @brief Append to an external buffer, its capacity is reused if the same buffer is written repeatedly
+		 */
+		explicit BinaryWriter(std::vector<unsigned char>& buffer) : mBuffer(buffer) {}
+
+		BinaryWriter(const BinaryWriter&) = delete;
+		BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+		void write(const void* data, size_t size)
+		{
+			if (size == 0)
+				return;
+
+			size_t offset = mBuffer.size();
+			mBuffer.resize(offset + size);
+			std::memcpy(mBuffer.data() + offset, data, size);
+		}
+
+		template<typename T>
+		void write(const T& val) { this->write(&val, sizeof(T)); }
+
+		void write(const std::string& str)
+		{
+			this->write(uint(str.size()));
+			this->write(str.data(), str.size());
+		}
+
+		template<typename T>
+		void write(const Array<T, DeviceType::CPU>& arr)
+		{
+			this->write(arr.size());
+			this->write(arr.begin(), sizeof(T) * arr.size());
+		}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+		/**
+		 * Device data is copied into the buffer directly, without a host array in between
+		 */
+		template<typename T>
+		void write(const Array<T, DeviceType::GPU>& arr)
+		{
+			this->write(arr.size());
+
+			size_t size = sizeof(T) * arr.size();
+			if (size == 0)
+				return;
+
+			size_t offset = mBuffer.size();
+			mBuffer.resize(offset + size);
+#ifdef CUDA_BACKEND
+			cuSafeCall(cudaMemcpy(mBuffer.data() + offset, arr.begin(), size, cudaMemcpyDeviceToHost));
+#else
+			std::memcpy(mBuffer.data() + offset, arr.begin(), size);
+#endif
+		}
+#else
+		template<typename T, DeviceType deviceType>
+		void write(const Array<T, deviceType>& arr)
+		{
+			CArray<T> host;
+			host.assign(arr);
+			this->write(host);
+		}
+#endif
+
+		template<typename T>
+		void write(const Array2D<T, DeviceType::CPU>& arr)
+		{
+			this->write(arr.nx());
+			this->write(arr.ny());
+			this->write(arr.begin(), sizeof(T) * arr.size());
+		}
+
+		template<typename T, DeviceType deviceType>
+		void write(const Array2D<T, deviceType>& arr)
+		{
+			CArray2D<T> host;
+			host.assign(arr);
+			this->write(host);
+		}
+
+		template<typename T>
+		void write(const Array3D<T, DeviceType::CPU>& arr)
+		{
+			this->write(arr.nx());
+			this->write(arr.ny());
+			this->write(arr.nz());
+			this->write(arr.begin(), sizeof(T) * arr.size());
+		}
+
+		template<typename T, DeviceType deviceType>
+		void write(const Array3D<T, deviceType>& arr)
+		{
+			CArray3D<T> host;
+			host.assign(arr);
+			this->write(host);
+		}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+		/**
+		 * Both the capacity and the size of each list are kept, elements beyond the size of a list are not stored
+		 */
+		template<typename T>
+		void write(const ArrayList<T, DeviceType::CPU>& arr)
+		{
+			ArrayList<T, DeviceType::CPU>& lists = const_cast<ArrayList<T, DeviceType::CPU>&>(arr);
+
+			uint num = lists.size();
+			this->write(num);
+
+			const CArray<uint>& index = lists.index();
+			for (uint i = 0; i < num; i++)
+			{
+				uint capacity = (i + 1 < num ? index[i + 1] : lists.elementSize()) - index[i];
+				this->write(capacity);
+				this->write(lists[i].size());
+			}
+
+			for (uint i = 0; i < num; i++)
+			{
+				this->write(lists[i].begin(), sizeof(T) * lists[i].size());
+			}
+		}
+
+		template<typename T, DeviceType deviceType>
+		void write(const ArrayList<T, deviceType>& arr)
+		{
+			CArrayList<T> host;
+			host.assign(arr);
+			this->write(host);
+		}
+#endif
+
+		size_t size() const { return mBuffer.size(); }
+
+		std::vector<unsigned char>& buffer() { return mBuffer; }
+
+	private:
+		std::vector<unsigned char> mStorage;
+		std::vector<unsigned char>& mBuffer;
+	};
+
+	/**
+	 * @brief Read values in the same order as they were written by a BinaryWriter, all read functions return false once the end of the data is reached.
+	 */
+	class BinaryReader
+	{
+	public:
+		BinaryReader(const unsigned char* data, size_t size)
+			: mData(data), mSize(size) {}
+
+		bool read(void* data, size_t size)
+		{
+			if (mOffset + size > mSize) {
+				mOffset = mSize;
+				mGood = false;
+				return false;
+			}
+
+			if (size > 0)
+				std::memcpy(data, mData + mOffset, size);
+
+			mOffset += size;
+			return true;
+		}
+
+		template<typename T>
+		bool read(T& val) { return this->read(&val, sizeof(T)); }
+
+		bool read(std::string& str)
+		{
+			uint num = 0;
+			if (!this->read(num) || num > mSize - mOffset)
+				return mGood = false;
+
+			str.assign((const char*)mData + mOffset, num);
+			mOffset += num;
+			return true;
+		}
+
+		template<typename T, DeviceType deviceType>
+		bool read(Array<T, deviceType>& arr)
+		{
+			uint num = 0;
+			if (!this->read(num) || size_t(num) * sizeof(T) > mSize - mOffset)
+				return mGood = false;
+
+			CArray<T> host;
+			host.resize(num);
+			this->read(host.begin(), sizeof(T) * num);
+
+			arr.assign(host);
+			return true;
+		}
+
+		template<typename T, DeviceType deviceType>
+		bool read(Array2D<T, deviceType>& arr)
+		{
+			uint nx = 0, ny = 0;
+			if (!this->read(nx) || !this->read(ny) || size_t(nx) * ny * sizeof(T) > mSize - mOffset)
+				return mGood = false;
+
+			CArray2D<T> host;
+			host.resize(nx, ny);
+			this->read(host.handle()->data(), sizeof(T) * nx * ny);
+
+			arr.assign(host);
+			return true;
+		}
+
+		template<typename T, DeviceType deviceType>
+		bool read(Array3D<T, deviceType>& arr)
+		{
+			uint nx = 0, ny = 0, nz = 0;
+			if (!this->read(nx) || !this->read(ny) || !this->read(nz) || size_t(nx) * ny * nz * sizeof(T) > mSize - mOffset)
+				return mGood = false;
+
+			CArray3D<T> host;
+			host.resize(nx, ny, nz);
+			this->read(host.handle()->data(), sizeof(T) * nx * ny * nz);
+
+			arr.assign(host);
+			return true;
+		}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
+		template<typename T, DeviceType deviceType>
+		bool read(ArrayList<T, deviceType>& arr)
+		{
+			uint num = 0;
+			if (!this->read(num) || size_t(num) * 2 * sizeof(uint) > mSize - mOffset)
+				return mGood = false;
+
+			if (num == 0) {
+				arr.clear();
+				return true;
+			}
+
+			CArray<uint> capacities(num);
+			CArray<uint> sizes(num);
+			for (uint i = 0; i < num; i++)
+			{
+				this->read(capacities[i]);
+				this->read(sizes[i]);
+
+				if (sizes[i] > capacities[i])
+					return mGood = false;
+			}
+
+			CArrayList<T> host;
+			host.resize(capacities);
+
+			for (uint i = 0; i < num; i++)
+			{
+				auto& lst = host[i];
+				lst.clear();
+
+				T val;
+				for (uint j = 0; j < sizes[i]; j++)
+				{
+					if (!this->read(val))
+						return false;
+
+					lst.insert(val);
+				}
+			}
+
+			arr.assign(host);
+			return true;
+		}
+#endif
+
+		bool good() const { return mGood; }
+
+		bool atEnd() const { return mOffset == mSize; }
+
+	private:
+		const unsigned char* mData;
+		size_t mSize;
+		size_t mOffset = 0;
+
+		bool mGood = true;
+	};
+}
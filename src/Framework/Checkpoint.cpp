@@ -0,0 +1,638 @@
+#include "Checkpoint.h"
+
+#include "SceneGraph.h"
+#include "BinaryStream.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <map>
+
+namespace dyno
+{
+	static const char CheckpointMagic[8] = { 'P', 'D', 'C', 'K', 'P', 'T', '0', '1' };
+
+	enum ChunkFlag : unsigned char
+	{
+		CHUNK_COMPRESSED = 1,
+		CHUNK_SHUFFLED = 2
+	};
+
+	/**
+	 * Group the i-th bytes of all 4-byte words together, floating point and integer arrays compress much better this way.
+	 */
+	static void shuffle(const unsigned char* src, unsigned char* dst, size_t n)
+	{
+		size_t words = n / 4;
+		for (size_t i = 0; i < words; i++)
+		{
+			for (size_t b = 0; b < 4; b++)
+				dst[b * words + i] = src[4 * i + b];
+		}
+
+		for (size_t i = 4 * words; i < n; i++)
+			dst[i] = src[i];
+	}
+
+	static void unshuffle(const unsigned char* src, unsigned char* dst, size_t n)
+	{
+		size_t words = n / 4;
+		for (size_t i = 0; i < words; i++)
+		{
+			for (size_t b = 0; b < 4; b++)
+				dst[4 * i + b] = src[b * words + i];
+		}
+
+		for (size_t i = 4 * words; i < n; i++)
+			dst[i] = src[i];
+	}
+
+	static void writeLength(std::vector<unsigned char>& dst, size_t len)
+	{
+		while (len >= 255)
+		{
+			dst.push_back(255);
+			len -= 255;
+		}
+		dst.push_back((unsigned char)len);
+	}
+
+	/**
+	 * A greedy LZ77 compressor, each sequence consists of a token (4-bit literal length, 4-bit match length),
+	 * 	the literals, a 16-bit offset and the extended match length. The last sequence only contains literals.
+	 */
+	static void compressBlock(const unsigned char* src, size_t n, std::vector<unsigned char>& dst)
+	{
+		const uint HashBits = 14;
+		const size_t MinMatch = 4;
+		const size_t MaxOffset = 65535;
+
+		std::vector<int64> table(size_t(1) << HashBits, -1);
+
+		auto read32 = [&](size_t i) -> uint {
+			uint v;
+			std::memcpy(&v, src + i, 4);
+			return v;
+		};
+
+		auto emit = [&](size_t anchor, size_t literals, size_t offset, size_t match) {
+			unsigned char token = (unsigned char)(std::min<size_t>(literals, 15) << 4);
+			if (match > 0)
+				token |= (unsigned char)std::min<size_t>(match - MinMatch, 15);
+			dst.push_back(token);
+
+			if (literals >= 15)
+				writeLength(dst, literals - 15);
+
+			dst.insert(dst.end(), src + anchor, src + anchor + literals);
+
+			if (match > 0)
+			{
+				dst.push_back((unsigned char)(offset & 0xFF));
+				dst.push_back((unsigned char)(offset >> 8));
+
+				if (match - MinMatch >= 15)
+					writeLength(dst, match - MinMatch - 15);
+			}
+		};
+
+		size_t anchor = 0;
+		size_t i = 0;
+		while (i + MinMatch <= n)
+		{
+			uint seq = read32(i);
+			uint h = (seq * 2654435761u) >> (32 - HashBits);
+			int64 ref = table[h];
+			table[h] = (int64)i;
+
+			if (ref >= 0 && i - ref <= MaxOffset && read32(ref) == seq)
+			{
+				size_t len = MinMatch;
+				while (i + len < n && src[ref + len] == src[i + len])
+					len++;
+
+				emit(anchor, i - anchor, i - ref, len);
+
+				i += len;
+				anchor = i;
+			}
+			else
+				i++;
+		}
+
+		emit(anchor, n - anchor, 0, 0);
+	}
+
+	static bool decompressBlock(const unsigned char* src, size_t n, unsigned char* dst, size_t rawSize)
+	{
+		const unsigned char* ip = src;
+		const unsigned char* end = src + n;
+
+		unsigned char* op = dst;
+		unsigned char* opEnd = dst + rawSize;
+
+		auto readLength = [&](size_t& len) -> bool {
+			unsigned char b;
+			do {
+				if (ip >= end)
+					return false;
+				b = *ip++;
+				len += b;
+			} while (b == 255);
+			return true;
+		};
+
+		while (ip < end)
+		{
+			unsigned char token = *ip++;
+
+			size_t literals = token >> 4;
+			if (literals == 15 && !readLength(literals))
+				return false;
+
+			if (literals > size_t(end - ip) || literals > size_t(opEnd - op))
+				return false;
+
+			std::memcpy(op, ip, literals);
+			ip += literals;
+			op += literals;
+
+			if (ip == end)
+				break;
+
+			if (end - ip < 2)
+				return false;
+
+			size_t offset = ip[0] | (size_t(ip[1]) << 8);
+			ip += 2;
+
+			size_t match = (token & 15);
+			if (match == 15 && !readLength(match))
+				return false;
+			match += 4;
+
+			if (offset == 0 || offset > size_t(op - dst) || match > size_t(opEnd - op))
+				return false;
+
+			//Byte by byte, the source and the destination may overlap
+			const unsigned char* ref = op - offset;
+			for (size_t k = 0; k < match; k++)
+				op[k] = ref[k];
+			op += match;
+		}
+
+		return op == opEnd;
+	}
+
+	/**
+	 * Connections are encoded the same way as by SceneLoaderXML, from == 0 refers to a node port while from > 0 refers to the output field (from - 1)
+	 */
+	struct CheckpointConnection
+	{
+		uint src;
+		uint from;
+		uint dst;
+		uint to;
+
+		bool operator==(const CheckpointConnection& c) const {
+			return src == c.src && from == c.from && dst == c.dst && to == c.to;
+		}
+	};
+
+	static std::vector<Node*> collectNodes(SceneGraph* scn)
+	{
+		std::vector<Node*> nodes;
+		for (auto it = scn->begin(); it != scn->end(); it++)
+		{
+			nodes.push_back(it.get().get());
+		}
+		return nodes;
+	}
+
+	static std::vector<CheckpointConnection> collectConnections(const std::vector<Node*>& nodes)
+	{
+		std::map<Node*, uint> indices;
+		for (uint i = 0; i < nodes.size(); i++)
+			indices[nodes[i]] = i;
+
+		std::vector<CheckpointConnection> connections;
+		for (uint i = 0; i < nodes.size(); i++)
+		{
+			auto& ports = nodes[i]->getImportNodes();
+			for (uint p = 0; p < ports.size(); p++)
+			{
+				for (auto src : ports[p]->getNodes())
+				{
+					if (indices.find(src) != indices.end())
+						connections.push_back({ indices[src], 0, i, p });
+				}
+			}
+
+			auto& inputs = nodes[i]->getInputFields();
+			for (uint j = 0; j < inputs.size(); j++)
+			{
+				FBase* source = inputs[j]->getSource();
+				Node* src = source == nullptr ? nullptr : dynamic_cast<Node*>(source->parent());
+				if (src == nullptr || indices.find(src) == indices.end())
+					continue;
+
+				auto& outputs = src->getOutputFields();
+				for (uint k = 0; k < outputs.size(); k++)
+				{
+					if (outputs[k] == source)
+						connections.push_back({ indices[src], k + 1, i, j });
+				}
+			}
+		}
+
+		return connections;
+	}
+
+	/**
+	 * Parameters are listed before states so that callbacks triggered by parameters do not overwrite restored states
+	 */
+	static std::vector<FBase*> checkpointFields(Node* node)
+	{
+		std::vector<FBase*> params;
+		std::vector<FBase*> states;
+		for (auto f : node->getAllFields())
+		{
+			if (f->getSource() != nullptr)
+				continue;
+
+			if (f->getFieldType() == FieldTypeEnum::Param)
+				params.push_back(f);
+			else if (f->getFieldType() == FieldTypeEnum::State)
+				states.push_back(f);
+		}
+
+		params.insert(params.end(), states.begin(), states.end());
+		return params;
+	}
+
+	static std::string sectionName(uint nodeIndex, FBase* field)
+	{
+		return "Node" + std::to_string(nodeIndex) + "/" + field->getObjectName();
+	}
+
+	Checkpoint::Section& Checkpoint::appendSection(const std::string& name)
+	{
+		if (mSectionNum == mSections.size())
+			mSections.emplace_back();
+
+		//Both the name and the data keep their capacity from the previous capture
+		Section& section = mSections[mSectionNum++];
+		section.name.assign(name);
+		section.data.clear();
+
+		return section;
+	}
+
+	bool Checkpoint::capture(SceneGraph* scn)
+	{
+		mSectionNum = 0;
+
+		if (scn == nullptr)
+		{
+			mSections.clear();
+			return false;
+		}
+
+		mFrameNumber = scn->getFrameNumber();
+		mElapsedTime = scn->getElapsedTime();
+
+		auto nodes = collectNodes(scn);
+		auto connections = collectConnections(nodes);
+
+		BinaryWriter scene(appendSection("Scene").data);
+		scene.write(mFrameNumber);
+		scene.write(mElapsedTime);
+		scene.write(scn->getGravity());
+		scene.write(scn->getLowerBound());
+		scene.write(scn->getUpperBound());
+
+		scene.write(uint(nodes.size()));
+		for (auto node : nodes)
+		{
+			scene.write(node->getClassInfo()->getClassName());
+		}
+
+		scene.write(uint(connections.size()));
+		for (auto& c : connections)
+		{
+			scene.write(c);
+		}
+
+		for (uint i = 0; i < nodes.size(); i++)
+		{
+			for (auto f : checkpointFields(nodes[i]))
+			{
+				BinaryWriter data(appendSection(sectionName(i, f)).data);
+
+				//Fields that cannot be serialized give their section back
+				if (!f->writeBinary(data))
+					mSectionNum--;
+			}
+		}
+
+		mSections.resize(mSectionNum);
+
+		return true;
+	}
+
+	bool Checkpoint::restore(SceneGraph* scn) const
+	{
+		if (scn == nullptr || mSections.empty() || mSections[0].name != "Scene")
+			return false;
+
+		BinaryReader scene(mSections[0].data.data(), mSections[0].data.size());
+
+		uint frameNumber;
+		float elapsedTime;
+		Vec3f gravity, lowerBound, upperBound;
+		scene.read(frameNumber);
+		scene.read(elapsedTime);
+		scene.read(gravity);
+		scene.read(lowerBound);
+		scene.read(upperBound);
+
+		uint nodeNum = 0;
+		scene.read(nodeNum);
+		std::vector<std::string> classNames(nodeNum);
+		for (uint i = 0; i < nodeNum && scene.good(); i++)
+		{
+			scene.read(classNames[i]);
+		}
+
+		uint connectionNum = 0;
+		scene.read(connectionNum);
+		std::vector<CheckpointConnection> connections(scene.good() ? connectionNum : 0);
+		for (uint i = 0; i < connections.size(); i++)
+		{
+			scene.read(connections[i]);
+		}
+
+		if (!scene.good())
+		{
+			Log::sendMessage(Log::Error, "Checkpoint: the scene section is corrupted");
+			return false;
+		}
+
+		std::vector<Node*> nodes;
+		if (scn->isEmpty())
+		{
+			std::vector<std::shared_ptr<Node>> created;
+			for (auto& name : classNames)
+			{
+				Object* obj = Object::createObject(name);
+				Node* node = dynamic_cast<Node*>(obj);
+				if (node == nullptr)
+				{
+					delete obj;
+					Log::sendMessage(Log::Error, "Checkpoint: cannot create node " + name);
+					return false;
+				}
+
+				created.push_back(scn->addNode(std::shared_ptr<Node>(node)));
+			}
+
+			for (auto& c : connections)
+			{
+				if (c.src >= nodeNum || c.dst >= nodeNum)
+					return false;
+
+				auto src = created[c.src];
+				auto dst = created[c.dst];
+				if (c.from == 0)
+				{
+					if (c.to < dst->getImportNodes().size())
+						src->connect(dst->getImportNodes()[c.to]);
+				}
+				else if (c.from - 1 < src->getOutputFields().size() && c.to < dst->getInputFields().size())
+				{
+					src->getOutputFields()[c.from - 1]->connect(dst->getInputFields()[c.to]);
+				}
+			}
+
+			for (auto& n : created)
+				nodes.push_back(n.get());
+		}
+		else
+		{
+			nodes = collectNodes(scn);
+
+			bool matched = nodes.size() == nodeNum;
+			for (uint i = 0; matched && i < nodeNum; i++)
+			{
+				matched = nodes[i]->getClassInfo()->getClassName() == classNames[i];
+			}
+
+			if (!matched || !(collectConnections(nodes) == connections))
+			{
+				Log::sendMessage(Log::Error, "Checkpoint: the node graph does not match the one of the checkpoint");
+				return false;
+			}
+		}
+
+		std::vector<std::map<std::string, FBase*>> fields(nodes.size());
+		for (uint i = 0; i < nodes.size(); i++)
+		{
+			for (auto f : checkpointFields(nodes[i]))
+				fields[i][f->getObjectName()] = f;
+		}
+
+		bool success = true;
+		for (size_t s = 1; s < mSections.size(); s++)
+		{
+			auto& section = mSections[s];
+
+			// Section names are of the form Node<index>/<field name>
+			size_t slash = section.name.find('/');
+			bool valid = section.name.compare(0, 4, "Node") == 0 && slash != std::string::npos && slash > 4;
+			uint index = valid ? (uint)std::stoul(section.name.substr(4, slash - 4)) : nodeNum;
+			std::string fieldName = valid ? section.name.substr(slash + 1) : "";
+
+			FBase* f = nullptr;
+			if (index < nodes.size() && fields[index].find(fieldName) != fields[index].end())
+				f = fields[index][fieldName];
+
+			BinaryReader reader(section.data.data(), section.data.size());
+			if (f == nullptr || !f->readBinary(reader))
+			{
+				Log::sendMessage(Log::Warning, "Checkpoint: failed to restore " + section.name);
+				success = false;
+			}
+		}
+
+		scn->setGravity(gravity);
+		scn->setLowerBound(lowerBound);
+		scn->setUpperBound(upperBound);
+		scn->setFrameNumber(frameNumber);
+		scn->setElapsedTime(elapsedTime);
+
+		return success;
+	}
+
+	bool Checkpoint::write(const std::string& filename, bool compressed) const
+	{
+		std::ofstream output(filename, std::ios::out | std::ios::binary);
+		if (!output.is_open())
+			return false;
+
+		auto put = [&](const void* data, size_t size) {
+			output.write((const char*)data, size);
+		};
+
+		put(CheckpointMagic, sizeof(CheckpointMagic));
+
+		uint sectionNum = (uint)mSections.size();
+		put(&sectionNum, sizeof(uint));
+
+		std::vector<unsigned char> shuffled;
+		std::vector<unsigned char> packed;
+		for (auto& section : mSections)
+		{
+			uint nameLength = (uint)section.name.size();
+			put(&nameLength, sizeof(uint));
+			put(section.name.data(), nameLength);
+
+			uint64 rawSize = section.data.size();
+			uint chunkNum = (uint)((rawSize + ChunkSize - 1) / ChunkSize);
+			put(&rawSize, sizeof(uint64));
+			put(&chunkNum, sizeof(uint));
+
+			for (uint c = 0; c < chunkNum; c++)
+			{
+				const unsigned char* chunk = section.data.data() + size_t(c) * ChunkSize;
+				uint chunkSize = (uint)std::min<uint64>(ChunkSize, rawSize - uint64(c) * ChunkSize);
+
+				unsigned char flags = 0;
+				const unsigned char* stored = chunk;
+				uint storedSize = chunkSize;
+
+				if (compressed)
+				{
+					shuffled.resize(chunkSize);
+					shuffle(chunk, shuffled.data(), chunkSize);
+
+					packed.clear();
+					compressBlock(shuffled.data(), chunkSize, packed);
+
+					// Keep the raw data if compression does not pay off
+					if (packed.size() < chunkSize)
+					{
+						flags = CHUNK_COMPRESSED | CHUNK_SHUFFLED;
+						stored = packed.data();
+						storedSize = (uint)packed.size();
+					}
+				}
+
+				put(&chunkSize, sizeof(uint));
+				put(&storedSize, sizeof(uint));
+				put(&flags, sizeof(unsigned char));
+				put(stored, storedSize);
+			}
+		}
+
+		output.close();
+
+		return !output.fail();
+	}
+
+	bool Checkpoint::read(const std::string& filename)
+	{
+		mSections.clear();
+
+		std::ifstream input(filename, std::ios::in | std::ios::binary);
+		if (!input.is_open())
+			return false;
+
+		auto get = [&](void* data, size_t size) -> bool {
+			input.read((char*)data, size);
+			return (size_t)input.gcount() == size;
+		};
+
+		char magic[8];
+		if (!get(magic, sizeof(magic)) || std::memcmp(magic, CheckpointMagic, sizeof(magic)) != 0)
+		{
+			Log::sendMessage(Log::Error, "Checkpoint: " + filename + " is not a checkpoint file");
+			return false;
+		}
+
+		uint sectionNum = 0;
+		if (!get(&sectionNum, sizeof(uint)))
+			return false;
+
+		std::vector<unsigned char> stored;
+		std::vector<unsigned char> shuffled;
+		for (uint s = 0; s < sectionNum; s++)
+		{
+			Section section;
+
+			uint nameLength = 0;
+			if (!get(&nameLength, sizeof(uint)))
+				return false;
+
+			section.name.resize(nameLength);
+			uint64 rawSize = 0;
+			uint chunkNum = 0;
+			if (!get(&section.name[0], nameLength) || !get(&rawSize, sizeof(uint64)) || !get(&chunkNum, sizeof(uint)))
+				return false;
+
+			section.data.resize(rawSize);
+
+			uint64 offset = 0;
+			for (uint c = 0; c < chunkNum; c++)
+			{
+				uint chunkSize = 0;
+				uint storedSize = 0;
+				unsigned char flags = 0;
+				if (!get(&chunkSize, sizeof(uint)) || !get(&storedSize, sizeof(uint)) || !get(&flags, sizeof(unsigned char)))
+					return false;
+
+				if (offset + chunkSize > rawSize)
+					return false;
+
+				unsigned char* dst = section.data.data() + offset;
+
+				if (flags & CHUNK_COMPRESSED)
+				{
+					stored.resize(storedSize);
+					shuffled.resize(chunkSize);
+
+					unsigned char* unpacked = (flags & CHUNK_SHUFFLED) ? shuffled.data() : dst;
+					if (!get(stored.data(), storedSize) || !decompressBlock(stored.data(), storedSize, unpacked, chunkSize))
+					{
+						Log::sendMessage(Log::Error, "Checkpoint: section " + section.name + " is corrupted");
+						return false;
+					}
+
+					if (flags & CHUNK_SHUFFLED)
+						unshuffle(shuffled.data(), dst, chunkSize);
+				}
+				else
+				{
+					if (storedSize != chunkSize || !get(dst, chunkSize))
+						return false;
+				}
+
+				offset += chunkSize;
+			}
+
+			if (offset != rawSize)
+				return false;
+
+			mSections.push_back(std::move(section));
+		}
+
+		if (mSections.empty() || mSections[0].name != "Scene")
+			return false;
+
+		BinaryReader scene(mSections[0].data.data(), mSections[0].data.size());
+		scene.read(mFrameNumber);
+		scene.read(mElapsedTime);
+
+		return scene.good();
+	}
+}
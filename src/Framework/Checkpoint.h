@@ -0,0 +1,83 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Platform.h"
+
+#include <string>
+#include <vector>
+
+namespace dyno
+{
+	class SceneGraph;
+
+	/**
+	 * @brief A binary snapshot of a scene graph, used to restart a simulation from a given frame.
+	 *
+	 * A checkpoint keeps the frame number, the elapsed time, the node graph (classes and connections)
+	 * and the data of all parameter and state fields of each node, including arrays and instances.
+	 *
+	 * capture() only copies the data into host memory, so that the expensive part, write(), can run in the background.
+	 * Capturing into the same checkpoint again reuses the buffers of the previous capture.
+	 * The file consists of named sections, each section is split into chunks that are optionally compressed.
+	 */
+	class Checkpoint
+	{
+	public:
+		Checkpoint() {};
+		~Checkpoint() {};
+
+		/**
+		 * @brief Copy the state of all nodes inside scn
+		 */
+		bool capture(SceneGraph* scn);
+
+		/**
+		 * @brief Apply the snapshot to scn.
+		 *
+		 * If scn is empty, nodes are created by their class names and connected as recorded. Otherwise the node graph of scn must match
+		 * 	the recorded one, which is the case when the scene is rebuilt the same way it was for the original run.
+		 */
+		bool restore(SceneGraph* scn) const;
+
+		bool write(const std::string& filename, bool compressed = false) const;
+		bool read(const std::string& filename);
+
+		uint frameNumber() const { return mFrameNumber; }
+		float elapsedTime() const { return mElapsedTime; }
+
+		/**
+		 * @brief Size of each chunk in bytes before compression
+		 */
+		static const uint ChunkSize = 1 << 20;
+
+	private:
+		struct Section
+		{
+			std::string name;
+			std::vector<unsigned char> data;
+		};
+
+		Section& appendSection(const std::string& name);
+
+		uint mFrameNumber = 0;
+		float mElapsedTime = 0.0f;
+
+		std::vector<Section> mSections;
+
+		//Number of sections filled by the ongoing capture
+		size_t mSectionNum = 0;
+	};
+}
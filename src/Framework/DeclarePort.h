@@ -28,6 +28,12 @@ public:									\
 	inline FArray<T, device>* state##name() {return &state_##name;}
 
 
+#define DEF_ARRAY_SOA_STATE(T, name, device, desc) \
+private:									\
+	FArraySoA<T, device> state_##name = FArraySoA<T, device>(std::string(#name), desc, FieldTypeEnum::State, this);	\
+public:									\
+	inline FArraySoA<T, device>* state##name() {return &state_##name;}
+
 #define DEF_ARRAY2D_STATE(T, name, device, desc) \
 private:									\
 	FArray2D<T, device> state_##name = FArray2D<T, device>(std::string(#name), desc, FieldTypeEnum::State, this);	\
@@ -3,6 +3,7 @@
 
 #include "Node.h"
 #include "Module.h"
+#include "SceneGraph.h"
 
 #include "FCallbackFunc.h"
 
@@ -102,6 +103,27 @@ namespace dyno
 		return this;
 	}
 
+	//Report a connection between two nodes to the scene graph so that the execution order is updated incrementally
+	void UpdateNodeDependency(FBase* src, FBase* dst, bool connecting)
+	{
+		Node* srcNode = dynamic_cast<Node*>(src->parent());
+		Node* dstNode = dynamic_cast<Node*>(dst->parent());
+		if (srcNode == nullptr || dstNode == nullptr || srcNode == dstNode)
+			return;
+
+		SceneGraph* scn = srcNode->getSceneGraph();
+		if (scn == nullptr || scn != dstNode->getSceneGraph())
+			return;
+
+		if (!srcNode->findOutputField(src) && !dstNode->findInputField(dst))
+			return;
+
+		if (connecting)
+			scn->addDependency(srcNode, dstNode);
+		else
+			scn->removeDependency(srcNode, dstNode);
+	}
+
 	void FBase::addSink(FBase* f)
 	{
 		auto it = std::find(mSinks.begin(), mSinks.end(), f);
@@ -113,6 +135,8 @@ namespace dyno
 //			f->setDerived(true);
 			f->setSource(this);
 
+			UpdateNodeDependency(this, f, true);
+
 			Log::sendMessage(Log::Info, FormatConnectionInfo(this, f, true, true));
 
 			return;
@@ -132,6 +156,8 @@ namespace dyno
 //			f->setDerived(false);
 			f->setSource(nullptr);
 
+			UpdateNodeDependency(this, f, false);
+
 			Log::sendMessage(Log::Info, FormatConnectionInfo(this, f, false, true));
 
 			return true;
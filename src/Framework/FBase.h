@@ -25,6 +25,8 @@
 namespace dyno {
 	class OBase;
 	class FCallBackFunc;
+	class BinaryWriter;
+	class BinaryReader;
 
 	enum FieldTypeEnum
 	{
@@ -94,6 +96,12 @@ public:
 	virtual std::string serialize() { return ""; }
 	virtual bool deserialize(const std::string& str) { return false; }
 
+	/**
+	 * @brief Binary snapshot of the field data used by checkpoints, return false if the field is empty or does not support it
+	 */
+	virtual bool writeBinary(BinaryWriter& writer) { return false; }
+	virtual bool readBinary(BinaryReader& reader) { return false; }
+
 	FBase* getTopField();
 	FBase* getSource();
 
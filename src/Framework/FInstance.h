@@ -16,6 +16,8 @@
 #pragma once
 #include <iostream>
 #include "FBase.h"
+#include "Object.h"
+#include "BinaryStream.h"
 
 namespace dyno {
 
@@ -121,6 +123,51 @@ namespace dyno {
 
 		uint size() override { return 1; }
 
+		/**
+		 * The class name of the object is stored with its data, if the current object is missing or of another class,
+		 * 	a new one is created by the class name while restoring.
+		 */
+		bool writeBinary(BinaryWriter& writer) override {
+			auto obj = asObject(this->constDataPtr());
+			if (obj == nullptr)
+				return false;
+
+			BinaryWriter data;
+			if (!obj->writeBinary(data))
+				return false;
+
+			writer.write(obj->getClassInfo()->getClassName());
+			writer.write(data.buffer().data(), data.size());
+			return true;
+		}
+
+		bool readBinary(BinaryReader& reader) override {
+			std::string className;
+			if (!reader.read(className))
+				return false;
+
+			auto obj = asObject(this->constDataPtr());
+			if (obj == nullptr || obj->getClassInfo()->getClassName() != className)
+			{
+				std::shared_ptr<T> created = std::dynamic_pointer_cast<T>(std::shared_ptr<Object>(Object::createObject(className)));
+				if (created == nullptr)
+					return false;
+
+				obj = created;
+				if (!obj->readBinary(reader))
+					return false;
+
+				this->setDataPtr(created);
+				return true;
+			}
+
+			if (!obj->readBinary(reader))
+				return false;
+
+			this->tick();
+			return true;
+		}
+
 	public:
 		std::shared_ptr<Object> objectPointer() final {
 			return std::dynamic_pointer_cast<Object>(mData);
@@ -145,6 +192,10 @@ namespace dyno {
 		}
 
 	private:
+		static std::shared_ptr<Object> asObject(std::shared_ptr<T> ptr) {
+			return std::dynamic_pointer_cast<Object>(ptr);
+		}
+
 		std::shared_ptr<T> mData = nullptr;
 	};
 }
\ No newline at end of file
@@ -17,12 +17,15 @@
 #include <iostream>
 #include <stdlib.h>
 #include <sstream>
+#include <type_traits>
 #include "FBase.h"
+#include "BinaryStream.h"
 
 #include "Array/Array.h"
 #include "Array/Array2D.h"
 #include "Array/Array3D.h"
 #include "Array/ArrayList.h"
+#include "Array/ArraySoA.h"
 
 namespace dyno {
 	/*!
@@ -55,6 +58,9 @@ namespace dyno {
 		std::string serialize() override { return "Unknown"; }
 		bool deserialize(const std::string& str) override { return false; }
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		bool isEmpty() override {
 			return this->constDataPtr() == nullptr;
 		}
@@ -135,6 +141,53 @@ namespace dyno {
 	}
 
 
+	/**
+	 * Plain data values are stored bitwise, other values (e.g., strings, paths and enums) fall back to serialize()
+	 */
+	template<typename T, bool Plain = std::is_trivially_destructible<T>::value>
+	struct FVarBinary
+	{
+		static void write(FVar<T>& f, BinaryWriter& writer) { writer.write(f.getValue()); }
+
+		static bool read(FVar<T>& f, BinaryReader& reader)
+		{
+			T val;
+			if (!reader.read(val))
+				return false;
+
+			f.setValue(val);
+			return true;
+		}
+	};
+
+	template<typename T>
+	struct FVarBinary<T, false>
+	{
+		static void write(FVar<T>& f, BinaryWriter& writer) { writer.write(f.serialize()); }
+
+		static bool read(FVar<T>& f, BinaryReader& reader)
+		{
+			std::string str;
+			return reader.read(str) && f.deserialize(str);
+		}
+	};
+
+	template<typename T>
+	bool FVar<T>::writeBinary(BinaryWriter& writer)
+	{
+		if (this->isEmpty())
+			return false;
+
+		FVarBinary<T>::write(*this, writer);
+		return true;
+	}
+
+	template<typename T>
+	bool FVar<T>::readBinary(BinaryReader& reader)
+	{
+		return FVarBinary<T>::read(*this, reader);
+	}
+
 	template<typename T>
 	using HostVarField = FVar<T>;
 
@@ -168,11 +221,12 @@ namespace dyno {
 
 		void assign(const T& val);
 		void assign(const std::vector<T>& vals);
-#ifndef NO_BACKEND
 		void assign(const DArray<T>& vals);
-#endif
 		void assign(const CArray<T>& vals);
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		bool isEmpty() override {
 			return this->size() == 0;
 		}
@@ -242,7 +296,6 @@ namespace dyno {
 		//this->tick();
 	}
 
-#ifndef NO_BACKEND
 	template<typename T, DeviceType deviceType>
 	void FArray<T, deviceType>::assign(const DArray<T>& vals)
 	{
@@ -256,7 +309,6 @@ namespace dyno {
 
 		//this->tick();
 	}
-#endif
 
 	template<typename T, DeviceType deviceType>
 	void FArray<T, deviceType>::reset()
@@ -286,12 +338,124 @@ namespace dyno {
 		//this->tick();
 	}
 
+	template<typename T, DeviceType deviceType>
+	bool FArray<T, deviceType>::writeBinary(BinaryWriter& writer)
+	{
+		auto& data = this->constDataPtr();
+		if (data == nullptr)
+			return false;
+
+		writer.write(*data);
+		return true;
+	}
+
+	template<typename T, DeviceType deviceType>
+	bool FArray<T, deviceType>::readBinary(BinaryReader& reader)
+	{
+		std::shared_ptr<DataType>& data = this->getDataPtr();
+		if (data == nullptr)
+			data = std::make_shared<DataType>();
+
+		return reader.read(*data);
+	}
+
 	template<typename T>
 	using HostArrayField = FArray<T, DeviceType::CPU>;
 
 	template<typename T>
 	using DeviceArrayField = FArray<T, DeviceType::GPU>;
 
+	/**
+	 * Define field for ArraySoA, T is the vector type, e.g., Vec3f
+	 */
+	template<typename T, DeviceType deviceType>
+	class FArraySoA : public FBase
+	{
+	public:
+		typedef T								VarType;
+		typedef ArraySoA<T, deviceType>			DataType;
+		typedef FArraySoA<T, deviceType>		FieldType;
+
+		DEFINE_FIELD_FUNC(FieldType, DataType, FArraySoA);
+
+		~FArraySoA() override;
+
+		inline uint size() override {
+			auto ref = this->constDataPtr();
+			return ref == nullptr ? 0 : ref->size();
+		}
+
+		void resize(uint num);
+		void reset();
+
+		void clear();
+
+		/**
+		 * @brief Convert from an array of structures
+		 */
+		void assign(const Array<T, deviceType>& vals);
+
+		bool isEmpty() override {
+			return this->size() == 0;
+		}
+	};
+
+	template<typename T, DeviceType deviceType>
+	FArraySoA<T, deviceType>::~FArraySoA()
+	{
+		if (m_data.use_count() == 1)
+		{
+			m_data->clear();
+		}
+	}
+
+	template<typename T, DeviceType deviceType>
+	void FArraySoA<T, deviceType>::resize(uint num)
+	{
+		std::shared_ptr<ArraySoA<T, deviceType>>& data = this->getDataPtr();
+		if (data == nullptr) {
+			data = std::make_shared<ArraySoA<T, deviceType>>();
+		}
+
+		data->resize(num);
+	}
+
+	template<typename T, DeviceType deviceType>
+	void FArraySoA<T, deviceType>::reset()
+	{
+		std::shared_ptr<ArraySoA<T, deviceType>>& data = this->getDataPtr();
+		if (data == nullptr)
+		{
+			data = std::make_shared<ArraySoA<T, deviceType>>();
+		}
+
+		data->reset();
+	}
+
+	template<typename T, DeviceType deviceType>
+	void FArraySoA<T, deviceType>::clear()
+	{
+		std::shared_ptr<ArraySoA<T, deviceType>>& data = this->getDataPtr();
+		if (data == nullptr)
+		{
+			data = std::make_shared<ArraySoA<T, deviceType>>();
+		}
+
+		data->clear();
+	}
+
+	template<typename T, DeviceType deviceType>
+	void FArraySoA<T, deviceType>::assign(const Array<T, deviceType>& vals)
+	{
+		std::shared_ptr<ArraySoA<T, deviceType>>& data = this->getDataPtr();
+		if (data == nullptr)
+		{
+			data = std::make_shared<ArraySoA<T, deviceType>>();
+		}
+
+		data->assign(vals);
+	}
+
 	/**
 	 * Define field for Array2D
 	 */
@@ -321,6 +485,9 @@ namespace dyno {
 		void assign(const CArray2D<T>& vals);
 		void assign(const DArray2D<T>& vals);
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		bool isEmpty() override {
 			return this->constDataPtr() == nullptr;
 		}
@@ -403,6 +570,27 @@ namespace dyno {
 		//this->tick();
 	}
 
+	template<typename T, DeviceType deviceType>
+	bool FArray2D<T, deviceType>::writeBinary(BinaryWriter& writer)
+	{
+		auto& data = this->constDataPtr();
+		if (data == nullptr)
+			return false;
+
+		writer.write(*data);
+		return true;
+	}
+
+	template<typename T, DeviceType deviceType>
+	bool FArray2D<T, deviceType>::readBinary(BinaryReader& reader)
+	{
+		std::shared_ptr<DataType>& data = this->getDataPtr();
+		if (data == nullptr)
+			data = std::make_shared<DataType>();
+
+		return reader.read(*data);
+	}
+
 	/**
 	 * Define field for Array3D
 	 */
@@ -432,6 +620,9 @@ namespace dyno {
 		void assign(const CArray3D<T>& vals);
 		void assign(const DArray3D<T>& vals);
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		bool isEmpty() override {
 			return this->constDataPtr() == nullptr;
 		}
@@ -510,7 +701,28 @@ namespace dyno {
 		//this->tick();
 	}
 
-#ifdef CUDA_BACKEND
+	template<typename T, DeviceType deviceType>
+	bool FArray3D<T, deviceType>::writeBinary(BinaryWriter& writer)
+	{
+		auto& data = this->constDataPtr();
+		if (data == nullptr)
+			return false;
+
+		writer.write(*data);
+		return true;
+	}
+
+	template<typename T, DeviceType deviceType>
+	bool FArray3D<T, deviceType>::readBinary(BinaryReader& reader)
+	{
+		std::shared_ptr<DataType>& data = this->getDataPtr();
+		if (data == nullptr)
+			data = std::make_shared<DataType>();
+
+		return reader.read(*data);
+	}
+
+#if defined(CUDA_BACKEND) || defined(CPU_BACKEND)
 	/**
 	 * Define field for Array
 	 */
@@ -540,6 +752,9 @@ namespace dyno {
 		void assign(const ArrayList<T, DeviceType::CPU>& src);
 		void assign(const ArrayList<T, DeviceType::GPU>& src);
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		bool isEmpty() override {
 			return this->constDataPtr() == nullptr;
 		}
@@ -617,6 +832,27 @@ namespace dyno {
 
 		data->clear();
 	}
+	template<typename T, DeviceType deviceType>
+	bool FArrayList<T, deviceType>::writeBinary(BinaryWriter& writer)
+	{
+		auto& data = this->constDataPtr();
+		if (data == nullptr)
+			return false;
+
+		writer.write(*data);
+		return true;
+	}
+
+	template<typename T, DeviceType deviceType>
+	bool FArrayList<T, deviceType>::readBinary(BinaryReader& reader)
+	{
+		std::shared_ptr<DataType>& data = this->getDataPtr();
+		if (data == nullptr)
+			data = std::make_shared<DataType>();
+
+		return reader.read(*data);
+	}
+
 #endif
 
 #ifdef VK_BACKEND
@@ -0,0 +1,301 @@
+#include "IncrementalDAG.h"
+
+#include <algorithm>
+
+namespace dyno {
+
+	const uint IncrementalDAG::INVALID_ID;
+
+	IncrementalDAG::~IncrementalDAG()
+	{
+		clear();
+	}
+
+	uint IncrementalDAG::addVertex()
+	{
+		uint v;
+		if (mFreeIds.empty())
+		{
+			v = (uint)mOut.size();
+
+			mOut.emplace_back();
+			mIn.emplace_back();
+			mRank.push_back(INVALID_ID);
+			mVisited.push_back(0);
+		}
+		else
+		{
+			v = mFreeIds.back();
+			mFreeIds.pop_back();
+		}
+
+		mRank[v] = (uint)mVertexAt.size();
+		mVertexAt.push_back(v);
+
+		mVertexNum++;
+		mRevision++;
+		mOrderDirty = true;
+
+		return v;
+	}
+
+	void IncrementalDAG::removeVertex(uint v)
+	{
+		if (!hasVertex(v))
+			return;
+
+		auto eraseAll = [](std::vector<uint>& list, uint id) {
+			list.erase(std::remove(list.begin(), list.end(), id), list.end());
+		};
+
+		for (auto s : mOut[v])
+			eraseAll(mIn[s], v);
+
+		for (auto p : mIn[v])
+			eraseAll(mOut[p], v);
+
+		mEdgeNum -= mOut[v].size() + mIn[v].size();
+
+		mOut[v].clear();
+		mIn[v].clear();
+
+		mVertexAt[mRank[v]] = INVALID_ID;
+		mRank[v] = INVALID_ID;
+		mFreeIds.push_back(v);
+
+		mVertexNum--;
+		mRevision++;
+		mOrderDirty = true;
+
+		//Removed vertices leave holes in the rank array, squeeze them out once they dominate
+		if (mVertexAt.size() > 2 * mVertexNum + 64)
+			compact();
+	}
+
+	bool IncrementalDAG::addEdge(uint u, uint v)
+	{
+		if (!hasVertex(u) || !hasVertex(v) || u == v)
+			return false;
+
+		const uint lower = mRank[v];
+		const uint upper = mRank[u];
+
+		// The current order is invalidated only if v is ranked before u
+		if (lower < upper)
+		{
+			if (searchForward(v, upper, u))
+			{
+				for (auto w : mDeltaF)
+					mVisited[w] = 0;
+
+				return false;
+			}
+
+			searchBackward(u, lower);
+			reorder();
+		}
+
+		mOut[u].push_back(v);
+		mIn[v].push_back(u);
+		mEdgeNum++;
+		mRevision++;
+
+		return true;
+	}
+
+	bool IncrementalDAG::removeEdge(uint u, uint v)
+	{
+		if (!hasVertex(u) || !hasVertex(v))
+			return false;
+
+		auto itOut = std::find(mOut[u].begin(), mOut[u].end(), v);
+		if (itOut == mOut[u].end())
+			return false;
+
+		mOut[u].erase(itOut);
+
+		auto itIn = std::find(mIn[v].begin(), mIn[v].end(), u);
+		mIn[v].erase(itIn);
+
+		mEdgeNum--;
+		mRevision++;
+
+		return true;
+	}
+
+	bool IncrementalDAG::hasVertex(uint v) const
+	{
+		return v < mRank.size() && mRank[v] != INVALID_ID;
+	}
+
+	bool IncrementalDAG::hasEdge(uint u, uint v) const
+	{
+		if (!hasVertex(u) || !hasVertex(v))
+			return false;
+
+		return std::find(mOut[u].begin(), mOut[u].end(), v) != mOut[u].end();
+	}
+
+	bool IncrementalDAG::hasPath(uint u, uint v)
+	{
+		if (!hasVertex(u) || !hasVertex(v))
+			return false;
+
+		if (u == v)
+			return true;
+
+		if (mRank[u] > mRank[v])
+			return false;
+
+		bool found = searchForward(u, mRank[v], v);
+
+		for (auto w : mDeltaF)
+			mVisited[w] = 0;
+
+		return found;
+	}
+
+	const std::vector<uint>& IncrementalDAG::topologicalOrder()
+	{
+		if (mOrderDirty)
+		{
+			mOrder.clear();
+			mOrder.reserve(mVertexNum);
+			for (auto v : mVertexAt)
+			{
+				if (v != INVALID_ID)
+					mOrder.push_back(v);
+			}
+
+			mOrderDirty = false;
+		}
+
+		return mOrder;
+	}
+
+	void IncrementalDAG::clear()
+	{
+		mOut.clear();
+		mIn.clear();
+		mRank.clear();
+		mVertexAt.clear();
+		mFreeIds.clear();
+		mOrder.clear();
+		mVisited.clear();
+
+		mVertexNum = 0;
+		mEdgeNum = 0;
+		mRevision++;
+		mOrderDirty = true;
+	}
+
+	bool IncrementalDAG::searchForward(uint v, uint upper, uint target)
+	{
+		mDeltaF.clear();
+		mStack.clear();
+
+		mVisited[v] = 1;
+		mDeltaF.push_back(v);
+		mStack.push_back(v);
+
+		while (!mStack.empty())
+		{
+			uint w = mStack.back();
+			mStack.pop_back();
+
+			for (auto s : mOut[w])
+			{
+				if (s == target)
+					return true;
+
+				if (!mVisited[s] && mRank[s] < upper)
+				{
+					mVisited[s] = 1;
+					mDeltaF.push_back(s);
+					mStack.push_back(s);
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void IncrementalDAG::searchBackward(uint u, uint lower)
+	{
+		mDeltaB.clear();
+		mStack.clear();
+
+		mVisited[u] = 1;
+		mDeltaB.push_back(u);
+		mStack.push_back(u);
+
+		while (!mStack.empty())
+		{
+			uint w = mStack.back();
+			mStack.pop_back();
+
+			for (auto p : mIn[w])
+			{
+				if (!mVisited[p] && mRank[p] > lower)
+				{
+					mVisited[p] = 1;
+					mDeltaB.push_back(p);
+					mStack.push_back(p);
+				}
+			}
+		}
+	}
+
+	void IncrementalDAG::reorder()
+	{
+		auto byRank = [&](uint a, uint b) { return mRank[a] < mRank[b]; };
+		std::sort(mDeltaB.begin(), mDeltaB.end(), byRank);
+		std::sort(mDeltaF.begin(), mDeltaF.end(), byRank);
+
+		// The affected vertices keep their pool of ranks, ancestors of u are moved in front of descendants of v
+		mRanks.clear();
+		for (auto w : mDeltaB)
+			mRanks.push_back(mRank[w]);
+		for (auto w : mDeltaF)
+			mRanks.push_back(mRank[w]);
+
+		std::sort(mRanks.begin(), mRanks.end());
+
+		size_t i = 0;
+		for (auto w : mDeltaB)
+		{
+			mVisited[w] = 0;
+			mRank[w] = mRanks[i];
+			mVertexAt[mRanks[i]] = w;
+			i++;
+		}
+
+		for (auto w : mDeltaF)
+		{
+			mVisited[w] = 0;
+			mRank[w] = mRanks[i];
+			mVertexAt[mRanks[i]] = w;
+			i++;
+		}
+
+		mRevision++;
+		mOrderDirty = true;
+	}
+
+	void IncrementalDAG::compact()
+	{
+		uint n = 0;
+		for (size_t r = 0; r < mVertexAt.size(); r++)
+		{
+			uint v = mVertexAt[r];
+			if (v != INVALID_ID)
+			{
+				mVertexAt[n] = v;
+				mRank[v] = n;
+				n++;
+			}
+		}
+
+		mVertexAt.resize(n);
+	}
+}
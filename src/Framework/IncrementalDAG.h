@@ -0,0 +1,123 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "Platform.h"
+
+#include <vector>
+
+namespace dyno {
+	/**
+	 * @brief A directed acyclic graph that maintains a topological order under edge insertions and removals.
+	 *
+	 * Vertices are dense integer ids handed out by addVertex(), adjacency is stored as flat arrays.
+	 * The order is maintained with the dynamic topological sort of Pearce and Kelly, an insertion only touches
+	 * the vertices whose rank lies between the two ends of the new edge. An edge that would close a cycle is rejected.
+	 */
+	class IncrementalDAG
+	{
+	public:
+		static const uint INVALID_ID = ~0u;
+
+		IncrementalDAG() {};
+		~IncrementalDAG();
+
+		/**
+		 * @brief Add a vertex, its rank is placed behind all existing vertices
+		 */
+		uint addVertex();
+
+		/**
+		 * @brief Remove a vertex and all edges incident to it, the id will be reused by later insertions
+		 */
+		void removeVertex(uint v);
+
+		/**
+		 * @brief Add an edge (u, v), parallel edges are counted separately
+		 *
+		 * @return false if the edge would introduce a cycle, the graph is left unchanged in that case
+		 */
+		bool addEdge(uint u, uint v);
+
+		/**
+		 * @brief Remove one edge (u, v)
+		 *
+		 * @return false if no such edge exists
+		 */
+		bool removeEdge(uint u, uint v);
+
+		bool hasVertex(uint v) const;
+		bool hasEdge(uint u, uint v) const;
+
+		/**
+		 * @brief Check whether v is reachable from u
+		 */
+		bool hasPath(uint u, uint v);
+
+		const std::vector<uint>& successors(uint v) const { return mOut[v]; }
+		const std::vector<uint>& predecessors(uint v) const { return mIn[v]; }
+
+		/**
+		 * @brief Rank of a vertex in the current topological order, ranks are not necessarily contiguous
+		 */
+		uint rank(uint v) const { return mRank[v]; }
+
+		/**
+		 * @brief All vertices in topological order
+		 */
+		const std::vector<uint>& topologicalOrder();
+
+		/**
+		 * @brief Incremented whenever a vertex or an edge is added or removed, caches derived from the graph are keyed on it
+		 */
+		uint revision() const { return mRevision; }
+
+		size_t sizeOfVertex() const { return mVertexNum; }
+		size_t sizeOfEdge() const { return mEdgeNum; }
+
+		void clear();
+
+	private:
+		bool searchForward(uint v, uint upper, uint target);
+		void searchBackward(uint u, uint lower);
+
+		void reorder();
+		void compact();
+
+	private:
+		std::vector<std::vector<uint>> mOut;
+		std::vector<std::vector<uint>> mIn;
+
+		//vertex to rank and rank to vertex, a removed vertex leaves a hole (INVALID_ID) in mVertexAt
+		std::vector<uint> mRank;
+		std::vector<uint> mVertexAt;
+
+		std::vector<uint> mFreeIds;
+
+		std::vector<uint> mOrder;
+		bool mOrderDirty = true;
+
+		uint mRevision = 0;
+		size_t mVertexNum = 0;
+		size_t mEdgeNum = 0;
+
+		//Scratch buffers used by addEdge
+		std::vector<char> mVisited;
+		std::vector<uint> mDeltaF;
+		std::vector<uint> mDeltaB;
+		std::vector<uint> mStack;
+		std::vector<uint> mRanks;
+	};
+}
@@ -3,57 +3,266 @@
 #include "Log.h"
 #include "FilePath.h"
 
+#include <algorithm>
+#include <chrono>
 
 namespace dyno
 {
 	std::string Log::sOutputFile;
 	std::ofstream Log::sOutputStream;
     void(*Log::receiver)(const Message&) = nullptr;
-    Log::MessageType Log::sLogLevel = Log::DebugInfo;
+    std::atomic<Log::MessageType> Log::sLogLevel(Log::DebugInfo);
 
-    std::atomic<Log*> Log::sLogInstance = nullptr;
-    std::queue<Log::Message> Log::sMessageQueue;
+    std::atomic<Log*> Log::sLogInstance(nullptr);
 
-#define LOG_DEBUG(format, ...) Log::instance()->writeMessage(Log::DebugInfo, format, ##__VA_ARGS__)
-#define LOG_INFO(format, ...)  Log::instance()->writeMessage(Log::Info, format, ##__VA_ARGS__)
-#define LOG_ERROR(format, ...) Log::instance()->writeMessage(Log::Error, format, ##__VA_ARGS__)
-#define LOG_WARN(format, ...) Log::instance()->writeMessage(Log::Warning, format, ##__VA_ARGS__)
-#define LOG_USER(format, ...) Log::instance()->writeMessage(Log::User, format, ##__VA_ARGS__)
-#define LOG_DISPLAY(format, ...) Log::instance()->writeMessage(Log::Display, format, ##__VA_ARGS__)
+    static std::atomic<unsigned long long> sDroppedMessages(0);
 
-    void Log::writeMessage(MessageType level, const char* format, ...)
+    //Interval at which the output thread drains the ring buffers if nobody wakes it up
+    static const std::chrono::milliseconds sDrainInterval(10);
+
+    struct Log::RingBuffer
     {
-		// log message
-		Log::Message m;
-		m.type = level;
-		m.text = std::string(format);
-		time_t t = time(NULL);
-		m.when = localtime(&t);
+        Record records[RingCapacity];
+
+        //Only written by the owner thread
+        std::atomic<unsigned long long> head{ 0 };
+        //Only written by the output thread
+        std::atomic<unsigned long long> tail{ 0 };
 
-        //Finish create Message and push into queue
+        //Set once the owner thread exits
+        std::atomic<bool> closed{ false };
+    };
+
+    //Registers the ring buffer of a thread on its first message and releases it when the thread exits
+    struct Log::ThreadRing
+    {
+        ~ThreadRing()
         {
-            std::lock_guard<std::mutex> lock(mtx);
-            sMessageQueue.push(m);  //push message into queue
-            mCondition.notify_one();
+            if (ring)
+                ring->closed.store(true, std::memory_order_release);
         }
+
+        std::shared_ptr<Log::RingBuffer> ring;
+    };
+
+    static long long currentTicks()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
     }
 
-    void Log::sendMessage(MessageType type, const std::string& text)
+    thread_local Log::ThreadRing Log::sThreadRing;
+
+    Log::Record* Log::beginRecord(MessageType type, const char* format)
     {
-		// Skip logging to file if minimum level is higher
-		if ((int)type < (int)sLogLevel)
-			return;
+        if (!sThreadRing.ring)
+        {
+            Log* log = instance();
+
+            sThreadRing.ring = std::make_shared<RingBuffer>();
+
+            std::lock_guard<std::mutex> lock(log->mRingMutex);
+            log->mRings.push_back(sThreadRing.ring);
+        }
+
+        RingBuffer* ring = sThreadRing.ring.get();
+
+        unsigned long long head = ring->head.load(std::memory_order_relaxed);
+        unsigned long long tail = ring->tail.load(std::memory_order_acquire);
+
+        if (head - tail >= RingCapacity)
+        {
+            sDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        //Wake up the output thread early before the buffer runs full
+        if (head - tail == RingCapacity / 2)
+            instance()->mCondition.notify_one();
+
+        Record& record = ring->records[head % RingCapacity];
+        record.type = type;
+        record.argc = 0;
+        record.size = 0;
+        record.ticks = currentTicks();
+        record.format = format;
+
+        return &record;
+    }
+
+    void Log::endRecord()
+    {
+        RingBuffer* ring = sThreadRing.ring.get();
+        ring->head.store(ring->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void Log::encodeString(Record& record, const char* str, size_t length)
+    {
+        size_t remaining = sizeof(record.payload) - record.size;
+
+        if (length <= 0xFFFF && 1 + sizeof(unsigned short) + length <= remaining)
+        {
+            unsigned char* ptr = record.payload + record.size;
+            unsigned short len = (unsigned short)length;
+
+            ptr[0] = ArgString;
+            std::memcpy(ptr + 1, &len, sizeof(unsigned short));
+            std::memcpy(ptr + 1 + sizeof(unsigned short), str, length);
 
-        switch (type)
+            record.size += (unsigned short)(1 + sizeof(unsigned short) + length);
+            record.argc++;
+        }
+        else if (1 + sizeof(std::string*) <= remaining)
+        {
+            record.push(ArgHeapString, new std::string(str, length));
+        }
+    }
+
+    template<typename T>
+    static T decode(const unsigned char* ptr)
+    {
+        T val;
+        std::memcpy(&val, ptr, sizeof(T));
+        return val;
+    }
+
+    std::string Log::render(const Record& record)
+    {
+        std::string text;
+
+        const unsigned char* arg = record.payload;
+        unsigned int argc = 0;
+
+        char buffer[32];
+
+        const char* ch = record.format;
+        while (*ch != '\0')
+        {
+            if (ch[0] != '{' || argc >= record.argc)
+            {
+                text.push_back(*ch++);
+                continue;
+            }
+
+            //Parse {} or {:n}
+            const char* end = ch + 1;
+            size_t width = 0;
+            if (*end == ':')
+            {
+                end++;
+                while (*end >= '0' && *end <= '9')
+                    width = width * 10 + (*end++ - '0');
+            }
+
+            if (*end != '}')
+            {
+                text.push_back(*ch++);
+                continue;
+            }
+
+            std::string str;
+            unsigned char tag = *arg++;
+            switch (tag)
+            {
+            case ArgInt:
+                snprintf(buffer, sizeof(buffer), "%lld", decode<long long>(arg));
+                str = buffer;
+                arg += sizeof(long long);
+                break;
+            case ArgUInt:
+                snprintf(buffer, sizeof(buffer), "%llu", decode<unsigned long long>(arg));
+                str = buffer;
+                arg += sizeof(unsigned long long);
+                break;
+            case ArgReal:
+                snprintf(buffer, sizeof(buffer), "%.10g", decode<double>(arg));
+                str = buffer;
+                arg += sizeof(double);
+                break;
+            case ArgBool:
+                str = decode<bool>(arg) ? "true" : "false";
+                arg += sizeof(bool);
+                break;
+            case ArgString:
+            {
+                unsigned short len = decode<unsigned short>(arg);
+                str.assign((const char*)arg + sizeof(unsigned short), len);
+                arg += sizeof(unsigned short) + len;
+                break;
+            }
+            case ArgHeapString:
+                str = *decode<std::string*>(arg);
+                arg += sizeof(std::string*);
+                break;
+            default:
+                break;
+            }
+
+            if (str.size() < width)
+                text.append(width - str.size(), ' ');
+            text += str;
+
+            argc++;
+            ch = end + 1;
+        }
+
+        return text;
+    }
+
+    void Log::release(Record& record)
+    {
+        const unsigned char* arg = record.payload;
+        for (unsigned int i = 0; i < record.argc; i++)
         {
-        case DebugInfo: LOG_DEBUG(text.c_str()); break;
-        case Info:		LOG_INFO(text.c_str()); break;
-        case Warning:	LOG_WARN(text.c_str()); break;
-        case Error:		LOG_ERROR(text.c_str()); break;
-        default:		LOG_USER(text.c_str());
+            unsigned char tag = *arg++;
+            switch (tag)
+            {
+            case ArgInt:
+            case ArgUInt:
+            case ArgReal:
+                arg += 8;
+                break;
+            case ArgBool:
+                arg += sizeof(bool);
+                break;
+            case ArgString:
+                arg += sizeof(unsigned short) + decode<unsigned short>(arg);
+                break;
+            case ArgHeapString:
+                delete decode<std::string*>(arg);
+                arg += sizeof(std::string*);
+            }
         }
     }
 
+    void Log::sendMessage(MessageType type, const std::string& text)
+    {
+		// Skip logging if minimum level is higher
+		if (!isEnabled(type))
+			return;
+
+        Record* record = beginRecord(type, "{}");
+        if (record == nullptr)
+            return;
+
+        encodeString(*record, text.data(), text.size());
+
+        endRecord();
+    }
+
+    void Log::sendMessage(MessageType type, const char* text)
+    {
+		if (!isEnabled(type))
+			return;
+
+        Record* record = beginRecord(type, "{}");
+        if (record == nullptr)
+            return;
+
+        encodeString(*record, text, std::strlen(text));
+
+        endRecord();
+    }
+
     void Log::setUserReceiver(void (*userFunc)(const Message&))
     {
         receiver = userFunc;
@@ -61,7 +270,7 @@ namespace dyno
 
 	void Log::setLevel(MessageType level)
 	{
-        sLogLevel = level;
+        sLogLevel.store(level, std::memory_order_relaxed);
 	}
 
 	void Log::setOutput(const std::string& filename)
@@ -83,6 +292,22 @@ namespace dyno
         return sOutputFile;
 	}
 
+	void Log::flush()
+	{
+		Log* log = instance();
+
+		std::unique_lock<std::mutex> lock(log->mtx);
+		unsigned long long request = ++log->mFlushRequests;
+
+		log->mCondition.notify_one();
+		log->mFlushed.wait(lock, [&]() { return log->mFlushedRequests >= request || !log->mRunning; });
+	}
+
+	unsigned long long Log::droppedMessages()
+	{
+		return sDroppedMessages.load(std::memory_order_relaxed);
+	}
+
 	Log* Log::instance()
     {
         static std::mutex mutex;
@@ -103,57 +328,150 @@ namespace dyno
     Log::Log()
         : mRunning(true)
     {
+        mStartTicks = currentTicks();
+        mStartTime = time(NULL);
+
         mThread = std::thread(&Log::outputThread, this);
     }
 
     Log::~Log()
     {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            mRunning = false;
+        }
 
         mCondition.notify_one();
         if (mThread.joinable()) {
             mThread.join();
         }
-
-        mRunning = false;
     }
 
     void Log::outputThread()
     {
-        while (mRunning) {
-            std::unique_lock<std::mutex> lock(mtx);
-            mCondition.wait(lock, [&]() { return !sMessageQueue.empty() || !mRunning; });
-
-            while (!sMessageQueue.empty()) {
-                auto m = sMessageQueue.front();
-                sMessageQueue.pop();
-
-				if (receiver) {
-					receiver(m);
-				}
-
-				// if enabled logging to file
-				if (sOutputStream.is_open())
-				{
-					// print time
-					char buffer[9];
-					strftime(buffer, 9, "%X", m.when);
-					sOutputStream << buffer;
-
-					// print type
-					switch (m.type)
-					{
-					case DebugInfo: sOutputStream << " | Debug   | "; break;
-					case Info:		sOutputStream << " | Info    | "; break;
-					case Warning:	sOutputStream << " | warning | "; break;
-					case Error:		sOutputStream << " | ERROR   | "; break;
-					default:		sOutputStream << " | user    | ";
-					}
-
-					// print description
-					sOutputStream << m.text << std::endl;
-				}
+        bool running = true;
+        while (running) {
+            unsigned long long requests;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                mCondition.wait_for(lock, sDrainInterval, [&]() { return mFlushRequests > mFlushedRequests || !mRunning; });
+
+                requests = mFlushRequests;
+                running = mRunning;
             }
 
+            this->drain();
+
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                mFlushedRequests = requests;
+            }
+            mFlushed.notify_all();
         }
     }
-}
\ No newline at end of file
+
+    void Log::drain()
+    {
+        std::vector<std::shared_ptr<RingBuffer>> rings;
+        {
+            std::lock_guard<std::mutex> lock(mRingMutex);
+            rings = mRings;
+        }
+
+        std::vector<Record> records;
+        std::vector<RingBuffer*> finished;
+        for (auto& ring : rings)
+        {
+            //All records of a closed ring buffer are visible once the flag is seen
+            bool closed = ring->closed.load(std::memory_order_acquire);
+
+            unsigned long long head = ring->head.load(std::memory_order_acquire);
+            unsigned long long tail = ring->tail.load(std::memory_order_relaxed);
+
+            for (unsigned long long i = tail; i < head; i++)
+                records.push_back(ring->records[i % RingCapacity]);
+
+            ring->tail.store(head, std::memory_order_release);
+
+            if (closed)
+                finished.push_back(ring.get());
+        }
+
+        if (!finished.empty())
+        {
+            std::lock_guard<std::mutex> lock(mRingMutex);
+            mRings.erase(std::remove_if(mRings.begin(), mRings.end(), [&](const std::shared_ptr<RingBuffer>& ring) {
+                return std::find(finished.begin(), finished.end(), ring.get()) != finished.end();
+            }), mRings.end());
+        }
+
+        //Restore the order in which messages were sent across threads
+        std::stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b) { return a.ticks < b.ticks; });
+
+        for (auto& record : records)
+        {
+            Message m;
+            m.type = record.type;
+            m.text = render(record);
+
+            time_t t = mStartTime + (time_t)((record.ticks - mStartTicks) / 1000000000);
+#ifdef _WIN32
+            localtime_s(&m.when, &t);
+#else
+            localtime_r(&t, &m.when);
+#endif
+
+            this->write(m);
+
+            release(record);
+        }
+
+        unsigned long long dropped = sDroppedMessages.load(std::memory_order_relaxed);
+        if (dropped > mDroppedReported)
+        {
+            Message m;
+            m.type = Warning;
+            m.text = std::to_string(dropped - mDroppedReported) + " log messages were dropped since the sending thread produced them faster than they could be written";
+
+            time_t t = time(NULL);
+#ifdef _WIN32
+            localtime_s(&m.when, &t);
+#else
+            localtime_r(&t, &m.when);
+#endif
+
+            this->write(m);
+
+            mDroppedReported = dropped;
+        }
+    }
+
+    void Log::write(const Message& m)
+    {
+		if (receiver) {
+			receiver(m);
+		}
+
+		// if enabled logging to file
+		if (sOutputStream.is_open())
+		{
+			// print time
+			char buffer[9];
+			strftime(buffer, 9, "%X", &m.when);
+			sOutputStream << buffer;
+
+			// print type
+			switch (m.type)
+			{
+			case DebugInfo: sOutputStream << " | Debug   | "; break;
+			case Info:		sOutputStream << " | Info    | "; break;
+			case Warning:	sOutputStream << " | warning | "; break;
+			case Error:		sOutputStream << " | ERROR   | "; break;
+			default:		sOutputStream << " | user    | ";
+			}
+
+			// print description
+			sOutputStream << m.text << std::endl;
+		}
+    }
+}
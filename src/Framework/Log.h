@@ -30,13 +30,25 @@
 #include <fstream>
 #include <iostream>
 #include <ctime>
-#include <queue>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <type_traits>
 #include <cstdio>
+#include <cstring>
 #include <cassert>
-#include <cstdarg>
 
 namespace dyno
 {
+    /*!
+     *	\brief	Asynchronous logger.
+     *
+     *	Each thread writes fixed-size binary records (a format and its arguments) into its own single-producer/single-consumer ring buffer,
+     *	so sending a message takes neither a lock nor a memory allocation. The output thread drains all ring buffers periodically,
+     *	composes the text and passes it to the receiver and the log file. Messages are dropped rather than blocking the sender once
+     *	the ring buffer of a thread is full, see droppedMessages().
+     */
     class Log
     {
     public:
@@ -52,19 +64,45 @@ namespace dyno
         struct Message {
             MessageType type;
             std::string text;
-            tm* when;
+            tm when;
         };
 
         static Log* instance();
 
+        /*!
+         *	\brief	Whether messages of the given type are logged, check it before composing an expensive message.
+         */
+        static bool isEnabled(MessageType type) { return (int)type >= (int)sLogLevel.load(std::memory_order_relaxed); }
 
         /*!
          *	\brief	Add a new message to log.
          *	\param	type	Type of the new message.
          *	\param	text	Message.
-         *	\remarks Message is directly passes to user receiver if one is set.
+         *	\remarks Message is passed to the user receiver by the output thread.
          */
         static void sendMessage(MessageType type, const std::string& text);
+        static void sendMessage(MessageType type, const char* text);
+
+        /*!
+         *	\brief	Add a new message composed of a format and arguments, e.g., sendMessage(Log::Info, "Node {:40}: {} ms", name, time).
+         *	\remarks Each {} is replaced with the next argument, {:n} pads the argument to at least n characters.
+         *			Integers, floating points, bool and strings are supported. Arguments are copied in binary form and
+         *			the text is only composed by the output thread, therefore the format must be a string literal.
+         */
+        template<size_t N, typename Arg, typename... Args>
+        static void sendMessage(MessageType type, const char(&format)[N], const Arg& arg, const Args&... args)
+        {
+            if (!isEnabled(type))
+                return;
+
+            Record* record = beginRecord(type, format);
+            if (record == nullptr)
+                return;
+
+            encode(*record, arg, args...);
+
+            endRecord();
+        }
 
          /*!
 		  *	\brief	Set user function to receive newly sent messages to logger.
@@ -86,15 +124,99 @@ namespace dyno
          */
         static const std::string& getOutput();
 
+        /*!
+         *	\brief	Block until all messages sent before the call are passed to the receiver and the log file.
+         */
+        static void flush();
+
+        /*!
+         *	\brief	Total number of messages dropped because the ring buffer of the sending thread was full.
+         */
+        static unsigned long long droppedMessages();
+
+        /*!
+         *	\brief	Number of records each thread can hold before the output thread drains them.
+         */
+        static const unsigned int RingCapacity = 1024;
+
     private:
+        enum ArgumentType : unsigned char
+        {
+            ArgInt,
+            ArgUInt,
+            ArgReal,
+            ArgBool,
+            ArgString,		//!< Stored inside the record
+            ArgHeapString	//!< Too long to fit into the record, owned by the record until rendered
+        };
+
+        struct Record
+        {
+            MessageType type;
+            unsigned short argc;
+            unsigned short size;
+            long long ticks;
+            const char* format;
+            unsigned char payload[104];
+
+            template<typename T>
+            void push(ArgumentType tag, const T& val)
+            {
+                if (size + 1 + sizeof(T) > sizeof(payload))
+                    return;
+
+                payload[size] = tag;
+                std::memcpy(payload + size + 1, &val, sizeof(T));
+                size += (unsigned short)(1 + sizeof(T));
+                argc++;
+            }
+        };
+
+        struct RingBuffer;
+        struct ThreadRing;
 
         Log();
         ~Log();
 
         void outputThread();
 
-		//Add a new message to log
-		void writeMessage(MessageType level, const char* format, ...);
+        //Drain all ring buffers and write out the messages
+        void drain();
+
+        void write(const Message& m);
+
+        //Return a record of the ring buffer owned by the calling thread, or nullptr if the buffer is full
+        static Record* beginRecord(MessageType type, const char* format);
+        static void endRecord();
+
+        static void encode(Record& record) {}
+
+        template<typename Arg, typename... Args>
+        static void encode(Record& record, const Arg& arg, const Args&... args)
+        {
+            encodeArgument(record, arg);
+            encode(record, args...);
+        }
+
+        template<typename T>
+        static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type encodeArgument(Record& record, T val) { record.push(ArgInt, (long long)val); }
+
+        template<typename T>
+        static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type encodeArgument(Record& record, T val) { record.push(ArgUInt, (unsigned long long)val); }
+
+        template<typename T>
+        static typename std::enable_if<std::is_floating_point<T>::value>::type encodeArgument(Record& record, T val) { record.push(ArgReal, (double)val); }
+
+        static void encodeArgument(Record& record, bool val) { record.push(ArgBool, val); }
+        static void encodeArgument(Record& record, const char* str) { encodeString(record, str, std::strlen(str)); }
+        static void encodeArgument(Record& record, const std::string& str) { encodeString(record, str.data(), str.size()); }
+
+        static void encodeString(Record& record, const char* str, size_t length);
+
+        static std::string render(const Record& record);
+
+        //Release the strings allocated on the heap
+        static void release(Record& record);
 
     private:
         bool mRunning;
@@ -102,11 +224,26 @@ namespace dyno
 		std::mutex mtx;
 		std::thread mThread;
 		std::condition_variable mCondition;
+		std::condition_variable mFlushed;
+
+		unsigned long long mFlushRequests = 0;
+		unsigned long long mFlushedRequests = 0;
+
+		std::mutex mRingMutex;
+		std::vector<std::shared_ptr<RingBuffer>> mRings;
+
+		unsigned long long mDroppedReported = 0;
+
+		//Used to convert the time stamps of records into the calendar time
+		long long mStartTicks;
+		time_t mStartTime;
 
         static std::atomic<Log*> sLogInstance;
 
-        static std::queue<Message> sMessageQueue;
-        static MessageType sLogLevel;
+        //Ring buffer of the calling thread
+        static thread_local ThreadRing sThreadRing;
+
+        static std::atomic<MessageType> sLogLevel;
 		static std::string sOutputFile;
 		static std::ofstream sOutputStream;
         static void (*receiver)(const Message&);
@@ -1,6 +1,6 @@
 #include "GroupModule.h"
 #include "Node.h"
-#include "DirectedAcyclicGraph.h"
+#include "IncrementalDAG.h"
 
 #include <queue>
 #include <set>
@@ -64,7 +64,20 @@ namespace dyno
 		std::queue<Module*> moduleQueue;
 		std::set<ObjectId> moduleSet;
 
-		DirectedAcyclicGraph graph;
+		IncrementalDAG graph;
+		std::map<ObjectId, uint> vertexIds;
+		std::vector<ObjectId> objectIds;
+
+		auto vertexOf = [&](ObjectId id) -> uint {
+			auto it = vertexIds.find(id);
+			if (it != vertexIds.end())
+				return it->second;
+
+			uint v = graph.addVertex();
+			vertexIds[id] = v;
+			objectIds.push_back(id);
+			return v;
+		};
 
 		auto retrieveModules = [&](ObjectId id, std::vector<FBase *>& fields) {
 			for(auto f : fields) {
@@ -75,7 +88,12 @@ namespace dyno
 					if (module != nullptr)
 					{
 						ObjectId oId = module->objectId();
-						graph.addEdge(id, oId);
+						uint u = vertexOf(id);
+						uint v = vertexOf(oId);
+						if (u != v && !graph.addEdge(u, v))
+						{
+							Log::sendMessage(Log::Warning, "A cycle is detected while connecting modules to " + module->getName());
+						}
 
 						if (moduleSet.find(oId) == moduleSet.end() && mModuleMap.count(oId) > 0)
 						{
@@ -108,10 +126,11 @@ namespace dyno
 			moduleQueue.pop();
 		}
 
-		auto& ids = graph.topologicalSort();
+		auto& order = graph.topologicalOrder();
 
-		for(auto id : ids)
+		for(auto v : order)
 		{
+			ObjectId id = objectIds[v];
 			if (mModuleMap.count(id) > 0)
 			{
 				mModuleList.push_back(mModuleMap[id].get());
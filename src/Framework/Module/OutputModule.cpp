@@ -1,9 +1,11 @@
 #include "Module/OutputModule.h"
+#include "Module/OutputQueue.h"
 
 namespace dyno
 {
 	OutputModule::OutputModule()
 		: Module()
+		, mPool(std::make_shared<SnapshotPool>())
 	{
 		this->varStride()->setRange(1, 1024);
 
@@ -18,6 +20,40 @@ namespace dyno
 	{
 	}
 
+	void OutputModule::flush()
+	{
+		std::unique_lock<std::mutex> lock(mPool->mutex);
+		mPool->released.wait(lock, [this] { return mPool->available.size() == mPool->created; });
+	}
+
+	void OutputModule::setSnapshotNumber(uint num)
+	{
+		std::lock_guard<std::mutex> lock(mPool->mutex);
+		mPool->capacity = num > 0 ? num : 1;
+	}
+
+	std::shared_ptr<OutputSnapshot> OutputModule::acquireSnapshot()
+	{
+		std::unique_lock<std::mutex> lock(mPool->mutex);
+
+		if (mPool->available.empty() && mPool->created < mPool->capacity)
+		{
+			auto snapshot = this->createSnapshot();
+			if (snapshot == nullptr)
+				return nullptr;
+
+			mPool->created++;
+			return snapshot;
+		}
+
+		//All snapshots are being written, wait for the oldest one
+		mPool->released.wait(lock, [this] { return !mPool->available.empty(); });
+
+		auto snapshot = mPool->available.back();
+		mPool->available.pop_back();
+		return snapshot;
+	}
+
 	void OutputModule::updateImpl()
 	{
 		uint startFrame = this->varStartFrame()->getValue();
@@ -32,7 +68,39 @@ namespace dyno
 			if ((frame - startFrame) % stride == 0)
 			{
 				//OutputFile
-				this->output();
+				ProfileZone zone(this->getClassInfo()->getClassName(), ProfileCategory::IO, this->objectId());
+
+				std::shared_ptr<OutputSnapshot> snapshot = this->varAsynchronous()->getValue() ? this->acquireSnapshot() : nullptr;
+				if (snapshot == nullptr)
+				{
+					this->output();
+					return;
+				}
+
+				auto pool = mPool;
+				auto release = [pool, snapshot]() {
+					std::lock_guard<std::mutex> lock(pool->mutex);
+					pool->available.push_back(snapshot);
+					pool->released.notify_all();
+				};
+
+				if (!this->takeSnapshot(snapshot.get()))
+				{
+					release();
+					return;
+				}
+
+				std::string filename = this->constructFileName();
+				OutputQueue::instance()->submit([snapshot, filename, release]() {
+					try {
+						snapshot->write(filename);
+					}
+					catch (...) {
+						release();
+						throw;
+					}
+					release();
+				}, this->getSceneGraph());
 			}
 		}
 	}
@@ -54,8 +122,7 @@ namespace dyno
 
 		std::stringstream ss; ss << index;
 
-		//TODO: check whether the path already contains "\\" or "/" at the end
-		std::string filename = path.string() + "\\" + prefix + ss.str();
+		std::string filename = (path / (prefix + ss.str())).string();
 		
 		return filename;
 	}
@@ -3,8 +3,29 @@
 
 #include "FilePath.h"
 
+#include <mutex>
+#include <condition_variable>
+
 namespace dyno
 {
+	/**
+	 * @brief Host side copy of the data written by an output module.
+	 * 	Snapshots are recycled across frames, so the arrays inside keep their memory.
+	 */
+	class OutputSnapshot
+	{
+	public:
+		virtual ~OutputSnapshot() {};
+
+		/**
+		 * @brief Write the content into a file, called by a writer thread of OutputQueue.
+		 * 	Must not access the module that took the snapshot, as it may have been destroyed in the meantime.
+		 *
+		 * @param filename the file name without extension, as returned by OutputModule::constructFileName()
+		 */
+		virtual void write(const std::string& filename) = 0;
+	};
+
 	class OutputModule : public Module
 	{
 	public:
@@ -22,18 +43,60 @@ namespace dyno
 
 		DEF_VAR(bool, Reordering, true, "If set true, the output file name will be re-indexed in sequence starting from zero");
 
+		DEF_VAR(bool, Asynchronous, true, "Write files in the background, only takes effect for modules supporting snapshots");
+
 		DEF_VAR_IN(uint, FrameNumber, "Input FrameNumber");
 
 		std::string getModuleType() override { return "OutputModule"; }
 
+		/**
+		 * @brief Block until all files submitted by this module are written
+		 */
+		void flush();
+
+		/**
+		 * @brief Number of snapshots in flight, 2 by default to double buffer the output.
+		 */
+		void setSnapshotNumber(uint num);
+
 	protected:
 		void updateImpl() final;
 
 		virtual void output() {};
 
+		/**
+		 * @brief Create an empty snapshot, return nullptr if the module only supports the synchronous output().
+		 */
+		virtual std::shared_ptr<OutputSnapshot> createSnapshot() { return nullptr; }
+
+		/**
+		 * @brief Copy the inputs into snapshot, called in the simulation thread.
+		 * 
+		 * @return false if there is nothing to write
+		 */
+		virtual bool takeSnapshot(OutputSnapshot* snapshot) { return false; }
+
 		/**
 		 * construct the file name with an index appended at the end
 		 */
 		std::string constructFileName();
+
+	private:
+		/**
+		 * Recycled snapshots, shared with the jobs in OutputQueue so that it may outlive the module
+		 */
+		struct SnapshotPool
+		{
+			std::mutex mutex;
+			std::condition_variable released;
+
+			std::vector<std::shared_ptr<OutputSnapshot>> available;
+			uint created = 0;
+			uint capacity = 2;
+		};
+
+		std::shared_ptr<OutputSnapshot> acquireSnapshot();
+
+		std::shared_ptr<SnapshotPool> mPool;
 	};
 }
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "OutputQueue.h"
+
+#include "Profiler.h"
+#include "Log.h"
+
+namespace dyno
+{
+	OutputQueue* OutputQueue::instance()
+	{
+		static OutputQueue queue;
+		return &queue;
+	}
+
+	OutputQueue::OutputQueue(unsigned int numWorkers, unsigned int capacity)
+		: mCapacity(capacity > 0 ? capacity : 1)
+	{
+		this->start(numWorkers);
+	}
+
+	OutputQueue::~OutputQueue()
+	{
+		this->flush();
+		this->stop();
+	}
+
+	void OutputQueue::setWorkerNumber(unsigned int n)
+	{
+		this->flush();
+		this->stop();
+		this->start(n);
+	}
+
+	void OutputQueue::setCapacity(unsigned int n)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCapacity = n > 0 ? n : 1;
+
+		mJobDone.notify_all();
+	}
+
+	void OutputQueue::submit(Job job, const void* owner, bool barrier)
+	{
+		//Jobs executed inside submit() are finished in order, a barrier needs no extra care
+		if (mWorkers.empty())
+		{
+			execute(job);
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(mMutex);
+
+		//Back pressure: wait for the writers to catch up
+		mJobDone.wait(lock, [this] { return mInFlight.size() < mCapacity; });
+
+		unsigned long long ticket = mNextTicket++;
+		mInFlight[ticket] = owner;
+
+		mJobs.push_back({ ticket, owner, barrier, std::move(job) });
+		mJobAdded.notify_one();
+	}
+
+	void OutputQueue::flush()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mJobDone.wait(lock, [this] { return mInFlight.empty(); });
+	}
+
+	void OutputQueue::flush(const void* owner)
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mJobDone.wait(lock, [this, owner] {
+			for (auto& job : mInFlight)
+			{
+				if (job.second == owner)
+					return false;
+			}
+			return true;
+		});
+	}
+
+	unsigned int OutputQueue::pendingJobs()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return (unsigned int)mInFlight.size();
+	}
+
+	void OutputQueue::start(unsigned int n)
+	{
+		mStop = false;
+		for (unsigned int i = 0; i < n; i++)
+			mWorkers.emplace_back(&OutputQueue::work, this);
+	}
+
+	void OutputQueue::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStop = true;
+		}
+		mJobAdded.notify_all();
+
+		for (auto& t : mWorkers)
+			t.join();
+
+		mWorkers.clear();
+	}
+
+	void OutputQueue::work()
+	{
+		while (true)
+		{
+			Entry entry;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mJobAdded.wait(lock, [this] { return mStop || !mJobs.empty(); });
+
+				if (mJobs.empty())
+					return;
+
+				entry = std::move(mJobs.front());
+				mJobs.pop_front();
+
+				//Jobs are dequeued in order, so the earlier ones are already running on other workers
+				if (entry.barrier)
+					mJobDone.wait(lock, [this, &entry] { return mInFlight.begin()->first == entry.ticket; });
+			}
+
+			{
+				PROFILE_ZONE("OutputQueue", ProfileCategory::IO);
+
+				execute(entry.job);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				mInFlight.erase(entry.ticket);
+			}
+			mJobDone.notify_all();
+		}
+	}
+
+	void OutputQueue::execute(Job& job)
+	{
+		//A failing job must neither take down a writer thread nor leave flush() waiting
+		try {
+			job();
+		}
+		catch (const std::exception& e) {
+			Log::sendMessage(Log::Error, std::string("Output job failed: ") + e.what());
+		}
+		catch (...) {
+			Log::sendMessage(Log::Error, "Output job failed with an unknown exception");
+		}
+	}
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <map>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+namespace dyno
+{
+	/**
+	 * @brief A bounded queue of file writing jobs executed by background threads.
+	 *
+	 * Output modules hand their host side snapshots to this queue, so that the simulation thread does not wait for disk I/O.
+	 * submit() blocks once capacity() jobs are pending, which keeps the memory held by snapshots bounded if the disk
+	 * cannot keep up with the simulation.
+	 */
+	class OutputQueue
+	{
+	public:
+		typedef std::function<void()> Job;
+
+		static OutputQueue* instance();
+
+		explicit OutputQueue(unsigned int numWorkers = 2, unsigned int capacity = 8);
+		~OutputQueue();
+
+		/**
+		 * @brief Wait for all pending jobs and restart with n writer threads, 0 means jobs are executed inside submit().
+		 */
+		void setWorkerNumber(unsigned int n);
+		unsigned int workerNumber() const { return (unsigned int)mWorkers.size(); }
+
+		/**
+		 * @brief Set the maximum number of pending jobs, at least one job is allowed.
+		 */
+		void setCapacity(unsigned int n);
+		unsigned int capacity() const { return mCapacity; }
+
+		/**
+		 * @brief Queue a job on behalf of owner, e.g., the scene graph it writes outputs for.
+		 * 	A barrier job only starts once all jobs submitted before it are finished, e.g., a checkpoint is not written ahead of the outputs of earlier frames.
+		 */
+		void submit(Job job, const void* owner = nullptr, bool barrier = false);
+
+		/**
+		 * @brief Block until all jobs submitted so far are finished, e.g., at the end of a run.
+		 */
+		void flush();
+
+		/**
+		 * @brief Block until the jobs submitted so far on behalf of owner are finished, jobs of other owners are not waited for
+		 */
+		void flush(const void* owner);
+
+		/**
+		 * @brief Number of jobs that are either queued or running
+		 */
+		unsigned int pendingJobs();
+
+	private:
+		void start(unsigned int n);
+		void stop();
+
+		void work();
+
+		static void execute(Job& job);
+
+		struct Entry
+		{
+			unsigned long long ticket;
+			const void* owner;
+			bool barrier;
+			Job job;
+		};
+
+		std::vector<std::thread> mWorkers;
+		std::deque<Entry> mJobs;
+
+		//Tickets and owners of the jobs that are either queued or running
+		std::map<unsigned long long, const void*> mInFlight;
+		unsigned long long mNextTicket = 0;
+
+		std::mutex mMutex;
+		std::condition_variable mJobAdded;
+		std::condition_variable mJobDone;
+
+		unsigned int mCapacity;
+
+		bool mStop = false;
+	};
+}
@@ -1,14 +1,18 @@
 #include "Pipeline.h"
 #include "Node.h"
 #include "SceneGraph.h"
-#include "DirectedAcyclicGraph.h"
+#include "IncrementalDAG.h"
 
 #include "Timer.h"
+#include "ThreadPool.h"
 
 #include <sstream>
 #include <iomanip>
 #include <queue>
 #include <set>
+#include <atomic>
+#include <algorithm>
+#include <functional>
 
 namespace dyno
 {
@@ -111,35 +115,133 @@ namespace dyno
 		}
 	}
 
+	bool Pipeline::isConcurrentExecution()
+	{
+		return mConcurrentExecution;
+	}
+
+	void Pipeline::setConcurrentExecution(bool concurrent)
+	{
+		mConcurrentExecution = concurrent;
+	}
+
 	void Pipeline::updateImpl()
 	{
 		if (mUpdateEnabled)
 		{
-			CTimer timer;
+			if (mConcurrentExecution && mTasks.size() > 1 && ThreadPool::instance()->threadNumber() > 1)
+			{
+				updateConcurrently();
+				return;
+			}
+
 			for(auto m : mModuleList)
 			{
-				if (this->printDebugInfo()) {
-					timer.start();
-				}
+				updateModule(m.get());
+			}
+		}
+	}
+
+	void Pipeline::updateModule(Module* m)
+	{
+		CTimer timer;
+
+		if (this->printDebugInfo()) {
+			timer.start();
+		}
 
-				//update the module
-				m->update();
+		//update the module
+		{
+			ProfileZone zone(m->getClassInfo()->getClassName(), ProfileCategory::Module, m->objectId());
 
-				if (this->printDebugInfo()) {
-					timer.stop();
+			m->update();
+		}
 
-					std::stringstream name;
-					std::stringstream ss;
-					name << std::setw(40) << m->getClassInfo()->getClassName();
-					ss << std::setprecision(10) << timer.getElapsedTime();
+		if (this->printDebugInfo() && Log::isEnabled(Log::Info)) {
+			timer.stop();
 
-					std::string info = "\t Module: " + name.str() + ": \t " + ss.str() + "ms";
-					Log::sendMessage(Log::Info, info);
-				}
+			Log::sendMessage(Log::Info, "\t Module: {:40}: \t {}ms", m->getClassInfo()->getClassName(), timer.getElapsedTime());
+		}
+	}
+
+	void Pipeline::updateConcurrently()
+	{
+		size_t num = mTasks.size();
+
+		std::unique_ptr<std::atomic<uint>[]> remaining(new std::atomic<uint>[num]);
+		for (size_t i = 0; i < num; i++)
+			remaining[i] = mTaskDependencies[i];
+
+		TaskGroup group;
+
+		std::function<void(uint)> execute = [&](uint i) {
+			Module* m = mTasks[i];
+
+#ifndef NDEBUG
+			claimFields(m);
+#endif
+			updateModule(m);
+#ifndef NDEBUG
+			releaseFields(m);
+#endif
+
+			for (auto s : mTaskSuccessors[i])
+			{
+				if (--remaining[s] == 0)
+					group.run([&execute, s]() { execute(s); });
 			}
+		};
+
+		for (uint i = 0; i < num; i++)
+		{
+			if (mTaskDependencies[i] == 0)
+				group.run([&execute, i]() { execute(i); });
 		}
+
+		group.wait();
 	}
 
+#ifndef NDEBUG
+	void Pipeline::claimFields(Module* m)
+	{
+		auto claim = [&](std::vector<FBase*>& fields) {
+			for (auto f : fields)
+			{
+				FBase* top = f->getTopField();
+
+				auto it = mFieldOwners.find(top);
+				if (it != mFieldOwners.end() && it->second != m)
+				{
+					Log::sendMessage(Log::Error, "Data race: " + m->getName() + " and " + it->second->getName() + " are running concurrently on the field " + top->getObjectName());
+					continue;
+				}
+
+				mFieldOwners[top] = m;
+			}
+		};
+
+		std::lock_guard<std::mutex> lock(mFieldMutex);
+		claim(m->getInputFields());
+		claim(m->getOutputFields());
+	}
+
+	void Pipeline::releaseFields(Module* m)
+	{
+		auto release = [&](std::vector<FBase*>& fields) {
+			for (auto f : fields)
+			{
+				auto it = mFieldOwners.find(f->getTopField());
+				if (it != mFieldOwners.end() && it->second == m)
+					mFieldOwners.erase(it);
+			}
+		};
+
+		std::lock_guard<std::mutex> lock(mFieldMutex);
+		release(m->getInputFields());
+		release(m->getOutputFields());
+	}
+#endif
+
 	bool Pipeline::requireUpdate()
 	{
 		return true;
@@ -184,7 +286,20 @@ namespace dyno
 // 			visited[mItor.first] = false;
 // 		}
 
-		DirectedAcyclicGraph graph;
+		IncrementalDAG graph;
+		std::map<ObjectId, uint> vertexIds;
+		std::vector<ObjectId> objectIds;
+
+		auto vertexOf = [&](ObjectId id) -> uint {
+			auto it = vertexIds.find(id);
+			if (it != vertexIds.end())
+				return it->second;
+
+			uint v = graph.addVertex();
+			vertexIds[id] = v;
+			objectIds.push_back(id);
+			return v;
+		};
 
 		auto retrieveModules = [&](ObjectId id, std::vector<FBase *>& fields) {
 			for(auto f : fields) {
@@ -195,7 +310,12 @@ namespace dyno
 					if (module != nullptr)
 					{
 						ObjectId oId = module->objectId();
-						graph.addEdge(id, oId);
+						uint u = vertexOf(id);
+						uint v = vertexOf(oId);
+						if (u != v && !graph.addEdge(u, v))
+						{
+							Log::sendMessage(Log::Warning, "A cycle is detected while connecting modules to " + module->getName());
+						}
 						
 						if (moduleSet.find(oId) == moduleSet.end() && mModuleMap.count(oId) > 0)
 						{
@@ -261,16 +381,76 @@ namespace dyno
 			}
 		}
 
-		auto& ids = graph.topologicalSort();
+		auto& order = graph.topologicalOrder();
 
-		for(auto id : ids)
+		for(auto v : order)
 		{
+			ObjectId id = objectIds[v];
 			if (mModuleMap.count(id) > 0)
 			{
 				mModuleList.push_back(mModuleMap[id]);
 			}
 		}
 
+		//Build the task graph
+		mTasks.clear();
+		mTaskSuccessors.clear();
+		mTaskDependencies.clear();
+
+		std::map<ObjectId, uint> taskIds;
+		for (auto m : mModuleList)
+		{
+			taskIds[m->objectId()] = (uint)mTasks.size();
+			mTasks.push_back(m.get());
+		}
+
+		mTaskSuccessors.resize(mTasks.size());
+		mTaskDependencies.resize(mTasks.size(), 0);
+
+		auto addTaskDependency = [&](uint i, uint j) {
+			auto& succ = mTaskSuccessors[i];
+			if (i != j && std::find(succ.begin(), succ.end(), j) == succ.end())
+			{
+				succ.push_back(j);
+				mTaskDependencies[j]++;
+			}
+		};
+
+		for (auto v : order)
+		{
+			auto itI = taskIds.find(objectIds[v]);
+			if (itI == taskIds.end())
+				continue;
+
+			for (auto w : graph.successors(v))
+			{
+				auto itJ = taskIds.find(objectIds[w]);
+				if (itJ != taskIds.end())
+					addTaskDependency(itI->second, itJ->second);
+			}
+		}
+
+		//Input fields can be modified in place, modules sharing a field are executed in the sequential order
+		std::map<FBase*, uint> lastTask;
+		auto orderByFields = [&](uint i, std::vector<FBase*>& fields) {
+			for (auto f : fields)
+			{
+				FBase* top = f->getTopField();
+
+				auto it = lastTask.find(top);
+				if (it != lastTask.end())
+					addTaskDependency(it->second, i);
+
+				lastTask[top] = i;
+			}
+		};
+
+		for (uint i = 0; i < mTasks.size(); i++)
+		{
+			orderByFields(i, mTasks[i]->getInputFields());
+			orderByFields(i, mTasks[i]->getOutputFields());
+		}
+
 		moduleSet.clear();
 
 		mModuleUpdated = false;
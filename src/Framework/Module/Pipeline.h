@@ -16,6 +16,8 @@
 #pragma once
 #include "Module.h"
 
+#include <mutex>
+
 namespace dyno
 {
 	class Node;
@@ -83,6 +85,14 @@ namespace dyno
 
 		void forceUpdate();
 
+		/**
+		 * @brief Whether modules are executed as a task graph on the thread pool.
+		 *		A module is started once all modules it depends on have finished. Besides the field connections,
+		 *		modules sharing a field are kept in the sequential order since input fields may be modified in place.
+		 */
+		bool isConcurrentExecution();
+		void setConcurrentExecution(bool concurrent);
+
 		/**
 		 * Turn a module output field to a node output node
 		 */
@@ -104,6 +114,16 @@ namespace dyno
 	private:
 		void reconstructPipeline();
 
+		void updateModule(Module* m);
+
+		void updateConcurrently();
+
+#ifndef NDEBUG
+		//Data race detection, each running module claims the fields it touches
+		void claimFields(Module* m);
+		void releaseFields(Module* m);
+#endif
+
 	private:
 		bool mModuleUpdated = false;
 		bool mUpdateEnabled = true;
@@ -114,6 +134,18 @@ namespace dyno
 		std::list<std::shared_ptr<Module>> mPersistentModule;
 
 		bool mTiming = false;
+
+		bool mConcurrentExecution = false;
+
+		//Task graph over mModuleList, edges point from a module to the modules depending on it
+		std::vector<Module*> mTasks;
+		std::vector<std::vector<uint>> mTaskSuccessors;
+		std::vector<uint> mTaskDependencies;
+
+#ifndef NDEBUG
+		std::mutex mFieldMutex;
+		std::map<FBase*, Module*> mFieldOwners;
+#endif
 	};
 }
 
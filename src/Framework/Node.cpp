@@ -80,6 +80,16 @@ void Node::setVisible(bool visible)
 	mRenderingEnabled = visible;
 }
 
+bool Node::isThreadSafe()
+{
+	return mThreadSafe;
+}
+
+void Node::setThreadSafe(bool safe)
+{
+	mThreadSafe = safe;
+}
+
 float Node::getDt()
 {
 	return mDt;
@@ -433,6 +443,10 @@ bool Node::appendExportNode(NodePort* nodePort)
 	mExportNodes.push_back(nodePort);
 
 	Log::sendMessage(Log::Info, FormatConnectionInfo(this, nodePort, true, true));
+	if (mSceneGraph != nullptr && nodePort->getParent()->getSceneGraph() == mSceneGraph) {
+		mSceneGraph->addDependency(this, nodePort->getParent());
+	}
+
 	return nodePort->addNode(this);
 }
 
@@ -452,6 +466,10 @@ bool Node::removeExportNode(NodePort* nodePort)
 	mExportNodes.erase(it);
 
 	Log::sendMessage(Log::Info, FormatConnectionInfo(this, nodePort, false, true));
+	if (mSceneGraph != nullptr && nodePort->getParent()->getSceneGraph() == mSceneGraph) {
+		mSceneGraph->removeDependency(this, nodePort->getParent());
+	}
+
 	return nodePort->removeNode(this);
 }
 
@@ -100,6 +100,15 @@ namespace dyno
 		/// Set the visibility of context
 		virtual void setVisible(bool visible);
 
+		/// Whether the node can be advanced concurrently with other independent nodes
+		bool isThreadSafe();
+
+		/**
+		 * @brief Nodes that share global resources should turn it off, they are then advanced one by one
+		 *		after the concurrent nodes of the same dependency level have finished
+		 */
+		void setThreadSafe(bool safe);
+
 		/// Simulation timestep
 		virtual Real getDt();
 
@@ -311,6 +320,8 @@ namespace dyno
 
 		bool mRenderingEnabled = true;
 
+		bool mThreadSafe = true;
+
 		bool mExported = true;
 
 		bool mForceUpdate = true;
@@ -191,7 +191,9 @@ namespace dyno {
 
 		~MultipleNodePort() {
 			//Disconnect nodes from node ports here instead of inside the destructor of Node to avoid memory leak
-			for(auto node : m_nodes)
+			//m_nodes is only refreshed by getNodes(), take a copy of the up-to-date list since disconnecting modifies m_derived_nodes
+			auto nodes = this->getNodes();
+			for(auto node : nodes)
 			{
 				disconnect(node, this);
 				//node->disconnect(this);
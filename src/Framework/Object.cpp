@@ -1,9 +1,47 @@
 #include <map>
+#include <mutex>
 #include "Object.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__)
+#include <dlfcn.h>
+#endif
+
 namespace dyno
 {
 static std::map< std::string, ClassInfo*> *classInfoMap = NULL;
+static std::map< std::string, std::string> *classModuleMap = NULL;
+static std::atomic<bool (*)(const std::string&)> classLoader {NULL};
+
+//Plugins register their classes while other threads may create objects, constructed on first use as classes register during static initialization
+static std::mutex& registryMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+//File of the shared library or executable that contains the address
+static std::string moduleOf(const void* address)
+{
+#if defined(_WIN32)
+	HMODULE module = NULL;
+	if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCSTR)address, &module))
+		return "";
+
+	char name[MAX_PATH];
+	DWORD length = GetModuleFileNameA(module, name, MAX_PATH);
+	return std::string(name, length);
+#elif defined(__unix__)
+	Dl_info info;
+	if (dladdr(address, &info) == 0 || info.dli_fname == NULL)
+		return "";
+
+	return info.dli_fname;
+#else
+	return "";
+#endif
+}
 
 IMPLEMENT_CLASS(Object)
 
@@ -18,31 +56,79 @@ Object::Object()
 
 bool Object::registerClass(ClassInfo* ci)
 {
+	//The constructor is code of the module defining the class, unlike ClassInfo which may be allocated on the heap
+	std::string module;
+	if (ci) {
+		module = ci->m_objectConstructor ? moduleOf((const void*)ci->m_objectConstructor) : moduleOf(ci);
+	}
+
+	std::lock_guard<std::mutex> lock(registryMutex());
+
 	if (!classInfoMap) {
 		classInfoMap = new std::map< std::string, ClassInfo*>();
+		classModuleMap = new std::map< std::string, std::string>();
 	}
 	if (ci) {
 		if (classInfoMap->find(ci->m_className) == classInfoMap->end()) {
 			classInfoMap->insert(std::map< std::string, ClassInfo*>::value_type(ci->m_className, ci));
+			classModuleMap->insert(std::map< std::string, std::string>::value_type(ci->m_className, module));
 			// fprintf(stderr,"%s\n", ci->m_className.c_str());
 		}
 	}
 	return true;
 }
-Object* Object::createObject(std::string name)
+
+static ClassInfo* findClass(const std::string& name)
 {
+	std::lock_guard<std::mutex> lock(registryMutex());
+
+	if (!classInfoMap)
+		return NULL;
+
 	std::map< std::string, ClassInfo*>::const_iterator iter = classInfoMap->find(name);
-	if (classInfoMap->end() != iter) {
-		return iter->second->createObject();
+	return classInfoMap->end() != iter ? iter->second : NULL;
+}
+
+Object* Object::createObject(std::string name)
+{
+	ClassInfo* ci = findClass(name);
+	if (ci != NULL) {
+		return ci->createObject();
+	}
+
+	//The loader registers classes itself, so the registry must not be locked while it runs
+	auto loader = classLoader.load();
+	if (loader != NULL && loader(name)) {
+		ci = findClass(name);
+		if (ci != NULL) {
+			return ci->createObject();
+		}
 	}
 	return NULL;
 }
 
+void Object::setClassLoader(bool (*loader)(const std::string&))
+{
+	classLoader = loader;
+}
+
 std::map< std::string, ClassInfo*>* Object::getClassMap()
 {
 	return classInfoMap;
 }
 
+bool Object::isRegistered(const std::string& name)
+{
+	return findClass(name) != NULL;
+}
+
+std::map< std::string, std::string> Object::getClassModules()
+{
+	std::lock_guard<std::mutex> lock(registryMutex());
+
+	return classModuleMap ? *classModuleMap : std::map< std::string, std::string>();
+}
+
 ObjectId Object::baseId()
 {
 	return BASE_ID;
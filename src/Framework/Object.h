@@ -22,6 +22,8 @@ namespace dyno
 {
 class Object;
 class ClassInfo;
+class BinaryWriter;
+class BinaryReader;
 
 
 typedef Object* (*ObjectConstructorFn)(void);
@@ -117,8 +119,28 @@ public:
 	virtual ~Object() {};
 	static bool registerClass(ClassInfo* ci);
 	static Object* createObject(std::string name);
+	/**
+	 * @brief The registry itself, it is not locked against plugins that are loaded lazily on other threads.
+	 * 	Use isRegistered() or getClassModules() once scenes may be created concurrently.
+	 */
 	static std::map< std::string, ClassInfo*>* getClassMap();
 
+	/**
+	 * @brief Whether a class is registered, safe to call while plugins are loaded on other threads.
+	 */
+	static bool isRegistered(const std::string& name);
+
+	/**
+	 * @brief The file of the shared library or executable defining each registered class, recorded when the class registers.
+	 */
+	static std::map< std::string, std::string> getClassModules();
+
+	/**
+	 * @brief Set a function called by createObject() for classes that are not registered, e.g., to load the plugin providing the class.
+	 * 	It returns true if the class is registered afterwards.
+	 */
+	static void setClassLoader(bool (*loader)(const std::string&));
+
 	/**
 	 * @brief Base Id
 	 * 
@@ -127,6 +149,12 @@ public:
 	static ObjectId baseId();
 
 	ObjectId objectId() { return id; }
+
+	/**
+	 * @brief Binary snapshot of the object data used by checkpoints of instance fields, return false if not supported
+	 */
+	virtual bool writeBinary(BinaryWriter& writer) { return false; }
+	virtual bool readBinary(BinaryReader& reader) { return false; }
 private:
 	ObjectId id;
 
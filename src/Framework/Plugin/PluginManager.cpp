@@ -1,8 +1,17 @@
 #include "PluginManager.h"
 
+#include "Object.h"
+#include "Timer.h"
+
 #include <ghc/fs_std.hpp>
 
 #include <iostream>
+#include <fstream>
+#include <set>
+
+#if defined(__unix__)
+#include <link.h>
+#endif
 
 namespace dyno
 {
@@ -68,6 +77,66 @@ namespace dyno
 		}
 	}
 
+	std::vector<std::string> Plugin::dependencies() const
+	{
+		std::vector<std::string> files;
+
+#if defined(__unix__)
+		if (mHnd == nullptr)
+			return files;
+
+		std::set<std::string> visited;
+		std::vector<void*> pending;
+		pending.push_back(mHnd);
+
+		while (!pending.empty())
+		{
+			void* hnd = pending.back();
+			pending.pop_back();
+
+			struct link_map* map = nullptr;
+			if (::dlinfo(hnd, RTLD_DI_LINKMAP, &map) != 0 || map == nullptr || map->l_ld == nullptr)
+			{
+				if (hnd != mHnd) ::dlclose(hnd);
+				continue;
+			}
+
+			//Most architectures relocate the dynamic section in place, the others keep addresses relative to the load base
+			const char* strtab = nullptr;
+			for (const ElfW(Dyn)* dyn = map->l_ld; dyn->d_tag != DT_NULL; dyn++)
+			{
+				if (dyn->d_tag == DT_STRTAB)
+					strtab = (const char*)(dyn->d_un.d_ptr < map->l_addr ? map->l_addr + dyn->d_un.d_ptr : dyn->d_un.d_ptr);
+			}
+
+			for (const ElfW(Dyn)* dyn = map->l_ld; strtab != nullptr && dyn->d_tag != DT_NULL; dyn++)
+			{
+				if (dyn->d_tag != DT_NEEDED)
+					continue;
+
+				//Already loaded together with the plugin, RTLD_NOLOAD resolves the name without loading anything
+				void* needed = ::dlopen(strtab + dyn->d_un.d_val, RTLD_LAZY | RTLD_NOLOAD);
+				if (needed == nullptr)
+					continue;
+
+				struct link_map* neededMap = nullptr;
+				if (::dlinfo(needed, RTLD_DI_LINKMAP, &neededMap) == 0 && neededMap != nullptr && neededMap->l_name != nullptr && neededMap->l_name[0] != '\0'
+					&& visited.insert(neededMap->l_name).second)
+				{
+					files.push_back(neededMap->l_name);
+					pending.push_back(needed);
+				}
+				else
+					::dlclose(needed);
+			}
+
+			if (hnd != mHnd) ::dlclose(hnd);
+		}
+#endif
+
+		return files;
+	}
+
 	Plugin& Plugin::operator=(Plugin&& rhs)
 	{
 		std::swap(rhs.mIsLoaded, mIsLoaded);
@@ -115,14 +184,89 @@ namespace dyno
 		return ext;
 	}
 
+	static std::string canonicalName(const std::string& file)
+	{
+		std::error_code error;
+		auto path = fs::weakly_canonical(fs::path(file), error);
+		return error ? file : path.string();
+	}
+
+	static bool loadClass(const std::string& className)
+	{
+		return PluginManager::instance()->loadPluginOfClass(className);
+	}
+
 	bool PluginManager::loadPlugin(const std::string& pluginName)
 	{
+		std::lock_guard<std::recursive_mutex> lock(mLoadMutex);
+
+		return this->loadPluginImpl(pluginName);
+	}
+
+	bool PluginManager::loadPluginImpl(const std::string& pluginName)
+	{
+		if (mPlugins.find(pluginName) != mPlugins.end())
+			return true;
+
+		CTimer timer;
+		timer.start();
+
 		auto plugin = Plugin::load(pluginName);
+
+		timer.stop();
+
+		PluginStatistics& stat = this->statisticsOf(pluginName);
+		stat.loadTime = timer.getElapsedTime();
+
 		if (plugin != nullptr)
 		{
 			std::cout << "\033[32m\033[1m" << "[Plugin]: loading " << pluginName << " in success " << "\033[0m" << std::endl;
 			mPlugins[pluginName] = plugin;
 
+			//Classes record the library defining them on registration, so the ones of shared dependencies are credited to every plugin using them
+			std::vector<std::string> dependencies = plugin->dependencies();
+
+			std::set<std::string> modules;
+			modules.insert(canonicalName(pluginName));
+			for (auto& file : dependencies)
+				modules.insert(canonicalName(file));
+
+			std::map<std::string, std::string> canonical;
+			std::vector<std::string> classes;
+			for (auto& c : Object::getClassModules())
+			{
+				if (c.second.empty())
+					continue;
+
+				auto it = canonical.find(c.second);
+				if (it == canonical.end())
+					it = canonical.emplace(c.second, canonicalName(c.second)).first;
+
+				if (modules.find(it->second) != modules.end())
+					classes.push_back(c.first);
+			}
+
+			stat.loaded = true;
+			stat.classes = (uint)classes.size();
+
+			for (auto it = mDeferredClasses.begin(); it != mDeferredClasses.end();)
+			{
+				if (it->second == pluginName)
+					it = mDeferredClasses.erase(it);
+				else
+					it++;
+			}
+
+			//Keep the manifest up to date for lazy loading
+			timer.start();
+
+			std::vector<std::string> recorded;
+			if (!this->readManifest(pluginName, recorded))
+				this->writeManifest(pluginName, dependencies, classes);
+
+			timer.stop();
+			stat.manifestTime += timer.getElapsedTime();
+
 			return true;
 		}
 		else
@@ -133,7 +277,63 @@ namespace dyno
 		}
 	}
 
-	void PluginManager::loadPluginByPath(const std::string& pathName)
+	bool PluginManager::registerPlugin(const std::string& pluginName)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mLoadMutex);
+
+		if (mPlugins.find(pluginName) != mPlugins.end())
+			return true;
+
+		CTimer timer;
+		timer.start();
+
+		std::vector<std::string> classes;
+		bool valid = this->readManifest(pluginName, classes);
+
+		timer.stop();
+
+		if (!valid)
+			return this->loadPluginImpl(pluginName);
+
+		PluginStatistics& stat = this->statisticsOf(pluginName);
+		stat.deferred = true;
+		stat.manifestTime = timer.getElapsedTime();
+		stat.classes = (uint)classes.size();
+
+		for (auto& name : classes)
+		{
+			if (!Object::isRegistered(name))
+				mDeferredClasses[name] = pluginName;
+		}
+
+		Object::setClassLoader(&loadClass);
+
+		return true;
+	}
+
+	bool PluginManager::loadPluginOfClass(const std::string& className)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mLoadMutex);
+
+		auto it = mDeferredClasses.find(className);
+		if (it == mDeferredClasses.end())
+			return false;
+
+		std::string pluginName = it->second;
+		mDeferredClasses.erase(it);
+
+		return this->loadPluginImpl(pluginName) && Object::isRegistered(className);
+	}
+
+	std::string PluginManager::providerOf(const std::string& className)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mLoadMutex);
+
+		auto it = mDeferredClasses.find(className);
+		return it == mDeferredClasses.end() ? "" : it->second;
+	}
+
+	void PluginManager::loadPluginByPath(const std::string& pathName, bool lazy)
 	{
 		fs::path file_path(pathName);
 
@@ -149,11 +349,115 @@ namespace dyno
 			std::string name = entry.path().filename().string();
 			if (entry.path().extension() == getExtension() && name.find("plugin-") != std::string::npos)
 			{
-				loadPlugin(entry.path().string());
+				if (lazy)
+					registerPlugin(entry.path().string());
+				else
+					loadPlugin(entry.path().string());
 			}
 		}
 	}
 
+	std::string PluginManager::manifestName(const std::string& pluginName)
+	{
+		return fs::path(pluginName).replace_extension(".manifest").string();
+	}
+
+	//The manifest is only valid for the libraries it was generated from
+	static std::string fileStamp(const std::string& pluginName)
+	{
+		std::error_code error;
+		auto size = fs::file_size(pluginName, error);
+		if (error)
+			return "";
+
+		auto time = fs::last_write_time(pluginName, error);
+		if (error)
+			return "";
+
+		return std::to_string(size) + " " + std::to_string(time.time_since_epoch().count());
+	}
+
+	bool PluginManager::readManifest(const std::string& pluginName, std::vector<std::string>& classes)
+	{
+		std::ifstream input(manifestName(pluginName));
+		if (!input.is_open())
+			return false;
+
+		std::string stamp = fileStamp(pluginName);
+
+		bool valid = false;
+		std::string line;
+		while (std::getline(input, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+
+			if (line.compare(0, 6, "stamp ") == 0)
+				valid = !stamp.empty() && line.substr(6) == stamp;
+			else if (line.compare(0, 8, "depends ") == 0)
+			{
+				//depends <size> <time> <file>
+				size_t pos = line.find(' ', line.find(' ', 8) + 1);
+				if (pos == std::string::npos || line.substr(8, pos - 8) != fileStamp(line.substr(pos + 1)))
+					return false;
+			}
+			else if (line.compare(0, 6, "class ") == 0)
+				classes.push_back(line.substr(6));
+		}
+
+		return valid;
+	}
+
+	bool PluginManager::writeManifest(const std::string& pluginName, const std::vector<std::string>& dependencies, const std::vector<std::string>& classes)
+	{
+		std::string stamp = fileStamp(pluginName);
+		if (stamp.empty())
+			return false;
+
+		std::vector<std::string> stamps;
+		for (auto& file : dependencies)
+		{
+			stamps.push_back(fileStamp(file));
+			if (stamps.back().empty())
+				return false;
+		}
+
+		//The plugin directory may be read-only, the plugin is loaded eagerly in that case
+		std::ofstream output(manifestName(pluginName));
+		if (!output.is_open())
+			return false;
+
+		output << "# Classes registered by " << fs::path(pluginName).filename().string() << ", generated when the plugin was loaded" << std::endl;
+		output << "stamp " << stamp << std::endl;
+		for (size_t i = 0; i < dependencies.size(); i++)
+			output << "depends " << stamps[i] << " " << dependencies[i] << std::endl;
+		for (auto& name : classes)
+			output << "class " << name << std::endl;
+
+		return output.good();
+	}
+
+	PluginStatistics& PluginManager::statisticsOf(const std::string& pluginName)
+	{
+		for (auto& stat : mStatistics)
+		{
+			if (stat.file == pluginName)
+				return stat;
+		}
+
+		mStatistics.push_back(PluginStatistics());
+		mStatistics.back().file = pluginName;
+
+		return mStatistics.back();
+	}
+
+	std::vector<PluginStatistics> PluginManager::statistics()
+	{
+		std::lock_guard<std::recursive_mutex> lock(mLoadMutex);
+
+		return mStatistics;
+	}
+
 	std::shared_ptr<Plugin> PluginManager::getPlugin(const char* pluginName)
 	{
 		auto it = mPlugins.find(pluginName);
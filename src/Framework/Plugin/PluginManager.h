@@ -5,6 +5,7 @@
 #include <string>
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include "PluginEntry.h"
 
@@ -41,6 +42,12 @@ namespace dyno
 
 		void unload();
 
+		/**
+		 * @brief Files of the shared libraries the plugin depends on, directly or indirectly.
+		 * 	Only available on Linux, where the DT_NEEDED entries of the loaded libraries are followed.
+		 */
+		std::vector<std::string> dependencies() const;
+
 		static std::shared_ptr<Plugin> load(std::string file);
 
 	private:
@@ -63,9 +70,38 @@ namespace dyno
 		PluginEntry* mEntryPoint = nullptr;
 	};
 
+	/**
+	 * @brief Load time and contents of a plugin, see PluginManager::statistics()
+	 */
+	struct PluginStatistics
+	{
+		std::string file;
+
+		/** @brief Whether the shared library is loaded into the current process */
+		bool loaded = false;
+
+		/** @brief Whether the plugin was registered from its manifest without being loaded at startup */
+		bool deferred = false;
+
+		/** @brief Time in milliseconds spent in loading the shared library and initializing the plugin */
+		double loadTime = 0.0;
+
+		/** @brief Time in milliseconds spent in reading or writing the manifest */
+		double manifestTime = 0.0;
+
+		/** @brief Number of classes the plugin registers */
+		uint classes = 0;
+	};
+
 	/** 
 	 * @brief Repository of plugins.
 	 * It can instantiate any class from any loaded plugin by its name.
+	 *
+	 * Each plugin may have a manifest next to its shared library, e.g., plugin-ObjIO-1.0.0.manifest, listing the classes that loading it
+	 * 	makes available, i.e., classes defined in the plugin or in the libraries it depends on. Plugins registered lazily are only loaded
+	 * 	once one of their classes is created by Object::createObject(), which keeps the startup cheap for applications that only use a few
+	 * 	plugins. The manifest is written whenever a plugin is loaded and the manifest is missing or outdated, so no extra build step is
+	 * 	required. It is outdated once the plugin or any of its dependencies changes.
 	 **/
 	class PluginManager
 	{
@@ -76,18 +112,63 @@ namespace dyno
 
 		bool loadPlugin(const std::string& pluginName);
 
-		void loadPluginByPath(const std::string& pathName);
+		/**
+		 * @brief Load all plugins inside a directory.
+		 * @param lazy If true, plugins with a valid manifest are registered without being loaded.
+		 * 	Note node actions of NodeFactory are only available after a plugin is loaded, therefore GUI applications should load eagerly.
+		 */
+		void loadPluginByPath(const std::string& pathName, bool lazy = false);
+
+		/**
+		 * @brief Register a plugin from its manifest, the plugin is loaded immediately if the manifest is missing or outdated.
+		 */
+		bool registerPlugin(const std::string& pluginName);
+
+		/**
+		 * @brief Load the plugin that provides the class, return false if no registered plugin provides it.
+		 */
+		bool loadPluginOfClass(const std::string& className);
+
+		/**
+		 * @brief The file of the plugin that provides the class, or an empty string if it is unknown.
+		 */
+		std::string providerOf(const std::string& className);
 
 		std::shared_ptr<Plugin> getPlugin(const char* pluginName);
 
+		/**
+		 * @brief Load time of all plugins that are registered or loaded, in the order of registration.
+		 */
+		std::vector<PluginStatistics> statistics();
+
+		/**
+		 * @brief Name of the manifest of a plugin
+		 */
+		static std::string manifestName(const std::string& pluginName);
+
 	private:
 		PluginManager() {};
 
+		bool loadPluginImpl(const std::string& pluginName);
+
+		bool readManifest(const std::string& pluginName, std::vector<std::string>& classes);
+		bool writeManifest(const std::string& pluginName, const std::vector<std::string>& dependencies, const std::vector<std::string>& classes);
+
+		PluginStatistics& statisticsOf(const std::string& pluginName);
+
 		using PluginMap = std::map<std::string, std::shared_ptr<Plugin>>;
 
 		static std::atomic<PluginManager*> pInstance;
 		static std::mutex mMutex;
 
+		//Guard loading and registering plugins, recursive since static initializers of a plugin may create objects
+		std::recursive_mutex mLoadMutex;
+
 		PluginMap mPlugins;
+
+		//Classes provided by plugins that are registered but not loaded yet
+		std::map<std::string, std::string> mDeferredClasses;
+
+		std::vector<PluginStatistics> mStatistics;
 	};
 }
@@ -8,10 +8,14 @@
 
 #include "Module/MouseInputModule.h"
 #include "Module/KeyboardInputModule.h"
+#include "Module/OutputQueue.h"
 
 #include "SceneLoaderFactory.h"
+#include "Checkpoint.h"
 
 #include "Timer.h"
+#include "ThreadPool.h"
+#include "Array/Allocator.h"
 
 #include <sstream>
 #include <iomanip>
@@ -51,6 +55,16 @@ namespace dyno
 		mAdvativeInterval = adaptive;
 	}
 
+	bool SceneGraph::isConcurrentExecution()
+	{
+		return mConcurrentExecution;
+	}
+
+	void SceneGraph::setConcurrentExecution(bool concurrent)
+	{
+		mConcurrentExecution = concurrent;
+	}
+
 	void SceneGraph::setGravity(Vec3f g)
 	{
 		mGravity = g;
@@ -63,6 +77,16 @@ namespace dyno
 
 	SceneGraph::~SceneGraph()
 	{
+		this->waitForCheckpoint();
+
+		//Finish the files written by the output modules of this scene, other scenes keep writing theirs
+		OutputQueue::instance()->flush(this);
+
+		//Nodes may outlive the scene graph, stop them from reporting connections back
+		for (auto& nm : mNodeMap) {
+			nm.second->setSceneGraph(nullptr);
+		}
+
 		mNodeMap.clear();
 		mNodeQueue.clear();
 	}
@@ -99,18 +123,16 @@ namespace dyno
 					timer.start();
 				}
 
-				node->update();
+				{
+					ProfileZone zone(node->getClassInfo()->getClassName(), ProfileCategory::Node, node->objectId());
 
-				if (mTiming) {
-					timer.stop();
+					node->update();
+				}
 
-					std::stringstream name;
-					std::stringstream ss;
-					name << std::setw(40) << node->getClassInfo()->getClassName();
-					ss << std::setprecision(10) << timer.getElapsedTime();
+				if (mTiming && Log::isEnabled(Log::Info)) {
+					timer.stop();
 
-					std::string info = "Node: \t" + name.str() + ": \t " + ss.str() + "ms \n";
-					Log::sendMessage(Log::Info, info);
+					Log::sendMessage(Log::Info, "Node: \t{:40}: \t {}ms \n", node->getClassInfo()->getClassName(), timer.getElapsedTime());
 				}
 			}
 
@@ -120,7 +142,12 @@ namespace dyno
 			bool mTiming = false;
 		};
 
-		this->traverseForward<AdvanceAct>(dt, mElapsedTime, mNodeTiming);
+		AdvanceAct act(dt, mElapsedTime, mNodeTiming);
+
+		if (mConcurrentExecution && ThreadPool::instance()->threadNumber() > 1)
+			this->traverseForwardConcurrently(&act);
+		else
+			this->traverseForward(&act);
 
 		mElapsedTime += dt;
 	}
@@ -129,6 +156,8 @@ namespace dyno
 	{
 		mSync.lock();
 
+		PROFILE_ZONE("Frame", ProfileCategory::Frame, mFrameNumber);
+
 		std::cout << "****************    Frame " << mFrameNumber << " Started    ****************" << std::endl;
 		
 		CTimer timer;
@@ -189,15 +218,120 @@ namespace dyno
 
 		timer.stop();
 
+		Allocator::device()->nextFrame();
+
 		std::cout << "----------------    Frame " << mFrameNumber << " Ended! ( " << timer.getElapsedTime() << " ms in Total)  ----------------" << std::endl << std::endl;
 
 		mFrameNumber++;
 
 		mWorkMode = RUNNING_MODE;
 
+		if (mCheckpointInterval > 0 && mFrameNumber % mCheckpointInterval == 0)
+		{
+			std::stringstream name;
+			name << mCheckpointPrefix << std::setw(6) << std::setfill('0') << mFrameNumber << ".ckpt";
+			this->writeCheckpoint(name.str(), mCheckpointCompression, false);
+		}
+
 		mSync.unlock();
 	}
 
+	bool SceneGraph::saveCheckpoint(const std::string& filename, bool compressed)
+	{
+		std::lock_guard<std::mutex> lock(mSync);
+
+		return this->writeCheckpoint(filename, compressed, true);
+	}
+
+	bool SceneGraph::writeCheckpoint(const std::string& filename, bool compressed, bool blocking)
+	{
+		auto& writing = mCheckpointWriting[mCheckpointBuffer];
+
+		//The buffer is still held by the checkpoint before the previous one
+		if (writing.valid() && writing.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			if (!blocking)
+			{
+				Log::sendMessage(Log::Warning, "Checkpoint " + filename + " is skipped, the previous ones are still being written");
+				return false;
+			}
+
+			writing.wait();
+		}
+
+		if (writing.valid() && !writing.get())
+			Log::sendMessage(Log::Error, "Failed to write a previous checkpoint");
+
+		auto& checkpoint = mCheckpoints[mCheckpointBuffer];
+		if (checkpoint == nullptr)
+			checkpoint = std::make_shared<Checkpoint>();
+
+		if (!checkpoint->capture(this))
+			return false;
+
+		auto done = std::make_shared<std::promise<bool>>();
+		writing = done->get_future();
+
+		//Outputs of the frames before the checkpoint must be complete when restarting from it
+		OutputQueue::instance()->submit([checkpoint, filename, compressed, done]() {
+			bool success = false;
+			try {
+				success = checkpoint->write(filename, compressed);
+			}
+			catch (...) {
+				done->set_value(false);
+				throw;
+			}
+			done->set_value(success);
+		}, this, true);
+
+		mCheckpointBuffer = 1 - mCheckpointBuffer;
+
+		return true;
+	}
+
+	bool SceneGraph::loadCheckpoint(const std::string& filename)
+	{
+		this->waitForCheckpoint();
+
+		Checkpoint checkpoint;
+		if (!checkpoint.read(filename))
+		{
+			Log::sendMessage(Log::Error, "Failed to read the checkpoint " + filename);
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(mSync);
+
+		bool success = checkpoint.restore(this);
+		if (success)
+			mWorkMode = RUNNING_MODE;
+
+		return success;
+	}
+
+	void SceneGraph::setCheckpointInterval(uint interval, std::string prefix, bool compressed)
+	{
+		mCheckpointInterval = interval;
+		mCheckpointPrefix = prefix;
+		mCheckpointCompression = compressed;
+	}
+
+	bool SceneGraph::waitForCheckpoint()
+	{
+		bool success = true;
+
+		//The older checkpoint first
+		for (uint i = 0; i < 2; i++)
+		{
+			auto& writing = mCheckpointWriting[(mCheckpointBuffer + i) % 2];
+			if (writing.valid())
+				success = writing.get() && success;
+		}
+
+		return success;
+	}
+
 	void SceneGraph::updateGraphicsContext()
 	{
 		class UpdateGrpahicsContextAct : public Action
@@ -430,56 +564,6 @@ namespace dyno
 		this->traverseForward(&eventAct);
 	}
 
-	//Used to traverse the whole scene graph
-	void DFS(Node* node, NodeList& nodeQueue, std::map<ObjectId, bool>& visited) {
-
-		visited[node->objectId()] = true;
-
-		auto imports = node->getImportNodes();
-		for (auto port : imports) {
-			auto& inNodes = port->getNodes();
-			for (auto inNode : inNodes) {
-				if (inNode != nullptr && !visited[inNode->objectId()]) {
-					DFS(inNode, nodeQueue, visited);
-				}
-			}
-		}
-
-		auto inFields = node->getInputFields();
-		for (auto f : inFields) {
-			auto* src = f->getSource();
-			if (src != nullptr) {
-				auto* inNode = dynamic_cast<Node*>(src->parent());
-				if (inNode != nullptr && !visited[inNode->objectId()]) {
-					DFS(inNode, nodeQueue, visited);
-				}
-			}
-		}
-
-		nodeQueue.push_back(node);
-
-		auto exports = node->getExportNodes();
-		for (auto port : exports) {
-			auto exNode = port->getParent();
-			if (exNode != nullptr && !visited[exNode->objectId()]) {
-				DFS(exNode, nodeQueue, visited);
-			}
-		}
-
-		auto outFields = node->getOutputFields();
-		for (auto f : outFields) {
-			auto& sinks = f->getSinks();
-			for (auto sink : sinks) {
-				if (sink != nullptr) {
-					auto exNode = dynamic_cast<Node*>(sink->parent());
-					if (exNode != nullptr && !visited[exNode->objectId()]) {
-						DFS(exNode, nodeQueue, visited);
-					}
-				}
-			}
-		}
-	};
-
 	//Used to traverse the scene graph from a specific node
 	void BFS(Node* node, NodeList& list, std::map<ObjectId, bool>& visited) {
 
@@ -541,28 +625,192 @@ namespace dyno
 
 	void SceneGraph::updateExecutionQueue()
 	{
-		if (!mQueueUpdateRequired)
+		if (!mQueueUpdateRequired && mQueueRevision == mNodeGraph.revision())
 			return;
 
 		mNodeQueue.clear();
 
-		std::map<ObjectId, bool> visited;
-		for (auto& nm : mNodeMap) {
-			visited[nm.first] = false;
+		auto& order = mNodeGraph.topologicalOrder();
+		for (auto v : order) {
+			mNodeQueue.push_back(mVertexNodes[v]);
+		}
+
+		mQueueRevision = mNodeGraph.revision();
+		mQueueUpdateRequired = false;
+	}
+
+	void SceneGraph::updateExecutionLevels()
+	{
+		if (mLevelRevision == mNodeGraph.revision())
+			return;
+
+		mNodeLevels.clear();
+
+		auto& order = mNodeGraph.topologicalOrder();
+
+		std::vector<uint> level(mVertexNodes.size(), 0);
+		for (auto v : order)
+		{
+			for (auto u : mNodeGraph.predecessors(v))
+				level[v] = std::max(level[v], level[u] + 1);
+		}
+
+		//A connection rejected for closing a cycle is still a data dependency, both ends are advanced serially
+		mCyclicNodes.clear();
+		for (auto& e : mRejectedEdges)
+		{
+			mCyclicNodes.insert(mVertexNodes[e.first.first]);
+			mCyclicNodes.insert(mVertexNodes[e.first.second]);
+		}
+
+		for (auto v : order)
+		{
+			if (level[v] >= mNodeLevels.size())
+				mNodeLevels.resize(level[v] + 1);
+
+			mNodeLevels[level[v]].push_back(mVertexNodes[v]);
+		}
+
+		mLevelRevision = mNodeGraph.revision();
+	}
+
+	void SceneGraph::traverseForwardConcurrently(Action* act)
+	{
+		updateExecutionLevels();
+
+		auto apply = [act](Node* node) {
+			act->start(node);
+			act->process(node);
+			act->end(node);
+		};
+
+		std::vector<Node*> serialNodes;
+		for (auto& nodes : mNodeLevels)
+		{
+			serialNodes.clear();
+
+			TaskGroup group;
+			for (auto node : nodes)
+			{
+				if (node->isThreadSafe() && nodes.size() > 1 && mCyclicNodes.count(node) == 0)
+					group.run([&apply, node]() { apply(node); });
+				else
+					serialNodes.push_back(node);
+			}
+			group.wait();
+
+			for (auto node : serialNodes)
+				apply(node);
 		}
+	}
 
-		for (auto& n : mNodeMap) {
-			if (!visited[n.first]) {
+	void SceneGraph::registerNode(Node* node)
+	{
+		uint v = mNodeGraph.addVertex();
+		if (v >= mVertexNodes.size())
+			mVertexNodes.resize(v + 1, nullptr);
 
-				Node* node = n.second.get();
+		mVertexIds[node->objectId()] = v;
+		mVertexNodes[v] = node;
 
-				DFS(node, mNodeQueue, visited);
+		//Collect connections established before the node was added
+		auto imports = node->getImportNodes();
+		for (auto port : imports) {
+			auto& inNodes = port->getNodes();
+			for (auto inNode : inNodes) {
+				if (inNode != nullptr)
+					addDependency(inNode, node);
 			}
 		}
 
-		visited.clear();
+		auto inFields = node->getInputFields();
+		for (auto f : inFields) {
+			auto* src = f->getSource();
+			if (src != nullptr)
+				addDependency(dynamic_cast<Node*>(src->parent()), node);
+		}
 
-		mQueueUpdateRequired = false;
+		auto exports = node->getExportNodes();
+		for (auto port : exports) {
+			addDependency(node, port->getParent());
+		}
+
+		auto outFields = node->getOutputFields();
+		for (auto f : outFields) {
+			auto& sinks = f->getSinks();
+			for (auto sink : sinks) {
+				if (sink != nullptr)
+					addDependency(node, dynamic_cast<Node*>(sink->parent()));
+			}
+		}
+	}
+
+	void SceneGraph::addDependency(Node* src, Node* dst)
+	{
+		if (src == nullptr || dst == nullptr || src == dst)
+			return;
+
+		auto itSrc = mVertexIds.find(src->objectId());
+		auto itDst = mVertexIds.find(dst->objectId());
+		if (itSrc == mVertexIds.end() || itDst == mVertexIds.end())
+			return;
+
+		uint u = itSrc->second;
+		uint v = itDst->second;
+
+		if (!mNodeGraph.addEdge(u, v))
+		{
+			mRejectedEdges[std::make_pair(u, v)]++;
+			mLevelRevision = IncrementalDAG::INVALID_ID;
+
+			Log::sendMessage(Log::Warning, "Connecting " + src->getName() + " to " + dst->getName() + " introduces a cycle into the scene graph, the connection is ignored in determining the execution order");
+		}
+	}
+
+	void SceneGraph::removeDependency(Node* src, Node* dst)
+	{
+		if (src == nullptr || dst == nullptr || src == dst)
+			return;
+
+		auto itSrc = mVertexIds.find(src->objectId());
+		auto itDst = mVertexIds.find(dst->objectId());
+		if (itSrc == mVertexIds.end() || itDst == mVertexIds.end())
+			return;
+
+		uint u = itSrc->second;
+		uint v = itDst->second;
+
+		auto itRejected = mRejectedEdges.find(std::make_pair(u, v));
+		if (itRejected != mRejectedEdges.end())
+		{
+			if (--itRejected->second == 0)
+				mRejectedEdges.erase(itRejected);
+
+			mLevelRevision = IncrementalDAG::INVALID_ID;
+
+			return;
+		}
+
+		if (mNodeGraph.removeEdge(u, v))
+			retryRejectedEdges();
+	}
+
+	void SceneGraph::retryRejectedEdges()
+	{
+		for (auto it = mRejectedEdges.begin(); it != mRejectedEdges.end();)
+		{
+			uint u = it->first.first;
+			uint v = it->first.second;
+
+			//A successful insertion bumps the graph revision, which in turn invalidates both cached orders
+			while (it->second > 0 && mNodeGraph.addEdge(u, v))
+				it->second--;
+
+			if (it->second == 0)
+				it = mRejectedEdges.erase(it);
+			else
+				++it;
+		}
 	}
 
 	void SceneGraph::traverseBackward(Action* act)
@@ -683,6 +931,29 @@ namespace dyno
 			mNodeMap.find(node->objectId()) == mNodeMap.end())
 			return;
 
+		auto itV = mVertexIds.find(node->objectId());
+		if (itV != mVertexIds.end())
+		{
+			uint v = itV->second;
+
+			for (auto it = mRejectedEdges.begin(); it != mRejectedEdges.end();)
+			{
+				if (it->first.first == v || it->first.second == v)
+				{
+					it = mRejectedEdges.erase(it);
+					mLevelRevision = IncrementalDAG::INVALID_ID;
+				}
+				else
+					++it;
+			}
+
+			mNodeGraph.removeVertex(v);
+			mVertexNodes[v] = nullptr;
+			mVertexIds.erase(itV);
+
+			retryRejectedEdges();
+		}
+
 		mNodeMap.erase(node->objectId());
 		mQueueUpdateRequired = true;
 	}
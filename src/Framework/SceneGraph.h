@@ -17,10 +17,13 @@
 #include "OBase.h"
 #include "Node.h"
 #include "NodeIterator.h"
+#include "IncrementalDAG.h"
 
 #include "Module/InputModule.h"
 
 #include <mutex>
+#include <set>
+#include <future>
 
 namespace dyno
 {
@@ -28,6 +31,8 @@ namespace dyno
 
 	typedef std::map<ObjectId, std::shared_ptr<Node>> NodeMap;
 
+	class Checkpoint;
+
 	class SceneGraph : public OBase
 	{
 	public:
@@ -93,10 +98,11 @@ namespace dyno
 				return nullptr;
 
 			mNodeMap[tNode->objectId()] = tNode;
-			mQueueUpdateRequired = true;
 
 			tNode->setSceneGraph(this);
 
+			registerNode(tNode.get());
+
 			return tNode;
 		}
 
@@ -111,6 +117,10 @@ namespace dyno
 		EWorkMode getWorkMode() { return mWorkMode; }
 
 	public:
+		/**
+		 * @brief A process-wide scene graph kept for compatibility.
+		 * 	Nodes and modules should query the scene graph they belong to with getSceneGraph(), so that several scenes can run in one process, see SceneGraphEnsemble.
+		 */
 		static SceneGraph& getInstance();
 
 		inline void setTotalTime(float t) { mMaxTime = t; }
@@ -124,9 +134,43 @@ namespace dyno
 		inline int getFrameNumber() { return mFrameNumber; }
 		inline void setFrameNumber(int n) { mFrameNumber = n; }
 
+		inline float getElapsedTime() { return mElapsedTime; }
+		inline void setElapsedTime(float t) { mElapsedTime = t; }
+
+		/**
+		 * @brief Save the state of all nodes into a binary checkpoint, see Checkpoint.
+		 * 	Only copying the state blocks the caller, compressing and writing the file run on the OutputQueue
+		 * 	once the outputs queued before are written.
+		 */
+		bool saveCheckpoint(const std::string& filename, bool compressed = false);
+
+		/**
+		 * @brief Restore the state from a checkpoint, the simulation continues from the frame the checkpoint was taken
+		 */
+		bool loadCheckpoint(const std::string& filename);
+
+		/**
+		 * @brief Save a checkpoint named <prefix><frame number>.ckpt every interval frames, 0 disables periodic checkpoints
+		 */
+		void setCheckpointInterval(uint interval, std::string prefix = "checkpoint_", bool compressed = true);
+		uint getCheckpointInterval() { return mCheckpointInterval; }
+
+		/**
+		 * @brief Block until all queued checkpoints are written, return whether they succeeded
+		 */
+		bool waitForCheckpoint();
+
 		bool isIntervalAdaptive();
 		void setAdaptiveInterval(bool adaptive);
 
+		/**
+		 * @brief Whether nodes without dependencies between each other are advanced concurrently on the thread pool.
+		 *		Nodes are grouped into levels according to the longest path from a source of the node graph,
+		 *		nodes within the same level are advanced in parallel, levels are processed in order.
+		 */
+		bool isConcurrentExecution();
+		void setConcurrentExecution(bool concurrent);
+
 		void setGravity(Vec3f g);
 		Vec3f getGravity();
 
@@ -150,6 +194,17 @@ namespace dyno
 		 */
 		void markQueueUpdateRequired();
 
+		/**
+		 * @brief Called when two nodes inside the scene graph are connected, either by a node port or by a field.
+		 *		The execution order is updated incrementally, a connection that closes a cycle is reported and ignored in ordering.
+		 */
+		void addDependency(Node* src, Node* dst);
+
+		/**
+		 * @brief Called when a connection between two nodes is removed
+		 */
+		void removeDependency(Node* src, Node* dst);
+
 	public:
 		void onMouseEvent(PMouseEvent event);
 
@@ -216,6 +271,26 @@ namespace dyno
 
 		void updateExecutionQueue();
 
+		/**
+		 * @brief Apply an action on all nodes level by level, nodes in the same level are processed concurrently
+		 */
+		void traverseForwardConcurrently(Action* act);
+
+	private:
+		void registerNode(Node* node);
+
+		/**
+		 * @brief Capture the state into a free checkpoint buffer and queue writing it, only waits for a free buffer if blocking is set
+		 */
+		bool writeCheckpoint(const std::string& filename, bool compressed, bool blocking);
+
+		void updateExecutionLevels();
+
+		/**
+		 * @brief Insert previously rejected connections again once removing an edge or a node has broken the cycle
+		 */
+		void retryRejectedEdges();
+
 	public:
 		SceneGraph()
 			: mElapsedTime(0)
@@ -260,6 +335,32 @@ namespace dyno
 
 		NodeList mNodeQueue;
 
+		//Dependencies between nodes, each node is assigned a dense vertex id
+		IncrementalDAG mNodeGraph;
+		std::map<ObjectId, uint> mVertexIds;
+		std::vector<Node*> mVertexNodes;
+
+		//Connections rejected by mNodeGraph since they would close a cycle
+		std::map<std::pair<uint, uint>, uint> mRejectedEdges;
+
+		uint mQueueRevision = IncrementalDAG::INVALID_ID;
+
+		//Nodes grouped by dependency levels, used for concurrent execution
+		std::vector<std::vector<Node*>> mNodeLevels;
+		std::set<Node*> mCyclicNodes;
+		uint mLevelRevision = IncrementalDAG::INVALID_ID;
+
+		bool mConcurrentExecution = false;
+
+		uint mCheckpointInterval = 0;
+		std::string mCheckpointPrefix;
+		bool mCheckpointCompression = true;
+
+		//Checkpoints are captured into two buffers in turn, so that capturing does not wait for the previous write
+		std::shared_ptr<Checkpoint> mCheckpoints[2];
+		std::future<bool> mCheckpointWriting[2];
+		uint mCheckpointBuffer = 0;
+
 		bool mNodeTiming = false;
 		bool mSimulationTiming = false;
 		bool mRenderingTiming = false;
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "SceneGraphEnsemble.h"
+
+#include "ThreadPool.h"
+
+namespace dyno
+{
+	SceneGraphEnsemble::SceneGraphEnsemble(uint num, SceneCreator creator)
+	{
+		for (uint i = 0; i < num; i++)
+		{
+			this->addScene(creator(i));
+		}
+	}
+
+	uint SceneGraphEnsemble::addScene(std::shared_ptr<SceneGraph> scn)
+	{
+		mScenes.push_back(scn);
+		return (uint)mScenes.size() - 1;
+	}
+
+	void SceneGraphEnsemble::reset()
+	{
+		TaskGroup group;
+		for (auto scn : mScenes)
+		{
+			group.run([scn]() { scn->reset(); });
+		}
+		group.wait();
+	}
+
+	void SceneGraphEnsemble::takeOneFrame()
+	{
+		this->run(1);
+	}
+
+	void SceneGraphEnsemble::run(uint frames)
+	{
+		if (frames == 0)
+			return;
+
+		TaskGroup group;
+
+		//One task per frame rather than per scene, a worker helping a nested task group therefore gets stuck in one frame at most
+		std::function<void(uint, uint)> step = [&](uint i, uint remaining) {
+			SceneGraph* scn = mScenes[i].get();
+			scn->takeOneFrame();
+
+			if (mFrameCallback)
+				mFrameCallback(i, scn);
+
+			if (remaining > 1)
+				group.run([&step, i, remaining]() { step(i, remaining - 1); });
+		};
+
+		for (uint i = 0; i < mScenes.size(); i++)
+		{
+			group.run([&step, i, frames]() { step(i, frames); });
+		}
+
+		group.wait();
+	}
+}
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "SceneGraph.h"
+
+#include <functional>
+
+namespace dyno
+{
+	/**
+	 * @brief A set of independent scene graphs that are advanced concurrently on the shared thread pool.
+	 *
+	 * Typical usage is a parameter sweep, where the same setup is created many times with a different parameter
+	 * 	and simulated within a single process. Each scene graph only depends on its own nodes, so scenes do not need to
+	 * 	be synchronized with each other, one task advances one scene by one frame.
+	 */
+	class SceneGraphEnsemble
+	{
+	public:
+		typedef std::function<std::shared_ptr<SceneGraph>(uint)> SceneCreator;
+		typedef std::function<void(uint, SceneGraph*)> FrameCallback;
+
+		SceneGraphEnsemble() {};
+
+		/**
+		 * @brief Create num scene graphs by calling creator(i) for i in [0, num)
+		 */
+		SceneGraphEnsemble(uint num, SceneCreator creator);
+
+		~SceneGraphEnsemble() {};
+
+		/**
+		 * @return the index of scn inside the ensemble
+		 */
+		uint addScene(std::shared_ptr<SceneGraph> scn);
+
+		std::shared_ptr<SceneGraph> getScene(uint i) { return mScenes[i]; }
+
+		uint size() const { return (uint)mScenes.size(); }
+
+		/**
+		 * @brief Reset all scene graphs concurrently
+		 */
+		void reset();
+
+		/**
+		 * @brief Advance all scene graphs by one frame and wait for all of them
+		 */
+		void takeOneFrame();
+
+		/**
+		 * @brief Advance each scene graph by the given number of frames.
+		 * 	Scene graphs do not wait for each other between frames, so cheap scenes do not idle while expensive ones are running.
+		 */
+		void run(uint frames);
+
+		/**
+		 * @brief Set a function called after each frame with the index of the scene graph, e.g., to collect results.
+		 * 	It is called from worker threads, concurrently for different scene graphs.
+		 */
+		void setFrameCallback(FrameCallback callback) { mFrameCallback = callback; }
+
+	private:
+		std::vector<std::shared_ptr<SceneGraph>> mScenes;
+
+		FrameCallback mFrameCallback;
+	};
+}
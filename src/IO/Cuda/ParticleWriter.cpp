@@ -39,51 +39,89 @@ namespace dyno
 
 	template<typename TDataType>
 	void ParticleWriter<TDataType>::OutputASCII(std::string filename)
+	{
+		mPosition.assign(this->inPointSet()->getDataPtr()->getPoints());
+
+		writeASCII(filename, mPosition);
+	}
+
+	template<typename TDataType>
+	void ParticleWriter<TDataType>::OutputBinary(std::string filename)
+	{
+		mPosition.assign(this->inPointSet()->getDataPtr()->getPoints());
+
+		writeBinary(filename, mPosition);
+	}
+
+	template<typename TDataType>
+	void ParticleWriter<TDataType>::writeASCII(std::string filename, const HostArray<Coord>& points)
 	{
 		std::fstream output;
 		output.open(filename.c_str(), std::ios::out);
-		auto& points = this->inPointSet()->getDataPtr()->getPoints();
+
 		int ptNum = points.size();
 
 		output << ptNum << ' ';
 
-		CArray<Coord> hPosition;
-		hPosition.resize(ptNum);
-
-		hPosition.assign(points);
-
 		for (int i = 0; i < ptNum; i++) 
 		{
-			output << hPosition[i][0] << ' ' << hPosition[i][1] << ' ' << hPosition[i][2] << ' ';
+			output << points[i][0] << ' ' << points[i][1] << ' ' << points[i][2] << ' ';
 		}
 		output.close();
 	}
 
 	template<typename TDataType>
-	void ParticleWriter<TDataType>::OutputBinary(std::string filename)
+	void ParticleWriter<TDataType>::writeBinary(std::string filename, const HostArray<Coord>& points)
 	{
 		std::fstream output;
 		output.open(filename.c_str(), std::ios::out | std::ios::binary);
 
-		auto& points = this->inPointSet()->getDataPtr()->getPoints();
 		int ptNum = points.size();
 
 		output.write((char*)&ptNum, sizeof(int));
 
-		CArray<Coord> hPosition;
-		hPosition.resize(ptNum);
-		hPosition.assign(points);
-
 		for (int i = 0; i < ptNum; i++) 
 		{
-			output.write((char*)&(hPosition[i][0]), sizeof(Real));
-			output.write((char*)&(hPosition[i][1]), sizeof(Real));
-			output.write((char*)&(hPosition[i][2]), sizeof(Real));
+			output.write((char*)&(points[i][0]), sizeof(Real));
+			output.write((char*)&(points[i][1]), sizeof(Real));
+			output.write((char*)&(points[i][2]), sizeof(Real));
+		}
+	}
+
+	template<typename TDataType>
+	class ParticleSnapshot : public OutputSnapshot
+	{
+	public:
+		typedef typename TDataType::Coord Coord;
+		typedef void (*Writer)(std::string, const HostArray<Coord>&);
+
+		void write(const std::string& filename) override
+		{
+			writer(filename + std::string(".txt"), points);
 		}
 
+		HostArray<Coord> points;
+		Writer writer = nullptr;
+	};
+
+	template<typename TDataType>
+	std::shared_ptr<OutputSnapshot> ParticleWriter<TDataType>::createSnapshot()
+	{
+		return std::make_shared<ParticleSnapshot<TDataType>>();
 	}
 
+	template<typename TDataType>
+	bool ParticleWriter<TDataType>::takeSnapshot(OutputSnapshot* snapshot)
+	{
+		if (this->inPointSet()->isEmpty())
+			return false;
+
+		auto ps = static_cast<ParticleSnapshot<TDataType>*>(snapshot);
+		ps->points.assign(this->inPointSet()->getDataPtr()->getPoints());
+		ps->writer = this->varFileType()->getValue() == OpenType::binary ? &writeBinary : &writeASCII;
 
+		return true;
+	}
 
 	DEFINE_CLASS(ParticleWriter);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Module/OutputModule.h"
 #include "Module/TopologyModule.h"
 #include "Topology/PointSet.h"
+#include "Array/HostArray.h"
 #include <string>
 
 namespace dyno
@@ -28,6 +29,8 @@ namespace dyno
 
 		void output()override;
 	protected:
+		std::shared_ptr<OutputSnapshot> createSnapshot() override;
+		bool takeSnapshot(OutputSnapshot* snapshot) override;
 
 	public:
 
@@ -35,5 +38,10 @@ namespace dyno
 		DEF_ENUM(OpenType, FileType, ASCII, "FileType");
 
 	private:
+		static void writeASCII(std::string filename, const HostArray<Coord>& points);
+		static void writeBinary(std::string filename, const HostArray<Coord>& points);
+
+		//Staging buffer of the synchronous path, kept across frames so that its capacity is reused
+		HostArray<Coord> mPosition;
 	};
 }
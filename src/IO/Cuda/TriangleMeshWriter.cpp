@@ -42,22 +42,10 @@ namespace dyno
 	template<typename TDataType>
 	void TriangleMeshWriter<TDataType>::outputSurfaceMesh(std::shared_ptr<TriangleSet<TDataType>> triangleset)
 	{
-		std::string filename = this->constructFileName() + this->file_postfix;;
-		std::ofstream output(filename.c_str(), std::ios::out);
-
-		std::cout << filename << std::endl;
-
-		if (!output.is_open()) {
-			printf("------Triangle Mesh Writer: open file failed \n");
-			return;
-		}
-
-		std::cout << "------Triangle Mesh Writer Action!------ " << std::endl;
-
-
-		CArray<Coord> host_vertices;
-		CArray<TopologyModule::Triangle> host_triangles;
+		std::string filename = this->constructFileName() + this->file_postfix;
 
+		HostArray<Coord> host_vertices;
+		HostArray<Triangle> host_triangles;
 
 		if (triangleset->getPoints().size())
 		{
@@ -68,59 +56,93 @@ namespace dyno
 			host_triangles.assign(triangleset->getTriangles());
 		}
 
+		writeOBJ(filename, host_vertices, host_triangles);
+	}
 
-		for (uint i = 0; i < host_vertices.size(); ++i) {
-			output << "v " << host_vertices[i][0] << " " << host_vertices[i][1] << " " << host_vertices[i][2] << std::endl;
-		}
-		for (uint i = 0; i < host_triangles.size(); ++i) {
-			output << "f " << host_triangles[i][0] + 1 << " " << host_triangles[i][1] + 1 << " " << host_triangles[i][2] + 1 << std::endl;
-		}
-		output.close();
-
+	template<typename TDataType>
+	void TriangleMeshWriter<TDataType>::outputPointCloud(std::shared_ptr<PointSet<TDataType>> pointset)
+	{
+		std::string filename = this->constructFileName() + this->file_postfix;
 
-		host_vertices.clear();
-		host_triangles.clear();
+		HostArray<Coord> host_vertices;
 
+		if (pointset->getPoints().size())
+		{
+			host_vertices.assign(pointset->getPoints());
+		}
 
-		return;
+		writeOBJ(filename, host_vertices, HostArray<Triangle>());
 	}
 
 	template<typename TDataType>
-	void TriangleMeshWriter<TDataType>::outputPointCloud(std::shared_ptr<PointSet<TDataType>> pointset)
+	bool TriangleMeshWriter<TDataType>::writeOBJ(std::string filename, const HostArray<Coord>& vertices, const HostArray<Triangle>& triangles)
 	{
-		std::string filename = this->constructFileName() + this->file_postfix;// 
 		std::ofstream output(filename.c_str(), std::ios::out);
 
 		std::cout << filename << std::endl;
 
 		if (!output.is_open()) {
 			printf("------Triangle Mesh Writer: open file failed \n");
-			return;
+			return false;
+		}
+
+		for (uint i = 0; i < vertices.size(); ++i) {
+			output << "v " << vertices[i][0] << " " << vertices[i][1] << " " << vertices[i][2] << std::endl;
+		}
+		for (uint i = 0; i < triangles.size(); ++i) {
+			output << "f " << triangles[i][0] + 1 << " " << triangles[i][1] + 1 << " " << triangles[i][2] + 1 << std::endl;
 		}
+		output.close();
 
-		std::cout << "------Pointcloud Writer Action!------ " << std::endl;
+		return true;
+	}
 
-		CArray<Coord> host_vertices;
+	template<typename TDataType>
+	class TriangleMeshSnapshot : public OutputSnapshot
+	{
+	public:
+		typedef typename TDataType::Coord Coord;
+		typedef typename TopologyModule::Triangle Triangle;
+		typedef bool (*Writer)(std::string, const HostArray<Coord>&, const HostArray<Triangle>&);
 
-		if (pointset->getPoints().size())
+		void write(const std::string& filename) override
 		{
-			host_vertices.assign(pointset->getPoints());
+			writer(filename + postfix, vertices, triangles);
 		}
 
-		for (uint i = 0; i < host_vertices.size(); ++i) {
-			output << "v " << host_vertices[i][0] << " " << host_vertices[i][1] << " " << host_vertices[i][2] << std::endl;
-		}
+		HostArray<Coord> vertices;
+		HostArray<Triangle> triangles;
 
-		output.close();
+		std::string postfix;
+		Writer writer = nullptr;
+	};
 
-		host_vertices.clear();
+	template<typename TDataType>
+	std::shared_ptr<OutputSnapshot> TriangleMeshWriter<TDataType>::createSnapshot()
+	{
+		return std::make_shared<TriangleMeshSnapshot<TDataType>>();
+	}
 
+	template<typename TDataType>
+	bool TriangleMeshWriter<TDataType>::takeSnapshot(OutputSnapshot* snapshot)
+	{
+		auto ps = TypeInfo::cast<PointSet<TDataType>>(this->inTopology()->getDataPtr());
+		if (ps == nullptr)
+			return false;
 
-		return;
-	}
+		auto ts = static_cast<TriangleMeshSnapshot<TDataType>*>(snapshot);
+		ts->vertices.assign(ps->getPoints());
+		ts->triangles.resize(0);
 
+		auto triSet = TypeInfo::cast<TriangleSet<TDataType>>(ps);
+		if (this->varOutputType()->getValue() == OutputType::TriangleMesh && triSet != nullptr)
+			ts->triangles.assign(triSet->getTriangles());
 
+		ts->postfix = this->file_postfix;
+		ts->writer = &writeOBJ;
 
+		return true;
+	}
 
 	DEFINE_CLASS(TriangleMeshWriter);
 }
\ No newline at end of file
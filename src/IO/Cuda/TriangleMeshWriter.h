@@ -8,6 +8,7 @@ the output file format: obj
 #include "Module/TopologyModule.h"
 
 #include "Topology/TriangleSet.h"
+#include "Array/HostArray.h"
 
 #include <string>
 #include <memory>
@@ -37,6 +38,10 @@ namespace dyno
 
 		void output()override;
 
+	protected:
+		std::shared_ptr<OutputSnapshot> createSnapshot() override;
+		bool takeSnapshot(OutputSnapshot* snapshot) override;
+
 
 	public:
 
@@ -53,5 +58,8 @@ namespace dyno
 		int count = -1;
 		bool skipFrame = false;
 
+	private:
+		static bool writeOBJ(std::string filename, const HostArray<Coord>& vertices, const HostArray<Triangle>& triangles);
+
 	};
 }
\ No newline at end of file
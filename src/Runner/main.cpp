@@ -0,0 +1,383 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+ * peridyno-run: load a scene file and simulate it without any render engine.
+ *
+ * The report is written as JSON lines, one object per line with a "type" of "run", "plugin", "frame", "node" or "summary",
+ * so that it can be consumed directly by batch and regression tracking scripts.
+ */
+#include "SceneGraph.h"
+#include "SceneLoaderFactory.h"
+#include "Module/OutputModule.h"
+#include "Module/OutputQueue.h"
+#include "Plugin/PluginManager.h"
+
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+#include "Array/Allocator.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace dyno;
+
+struct RunnerOptions
+{
+	std::string scene;
+	std::string output = ".";
+	std::string report;
+	std::string restart;
+
+	std::vector<std::string> plugins;
+
+	uint firstFrame = 0;
+	uint lastFrame = 100;
+
+	uint threads = 0;
+
+	bool profile = false;
+
+	bool eagerPlugins = false;
+};
+
+static void printUsage()
+{
+	std::cerr
+		<< "Usage: peridyno-run <scene file> [options]" << std::endl
+		<< "  --frames <n>|<first>:<last>  Frames to simulate, frames before <first> are a warm-up and not reported (default 100)" << std::endl
+		<< "  --threads <n>                Number of host threads, 0 uses all hardware threads (default 0)" << std::endl
+		<< "  --output <dir>               Directory for the files of output modules and the profiler trace (default .)" << std::endl
+		<< "  --report <file>              Write the report into a file instead of the standard output" << std::endl
+		<< "  --plugin <path>              Load a plugin library, or all plugins inside a directory, may be repeated" << std::endl
+		<< "  --restart <file>             Continue from a checkpoint, see SceneGraph::saveCheckpoint()" << std::endl
+		<< "  --profile                    Report the time spent in each node and write a Chrome trace" << std::endl
+		<< "  --eager-plugins              Load all plugins at startup instead of only those the scene uses" << std::endl;
+}
+
+static bool parseArguments(int argc, char** argv, RunnerOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--frames" && hasValue)
+		{
+			std::string range = argv[++i];
+			size_t colon = range.find(':');
+			if (colon == std::string::npos) {
+				options.firstFrame = 0;
+				options.lastFrame = std::atoi(range.c_str());
+			}
+			else {
+				options.firstFrame = std::atoi(range.substr(0, colon).c_str());
+				options.lastFrame = std::atoi(range.substr(colon + 1).c_str());
+			}
+		}
+		else if (arg == "--threads" && hasValue)
+			options.threads = std::atoi(argv[++i]);
+		else if (arg == "--output" && hasValue)
+			options.output = argv[++i];
+		else if (arg == "--report" && hasValue)
+			options.report = argv[++i];
+		else if (arg == "--plugin" && hasValue)
+			options.plugins.push_back(argv[++i]);
+		else if (arg == "--restart" && hasValue)
+			options.restart = argv[++i];
+		else if (arg == "--profile")
+			options.profile = true;
+		else if (arg == "--eager-plugins")
+			options.eagerPlugins = true;
+		else if (arg.size() > 0 && arg[0] != '-' && options.scene.empty())
+			options.scene = arg;
+		else
+			return false;
+	}
+
+	return !options.scene.empty() && options.firstFrame <= options.lastFrame;
+}
+
+static std::string escape(const std::string& str)
+{
+	std::string ret;
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+			ret += '\\';
+
+		if ((unsigned char)c < 0x20)
+			ret += ' ';
+		else
+			ret += c;
+	}
+	return ret;
+}
+
+/**
+ * Peak resident memory of the process in bytes
+ */
+static size_t peakHostMemory()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize;
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return size_t(usage.ru_maxrss);
+#else
+	return size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/**
+ * Particles are counted as the elements of the Position states of all nodes
+ */
+static size_t countParticles(std::shared_ptr<SceneGraph> scn)
+{
+	size_t num = 0;
+	for (auto it = scn->begin(); it != scn->end(); it++)
+	{
+		FBase* field = it->getField("Position");
+		if (field != nullptr && field->getFieldType() == FieldTypeEnum::State)
+			num += field->size();
+	}
+	return num;
+}
+
+int main(int argc, char** argv)
+{
+	RunnerOptions options;
+	if (!parseArguments(argc, argv, options))
+	{
+		printUsage();
+		return 1;
+	}
+
+	//Keep the standard output for the report, messages printed by the simulation go to the standard error
+	std::streambuf* stdoutBuffer = std::cout.rdbuf();
+	std::ofstream reportFile;
+	if (!options.report.empty())
+	{
+		reportFile.open(options.report.c_str(), std::ios::out);
+		if (!reportFile.is_open())
+		{
+			std::cerr << "Failed to open " << options.report << std::endl;
+			return 1;
+		}
+	}
+	std::ostream report(options.report.empty() ? stdoutBuffer : reportFile.rdbuf());
+	std::cout.rdbuf(std::cerr.rdbuf());
+
+	ThreadPool::instance()->setThreadNumber(options.threads);
+
+	//Plugins with a manifest are only loaded once the scene creates one of their classes
+	bool lazy = !options.eagerPlugins;
+
+	CTimer startup;
+	startup.start();
+
+#ifdef NDEBUG
+	PluginManager::instance()->loadPluginByPath(getPluginPath() + "Release", lazy);
+#else
+	PluginManager::instance()->loadPluginByPath(getPluginPath() + "Debug", lazy);
+#endif
+	for (auto& plugin : options.plugins)
+	{
+		if (fs::is_directory(plugin))
+			PluginManager::instance()->loadPluginByPath(plugin, lazy);
+		else if (lazy)
+			PluginManager::instance()->registerPlugin(plugin);
+		else
+			PluginManager::instance()->loadPlugin(plugin);
+	}
+
+	startup.stop();
+	double pluginTime = startup.getElapsedTime();
+
+	startup.start();
+
+	SceneLoader* loader = SceneLoaderFactory::getInstance().getEntryByFileName(options.scene);
+	std::shared_ptr<SceneGraph> scn = loader != nullptr ? loader->load(options.scene) : nullptr;
+	if (scn == nullptr)
+	{
+		std::cerr << "Failed to load " << options.scene << std::endl;
+		std::cout.rdbuf(stdoutBuffer);
+		return 1;
+	}
+
+	//Redirect all output modules
+	std::error_code error;
+	fs::create_directories(options.output, error);
+	for (auto it = scn->begin(); it != scn->end(); it++)
+	{
+		for (auto& m : it->getModuleList())
+		{
+			auto output = std::dynamic_pointer_cast<OutputModule>(m);
+			if (output != nullptr)
+			{
+				FilePath path(options.output);
+				path.set_as_path(true);
+				output->varOutputPath()->setValue(path);
+			}
+		}
+	}
+
+	scn->reset();
+
+	startup.stop();
+	double sceneTime = startup.getElapsedTime();
+
+	if (!options.restart.empty() && !scn->loadCheckpoint(options.restart))
+	{
+		std::cerr << "Failed to restart from " << options.restart << std::endl;
+		std::cout.rdbuf(stdoutBuffer);
+		return 1;
+	}
+
+	uint numNodes = 0;
+	std::map<ObjectId, std::string> nodeNames;
+	for (auto it = scn->begin(); it != scn->end(); it++)
+	{
+		nodeNames[it->objectId()] = it->getName();
+		numNodes++;
+	}
+
+	report << "{\"type\":\"run\",\"scene\":\"" << escape(options.scene) << "\""
+		<< ",\"first_frame\":" << options.firstFrame
+		<< ",\"last_frame\":" << options.lastFrame
+		<< ",\"start_frame\":" << scn->getFrameNumber()
+		<< ",\"threads\":" << ThreadPool::instance()->threadNumber()
+		<< ",\"nodes\":" << numNodes
+		<< ",\"plugin_ms\":" << pluginTime
+		<< ",\"scene_ms\":" << sceneTime << "}" << std::endl;
+
+	//Plugins loaded lazily are accounted to scene_ms
+	for (auto& p : PluginManager::instance()->statistics())
+	{
+		report << "{\"type\":\"plugin\",\"file\":\"" << escape(fs::path(p.file).filename().string()) << "\""
+			<< ",\"loaded\":" << (p.loaded ? "true" : "false")
+			<< ",\"deferred\":" << (p.deferred ? "true" : "false")
+			<< ",\"classes\":" << p.classes
+			<< ",\"load_ms\":" << p.loadTime
+			<< ",\"manifest_ms\":" << p.manifestTime << "}" << std::endl;
+	}
+
+	double totalTime = 0.0;
+	size_t totalParticles = 0;
+	uint numFrames = 0;
+
+	CTimer timer;
+	while (scn->getFrameNumber() < options.lastFrame)
+	{
+		uint frame = scn->getFrameNumber();
+		bool reported = frame >= options.firstFrame;
+
+		//Warm-up frames are not profiled
+		Profiler::setEnabled(options.profile && reported);
+
+		timer.start();
+		scn->takeOneFrame();
+		timer.stop();
+
+		if (!reported)
+			continue;
+
+		double ms = timer.getElapsedTime();
+		size_t particles = countParticles(scn);
+
+		totalTime += ms;
+		totalParticles += particles;
+		numFrames++;
+
+		report << "{\"type\":\"frame\",\"frame\":" << frame
+			<< ",\"wall_ms\":" << ms
+			<< ",\"sim_time\":" << scn->getElapsedTime()
+			<< ",\"particles\":" << particles
+			<< ",\"particles_per_second\":" << (ms > 0.0 ? particles * 1000.0 / ms : 0.0)
+			<< "}" << std::endl;
+	}
+
+	Profiler::setEnabled(false);
+
+	//Files written in the background must be complete before reporting
+	timer.start();
+	OutputQueue::instance()->flush();
+	scn->waitForCheckpoint();
+	timer.stop();
+
+	double flushTime = timer.getElapsedTime();
+
+	if (options.profile)
+	{
+		for (auto& s : Profiler::instance()->statistics(true))
+		{
+			if (s.category != ProfileCategory::Node)
+				continue;
+
+			report << "{\"type\":\"node\",\"node\":\"" << escape(nodeNames[ObjectId(s.instance)]) << "\""
+				<< ",\"class\":\"" << escape(s.name) << "\""
+				<< ",\"id\":" << s.instance
+				<< ",\"count\":" << s.count
+				<< ",\"total_ms\":" << s.total
+				<< ",\"mean_ms\":" << s.mean
+				<< ",\"p50_ms\":" << s.p50
+				<< ",\"p99_ms\":" << s.p99
+				<< ",\"max_ms\":" << s.max
+				<< "}" << std::endl;
+		}
+
+		std::string trace = (fs::path(options.output) / "peridyno-run.trace.json").string();
+		if (!Profiler::instance()->exportChromeTrace(trace))
+			std::cerr << "Failed to write " << trace << std::endl;
+	}
+
+	AllocatorStatistics device = Allocator::device()->statistics();
+
+	report << "{\"type\":\"summary\",\"frames\":" << numFrames
+		<< ",\"wall_ms\":" << totalTime
+		<< ",\"mean_frame_ms\":" << (numFrames > 0 ? totalTime / numFrames : 0.0)
+		<< ",\"frames_per_second\":" << (totalTime > 0.0 ? numFrames * 1000.0 / totalTime : 0.0)
+		<< ",\"particles_per_second\":" << (totalTime > 0.0 ? totalParticles * 1000.0 / totalTime : 0.0)
+		<< ",\"output_flush_ms\":" << flushTime
+		<< ",\"peak_host_bytes\":" << peakHostMemory()
+		<< ",\"peak_device_bytes\":" << device.bytesPeak
+		<< "}" << std::endl;
+
+	std::cout.rdbuf(stdoutBuffer);
+
+	//Arrays of the scene go back to the pool, hand the pool back to the device while it is still alive
+	scn = nullptr;
+	Allocator::releaseAllCached();
+
+	return 0;
+}
@@ -5,7 +5,8 @@
 
 #include "Timer.h"
 
-#include <thrust/sort.h>
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
 
 namespace dyno
 {
@@ -438,8 +439,10 @@ namespace dyno
 			this->varSelfCollision()->getValue()
 		);
 
-		int total_node_num = thrust::reduce(thrust::device, mCounter.begin(), mCounter.begin() + mCounter.size(), (int)0, thrust::plus<int>());
-		thrust::exclusive_scan(thrust::device, mCounter.begin(), mCounter.begin() + mCounter.size(), mCounter.begin());
+		Reduction<uint> reduce;
+		int total_node_num = reduce.accumulate(mCounter.begin(), mCounter.size());
+		Scan<uint> scan;
+		scan.exclusive(mCounter.begin(), mCounter.size());
 
 		mIds.resize(total_node_num);
 		/*
@@ -472,7 +475,7 @@ namespace dyno
 			mIds,
 			mCounter);
 
-		thrust::sort(thrust::device, mKeys.begin(), mKeys.begin() + mKeys.size());
+		mSort.sort(mKeys);
 
 		mNewCounter.resize(mCounter.size());
 		cuExecute(aabb_src.size(),
@@ -2,6 +2,7 @@
 #include "Module/ComputeModule.h"
 
 #include "Algorithm/Reduction.h"
+#include "Algorithm/Sort.h"
 #include "Primitive/Primitive3D.h"
 
 #include "Topology/LinearBVH.h"
@@ -62,6 +63,8 @@ namespace dyno
 		DArray<int> mIds;
 		DArray<PKey> mKeys;
 
+		Sort<PKey> mSort;
+
 		LinearBVH<TDataType> bvh;
 	};
 
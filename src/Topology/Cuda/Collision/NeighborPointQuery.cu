@@ -637,21 +637,16 @@ namespace dyno
 			h,
 			octree);
 
+		//The row offsets of lists are the scanned counts
 		DArrayList<int> lists;
 		lists.resize(counter);
 
-		Reduction<uint> reduce;
-		uint total_num = reduce.accumulate(counter.begin(), counter.size());
-
-		Scan<uint> scan;
-		scan.exclusive(counter.begin(), counter.size());
-
-		DArray<int> ids(total_num);
+		DArray<int> ids(lists.elementSize());
 		cuExecute(numSrc,
 			CDBP_RequestIntersectionIds,
 			lists,
 			ids,
-			counter,
+			lists.index(),
 			points,
 			h,
 			octree);
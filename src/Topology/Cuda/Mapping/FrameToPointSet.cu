@@ -51,7 +51,7 @@ namespace dyno
 	}
 
 
-	template <typename Coord, typename Rigid, typename Matrix>
+	template <typename Coord, typename Matrix>
 	__global__ void ApplyRigidTranform(
 		DArray<Coord> points,
 		Coord curCenter,
@@ -74,9 +74,14 @@ namespace dyno
 			std::cout << "The array sizes does not match for RigidToPoints" << std::endl;
 		}
 
-		uint pDims = cudaGridSize(points.size(), BLOCK_SIZE);
-
-		ApplyRigidTranform<Coord, Rigid, Matrix><< <pDims, BLOCK_SIZE >> >(points, rigid.getCenter(), rigid.getRotationMatrix(), m_refPoints, m_refRigid.getCenter(), m_refRigid.getRotationMatrix());
+		cuExecute(points.size(),
+			ApplyRigidTranform,
+			points,
+			rigid.getCenter(),
+			rigid.getRotationMatrix(),
+			m_refPoints,
+			m_refRigid.getCenter(),
+			m_refRigid.getRotationMatrix());
 	}
 
 	template<typename TDataType>
@@ -84,9 +89,8 @@ namespace dyno
 	{
 		DArray<Coord>& m_coords = m_initTo->getPoints();
 
-		uint pDims = cudaGridSize(m_coords.size(), BLOCK_SIZE);
-
-		ApplyRigidTranform<Coord, Rigid, Matrix> << <pDims, BLOCK_SIZE >> >(
+		cuExecute(m_coords.size(),
+			ApplyRigidTranform,
 			m_to->getPoints(),
 			m_from->getCenter(), 
 			m_from->getOrientation(),
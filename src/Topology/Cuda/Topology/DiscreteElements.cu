@@ -1,4 +1,5 @@
 #include "DiscreteElements.h"
+#include "BinaryStream.h"
 
 namespace dyno
 {
@@ -17,6 +18,47 @@ namespace dyno
 // 		m_hostSpheres.clear();
 	}
 
+	template<typename TDataType>
+	bool DiscreteElements<TDataType>::writeBinary(BinaryWriter& writer)
+	{
+		writer.write(m_spheres);
+		writer.write(m_boxes);
+		writer.write(m_tets);
+		writer.write(m_caps);
+		writer.write(m_tris);
+		writer.write(mBallAndSocketJoints);
+		writer.write(mSliderJoints);
+		writer.write(mHingeJoints);
+		writer.write(mFixedJoints);
+		writer.write(mPointJoints);
+		writer.write(m_tet_sdf);
+		writer.write(m_tet_body_mapping);
+		writer.write(m_tet_element_id);
+
+		return true;
+	}
+
+	template<typename TDataType>
+	bool DiscreteElements<TDataType>::readBinary(BinaryReader& reader)
+	{
+		bool success = reader.read(m_spheres)
+			&& reader.read(m_boxes)
+			&& reader.read(m_tets)
+			&& reader.read(m_caps)
+			&& reader.read(m_tris)
+			&& reader.read(mBallAndSocketJoints)
+			&& reader.read(mSliderJoints)
+			&& reader.read(mHingeJoints)
+			&& reader.read(mFixedJoints)
+			&& reader.read(mPointJoints)
+			&& reader.read(m_tet_sdf)
+			&& reader.read(m_tet_body_mapping)
+			&& reader.read(m_tet_element_id);
+
+		this->tagAsChanged();
+		return success;
+	}
+
 	template<typename TDataType>
 	void DiscreteElements<TDataType>::scale(Real s)
 	{
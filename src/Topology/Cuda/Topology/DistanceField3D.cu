@@ -197,6 +197,7 @@ namespace dyno{
 		m_h = (p1 - p0)*Coord(1.0 / Real(nbx+1), 1.0 / Real(nby+1), 1.0 / Real(nbz+1));
 
 		m_distance.resize(nbx+1, nby+1, nbz+1);
+		this->updateLayout();
 	}
 
 	template<typename TDataType>
@@ -232,10 +233,12 @@ namespace dyno{
 		m_h[1] *= s;
 		m_h[2] *= s;
 
-		dim3 blockSize = make_uint3(8, 8, 8);
-		dim3 gridDims = cudaGridSize3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()), blockSize);
+		cuExecute3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()),
+			K_Scale,
+			m_distance,
+			s);
 
-		K_Scale << <gridDims, blockSize >> >(m_distance, s);
+		this->updateLayout();
 	}
 
 	template<typename Real>
@@ -255,10 +258,11 @@ namespace dyno{
 	template<typename TDataType>
 	void DistanceField3D<TDataType>::invertSDF()
 	{
-		dim3 blockSize = make_uint3(8, 8, 8);
-		dim3 gridDims = cudaGridSize3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()), blockSize);
+		cuExecute3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()),
+			K_Invert,
+			m_distance);
 
-		K_Invert << <gridDims, blockSize >> >(m_distance);
+		this->updateLayout();
 	}
 
 	template <typename Real, typename Coord>
@@ -283,10 +287,16 @@ namespace dyno{
 	{
 		m_bInverted = inverted;
 
-		dim3 blockSize = make_uint3(4, 4, 4);
-		dim3 gridDims = cudaGridSize3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()), blockSize);
+		cuExecute3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()),
+			K_DistanceFieldToBox,
+			m_distance,
+			m_left,
+			m_h,
+			lo,
+			hi,
+			inverted);
 
-		K_DistanceFieldToBox << <gridDims, blockSize >> >(m_distance, m_left, m_h, lo, hi, inverted);
+		this->updateLayout();
 	}
 
 	template <typename Real, typename Coord>
@@ -312,10 +322,18 @@ namespace dyno{
 	{
 		m_bInverted = inverted;
 
-		dim3 blockSize = make_uint3(8, 8, 8);
-		dim3 gridDims = cudaGridSize3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()), blockSize);
-
-		K_DistanceFieldToCylinder << <gridDims, blockSize >> >(m_distance, m_left, m_h, center, radius, height, axis, inverted);
+		cuExecute3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()),
+			K_DistanceFieldToCylinder,
+			m_distance,
+			m_left,
+			m_h,
+			center,
+			radius,
+			height,
+			axis,
+			inverted);
+
+		this->updateLayout();
 	}
 
 	template <typename Real, typename Coord>
@@ -343,10 +361,16 @@ namespace dyno{
 	{
 		m_bInverted = inverted;
 
-		dim3 blockSize = make_uint3(8, 8, 8);
-		dim3 gridDims = cudaGridSize3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()), blockSize);
+		cuExecute3D(make_uint3(m_distance.nx(), m_distance.ny(), m_distance.nz()),
+			K_DistanceFieldToSphere,
+			m_distance,
+			m_left,
+			m_h,
+			center,
+			radius,
+			inverted);
 
-		K_DistanceFieldToSphere << <gridDims, blockSize >> >(m_distance, m_left, m_h, center, radius, inverted);
+		this->updateLayout();
 	}
 
 	template<typename TDataType>
@@ -404,6 +428,10 @@ namespace dyno{
 		{
 			invertSDF();
 		}
+		else
+		{
+			this->updateLayout();
+		}
 
 		std::cout << "read data successful" << std::endl;
 	}
@@ -412,6 +440,23 @@ namespace dyno{
 	void DistanceField3D<TDataType>::release()
 	{
 		m_distance.clear();
+		m_tiled.clear();
+	}
+
+	template<typename TDataType>
+	void DistanceField3D<TDataType>::setTiledLayout(bool tiled)
+	{
+		m_bTiled = tiled;
+		this->updateLayout();
+	}
+
+	template<typename TDataType>
+	void DistanceField3D<TDataType>::updateLayout()
+	{
+		if (m_bTiled)
+			m_tiled.assign(m_distance);
+		else
+			m_tiled.clear();
 	}
 
 	template class DistanceField3D<DataType3f>;
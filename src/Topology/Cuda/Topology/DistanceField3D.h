@@ -13,6 +13,7 @@
 #include <string>
 #include "Platform.h"
 #include "Array/Array3D.h"
+#include "Array/ArrayTiled.h"
 
 namespace dyno {
 
@@ -92,15 +93,31 @@ namespace dyno {
 			m_left = sdf.m_left;
 			m_h = sdf.m_h;
 			m_bInverted = sdf.m_bInverted;
+			m_bTiled = sdf.m_bTiled;
 			m_distance.assign(sdf.m_distance);
+			this->updateLayout();
 		}
 
 		DArray3D<Real>& getMDistance() { return m_distance; }
 
 		void setDistance(CArray3D<Real> distance) {
 			m_distance.assign(distance);
+			this->updateLayout();
 		}
 
+		/**
+		 * @brief Let getDistance() sample a tiled copy of the grid, which keeps the 8 cells of a lookup close in memory.
+		 * 	It pays off for large fields at the cost of a second copy of the grid.
+		 */
+		void setTiledLayout(bool tiled);
+
+		bool isTiledLayout() { return m_bTiled; }
+
+		/**
+		 * @brief Refresh the tiled copy, call it after modifying the grid returned by getMDistance()
+		 */
+		void updateLayout();
+
 		Coord getH() { return m_h; }
 
 		/**
@@ -114,6 +131,10 @@ namespace dyno {
 			return (1.0f - alpha)*a + alpha *b;
 		}
 
+		GPU_FUNC inline Real sample(const int i, const int j, const int k) const {
+			return m_bTiled ? m_tiled(i, j, k) : m_distance(i, j, k);
+		}
+
 		/**
 		 * @brief Lower left corner
 		 * 
@@ -133,6 +154,13 @@ namespace dyno {
 		 * 
 		 */
 		DArray3D<Real> m_distance;
+
+		/**
+		 * @brief A copy of m_distance in the tiled layout, only allocated if m_bTiled is true
+		 *
+		 */
+		bool m_bTiled = false;
+		DArrayTiled3D<Real> m_tiled;
 	};
 
 	template<typename TDataType>
@@ -156,14 +184,14 @@ namespace dyno {
 		Real beta = alphav[1];
 		Real gamma = alphav[2];
 
-		Real d000 = m_distance(i, j, k);
-		Real d100 = m_distance(i + 1, j, k);
-		Real d010 = m_distance(i, j + 1, k);
-		Real d110 = m_distance(i + 1, j + 1, k);
-		Real d001 = m_distance(i, j, k + 1);
-		Real d101 = m_distance(i + 1, j, k + 1);
-		Real d011 = m_distance(i, j + 1, k + 1);
-		Real d111 = m_distance(i + 1, j + 1, k + 1);
+		Real d000 = this->sample(i, j, k);
+		Real d100 = this->sample(i + 1, j, k);
+		Real d010 = this->sample(i, j + 1, k);
+		Real d110 = this->sample(i + 1, j + 1, k);
+		Real d001 = this->sample(i, j, k + 1);
+		Real d101 = this->sample(i + 1, j, k + 1);
+		Real d011 = this->sample(i, j + 1, k + 1);
+		Real d111 = this->sample(i + 1, j + 1, k + 1);
 
 		Real dx00 = lerp(d000, d100, alpha);
 		Real dx10 = lerp(d010, d110, alpha);
@@ -1,8 +1,8 @@
 #include "EdgeSet.h"
+#include "BinaryStream.h"
 #include <vector>
 #include "Array/ArrayList.h"
 
-#include <thrust/sort.h>
 
 
 namespace dyno
@@ -83,6 +83,23 @@ namespace dyno
 		PointSet<TDataType>::copyFrom(edgeSet);
 	}
 
+	template<typename TDataType>
+	bool EdgeSet<TDataType>::writeBinary(BinaryWriter& writer)
+	{
+		PointSet<TDataType>::writeBinary(writer);
+		writer.write(mEdges);
+		writer.write(mVer2Edge);
+		return true;
+	}
+
+	template<typename TDataType>
+	bool EdgeSet<TDataType>::readBinary(BinaryReader& reader)
+	{
+		return PointSet<TDataType>::readBinary(reader)
+			&& reader.read(mEdges)
+			&& reader.read(mVer2Edge);
+	}
+
 	template<typename TDataType>
 	void EdgeSet<TDataType>::setEdges(std::vector<Edge>& edges)
 	{
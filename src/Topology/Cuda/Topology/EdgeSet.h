@@ -127,6 +127,9 @@ namespace dyno
 
 		void copyFrom(EdgeSet<TDataType>& edgeSet);
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		bool isEmpty() override;
 
 		void clear() override;
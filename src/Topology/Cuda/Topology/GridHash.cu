@@ -115,9 +115,11 @@ namespace dyno
 	{
 		clear();
 
-		dim3 pDims = int(ceil(pos.size() / BLOCK_SIZE + 0.5f));
+		cuExecute(pos.size(),
+			K_CalculateParticleNumber,
+			*this,
+			pos);
 
-		K_CalculateParticleNumber << <pDims, BLOCK_SIZE >> > (*this, pos);
 		particle_num = m_reduce->accumulate(index, num);
 
 		if (m_scan == nullptr)
@@ -134,8 +136,10 @@ namespace dyno
 
 		//		std::cout << "Particle number: " << particle_num << std::endl;
 
-		K_ConstructHashTable << <pDims, BLOCK_SIZE >> > (*this, pos);
-		cuSynchronize();
+		cuExecute(pos.size(),
+			K_ConstructHashTable,
+			*this,
+			pos);
 	}
 
 	template<typename TDataType>
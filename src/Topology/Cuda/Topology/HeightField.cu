@@ -1,4 +1,5 @@
 #include "HeightField.h"
+#include "BinaryStream.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -58,6 +59,27 @@ namespace dyno
 		mHeights.assign(hf.mHeights);
 	}
 
+	template<typename TDataType>
+	bool HeightField<TDataType>::writeBinary(BinaryWriter& writer)
+	{
+		writer.write(mOrigin);
+		writer.write(mGridSpacing);
+		writer.write(mDisplacement);
+		writer.write(mHeights);
+		return true;
+	}
+
+	template<typename TDataType>
+	bool HeightField<TDataType>::readBinary(BinaryReader& reader)
+	{
+		if (!reader.read(mOrigin) || !reader.read(mGridSpacing)
+			|| !reader.read(mDisplacement) || !reader.read(mHeights))
+			return false;
+
+		this->tagAsChanged();
+		return true;
+	}
+
 	template <typename Real, typename Coord>
 	__global__ void PS_Scale(
 		DArray<Coord> vertex,
@@ -143,7 +165,7 @@ namespace dyno
 	}
 
 	template<typename TDataType>
-	DArray2D<TDataType::Real>& HeightField<TDataType>::calculateHeightField()
+	DArray2D<typename TDataType::Real>& HeightField<TDataType>::calculateHeightField()
 	{
 		uint nx = mDisplacement.nx();
 		uint ny = mDisplacement.ny();
@@ -18,6 +18,9 @@ namespace dyno
 
 		void copyFrom(HeightField<TDataType>& hf);
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		void scale(Real s);
 		void scale(Coord s);
 		void translate(Coord t);
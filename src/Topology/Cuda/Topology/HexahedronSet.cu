@@ -4,7 +4,9 @@
 #include <iostream>
 #include <sstream>
 
-#include <thrust/sort.h>
+#include "KeySort.h"
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
 
 namespace dyno
 {
@@ -228,7 +230,8 @@ namespace dyno
 			hexIds,
 			m_hexahedrons);
 
-		thrust::sort_by_key(thrust::device, keys.begin(), keys.begin() + keys.size(), hexIds.begin());
+		KeySort<QKey> sort;
+		sort.sortByKey(keys, hexIds);
 
 		DArray<int> counter;
 		counter.resize(6 * hexSize);
@@ -238,8 +241,10 @@ namespace dyno
 			counter,
 			keys);
 
-		int quadNum = thrust::reduce(thrust::device, counter.begin(), counter.begin() + counter.size());
-		thrust::exclusive_scan(thrust::device, counter.begin(), counter.begin() + counter.size(), counter.begin());
+		Reduction<int> reduce;
+		int quadNum = reduce.accumulate(counter.begin(), counter.size());
+		Scan<int> scan;
+		scan.exclusive(counter.begin(), counter.size());
 
 		quad2Hex.resize(quadNum);
 
@@ -0,0 +1,157 @@
+#include "KeySort.h"
+
+namespace dyno
+{
+	template<typename TKey>
+	struct KS_Arity;
+
+	template<> struct KS_Arity<EKey> { static const int value = 2; };
+	template<> struct KS_Arity<TKey> { static const int value = 3; };
+	template<> struct KS_Arity<QKey> { static const int value = 4; };
+
+	template<typename TKey>
+	KeySort<TKey>::KeySort()
+	{
+	}
+
+	template<typename TKey>
+	KeySort<TKey>::~KeySort()
+	{
+		mRadix.clear();
+		mPermutation.clear();
+		mKeyBuffer.clear();
+		mValueBuffer.clear();
+	}
+
+	__global__ void KS_Sequence(
+		DArray<uint> ids)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= ids.size()) return;
+
+		ids[tId] = tId;
+	}
+
+	//Flip the sign bit so that EMPTY (-1) ids are ordered before valid ones, as in operator<
+	template<typename TKey>
+	__global__ void KS_SetupRadix(
+		DArray<uint64> radix,
+		DArray<TKey> keys,
+		DArray<uint> permutation,
+		int first,
+		int arity)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= radix.size()) return;
+
+		TKey key = keys[permutation[tId]];
+
+		uint64 hi = (uint)key[first] ^ 0x80000000u;
+		uint64 lo = first + 1 < arity ? (uint)key[first + 1] ^ 0x80000000u : 0u;
+
+		radix[tId] = hi << 32 | lo;
+	}
+
+	template<typename TKey>
+	__global__ void KS_GatherKeys(
+		DArray<TKey> dst,
+		DArray<TKey> src,
+		DArray<uint> permutation)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= dst.size()) return;
+
+		dst[tId] = src[permutation[tId]];
+	}
+
+	__global__ void KS_GatherValues(
+		char* dst,
+		const char* src,
+		DArray<uint> permutation,
+		size_t valueSize)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= permutation.size()) return;
+
+		const char* s = src + permutation[tId] * valueSize;
+		char* d = dst + tId * valueSize;
+		for (size_t b = 0; b < valueSize; b++)
+			d[b] = s[b];
+	}
+
+	__global__ void KS_CopyValues(
+		char* dst,
+		const char* src,
+		size_t valueSize,
+		uint num)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= num) return;
+
+		for (size_t b = 0; b < valueSize; b++)
+			dst[tId * valueSize + b] = src[tId * valueSize + b];
+	}
+
+	template<typename TKey>
+	void KeySort<TKey>::sortByKey(DArray<TKey>& keys, void* values, const size_t valueSize)
+	{
+		const int arity = KS_Arity<TKey>::value;
+
+		uint num = keys.size();
+		if (num < 2)
+			return;
+
+		mRadix.resize(num);
+		mPermutation.resize(num);
+
+		cuExecute(num,
+			KS_Sequence,
+			mPermutation);
+
+		for (int first = 2 * ((arity - 1) / 2); first >= 0; first -= 2)
+		{
+			cuExecute(num,
+				KS_SetupRadix,
+				mRadix,
+				keys,
+				mPermutation,
+				first,
+				arity);
+
+			mSort.sortByKey(mRadix, mPermutation);
+		}
+
+		mKeyBuffer.resize(num);
+
+		cuExecute(num,
+			KS_GatherKeys,
+			mKeyBuffer,
+			keys,
+			mPermutation);
+
+		keys.assign(mKeyBuffer);
+
+		if (values == nullptr)
+			return;
+
+		mValueBuffer.resize(num * valueSize);
+
+		cuExecute(num,
+			KS_GatherValues,
+			mValueBuffer.begin(),
+			(const char*)values,
+			mPermutation,
+			valueSize);
+
+		cuExecute(num,
+			KS_CopyValues,
+			(char*)values,
+			mValueBuffer.begin(),
+			valueSize,
+			num);
+	}
+
+	template class KeySort<EKey>;
+	template class KeySort<TKey>;
+	template class KeySort<QKey>;
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2024 Xiaowei He
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "EdgeSet.h"
+#include "TriangleSet.h"
+#include "QuadSet.h"
+
+#include "Algorithm/Sort.h"
+
+namespace dyno
+{
+	/**
+	 * @brief Sort EKey, TKey or QKey in the order of their operator< together with attached values.
+	 *
+	 * Two ids are packed into one 64-bit radix key per pass, passes run from the last pair of ids to the first
+	 * 	with the stable Sort, so the keys only need to be moved once at the end.
+	 */
+	template<typename TKey>
+	class KeySort
+	{
+	public:
+		KeySort();
+		~KeySort();
+
+		KeySort(const KeySort&) = delete;
+		KeySort& operator=(const KeySort&) = delete;
+
+		void sortByKey(DArray<TKey>& keys, void* values, const size_t valueSize);
+
+		template<typename TValue>
+		void sortByKey(DArray<TKey>& keys, DArray<TValue>& values)
+		{
+			assert(keys.size() == values.size());
+			this->sortByKey(keys, values.begin(), sizeof(TValue));
+		}
+
+	private:
+		Sort<uint64> mSort;
+
+		DArray<uint64> mRadix;
+		DArray<uint> mPermutation;
+
+		DArray<TKey> mKeyBuffer;
+		DArray<char> mValueBuffer;
+	};
+}
@@ -4,7 +4,7 @@
 #include "STL/Stack.h"
 #include "Math/SimpleMath.h"
 
-#include <thrust/sort.h>
+#include "Algorithm/Sort.h"
 
 #include "Timer.h"
 
@@ -335,7 +335,9 @@ namespace dyno
 
 // 		GTimer timer;
 // 		timer.start();
-		thrust::sort_by_key(thrust::device, mMortonCodes.begin(), mMortonCodes.begin() + mMortonCodes.size(), mSortedObjectIds.begin());
+		//LinearBVH is passed to kernels by value, scratch buffers are recycled by the device allocator instead of being kept as members
+		Sort<uint64> sort;
+		sort.sortByKey(mMortonCodes, mSortedObjectIds);
 // 		timer.stop();
 // 		std::cout << "Sort: " << timer.getElapsedTime() << std::endl;
 
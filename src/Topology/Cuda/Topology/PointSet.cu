@@ -1,4 +1,5 @@
 #include "PointSet.h"
+#include "BinaryStream.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -67,6 +68,23 @@ namespace dyno
 		mCoords.assign(pointSet.getPoints());
 	}
 
+	template<typename TDataType>
+	bool PointSet<TDataType>::writeBinary(BinaryWriter& writer)
+	{
+		writer.write(mCoords);
+		return true;
+	}
+
+	template<typename TDataType>
+	bool PointSet<TDataType>::readBinary(BinaryReader& reader)
+	{
+		if (!reader.read(mCoords))
+			return false;
+
+		this->tagAsChanged();
+		return true;
+	}
+
 	template<typename TDataType>
 	void PointSet<TDataType>::setPoints(const std::vector<Coord>& pos)
 	{
@@ -38,6 +38,9 @@ namespace dyno
 
 		void copyFrom(PointSet<TDataType>& pointSet);
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		void setPoints(const std::vector<Coord>& pos);
 		void setPoints(const DArray<Coord>& pos);
 		void setSize(int size);
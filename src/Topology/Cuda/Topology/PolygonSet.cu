@@ -1,6 +1,8 @@
 #include "PolygonSet.h"
 
-#include <thrust/sort.h>
+#include "KeySort.h"
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
 
 namespace dyno
 {
@@ -82,7 +84,7 @@ namespace dyno
 	template<typename TDataType>
 	void PolygonSet<TDataType>::updateTopology()
 	{
-		uint vNum = mCoords.size();
+		uint vNum = this->mCoords.size();
 
 		//Update the vertex to polygon mapping
 		DArray<uint> counter(vNum);
@@ -195,8 +197,10 @@ namespace dyno
 
 		mPoly2Edg.resize(radix);
 
-		int eNum = thrust::reduce(thrust::device, radix.begin(), radix.begin() + radix.size());
-		thrust::exclusive_scan(thrust::device, radix.begin(), radix.begin() + radix.size(), radix.begin());
+		Reduction<uint> reduce;
+		int eNum = reduce.accumulate(radix.begin(), radix.size());
+		Scan<uint> scan;
+		scan.exclusive(radix.begin(), radix.size());
 
 		DArray<EKey> edgeKeys(eNum);
 		DArray<uint> polyIds(eNum);
@@ -210,22 +214,23 @@ namespace dyno
 
 		DArray<uint> uniqueEdgeCounter(eNum);
 
-		thrust::sort_by_key(thrust::device, edgeKeys.begin(), edgeKeys.begin() + edgeKeys.size(), polyIds.begin());
+		KeySort<EKey> sort;
+		sort.sortByKey(edgeKeys, polyIds);
 
 		cuExecute(edgeKeys.size(),
 			PolygonSet_CountUniqueEdge,
 			uniqueEdgeCounter,
 			edgeKeys);
 
-		int uniqueNum = thrust::reduce(thrust::device, uniqueEdgeCounter.begin(), uniqueEdgeCounter.begin() + uniqueEdgeCounter.size());
-		thrust::exclusive_scan(thrust::device, uniqueEdgeCounter.begin(), uniqueEdgeCounter.begin() + uniqueEdgeCounter.size(), uniqueEdgeCounter.begin());
+		int uniqueNum = reduce.accumulate(uniqueEdgeCounter.begin(), uniqueEdgeCounter.size());
+		scan.exclusive(uniqueEdgeCounter.begin(), uniqueEdgeCounter.size());
 
-		mEdges.resize(uniqueNum);
+		this->mEdges.resize(uniqueNum);
 		mEdg2Poly.resize(uniqueNum);
 
 		cuExecute(edgeKeys.size(),
 			PolygonSet_SetupEdgeIndices,
-			mEdges,
+			this->mEdges,
 			mPoly2Edg,
 			mEdg2Poly,
 			edgeKeys,
@@ -241,8 +246,8 @@ namespace dyno
 	template<typename TDataType>
 	void PolygonSet<TDataType>::extractEdgeSet(EdgeSet<TDataType>& es)
 	{
-		es.setPoints(mCoords);
-		es.setEdges(mEdges);
+		es.setPoints(this->mCoords);
+		es.setEdges(this->mEdges);
 
 		es.update();
 	}
@@ -293,8 +298,10 @@ namespace dyno
 			radix,
 			mPolygonIndex);
 
-		int tNum = thrust::reduce(thrust::device, radix.begin(), radix.begin() + radix.size());
-		thrust::exclusive_scan(thrust::device, radix.begin(), radix.begin() + radix.size(), radix.begin());
+		Reduction<uint> reduce;
+		int tNum = reduce.accumulate(radix.begin(), radix.size());
+		Scan<uint> scan;
+		scan.exclusive(radix.begin(), radix.size());
 
 		DArray<Triangle> triangleIndices(tNum);
 
@@ -305,7 +312,7 @@ namespace dyno
 			mPolygonIndex,
 			radix);
 
-		ts.setPoints(mCoords);
+		ts.setPoints(this->mCoords);
 		ts.setTriangles(triangleIndices);
 		ts.update();
 
@@ -360,8 +367,10 @@ namespace dyno
 			radix,
 			mPolygonIndex);
 
-		int tNum = thrust::reduce(thrust::device, radix.begin(), radix.begin() + radix.size());
-		thrust::exclusive_scan(thrust::device, radix.begin(), radix.begin() + radix.size(), radix.begin());
+		Reduction<uint> reduce;
+		int tNum = reduce.accumulate(radix.begin(), radix.size());
+		Scan<uint> scan;
+		scan.exclusive(radix.begin(), radix.size());
 
 		DArray<Quad> quadIndices(tNum);
 
@@ -372,7 +381,7 @@ namespace dyno
 			mPolygonIndex,
 			radix);
 
-		qs.setPoints(mCoords);
+		qs.setPoints(this->mCoords);
 		qs.setQuads(quadIndices);
 		qs.update();
 
@@ -427,8 +436,10 @@ namespace dyno
 			radix,
 			mPolygonIndex);
 
-		int tNum = thrust::reduce(thrust::device, radix.begin(), radix.begin() + radix.size());
-		thrust::exclusive_scan(thrust::device, radix.begin(), radix.begin() + radix.size(), radix.begin());
+		Reduction<uint> reduce;
+		int tNum = reduce.accumulate(radix.begin(), radix.size());
+		Scan<uint> scan;
+		scan.exclusive(radix.begin(), radix.size());
 
 		DArray<Triangle> triangleIndex(tNum);
 
@@ -438,7 +449,7 @@ namespace dyno
 			mPolygonIndex,
 			radix);
 
-		ts.setPoints(mCoords);
+		ts.setPoints(this->mCoords);
 		ts.setTriangles(triangleIndex);
 		ts.update();
 
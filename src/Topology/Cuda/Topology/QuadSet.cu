@@ -3,7 +3,9 @@
 #include <iostream>
 #include <sstream>
 
-#include <thrust/sort.h>
+#include "KeySort.h"
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
 
 namespace dyno
 {
@@ -161,7 +163,8 @@ namespace dyno
 			quadIds,
 			mQuads);
 
-		thrust::sort_by_key(thrust::device, keys.begin(), keys.begin() + keys.size(), quadIds.begin());
+		KeySort<EKey> sort;
+		sort.sortByKey(keys, quadIds);
 
 		DArray<int> counter;
 		counter.resize(4 * quadSize);
@@ -171,8 +174,10 @@ namespace dyno
 			counter,
 			keys);
 
-		int edgeNum = thrust::reduce(thrust::device, counter.begin(), counter.begin() + counter.size());
-		thrust::exclusive_scan(thrust::device, counter.begin(), counter.begin() + counter.size(), counter.begin());
+		Reduction<int> reduce;
+		int edgeNum = reduce.accumulate(counter.begin(), counter.size());
+		Scan<int> scan;
+		scan.exclusive(counter.begin(), counter.size());
 
 		mEdg2Quad.resize(edgeNum);
 
@@ -1,6 +1,8 @@
 #include "SimplexSet.h"
 
-#include <thrust/sort.h>
+#include "KeySort.h"
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
 
 namespace dyno
 {
@@ -122,7 +124,8 @@ namespace dyno
 			vIds,
 			mEdgeIndex);
 
-		thrust::sort(thrust::device, vIds.begin(), vIds.begin() + vIds.size());
+		Sort<uint> sort;
+		sort.sort(vIds);
 
 		DArray<int> radix(eNum * 2);
 
@@ -131,8 +134,10 @@ namespace dyno
 			radix,
 			vIds);
 
-		int vNum = thrust::reduce(thrust::device, radix.begin(), radix.begin() + radix.size());
-		thrust::exclusive_scan(thrust::device, radix.begin(), radix.begin() + radix.size(), radix.begin());
+		Reduction<int> reduce;
+		int vNum = reduce.accumulate(radix.begin(), radix.size());
+		Scan<int> scan;
+		scan.exclusive(radix.begin(), radix.size());
 
 		DArray<Coord> vertices(vNum);
 		DArray<Edge> edgeIndices(mEdgeIndex.size());
@@ -210,7 +215,8 @@ namespace dyno
 			vIds,
 			mTriangleIndex);
 
-		thrust::sort(thrust::device, vIds.begin(), vIds.begin() + vIds.size());
+		Sort<uint> sort;
+		sort.sort(vIds);
 
 		DArray<int> radix(tNum * 3);
 
@@ -219,8 +225,10 @@ namespace dyno
 			radix,
 			vIds);
 
-		int vNum = thrust::reduce(thrust::device, radix.begin(), radix.begin() + radix.size());
-		thrust::exclusive_scan(thrust::device, radix.begin(), radix.begin() + radix.size(), radix.begin());
+		Reduction<int> reduce;
+		int vNum = reduce.accumulate(radix.begin(), radix.size());
+		Scan<int> scan;
+		scan.exclusive(radix.begin(), radix.size());
 
 		DArray<Coord> vertices(vNum);
 		DArray<Triangle> triangleIndex(mTriangleIndex.size());
@@ -300,7 +308,8 @@ namespace dyno
 			vIds,
 			mTetrahedronIndex);
 
-		thrust::sort(thrust::device, vIds.begin(), vIds.begin() + vIds.size());
+		Sort<uint> sort;
+		sort.sort(vIds);
 
 		DArray<int> radix(tNum * 4);
 
@@ -309,8 +318,10 @@ namespace dyno
 			radix,
 			vIds);
 
-		int vNum = thrust::reduce(thrust::device, radix.begin(), radix.begin() + radix.size());
-		thrust::exclusive_scan(thrust::device, radix.begin(), radix.begin() + radix.size(), radix.begin());
+		Reduction<int> reduce;
+		int vNum = reduce.accumulate(radix.begin(), radix.size());
+		Scan<int> scan;
+		scan.exclusive(radix.begin(), radix.size());
 
 		DArray<Coord> vertices(vNum);
 		DArray<Tetrahedron> tetrahedronIndex(mTetrahedronIndex.size());
@@ -478,7 +489,8 @@ namespace dyno
 			mTriangleIndex,
 			mTetrahedronIndex);
 
-		thrust::sort_by_key(thrust::device, keys.begin(), keys.begin() + keys.size(), edges.begin());
+		KeySort<EKey> sort;
+		sort.sortByKey(keys, edges);
 
 		DArray<int> radix(eNum);
 
@@ -487,8 +499,10 @@ namespace dyno
 			radix,
 			keys);
 
-		int N = thrust::reduce(thrust::device, radix.begin(), radix.begin() + radix.size());
-		thrust::exclusive_scan(thrust::device, radix.begin(), radix.begin() + radix.size(), radix.begin());
+		Reduction<int> reduce;
+		int N = reduce.accumulate(radix.begin(), radix.size());
+		Scan<int> scan;
+		scan.exclusive(radix.begin(), radix.size());
 
 		DArray<Edge> distinctEdges(N);
 
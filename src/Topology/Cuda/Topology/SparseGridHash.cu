@@ -3,8 +3,6 @@
 #include "Object.h"
 #include "DataTypes.h"
 
-#include <thrust/sort.h>
-
 namespace dyno 
 {
 	template<typename TDataType>
@@ -96,7 +94,7 @@ namespace dyno
 			m_L,
 			m_level_max);
 
-		thrust::sort(thrust::device, m_all_nodes.begin(), m_all_nodes.begin() + m_all_nodes.size(), NodeCmp());
+		SortOctreeNodes(m_all_nodes);
 	}
 
 	DEFINE_CLASS(SparseGridHash);
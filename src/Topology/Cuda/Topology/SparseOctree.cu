@@ -1,7 +1,9 @@
 #pragma once
 #include "SparseOctree.h"
 
-#include <thrust/sort.h>
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
+#include "Algorithm/Sort.h"
 
 #include "Object.h"
 
@@ -224,6 +226,39 @@ namespace dyno {
 	}
 
 
+	/**
+	 * Keys are aligned to MAX_LEVEL and followed by the level, a node is greater than another one by OctreeNode::operator>
+	 * 	exactly when its radix is larger. The radix is complemented as Sort orders ascendingly.
+	 */
+	__global__ void SO_SetupRadix(
+		DArray<uint64> radix,
+		DArray<OctreeNode> nodes)
+	{
+		uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+		if (tId >= nodes.size()) return;
+
+		OctreeNode node = nodes[tId];
+
+		uint64 aligned = node.key() << DIM * (MAX_LEVEL - node.level());
+
+		radix[tId] = ~(aligned << 4 | node.level());
+	}
+
+	void SortOctreeNodes(DArray<OctreeNode>& nodes)
+	{
+		DArray<uint64> radix(nodes.size());
+
+		cuExecute(nodes.size(),
+			SO_SetupRadix,
+			radix,
+			nodes);
+
+		Sort<uint64> sort;
+		sort.sortByKey(radix, nodes);
+
+		radix.clear();
+	}
+
 	template<typename TDataType>
 	SparseOctree<TDataType>::SparseOctree()
 	{
@@ -1133,8 +1168,10 @@ namespace dyno {
 			m_level_max);
 
 		//step 1.2: allocate enough space to store all cells
-		int total_node_num = thrust::reduce(thrust::device, data_count.begin(), data_count.begin() + data_count.size(), (int)0, thrust::plus<int>());
-		thrust::exclusive_scan(thrust::device, data_count.begin(), data_count.begin() + data_count.size(), data_count.begin());
+		Reduction<int> reduce;
+		int total_node_num = reduce.accumulate(data_count.begin(), data_count.size());
+		Scan<int> scan;
+		scan.exclusive(data_count.begin(), data_count.size());
 
 		m_all_nodes.resize(total_node_num);
 
@@ -1153,7 +1190,7 @@ namespace dyno {
 
 		//print(m_all_nodes);
 		//std::cout << total_node_num << std::endl;
-		thrust::sort(thrust::device, m_all_nodes.begin(), m_all_nodes.begin() + m_all_nodes.size(), NodeCmp());
+		SortOctreeNodes(m_all_nodes);
 
 		//print(m_all_nodes);
 
@@ -1176,8 +1213,10 @@ namespace dyno {
 			duplicates_count,
 			nodes);
 
-		int non_duplicative_num = thrust::reduce(thrust::device, duplicates_count.begin(), duplicates_count.begin() + duplicates_count.size(), (int)0, thrust::plus<int>());
-		thrust::exclusive_scan(thrust::device, duplicates_count.begin(), duplicates_count.begin() + duplicates_count.size(), duplicates_count.begin());
+		Reduction<int> reduce;
+		int non_duplicative_num = reduce.accumulate(duplicates_count.begin(), duplicates_count.size());
+		Scan<int> scan;
+		scan.exclusive(duplicates_count.begin(), duplicates_count.size());
 
 		node_buffer.resize(2 * non_duplicative_num - 1);
 
@@ -1209,7 +1248,7 @@ namespace dyno {
 			node_buffer,
 			non_duplicative_num);
 
-		thrust::sort(thrust::device, node_buffer.begin(), node_buffer.begin() + node_buffer.size(), NodeCmp());
+		SortOctreeNodes(node_buffer);
 
 		//print(node_buffer);
 		nonRepeatNodes_cpy.resize(node_buffer.size());
@@ -1225,8 +1264,8 @@ namespace dyno {
 			node_count,
 			nonRepeatNodes_cpy);
 
-		thrust::sort(thrust::device, node_buffer.begin(), node_buffer.begin() + node_buffer.size(), NodeCmp());
-		non_duplicative_num = thrust::reduce(thrust::device, node_count.begin(), node_count.begin() + node_count.size(), (int)0, thrust::plus<int>());
+		SortOctreeNodes(node_buffer);
+		non_duplicative_num = reduce.accumulate(node_count.begin(), node_count.size());
 
 
 		m_post_ordered_nodes.resize(non_duplicative_num);
@@ -1248,7 +1287,7 @@ namespace dyno {
 
 		//print(morton_b);
 
-		thrust::sort(thrust::device, aux_nodes.begin(), aux_nodes.begin() + aux_nodes.size(), NodeCmp());
+		SortOctreeNodes(aux_nodes);
 
 		//print(aux_nodes);
 
@@ -106,6 +106,11 @@ namespace dyno {
 		}
 	};
 
+	/**
+	 * @brief Sort nodes in the order of NodeCmp with a radix sort
+	 */
+	void SortOctreeNodes(DArray<OctreeNode>& nodes);
+
 	template<typename TDataType>
 	class SparseOctree
 	{
@@ -3,7 +3,9 @@
 #include <iostream>
 #include <sstream>
 
-#include <thrust/sort.h>
+#include "KeySort.h"
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
 
 namespace dyno
 {
@@ -294,7 +296,8 @@ namespace dyno
 			tetIds,
 			mTethedrons);
 
-		thrust::sort_by_key(thrust::device, keys.begin(), keys.begin() + keys.size(), tetIds.begin());
+		KeySort<TKey> sort;
+		sort.sortByKey(keys, tetIds);
 
 		DArray<int> counter;
 		counter.resize(4 * tetSize);
@@ -304,8 +307,10 @@ namespace dyno
 			counter,
 			keys);
 
-		int triNum = thrust::reduce(thrust::device, counter.begin(), counter.begin() + counter.size());
-		thrust::exclusive_scan(thrust::device, counter.begin(), counter.begin() + counter.size(), counter.begin());
+		Reduction<int> reduce;
+		int triNum = reduce.accumulate(counter.begin(), counter.size());
+		Scan<int> scan;
+		scan.exclusive(counter.begin(), counter.size());
 
 		mTri2Tet.resize(triNum);
 
@@ -1,9 +1,12 @@
 #include "TriangleSet.h"
+#include "BinaryStream.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
-#include <thrust/sort.h>
+#include "KeySort.h"
+#include "Algorithm/Scan.h"
+#include "Algorithm/Reduction.h"
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tinyobjloader/tiny_obj_loader.h"
 
@@ -166,7 +169,8 @@ namespace dyno
 			triIds,
 			mEdg2Tri);
 
-		thrust::sort_by_key(thrust::device, triIds.begin(), triIds.begin() + triIds.size(), edgIds.begin());
+		Sort<int> sort;
+		sort.sortByKey(triIds, edgIds);
 
 		auto& pEdges = this->getEdges();
 
@@ -260,7 +264,8 @@ namespace dyno
 			triIds,
 			mTriangleIndex);
 
-		thrust::sort_by_key(thrust::device, keys.begin(), keys.begin() + keys.size(), triIds.begin());
+		KeySort<EKey> sort;
+		sort.sortByKey(keys, triIds);
 
 		DArray<int> counter;
 		counter.resize(3 * triSize);
@@ -270,8 +275,10 @@ namespace dyno
 			counter,
 			keys);
 
-		int edgeNum = thrust::reduce(thrust::device, counter.begin(), counter.begin() + counter.size());
-		thrust::exclusive_scan(thrust::device, counter.begin(), counter.begin() + counter.size(), counter.begin());
+		Reduction<int> reduce;
+		int edgeNum = reduce.accumulate(counter.begin(), counter.size());
+		Scan<int> scan;
+		scan.exclusive(counter.begin(), counter.size());
 
 		mEdg2Tri.resize(edgeNum);
 
@@ -360,6 +367,29 @@ namespace dyno
 		EdgeSet<TDataType>::copyFrom(triangleSet);
 	}
 
+	template<typename TDataType>
+	bool TriangleSet<TDataType>::writeBinary(BinaryWriter& writer)
+	{
+		EdgeSet<TDataType>::writeBinary(writer);
+		writer.write(mTriangleIndex);
+		writer.write(mVer2Tri);
+		writer.write(mEdg2Tri);
+		writer.write(mTri2Edg);
+		writer.write(mVertexNormal);
+		return true;
+	}
+
+	template<typename TDataType>
+	bool TriangleSet<TDataType>::readBinary(BinaryReader& reader)
+	{
+		return EdgeSet<TDataType>::readBinary(reader)
+			&& reader.read(mTriangleIndex)
+			&& reader.read(mVer2Tri)
+			&& reader.read(mEdg2Tri)
+			&& reader.read(mTri2Edg)
+			&& reader.read(mVertexNormal);
+	}
+
 	template<typename Triangle>
 	__global__ void TS_UpdateIndex(
 		DArray<Triangle> indices,
@@ -132,6 +132,9 @@ namespace dyno
 
 		void copyFrom(TriangleSet<TDataType>& triangleSet);
 
+		bool writeBinary(BinaryWriter& writer) override;
+		bool readBinary(BinaryReader& reader) override;
+
 		std::shared_ptr<TriangleSet<TDataType>> 
 			merge(TriangleSet<TDataType>& ts);
 
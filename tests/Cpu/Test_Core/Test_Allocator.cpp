@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "Array/Array.h"
+#include "Array/Array2D.h"
+#include "Array/Array3D.h"
+#include "Array/ArrayList.h"
+
+using namespace dyno;
+
+TEST(Allocator, SizeClass)
+{
+	EXPECT_EQ(CachingAllocator::sizeClass(1), 256);
+	EXPECT_EQ(CachingAllocator::sizeClass(256), 256);
+	EXPECT_EQ(CachingAllocator::sizeClass(300), 512);
+	EXPECT_EQ(CachingAllocator::sizeClass(1500), 1536);
+	EXPECT_EQ(CachingAllocator::sizeClass(4097), 4608);
+
+	for (size_t n = 1; n < 100000; n += 97)
+	{
+		size_t size = CachingAllocator::sizeClass(n);
+		EXPECT_GE(size, n);
+		EXPECT_LE(size, n + n / 8 + 256);
+	}
+}
+
+TEST(Allocator, Caching)
+{
+	std::shared_ptr<HostAllocator> host = std::make_shared<HostAllocator>();
+	CachingAllocator pool(host);
+
+	void* a = pool.allocate(1000);
+	void* b = pool.allocate(5000);
+	pool.deallocate(a, 1000);
+
+	//Same size class, the block freed before is reused
+	void* c = pool.allocate(1024);
+	EXPECT_EQ(a, c);
+
+	AllocatorStatistics stat = pool.statistics();
+	EXPECT_EQ(stat.allocations, 3);
+	EXPECT_EQ(stat.hits, 1);
+	EXPECT_EQ(stat.bytesLive, 6024);
+	EXPECT_EQ(stat.bytesPeak, 6024);
+	EXPECT_EQ(host->statistics().allocations, 2);
+
+	pool.deallocate(b, 5000);
+	pool.deallocate(c, 1024);
+
+	stat = pool.statistics();
+	EXPECT_EQ(stat.bytesLive, 0);
+	EXPECT_EQ(stat.bytesCached, CachingAllocator::sizeClass(5000) + CachingAllocator::sizeClass(1024));
+
+	pool.releaseCached();
+	EXPECT_EQ(pool.statistics().bytesCached, 0);
+	EXPECT_EQ(host->statistics().bytesLive, 0);
+
+	pool.setMaxCachedBytes(0);
+	pool.deallocate(pool.allocate(100), 100);
+	EXPECT_EQ(pool.statistics().bytesCached, 0);
+}
+
+TEST(Allocator, Frame)
+{
+	CachingAllocator pool(std::make_shared<HostAllocator>());
+
+	for (int i = 0; i < 4; i++)
+		pool.deallocate(pool.allocate(64), 64);
+
+	pool.nextFrame();
+
+	AllocatorStatistics stat = pool.statistics();
+	EXPECT_EQ(stat.frameAllocations, 0);
+	EXPECT_EQ(stat.lastFrameAllocations, 4);
+	EXPECT_FLOAT_EQ(stat.hitRate(), 0.75f);
+}
+
+TEST(Allocator, Arrays)
+{
+	Allocator* pool = Allocator::device();
+	pool->releaseCached();
+
+	AllocatorStatistics init = pool->statistics();
+
+	DArray<float> arr(1000);
+	DArray2D<float> arr2d(10, 20);
+	DArray3D<float> arr3d(4, 5, 6);
+
+	AllocatorStatistics stat = pool->statistics();
+	EXPECT_EQ(stat.allocations - init.allocations, 3);
+	EXPECT_EQ(stat.bytesLive - init.bytesLive, (1024 + 200 + 120) * sizeof(float));
+
+	//The buffer released by the first resize is reused by the second one
+	arr.resize(3000);
+	arr.resize(1000);
+
+	stat = pool->statistics();
+	EXPECT_EQ(stat.allocations - init.allocations, 5);
+	EXPECT_EQ(stat.hits - init.hits, 1);
+
+	DArrayList<int> lists;
+	lists.resize(100, 4);
+	EXPECT_EQ(lists.elementSize(), 400);
+
+	lists.clear();
+	arr.clear();
+	arr2d.clear();
+	arr3d.clear();
+
+	EXPECT_EQ(pool->statistics().bytesLive, init.bytesLive);
+
+	//Freed arrays stay in the pool until it is released explicitly, e.g., before the device context is torn down
+	EXPECT_GT(pool->statistics().bytesCached, 0);
+	Allocator::releaseAllCached();
+	EXPECT_EQ(pool->statistics().bytesCached, 0);
+}
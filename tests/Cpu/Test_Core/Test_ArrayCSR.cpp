@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "Array/ArrayCSR.h"
+
+using namespace dyno;
+
+__global__ void TK_FillRows(
+	DArrayCSR<int> csr)
+{
+	uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+	if (tId >= csr.size()) return;
+
+	List<int> row = csr[tId];
+	for (uint j = 0; j < row.size(); j++)
+	{
+		row[j] = tId * 10 + j;
+	}
+}
+
+__global__ void TK_InsertRows(
+	DArrayList<int> lists)
+{
+	uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+	if (tId >= lists.size()) return;
+
+	List<int>& list = lists[tId];
+	for (uint j = 0; j < tId % 3; j++)
+	{
+		list.insert(tId);
+	}
+}
+
+TEST(ArrayCSR, Resize)
+{
+	CArray<uint> hCounts(1000);
+	for (uint i = 0; i < hCounts.size(); i++)
+		hCounts[i] = i % 4;
+
+	DArray<uint> dCounts;
+	dCounts.assign(hCounts);
+
+	DArrayCSR<int> dCsr;
+	dCsr.resize(dCounts);
+
+	EXPECT_EQ(dCsr.size(), 1000);
+	EXPECT_EQ(dCsr.elementSize(), 1500);
+
+	cuExecute(dCsr.size(),
+		TK_FillRows,
+		dCsr);
+
+	CArrayCSR<int> hCsr;
+	hCsr.assign(dCsr);
+
+	EXPECT_EQ(hCsr.size(), 1000);
+	EXPECT_EQ(hCsr.size(999), 3);
+	EXPECT_EQ(hCsr[999][2], 9992);
+	EXPECT_EQ(hCsr.index()[1000], 1500);
+
+	CArrayCSR<int> hCsr2;
+	hCsr2.resize(hCounts);
+	EXPECT_EQ(hCsr2.elementSize(), 1500);
+	EXPECT_EQ(hCsr2.size(998), 2);
+
+	dCounts.clear();
+	dCsr.clear();
+}
+
+TEST(ArrayCSR, FromArrayList)
+{
+	DArrayList<int> dLists;
+	dLists.resize(100, 2);
+
+	cuExecute(dLists.size(),
+		TK_InsertRows,
+		dLists);
+
+	//Both conversions only keep the inserted elements, rows report their real size
+	DArrayCSR<int> dCsr;
+	dCsr.assign(dLists);
+	EXPECT_EQ(dCsr.size(), 100);
+	EXPECT_EQ(dCsr.elementSize(), 99);
+
+	CArrayCSR<int> fromDevice;
+	fromDevice.assign(dCsr);
+	EXPECT_EQ(fromDevice.size(98), 2);
+	EXPECT_EQ(fromDevice[97].size(), 1);
+	EXPECT_EQ(fromDevice[96].size(), 0);
+	EXPECT_EQ(fromDevice[98][1], 98);
+
+	CArrayList<int> hLists;
+	hLists.assign(dLists);
+
+	CArrayCSR<int> hCsr;
+	hCsr.assign(hLists);
+
+	EXPECT_EQ(hCsr.size(), 100);
+	EXPECT_EQ(hCsr.elementSize(), 99);
+	EXPECT_EQ(hCsr.size(98), 2);
+	EXPECT_EQ(hCsr[98].size(), 2);
+	EXPECT_EQ(hCsr[98][1], 98);
+
+	dLists.clear();
+	dCsr.clear();
+}
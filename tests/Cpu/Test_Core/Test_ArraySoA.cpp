@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+#include "Array/ArraySoA.h"
+
+#include <cstdint>
+
+using namespace dyno;
+
+__global__ void TK_Integrate(
+	DArraySoA<Vec3f> pos,
+	DArraySoA<Vec3f> vel,
+	float dt)
+{
+	uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+	if (tId >= pos.size()) return;
+
+	Vec3f v = vel[tId];
+	pos[tId] += dt * v;
+}
+
+TEST(ArraySoA, Layout)
+{
+	CArraySoA<Vec3f> arr(100);
+	EXPECT_EQ(arr.size(), 100);
+	EXPECT_EQ(arr.pitch(), 112);
+	EXPECT_EQ((uintptr_t)(arr.y() - arr.x()) * sizeof(float) % 64, 0);
+
+	arr.assign(Vec3f(1.0f, 2.0f, 3.0f));
+	arr[7] = Vec3f(4.0f, 5.0f, 6.0f);
+	arr[7] += Vec3f(1.0f);
+
+	EXPECT_FLOAT_EQ(arr.x()[0], 1.0f);
+	EXPECT_FLOAT_EQ(arr.z()[99], 3.0f);
+	EXPECT_FLOAT_EQ(arr.y()[7], 6.0f);
+
+	Vec3f v = arr[7];
+	EXPECT_FLOAT_EQ(v[2], 7.0f);
+}
+
+TEST(ArraySoA, Conversion)
+{
+	uint n = 1000;
+
+	CArray<Vec3f> hAoS(n);
+	for (uint i = 0; i < n; i++)
+		hAoS[i] = Vec3f(float(i), 2.0f * i, -float(i));
+
+	DArray<Vec3f> dAoS;
+	dAoS.assign(hAoS);
+
+	DArraySoA<Vec3f> dPos;
+	dPos.assign(dAoS);
+
+	DArraySoA<Vec3f> dVel(n);
+	dVel.assign(Vec3f(0.0f, 0.0f, 10.0f));
+
+	cuExecute(n,
+		TK_Integrate,
+		dPos,
+		dVel,
+		0.5f);
+
+	dPos.toAoS(dAoS);
+	hAoS.assign(dAoS);
+
+	EXPECT_FLOAT_EQ(hAoS[999][0], 999.0f);
+	EXPECT_FLOAT_EQ(hAoS[999][1], 1998.0f);
+	EXPECT_FLOAT_EQ(hAoS[999][2], -994.0f);
+
+	CArraySoA<Vec3f> hPos;
+	hPos.assign(dPos);
+	EXPECT_FLOAT_EQ(hPos.z()[10], -5.0f);
+
+	CArray<Vec3f> hBack;
+	hPos.toAoS(hBack);
+	EXPECT_FLOAT_EQ(hBack[10][1], 20.0f);
+
+	dAoS.clear();
+	dPos.clear();
+	dVel.clear();
+}
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "Array/ArrayTiled.h"
+#include "Vector.h"
+
+#include <set>
+
+using namespace dyno;
+
+TEST(ArrayTiled, Index)
+{
+	//Every cell maps to a distinct slot within the capacity
+	CArrayTiled3D<float> grid(9, 5, 6);
+	EXPECT_EQ(grid.capacity(), 3 * 2 * 2 * 64);
+
+	std::set<size_t> slots;
+	for (uint k = 0; k < 6; k++)
+		for (uint j = 0; j < 5; j++)
+			for (uint i = 0; i < 9; i++)
+				slots.insert(grid.index(i, j, k));
+
+	EXPECT_EQ(slots.size(), 9 * 5 * 6);
+	EXPECT_LT(*slots.rbegin(), grid.capacity());
+
+	//A 2x2x2 stencil aligned to even coordinates lies within 8 consecutive slots
+	size_t base = grid.index(2, 2, 2);
+	EXPECT_EQ(base % 8, 0);
+	EXPECT_EQ(grid.index(3, 3, 3), base + 7);
+
+	CArrayTiled2D<int> grid2(20, 10);
+	std::set<size_t> slots2;
+	for (uint j = 0; j < 10; j++)
+		for (uint i = 0; i < 20; i++)
+			slots2.insert(grid2.index(i, j));
+
+	EXPECT_EQ(slots2.size(), 200);
+	EXPECT_LT(*slots2.rbegin(), grid2.capacity());
+}
+
+TEST(ArrayTiled, Conversion3D)
+{
+	CArray3D<float> hLinear(17, 9, 5);
+	for (uint k = 0; k < 5; k++)
+		for (uint j = 0; j < 9; j++)
+			for (uint i = 0; i < 17; i++)
+				hLinear(i, j, k) = float(i + 100 * j + 10000 * k);
+
+	CArrayTiled3D<float> hTiled;
+	hTiled.assign(hLinear);
+	EXPECT_FLOAT_EQ(hTiled(16, 8, 4), 40816.0f);
+
+	DArray3D<float> dLinear;
+	dLinear.assign(hLinear);
+
+	DArrayTiled3D<float> dTiled;
+	dTiled.assign(dLinear);
+
+	CArrayTiled3D<float> hCopy;
+	hCopy.assign(dTiled);
+	EXPECT_FLOAT_EQ(hCopy(3, 7, 2), 20703.0f);
+
+	DArray3D<float> dBack;
+	dTiled.toLinear(dBack);
+
+	CArray3D<float> hBack;
+	hBack.assign(dBack);
+	EXPECT_FLOAT_EQ(hBack(16, 8, 4), 40816.0f);
+	EXPECT_FLOAT_EQ(hBack(0, 1, 0), 100.0f);
+
+	dLinear.clear();
+	dTiled.clear();
+	dBack.clear();
+}
+
+TEST(ArrayTiled, Conversion2D)
+{
+	CArray2D<Vec2f> hLinear(30, 11);
+	for (uint j = 0; j < 11; j++)
+		for (uint i = 0; i < 30; i++)
+			hLinear(i, j) = Vec2f(float(i), float(j));
+
+	DArray2D<Vec2f> dLinear;
+	dLinear.assign(hLinear);
+
+	DArrayTiled2D<Vec2f> dTiled;
+	dTiled.assign(dLinear);
+
+	CArrayTiled2D<Vec2f> hTiled;
+	hTiled.assign(dTiled);
+	EXPECT_FLOAT_EQ(hTiled(29, 10)[0], 29.0f);
+	EXPECT_FLOAT_EQ(hTiled(29, 10)[1], 10.0f);
+
+	DArray2D<Vec2f> dBack;
+	dTiled.toLinear(dBack);
+
+	CArray2D<Vec2f> hBack;
+	hBack.assign(dBack);
+	EXPECT_FLOAT_EQ(hBack(17, 3)[0], 17.0f);
+
+	dLinear.clear();
+	dTiled.clear();
+	dBack.clear();
+}
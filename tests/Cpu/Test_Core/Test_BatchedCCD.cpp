@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+#include "CCD/BatchedCCD.h"
+
+#include <random>
+
+using namespace dyno;
+
+//Vertex 0 falls through the triangle (1, 2, 3) at t = 0.5, the edges (4, 5) and (6, 7) cross at t = 0.25, the edge (8, 9) stays apart
+static void buildScene(CArray<Vec3f>& x0, CArray<Vec3f>& x1)
+{
+	x0.resize(10);
+	x1.resize(10);
+
+	x0[0] = Vec3f(0.2f, 0.2f, 1.0f);	x1[0] = Vec3f(0.2f, 0.2f, -1.0f);
+	x0[1] = Vec3f(0.0f, 0.0f, 0.0f);	x1[1] = x0[1];
+	x0[2] = Vec3f(1.0f, 0.0f, 0.0f);	x1[2] = x0[2];
+	x0[3] = Vec3f(0.0f, 1.0f, 0.0f);	x1[3] = x0[3];
+
+	x0[4] = Vec3f(-1.0f, 0.0f, 0.0f);	x1[4] = x0[4];
+	x0[5] = Vec3f(1.0f, 0.0f, 0.0f);	x1[5] = x0[5];
+	x0[6] = Vec3f(0.0f, -1.0f, 0.5f);	x1[6] = Vec3f(0.0f, -1.0f, -1.5f);
+	x0[7] = Vec3f(0.0f, 1.0f, 0.5f);	x1[7] = Vec3f(0.0f, 1.0f, -1.5f);
+
+	x0[8] = Vec3f(5.0f, 5.0f, 5.0f);	x1[8] = x0[8];
+	x0[9] = Vec3f(6.0f, 5.0f, 5.0f);	x1[9] = x0[9];
+}
+
+TEST(BatchedCCD, Tight)
+{
+	CArray<Vec3f> x0, x1;
+	buildScene(x0, x1);
+
+	CArray<VertexFacePair> vf;
+	vf.pushBack(VertexFacePair(0, 1, 2, 3));
+	vf.pushBack(VertexFacePair(4, 1, 2, 3));
+
+	CArray<EdgeEdgePair> ee;
+	ee.pushBack(EdgeEdgePair(4, 5, 6, 7));
+	ee.pushBack(EdgeEdgePair(8, 9, 6, 7));
+
+	BatchedCCD<float> ccd;
+
+	CArray<float> vfToi, eeToi, vertexToi;
+	ccd.vertexFace(x0, x1, vf, vfToi, vertexToi);
+	ccd.edgeEdge(x0, x1, ee, eeToi, vertexToi);
+
+	EXPECT_NEAR(vfToi[0], 0.5f, 1e-5f);
+	EXPECT_EQ(vfToi[1], 1.0f);
+	EXPECT_NEAR(eeToi[0], 0.25f, 1e-5f);
+	EXPECT_EQ(eeToi[1], 1.0f);
+
+	EXPECT_NEAR(vertexToi[0], 0.5f, 1e-5f);
+	EXPECT_NEAR(vertexToi[1], 0.5f, 1e-5f);
+	EXPECT_NEAR(vertexToi[4], 0.25f, 1e-5f);
+	EXPECT_NEAR(vertexToi[7], 0.25f, 1e-5f);
+
+	EXPECT_EQ(ccd.statistics().pairs, 4u);
+	EXPECT_EQ(ccd.statistics().collisions, 2u);
+}
+
+TEST(BatchedCCD, Additive)
+{
+	CArray<Vec3f> x0, x1;
+	buildScene(x0, x1);
+
+	CArray<VertexFacePair> vf;
+	vf.pushBack(VertexFacePair(0, 1, 2, 3));
+
+	BatchedCCD<float> ccd(BatchedCCD<float>::ADDITIVE);
+	ccd.setAdditiveParameters(0.0f, 0.2f, 0.95f);
+
+	CArray<float> toi, vertexToi;
+	ccd.vertexFace(x0, x1, vf, toi, vertexToi);
+
+	//Conservative advancement stops before the contact
+	EXPECT_LT(toi[0], 0.5f);
+	EXPECT_GT(toi[0], 0.3f);
+}
+
+//The filters must not change the outcome of the exact test
+TEST(BatchedCCD, ConservativeFilters)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	std::mt19937 rng(17);
+	std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+	const uint vertexNum = 400;
+	CArray<Vec3f> x0(vertexNum), x1(vertexNum);
+	for (uint i = 0; i < vertexNum; i++)
+	{
+		x0[i] = Vec3f(dist(rng), dist(rng), dist(rng));
+		x1[i] = x0[i] + 0.3f * Vec3f(dist(rng) - 0.5f, dist(rng) - 0.5f, dist(rng) - 0.5f);
+	}
+
+	CArray<VertexFacePair> vf;
+	CArray<EdgeEdgePair> ee;
+	for (uint i = 0; i < 20000; i++)
+	{
+		uint v[4];
+		v[0] = rng() % vertexNum;
+		for (int k = 1; k < 4; k++)
+		{
+			bool unique;
+			do {
+				v[k] = rng() % vertexNum;
+				unique = true;
+				for (int l = 0; l < k; l++)
+					unique &= v[l] != v[k];
+			} while (!unique);
+		}
+
+		vf.pushBack(VertexFacePair(v[0], v[1], v[2], v[3]));
+		ee.pushBack(EdgeEdgePair(v[0], v[1], v[2], v[3]));
+	}
+
+	BatchedCCD<float> filtered;
+	BatchedCCD<float> exact;
+	exact.setFilters(false, false);
+
+	CArray<float> toi0, toi1, vertexToi0, vertexToi1;
+
+	filtered.vertexFace(x0, x1, vf, toi0, vertexToi0);
+	exact.vertexFace(x0, x1, vf, toi1, vertexToi1);
+	for (uint i = 0; i < vf.size(); i++)
+		EXPECT_EQ(toi0[i], toi1[i]);
+
+	filtered.edgeEdge(x0, x1, ee, toi0, vertexToi0);
+	exact.edgeEdge(x0, x1, ee, toi1, vertexToi1);
+	for (uint i = 0; i < ee.size(); i++)
+		EXPECT_EQ(toi0[i], toi1[i]);
+
+	for (uint i = 0; i < vertexNum; i++)
+		EXPECT_EQ(vertexToi0[i], vertexToi1[i]);
+
+	EXPECT_GT(filtered.statistics().collisions, 0u);
+	EXPECT_EQ(filtered.statistics().collisions, exact.statistics().collisions);
+	EXPECT_GT(filtered.statistics().culledByBounds + filtered.statistics().culledBySign, filtered.statistics().pairs / 2);
+}
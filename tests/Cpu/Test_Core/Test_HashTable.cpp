@@ -0,0 +1,182 @@
+#include "gtest/gtest.h"
+#include "Array/Array.h"
+#include "STL/HashSet.h"
+#include "STL/HashMap.h"
+#include "ThreadPool.h"
+
+#include <set>
+
+using namespace dyno;
+
+__global__ void TK_Dedup(
+	DArray<uint> unique,
+	DArray<uint> keys,
+	HashSet<uint> set)
+{
+	uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+	if (tId >= keys.size()) return;
+
+	unique[tId] = set.insertFirst(keys[tId]) ? 1 : 0;
+}
+
+__global__ void TK_Count(
+	DArray<unsigned long long> keys,
+	HashMap<unsigned long long, uint> map)
+{
+	uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+	if (tId >= keys.size()) return;
+
+	int slot = map.insert(keys[tId]);
+	atomicAdd(&map.value(slot), 1u);
+}
+
+TEST(HashTable, Dedup)
+{
+	uint n = 100000;
+
+	CArray<uint> hKeys(n);
+	for (uint i = 0; i < n; i++)
+		hKeys[i] = (i * 7919u) % 1000u;
+
+	DArray<uint> dKeys;
+	dKeys.assign(hKeys);
+
+	DArray<uint> dUnique(n);
+
+	uint capacity = HashSet<uint>::capacityFor(1000);
+	EXPECT_EQ(capacity, 2048);
+
+	DArray<uint> buffer(capacity);
+	buffer.reset();
+
+	HashSet<uint> set;
+	set.reserve(buffer.begin(), capacity);
+
+	cuExecute(n,
+		TK_Dedup,
+		dUnique,
+		dKeys,
+		set);
+
+	CArray<uint> hUnique;
+	hUnique.assign(dUnique);
+
+	uint count = 0;
+	for (uint i = 0; i < n; i++)
+		count += hUnique[i];
+
+	EXPECT_EQ(count, 1000);
+	EXPECT_TRUE(set.contains(999));
+	EXPECT_FALSE(set.contains(1000));
+	EXPECT_EQ(set.insert(5), set.find(5));
+
+	dKeys.clear();
+	dUnique.clear();
+	buffer.clear();
+}
+
+TEST(HashTable, Map)
+{
+	uint n = 50000;
+
+	CArray<unsigned long long> hKeys(n);
+	for (uint i = 0; i < n; i++)
+		hKeys[i] = ((unsigned long long)(i % 100) << 32) | (i % 100);
+
+	DArray<unsigned long long> dKeys;
+	dKeys.assign(hKeys);
+
+	uint capacity = HashMap<unsigned long long, uint>::capacityFor(100);
+
+	DArray<unsigned long long> keyBuffer(capacity);
+	DArray<uint> valueBuffer(capacity);
+	DArray<uint> readyBuffer(capacity);
+	keyBuffer.reset();
+	valueBuffer.reset();
+	readyBuffer.reset();
+
+	HashMap<unsigned long long, uint> map;
+	map.reserve(keyBuffer.begin(), valueBuffer.begin(), readyBuffer.begin(), capacity);
+
+	cuExecute(n,
+		TK_Count,
+		dKeys,
+		map);
+
+	uint* count = map.get((42ull << 32) | 42ull);
+	ASSERT_NE(count, nullptr);
+	EXPECT_EQ(*count, 500);
+	EXPECT_EQ(map.get(42ull), nullptr);
+
+	dKeys.clear();
+	keyBuffer.clear();
+	valueBuffer.clear();
+	readyBuffer.clear();
+}
+
+TEST(HashTable, HostThreads)
+{
+	std::vector<int> buffer(HashSet<int>::capacityFor(5000), 0);
+
+	HashSet<int> set;
+	set.reserve(buffer.data(), (uint)buffer.size());
+
+	std::atomic<int> inserted(0);
+	ThreadPool::instance()->parallelFor(0, 20000, [&](unsigned int first, unsigned int last) {
+		for (unsigned int i = first; i < last; i++)
+		{
+			if (set.insertFirst(-2 - int(i % 5000)))
+				inserted++;
+		}
+	}, 64);
+
+	EXPECT_EQ(inserted.load(), 5000);
+	EXPECT_TRUE(set.contains(-5001));
+	EXPECT_FALSE(set.contains(2));
+
+	//A full table reports failure
+	std::vector<uint> small(16, 0);
+	HashSet<uint> full;
+	full.reserve(small.data(), 16);
+	for (uint i = 0; i < 16; i++)
+		EXPECT_GE(full.insert(i), 0);
+	EXPECT_EQ(full.insert(100), -1);
+}
+
+TEST(HashTable, MapPublication)
+{
+	const uint n = 4096;
+
+	uint capacity = HashMap<uint, uint>::capacityFor(n);
+	std::vector<uint> keys(capacity, 0);
+	std::vector<uint> values(capacity, 0);
+	std::vector<uint> ready(capacity, 0);
+
+	HashMap<uint, uint> map;
+	map.reserve(keys.data(), values.data(), ready.data(), capacity);
+
+	//Half of the tasks insert while the other half look the keys up, a value must never be seen before it is written
+	std::atomic<int> mismatches(0);
+	ThreadPool::instance()->parallelFor(0, 2 * n, [&](unsigned int first, unsigned int last) {
+		for (unsigned int i = first; i < last; i++)
+		{
+			uint key = i / 2;
+			if (i % 2 == 0)
+				map.insert(key, 3 * key + 1);
+			else
+			{
+				uint* val = map.get(key);
+				if (val != nullptr && *val != 3 * key + 1)
+					mismatches++;
+			}
+		}
+	}, 16);
+
+	EXPECT_EQ(mismatches.load(), 0);
+	for (uint key = 0; key < n; key++)
+	{
+		uint* val = map.get(key);
+		ASSERT_NE(val, nullptr);
+		EXPECT_EQ(*val, 3 * key + 1);
+	}
+}
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "Array/ArrayList.h"
+#include "Algorithm/HostScan.h"
+#include "Algorithm/HostReduction.h"
+
+using namespace dyno;
+
+TEST(HostScan, Exclusive)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	for (uint n : { 1u, 7u, 100u, 16385u, 1000003u })
+	{
+		CArray<uint> input(n);
+		for (uint i = 0; i < n; i++)
+			input[i] = i % 13;
+
+		CArray<uint> output;
+
+		HostScan<uint> scan;
+		scan.exclusive(output, input);
+
+		uint sum = 0;
+		bool correct = true;
+		for (uint i = 0; i < n; i++)
+		{
+			correct &= output[i] == sum;
+			sum += input[i];
+		}
+		EXPECT_TRUE(correct);
+
+		//In place
+		scan.inclusive(input);
+
+		sum = 0;
+		correct = true;
+		for (uint i = 0; i < n; i++)
+		{
+			sum += i % 13;
+			correct &= input[i] == sum;
+		}
+		EXPECT_TRUE(correct);
+	}
+}
+
+TEST(HostScan, Float)
+{
+	CArray<float> input(100000);
+	for (uint i = 0; i < input.size(); i++)
+		input[i] = 0.5f;
+
+	HostScan<float> scan;
+	scan.inclusive(input);
+
+	EXPECT_FLOAT_EQ(input[0], 0.5f);
+	EXPECT_FLOAT_EQ(input[99999], 50000.0f);
+}
+
+TEST(HostReduction, Scalar)
+{
+	CArray<int> arr(300001);
+	for (uint i = 0; i < arr.size(); i++)
+		arr[i] = int(i % 1000) - 500;
+
+	arr[123457] = 10000;
+	arr[7] = -10000;
+
+	HostReduction<int> reduce;
+	EXPECT_EQ(reduce.maximum(arr), 10000);
+	EXPECT_EQ(reduce.minimum(arr), -10000);
+
+	long long sum = 0;
+	for (uint i = 0; i < arr.size(); i++)
+		sum += arr[i];
+	EXPECT_EQ(reduce.accumulate(arr), (int)sum);
+
+	CArray<double> darr(1000);
+	for (uint i = 0; i < darr.size(); i++)
+		darr[i] = i;
+
+	HostReduction<double> dreduce;
+	EXPECT_DOUBLE_EQ(dreduce.average(darr), 499.5);
+	EXPECT_DOUBLE_EQ(dreduce.minimum(darr), 0.0);
+	EXPECT_DOUBLE_EQ(dreduce.maximum(darr), 999.0);
+}
+
+TEST(HostReduction, Vec3f)
+{
+	CArray<Vec3f> arr(50001);
+	for (uint i = 0; i < arr.size(); i++)
+		arr[i] = Vec3f(1.0f, float(i % 100), -float(i % 50));
+
+	HostReduction<Vec3f> reduce;
+
+	Vec3f vmax = reduce.maximum(arr);
+	Vec3f vmin = reduce.minimum(arr);
+	Vec3f vsum = reduce.accumulate(arr);
+
+	EXPECT_FLOAT_EQ(vmax[1], 99.0f);
+	EXPECT_FLOAT_EQ(vmax[2], 0.0f);
+	EXPECT_FLOAT_EQ(vmin[1], 0.0f);
+	EXPECT_FLOAT_EQ(vmin[2], -49.0f);
+	EXPECT_FLOAT_EQ(vsum[0], 50001.0f);
+}
+
+TEST(HostScan, ArrayList)
+{
+	CArray<uint> counts(20000);
+	for (uint i = 0; i < counts.size(); i++)
+		counts[i] = i % 3;
+
+	CArrayList<int> lists;
+	lists.resize(counts);
+
+	EXPECT_EQ(lists.elementSize(), 19999);
+	EXPECT_EQ(lists.size(19999), 1);
+}
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include "Array/HostArray.h"
+#include "Vector.h"
+
+#include <cstdint>
+
+using namespace dyno;
+
+TEST(HostArray, Resize)
+{
+	HostArray<float> arr;
+	EXPECT_TRUE(arr.isEmpty());
+
+	arr.resize(100);
+	EXPECT_EQ(arr.size(), 100);
+	EXPECT_EQ((uintptr_t)arr.begin() % 64, 0);
+
+	for (uint i = 0; i < arr.size(); i++)
+		arr[i] = float(i);
+
+	//Shrinking and growing within the capacity keeps the buffer
+	float* ptr = arr.begin();
+	arr.resize(10);
+	arr.resize(100);
+	EXPECT_EQ(arr.begin(), ptr);
+	EXPECT_FLOAT_EQ(arr[99], 99.0f);
+
+	//Growing beyond the capacity keeps the existing elements
+	arr.resize(1000);
+	EXPECT_GE(arr.capacity(), 1000);
+	EXPECT_FLOAT_EQ(arr[99], 99.0f);
+
+	arr.reset();
+	EXPECT_FLOAT_EQ(arr[999], 0.0f);
+
+	arr.clear();
+	EXPECT_EQ(arr.begin(), nullptr);
+}
+
+TEST(HostArray, PushBack)
+{
+	HostArray<int> arr;
+	for (int i = 0; i < 1000; i++)
+		arr.pushBack(i);
+
+	EXPECT_EQ(arr.size(), 1000);
+	EXPECT_EQ(arr[999], 999);
+
+	HostArray<int> moved(std::move(arr));
+	EXPECT_EQ(arr.size(), 0);
+	EXPECT_EQ(moved[500], 500);
+}
+
+TEST(HostArray, Assign)
+{
+	//Large enough to take the huge page path
+	uint n = 1 << 20;
+
+	CArray<Vec3f> hSrc(n);
+	for (uint i = 0; i < n; i++)
+		hSrc[i] = Vec3f(float(i), 1.0f, 2.0f);
+
+	DArray<Vec3f> dArr;
+	dArr.assign(hSrc);
+
+	HostArray<Vec3f> hArr;
+	hArr.assign(dArr);
+	EXPECT_EQ(hArr.size(), n);
+	EXPECT_FLOAT_EQ(hArr[n - 1][0], float(n - 1));
+
+	hArr[0] = Vec3f(-1.0f);
+
+	DArray<Vec3f> dCopy;
+	dCopy.assign(hArr);
+
+	CArray<Vec3f> hDst;
+	hDst.assign(dCopy);
+	EXPECT_FLOAT_EQ(hDst[0][1], -1.0f);
+	EXPECT_FLOAT_EQ(hDst[n - 1][2], 2.0f);
+
+	dArr.clear();
+	dCopy.clear();
+}
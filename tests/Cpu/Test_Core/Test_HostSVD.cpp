@@ -0,0 +1,231 @@
+#include "gtest/gtest.h"
+#include "Algorithm/HostSVD.h"
+#include "Matrix/MatrixFunc.h"
+#include "ThreadPool.h"
+
+#include <random>
+#include <vector>
+
+using namespace dyno;
+
+static void buildMatrices(std::vector<Mat3f>& A, size_t num, std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	A.resize(num);
+	for (size_t n = 0; n < num; n++)
+	{
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				A[n](i, j) = dist(rng);
+	}
+
+	//Degenerate cases
+	if (num > 4)
+	{
+		A[0] = Mat3f::identityMatrix();
+		A[1] = Mat3f(0.0f);
+		A[2] = Mat3f(1.0f);
+		A[3] = Mat3f(2.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.5f);
+	}
+}
+
+static float maxError(const Mat3f& a, const Mat3f& b)
+{
+	float err = 0.0f;
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+			err = std::max(err, std::abs(a(i, j) - b(i, j)));
+	return err;
+}
+
+static void checkDecomposition(const std::vector<Mat3f>& A, const std::vector<Mat3f>& U, const std::vector<Vec3f>& S, const std::vector<Mat3f>& V)
+{
+	for (size_t n = 0; n < A.size(); n++)
+	{
+		Mat3f D(0.0f);
+		D(0, 0) = S[n][0];
+		D(1, 1) = S[n][1];
+		D(2, 2) = S[n][2];
+
+		EXPECT_LT(maxError(U[n] * D * V[n].transpose(), A[n]), 2e-4f);
+		EXPECT_LT(maxError(U[n] * U[n].transpose(), Mat3f::identityMatrix()), 2e-4f);
+		EXPECT_LT(maxError(V[n] * V[n].transpose(), Mat3f::identityMatrix()), 2e-4f);
+		EXPECT_NEAR(U[n].determinant(), 1.0f, 2e-4f);
+		EXPECT_NEAR(V[n].determinant(), 1.0f, 2e-4f);
+
+		EXPECT_GE(std::abs(S[n][0]), std::abs(S[n][1]) - 1e-5f);
+		EXPECT_GE(std::abs(S[n][1]), std::abs(S[n][2]) - 1e-5f);
+		EXPECT_GE(S[n][1], -1e-5f);
+	}
+}
+
+TEST(HostSVD, Decomposition)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	std::mt19937 rng(7);
+
+	simd::InstructionSet isas[] = { simd::ISA_SCALAR, simd::ISA_AVX2, simd::ISA_AVX512, simd::ISA_AUTO };
+
+	for (size_t num : { 1, 7, 17, 1000, 5003 })
+	{
+		std::vector<Mat3f> A;
+		buildMatrices(A, num, rng);
+
+		std::vector<Mat3f> U0(num), V0(num);
+		std::vector<Vec3f> S0(num);
+		HostSVD::svd(A.data(), U0.data(), S0.data(), V0.data(), num, simd::ISA_SCALAR);
+		checkDecomposition(A, U0, S0, V0);
+
+		//Unsupported instruction sets fall back to the scalar path
+		for (auto isa : isas)
+		{
+			std::vector<Mat3f> U(num), V(num);
+			std::vector<Vec3f> S(num);
+			HostSVD::svd(A.data(), U.data(), S.data(), V.data(), num, isa);
+			checkDecomposition(A, U, S, V);
+
+			for (size_t n = 0; n < num; n++)
+			{
+				EXPECT_NEAR(S[n][0], S0[n][0], 1e-4f);
+				EXPECT_NEAR(S[n][1], S0[n][1], 1e-4f);
+				EXPECT_NEAR(S[n][2], S0[n][2], 1e-4f);
+			}
+		}
+	}
+}
+
+TEST(HostSVD, StructureOfArrays)
+{
+	std::mt19937 rng(3);
+
+	const size_t num = 333;
+	std::vector<Mat3f> A;
+	buildMatrices(A, num, rng);
+
+	std::vector<float> a(9 * num), u(9 * num), s(3 * num), v(9 * num);
+	const float* pa[9];
+	float* pu[9];
+	float* ps[3];
+	float* pv[9];
+	for (int k = 0; k < 9; k++)
+	{
+		pa[k] = &a[k * num];
+		pu[k] = &u[k * num];
+		pv[k] = &v[k * num];
+	}
+	for (int k = 0; k < 3; k++)
+		ps[k] = &s[k * num];
+
+	for (size_t n = 0; n < num; n++)
+		for (int k = 0; k < 9; k++)
+			a[k * num + n] = A[n](k / 3, k % 3);
+
+	HostSVD::svd(pa, pu, ps, pv, num);
+
+	std::vector<Mat3f> U(num), V(num);
+	std::vector<Vec3f> S(num);
+	for (size_t n = 0; n < num; n++)
+	{
+		for (int k = 0; k < 9; k++)
+		{
+			U[n](k / 3, k % 3) = pu[k][n];
+			V[n](k / 3, k % 3) = pv[k][n];
+		}
+		S[n] = Vec3f(ps[0][n], ps[1][n], ps[2][n]);
+	}
+
+	checkDecomposition(A, U, S, V);
+}
+
+TEST(HostSVD, PolarDecomposition)
+{
+	std::mt19937 rng(5);
+
+	const size_t num = 500;
+	std::vector<Mat3f> A;
+	buildMatrices(A, num, rng);
+
+	std::vector<Mat3f> R(num), D(num);
+	HostSVD::polarDecomposition(A.data(), R.data(), nullptr, D.data(), nullptr, num);
+
+	for (size_t n = 0; n < num; n++)
+	{
+		EXPECT_LT(maxError(R[n] * R[n].transpose(), Mat3f::identityMatrix()), 2e-4f);
+		EXPECT_NEAR(R[n].determinant(), 1.0f, 2e-4f);
+
+		//Agrees with the single matrix version
+		Mat3f r, u, d, v;
+		polarDecomposition(A[n], r, u, d, v);
+		EXPECT_LT(maxError(r, R[n]), 1e-4f);
+		EXPECT_LT(maxError(u * d * v.transpose(), A[n]), 2e-4f);
+
+		//A well conditioned matrix with a positive determinant is closest to R among all rotations, A = R * S with S symmetric
+		if (A[n].determinant() > 0.05f)
+		{
+			Mat3f S = R[n].transpose() * A[n];
+			EXPECT_LT(maxError(S, S.transpose()), 5e-4f);
+		}
+	}
+}
+
+TEST(HostSVD, Degenerate)
+{
+	std::vector<Mat3f> A;
+	A.push_back(Mat3f(1.0f));
+	A.push_back(Mat3f(1e-8f));
+	A.push_back(Mat3f(0.0f));
+	A.push_back(Mat3f(1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 6.0f, 1.0f, 1.0f, 1.0f));
+	A.push_back(Mat3f(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+	A.push_back(Mat3f(3.0f, 0.0f, 0.0f, 0.0f, 3.0f, 0.0f, 0.0f, 0.0f, 3.0f));
+
+	size_t num = A.size();
+
+	std::vector<Mat3f> R0(num), U0(num), D0(num), V0(num);
+	HostSVD::polarDecomposition(A.data(), R0.data(), U0.data(), D0.data(), V0.data(), num, simd::ISA_SCALAR);
+
+	//The rotation of a rank deficient matrix is not unique, all instruction sets must still pick the same one
+	simd::InstructionSet isas[] = { simd::ISA_AVX2, simd::ISA_AVX512 };
+	for (auto isa : isas)
+	{
+		std::vector<Mat3f> R(num), U(num), D(num), V(num);
+		HostSVD::polarDecomposition(A.data(), R.data(), U.data(), D.data(), V.data(), num, isa);
+
+		for (size_t n = 0; n < num; n++)
+		{
+			EXPECT_LT(maxError(R[n], R0[n]), 1e-4f);
+			EXPECT_LT(maxError(U[n] * D[n] * V[n].transpose(), A[n]), 2e-4f);
+			EXPECT_NEAR(R[n].determinant(), 1.0f, 2e-4f);
+		}
+	}
+}
+
+TEST(HostSVD, Convergence)
+{
+	std::mt19937 rng(11);
+
+	//The sweeps stop relative to the scale of the matrices
+	for (float scale : { 1e-4f, 1.0f, 1e4f })
+	{
+		const size_t num = 1000;
+		std::vector<Mat3f> A;
+		buildMatrices(A, num, rng);
+		for (size_t n = 0; n < num; n++)
+			A[n] *= scale;
+
+		std::vector<Mat3f> U(num), V(num);
+		std::vector<Vec3f> S(num);
+		HostSVD::svd(A.data(), U.data(), S.data(), V.data(), num);
+
+		for (size_t n = 0; n < num; n++)
+		{
+			Mat3f D(0.0f);
+			D(0, 0) = S[n][0];
+			D(1, 1) = S[n][1];
+			D(2, 2) = S[n][2];
+
+			EXPECT_LT(maxError(U[n] * D * V[n].transpose(), A[n]), 2e-5f * scale);
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+#include "Array/Array.h"
+#include "Array/Array3D.h"
+#include "Array/ArrayList.h"
+#include "Algorithm/Reduction.h"
+
+using namespace dyno;
+
+template<typename T>
+__global__ void TK_Fill(
+	DArray<T> arr)
+{
+	uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+	if (tId >= arr.size()) return;
+
+	arr[tId] = T(tId);
+}
+
+__global__ void TK_Sum(
+	DArray<uint> sum,
+	DArray<uint> arr)
+{
+	uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+	if (tId >= arr.size()) return;
+
+	atomicAdd(&sum[0], arr[tId]);
+}
+
+__global__ void TK_Grid(
+	DArray3D<float> grid)
+{
+	uint i = threadIdx.x + blockIdx.x * blockDim.x;
+	uint j = threadIdx.y + blockIdx.y * blockDim.y;
+	uint k = threadIdx.z + blockIdx.z * blockDim.z;
+
+	if (i >= grid.nx() || j >= grid.ny() || k >= grid.nz()) return;
+
+	grid(i, j, k) = i + 10 * j + 100 * k;
+}
+
+__global__ void TK_Insert(
+	DArrayList<int> lists)
+{
+	uint tId = threadIdx.x + (blockIdx.x * blockDim.x);
+	if (tId >= lists.size()) return;
+
+	List<int>& list = lists[tId];
+	for (uint i = 0; i < tId % 5; i++)
+	{
+		list.atomicInsert(tId);
+	}
+}
+
+TEST(Kernel, cuExecute)
+{
+	DArray<uint> dArr(10000);
+	cuExecute(dArr.size(),
+		TK_Fill,
+		dArr);
+
+	CArray<uint> hArr;
+	hArr.assign(dArr);
+
+	bool correct = true;
+	for (uint i = 0; i < hArr.size(); i++)
+		correct &= hArr[i] == i;
+
+	EXPECT_EQ(correct, true);
+
+	DArray<uint> dSum(1);
+	dSum.reset();
+	cuExecute(dArr.size(),
+		TK_Sum,
+		dSum,
+		dArr);
+
+	CArray<uint> hSum;
+	hSum.assign(dSum);
+
+	Reduction<uint> reduce;
+	EXPECT_EQ(hSum[0], 49995000);
+	EXPECT_EQ(reduce.accumulate(dArr.begin(), dArr.size()), 49995000);
+
+	dArr.clear();
+	dSum.clear();
+}
+
+TEST(Kernel, cuExecute3D)
+{
+	DArray3D<float> dGrid(17, 9, 5);
+	cuExecute3D(make_uint3(dGrid.nx(), dGrid.ny(), dGrid.nz()),
+		TK_Grid,
+		dGrid);
+
+	CArray3D<float> hGrid;
+	hGrid.assign(dGrid);
+
+	EXPECT_EQ(hGrid(16, 8, 4), 496.0f);
+	EXPECT_EQ(hGrid(3, 2, 1), 123.0f);
+
+	dGrid.clear();
+}
+
+TEST(Kernel, ArrayList)
+{
+	CArray<uint> hCounts(1000);
+	for (uint i = 0; i < hCounts.size(); i++)
+		hCounts[i] = i % 5;
+
+	DArray<uint> dCounts;
+	dCounts.assign(hCounts);
+
+	DArrayList<int> dLists;
+	dLists.resize(dCounts);
+
+	cuExecute(dLists.size(),
+		TK_Insert,
+		dLists);
+
+	CArrayList<int> hLists;
+	hLists.assign(dLists);
+
+	EXPECT_EQ(dLists.elementSize(), 2000);
+	EXPECT_EQ(hLists[999].size(), 4);
+	EXPECT_EQ(hLists[999][3], 999);
+
+	dCounts.clear();
+	dLists.clear();
+}
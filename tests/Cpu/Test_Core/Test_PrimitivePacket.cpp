@@ -0,0 +1,192 @@
+#include "gtest/gtest.h"
+#include "Primitive/PrimitivePacket.h"
+
+#include <random>
+#include <vector>
+#include <cstring>
+
+using namespace dyno;
+
+struct TriangleSet
+{
+	std::vector<float> coords[3][3];
+
+	TriangleSoA soa() const
+	{
+		TriangleSoA t;
+		for (int k = 0; k < 3; k++)
+			for (int d = 0; d < 3; d++)
+				t.v[k][d] = coords[k][d].data();
+		return t;
+	}
+
+	TTriangle3D<float> triangle(size_t i) const
+	{
+		return TTriangle3D<float>(
+			Vec3f(coords[0][0][i], coords[0][1][i], coords[0][2][i]),
+			Vec3f(coords[1][0][i], coords[1][1][i], coords[1][2][i]),
+			Vec3f(coords[2][0][i], coords[2][1][i], coords[2][2][i]));
+	}
+};
+
+static void buildTriangles(TriangleSet& set, size_t num, std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	for (int k = 0; k < 3; k++)
+		for (int d = 0; d < 3; d++)
+			set.coords[k][d].resize(num);
+
+	for (size_t i = 0; i < num; i++)
+	{
+		Vec3f o(dist(rng), dist(rng), dist(rng));
+		for (int k = 0; k < 3; k++)
+		{
+			Vec3f p = o + 0.3f * Vec3f(dist(rng), dist(rng), dist(rng));
+
+			//Some degenerate triangles
+			if (i % 97 == 0 && k == 2)
+				p = Vec3f(set.coords[1][0][i], set.coords[1][1][i], set.coords[1][2][i]);
+
+			for (int d = 0; d < 3; d++)
+				set.coords[k][d][i] = p[d];
+		}
+	}
+}
+
+static const simd::InstructionSet isas[] = { simd::ISA_AVX2, simd::ISA_AVX512, simd::ISA_AUTO };
+
+TEST(PrimitivePacket, PointTriangles)
+{
+	std::mt19937 rng(23);
+
+	for (size_t num : { 1, 5, 16, 37, 1000 })
+	{
+		TriangleSet set;
+		buildTriangles(set, num, rng);
+
+		for (int q = 0; q < 20; q++)
+		{
+			Vec3f p(rng() % 200 / 100.0f - 1.0f, rng() % 200 / 100.0f - 1.0f, rng() % 200 / 100.0f - 1.0f);
+
+			std::vector<float> d0(num), u0(num), v0(num);
+			PrimitivePacket::pointTriangles(p, set.soa(), num, d0.data(), u0.data(), v0.data(), simd::ISA_SCALAR);
+
+			//Validate the scalar reference against Primitive3D
+			for (size_t i = 0; i < num; i++)
+			{
+				TTriangle3D<float> tri = set.triangle(i);
+				if (tri.area() < 1e-6f)
+					continue;
+
+				float ref = TPoint3D<float>(p).distanceSquared(tri);
+				EXPECT_NEAR(d0[i], ref, 1e-4f * (1.0f + ref));
+
+				Vec3f c = tri.v[0] + u0[i] * (tri.v[1] - tri.v[0]) + v0[i] * (tri.v[2] - tri.v[0]);
+				EXPECT_NEAR((c - p).normSquared(), d0[i], 1e-4f * (1.0f + ref));
+			}
+
+			//The SIMD paths return the same bits
+			for (auto isa : isas)
+			{
+				std::vector<float> d(num), u(num), v(num);
+				PrimitivePacket::pointTriangles(p, set.soa(), num, d.data(), u.data(), v.data(), isa);
+
+				EXPECT_EQ(memcmp(d.data(), d0.data(), num * sizeof(float)), 0);
+				EXPECT_EQ(memcmp(u.data(), u0.data(), num * sizeof(float)), 0);
+				EXPECT_EQ(memcmp(v.data(), v0.data(), num * sizeof(float)), 0);
+
+				std::vector<float> dOnly(num);
+				PrimitivePacket::pointTriangles(p, set.soa(), num, dOnly.data(), nullptr, nullptr, isa);
+				EXPECT_EQ(memcmp(dOnly.data(), d0.data(), num * sizeof(float)), 0);
+			}
+
+			float closestDist;
+			size_t closest = PrimitivePacket::closestTriangle(p, set.soa(), num, closestDist);
+			ASSERT_LT(closest, num);
+			for (size_t i = 0; i < num; i++)
+				EXPECT_LE(closestDist, d0[i]);
+		}
+	}
+}
+
+TEST(PrimitivePacket, PointsTriangle)
+{
+	std::mt19937 rng(29);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	const size_t num = 1003;
+	std::vector<float> x[3];
+	for (int d = 0; d < 3; d++)
+	{
+		x[d].resize(num);
+		for (size_t i = 0; i < num; i++)
+			x[d][i] = dist(rng);
+	}
+	PointSoA points = { { x[0].data(), x[1].data(), x[2].data() } };
+
+	TTriangle3D<float> tri(Vec3f(-0.5f, -0.3f, 0.1f), Vec3f(0.6f, -0.2f, -0.1f), Vec3f(0.0f, 0.7f, 0.2f));
+
+	std::vector<float> d0(num);
+	PrimitivePacket::pointsTriangle(points, tri, num, d0.data(), nullptr, nullptr, simd::ISA_SCALAR);
+
+	for (size_t i = 0; i < num; i++)
+	{
+		float ref = TPoint3D<float>(Vec3f(x[0][i], x[1][i], x[2][i])).distanceSquared(tri);
+		EXPECT_NEAR(d0[i], ref, 1e-5f);
+	}
+
+	for (auto isa : isas)
+	{
+		std::vector<float> d(num);
+		PrimitivePacket::pointsTriangle(points, tri, num, d.data(), nullptr, nullptr, isa);
+		EXPECT_EQ(memcmp(d.data(), d0.data(), num * sizeof(float)), 0);
+	}
+}
+
+TEST(PrimitivePacket, SegmentTriangles)
+{
+	std::mt19937 rng(31);
+
+	const size_t num = 777;
+	TriangleSet set;
+	buildTriangles(set, num, rng);
+
+	for (int q = 0; q < 20; q++)
+	{
+		Vec3f p0(rng() % 200 / 100.0f - 1.0f, rng() % 200 / 100.0f - 1.0f, -1.5f);
+		Vec3f p1(rng() % 200 / 100.0f - 1.0f, rng() % 200 / 100.0f - 1.0f, 1.5f);
+
+		std::vector<float> t0(num);
+		PrimitivePacket::segmentTriangles(p0, p1, set.soa(), num, t0.data(), simd::ISA_SCALAR);
+
+		size_t hits = 0;
+		for (size_t i = 0; i < num; i++)
+		{
+			TTriangle3D<float> tri = set.triangle(i);
+			if (tri.area() < 1e-6f)
+				continue;
+
+			TPoint3D<float> inter;
+			bool ref = TSegment3D<float>(p0, p1).intersect(tri, inter);
+
+			//Skip grazing hits where both tests may legitimately disagree
+			float d2 = TPoint3D<float>(p0 + t0[i] * (p1 - p0)).distanceSquared(tri);
+			if (ref != (t0[i] <= 1.0f) && std::abs(d2) > 1e-8f)
+				ADD_FAILURE() << "triangle " << i;
+
+			if (t0[i] <= 1.0f)
+			{
+				hits++;
+				EXPECT_LT(d2, 1e-8f);
+			}
+		}
+		(void)hits;
+
+		for (auto isa : isas)
+		{
+			std::vector<float> t(num);
+			PrimitivePacket::segmentTriangles(p0, p1, set.soa(), num, t.data(), isa);
+			EXPECT_EQ(memcmp(t.data(), t0.data(), num * sizeof(float)), 0);
+		}
+	}
+}
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace dyno;
+
+TEST(Profiler, Zones)
+{
+	Profiler* profiler = Profiler::instance();
+	profiler->clear();
+
+	{
+		PROFILE_ZONE("Disabled");
+	}
+	EXPECT_EQ(profiler->events().size(), 0);
+
+	Profiler::setEnabled(true);
+
+	{
+		PROFILE_ZONE("Outer", ProfileCategory::Node, 7);
+		for (int i = 0; i < 10; i++)
+		{
+			ProfileZone zone(std::string("Inner"), ProfileCategory::Module, i % 2);
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+	}
+
+	Profiler::setEnabled(false);
+
+	auto events = profiler->events();
+	ASSERT_EQ(events.size(), 11);
+
+	EXPECT_STREQ(events[0].name, "Outer");
+	EXPECT_EQ(events[0].depth, 0);
+	EXPECT_EQ(events[0].instance, 7);
+	for (size_t i = 1; i < events.size(); i++)
+	{
+		EXPECT_STREQ(events[i].name, "Inner");
+		EXPECT_EQ(events[i].depth, 1);
+		EXPECT_GE(events[i].begin, events[0].begin);
+		EXPECT_LE(events[i].end, events[0].end);
+	}
+
+	auto stats = profiler->statistics();
+	ASSERT_EQ(stats.size(), 2);
+	for (auto& s : stats)
+	{
+		if (s.name == "Inner")
+		{
+			EXPECT_EQ(s.count, 10);
+			EXPECT_GE(s.p50, 0.1);
+			EXPECT_LE(s.min, s.p50);
+			EXPECT_LE(s.p50, s.p99);
+			EXPECT_LE(s.p99, s.max);
+			EXPECT_NEAR(s.mean * s.count, s.total, 1e-9);
+		}
+	}
+
+	auto perInstance = profiler->statistics(true);
+	EXPECT_EQ(perInstance.size(), 3);
+
+	profiler->clear();
+	EXPECT_EQ(profiler->events().size(), 0);
+}
+
+TEST(Profiler, Threads)
+{
+	Profiler* profiler = Profiler::instance();
+	profiler->clear();
+
+	ThreadPool::instance()->setThreadNumber(4);
+
+	Profiler::setEnabled(true);
+
+	// More zones than a single chunk holds
+	ThreadPool::instance()->parallelFor(0, 20000, [&](unsigned int first, unsigned int last) {
+		for (unsigned int i = first; i < last; i++)
+		{
+			PROFILE_ZONE("Task", ProfileCategory::Kernel);
+		}
+	}, 100);
+
+	Profiler::setEnabled(false);
+
+	auto events = profiler->events();
+	EXPECT_EQ(events.size(), 20000);
+
+	auto stats = profiler->statistics();
+	ASSERT_EQ(stats.size(), 1);
+	EXPECT_EQ(stats[0].count, 20000);
+	EXPECT_EQ(stats[0].category, ProfileCategory::Kernel);
+
+	std::string filename = "profiler_trace.json";
+	EXPECT_TRUE(profiler->exportChromeTrace(filename));
+
+	std::ifstream input(filename);
+	std::stringstream buffer;
+	buffer << input.rdbuf();
+	std::string trace = buffer.str();
+
+	EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+	EXPECT_NE(trace.find("\"name\":\"Task\",\"cat\":\"Kernel\",\"ph\":\"X\""), std::string::npos);
+	EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+
+	input.close();
+	std::remove(filename.c_str());
+
+	profiler->clear();
+}
@@ -0,0 +1,206 @@
+#include "gtest/gtest.h"
+#include "Array/ArrayList.h"
+#include "Algorithm/SegmentedScan.h"
+#include "Algorithm/Compaction.h"
+#include "Algorithm/HostSegmentedScan.h"
+#include "Algorithm/HostCompaction.h"
+
+#include <random>
+#include <functional>
+
+using namespace dyno;
+
+//Skewed row lengths: mostly short rows, some empty ones and a few very long ones
+static void buildSkewedCounts(CArray<uint>& counts, uint rows, std::mt19937& rng)
+{
+	counts.resize(rows);
+	for (uint i = 0; i < rows; i++)
+	{
+		uint r = rng() % 100;
+		counts[i] = r < 10 ? 0 : (r < 98 ? rng() % 8 : 1000 + rng() % 20000);
+	}
+}
+
+TEST(SegmentedScan, ReduceAndScan)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	std::mt19937 rng(11);
+
+	for (uint rows : { 1u, 5u, 3000u, 50000u })
+	{
+		CArray<uint> hCounts;
+		buildSkewedCounts(hCounts, rows, rng);
+
+		CArrayList<int> hList;
+		hList.resize(hCounts);
+
+		std::vector<std::vector<int>> ref(rows);
+		for (uint i = 0; i < rows; i++)
+		{
+			for (uint k = 0; k < hCounts[i]; k++)
+			{
+				int v = int(rng() % 21) - 10;
+				hList[i].insert(v);
+				ref[i].push_back(v);
+			}
+		}
+
+		DArrayList<int> list;
+		list.assign(hList);
+
+		SegmentedScan<int> seg;
+
+		DArray<int> sums;
+		seg.sum(sums, list);
+
+		DArray<int> maxima;
+		seg.reduce(maxima, list, -100, [](int a, int b) { return a > b ? a : b; });
+
+		DArray<int> weighted;
+		seg.transformReduce(weighted, list, [](uint row, int e) { return int(row % 3) * e; }, 0, std::plus<int>());
+
+		CArray<int> hSums, hMaxima, hWeighted;
+		hSums.assign(sums);
+		hMaxima.assign(maxima);
+		hWeighted.assign(weighted);
+
+		bool correct = true;
+		for (uint i = 0; i < rows; i++)
+		{
+			int s = 0, m = -100, w = 0;
+			for (int v : ref[i])
+			{
+				s += v;
+				m = v > m ? v : m;
+				w += int(i % 3) * v;
+			}
+			correct &= hSums[i] == s && hMaxima[i] == m && hWeighted[i] == w;
+		}
+		EXPECT_TRUE(correct);
+
+		seg.exclusive(list, 5, std::plus<int>());
+
+		CArrayList<int> hScanned;
+		hScanned.assign(list);
+
+		correct = true;
+		for (uint i = 0; i < rows; i++)
+		{
+			int s = 5;
+			for (uint k = 0; k < ref[i].size(); k++)
+			{
+				correct &= hScanned[i][k] == s;
+				s += ref[i][k];
+			}
+		}
+		EXPECT_TRUE(correct);
+
+		list.clear();
+		sums.clear();
+		maxima.clear();
+		weighted.clear();
+	}
+}
+
+TEST(SegmentedScan, HostInclusive)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	std::mt19937 rng(5);
+
+	CArray<uint> counts;
+	buildSkewedCounts(counts, 20000, rng);
+
+	CArrayList<float> list;
+	list.resize(counts);
+
+	for (uint i = 0; i < list.size(); i++)
+	{
+		for (uint k = 0; k < counts[i]; k++)
+			list[i].insert(1.0f);
+	}
+
+	HostSegmentedScan<float> seg;
+	seg.inclusive(list, std::plus<float>());
+
+	CArray<float> last;
+	seg.reduce(last, list, 0.0f, [](float a, float b) { return a > b ? a : b; });
+
+	bool correct = true;
+	for (uint i = 0; i < list.size(); i++)
+	{
+		for (uint k = 0; k < counts[i]; k++)
+			correct &= list[i][k] == float(k + 1);
+
+		correct &= last[i] == float(counts[i]);
+	}
+	EXPECT_TRUE(correct);
+}
+
+TEST(Compaction, CompactAndPartition)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	std::mt19937 rng(3);
+
+	for (uint n : { 0u, 1u, 100u, 16384u, 300001u })
+	{
+		std::vector<uint> hFlags(n);
+		std::vector<int> hValues(n);
+		for (uint i = 0; i < n; i++)
+		{
+			hFlags[i] = rng() % 3 == 0 ? 1 : 0;
+			hValues[i] = int(i) * 7;
+		}
+
+		DArray<uint> flags;
+		flags.assign(hFlags);
+
+		DArray<int> values;
+		values.assign(hValues);
+
+		Compaction compaction;
+
+		DArray<uint> ids;
+		uint count = compaction.compact(ids, flags);
+
+		DArray<int> selected;
+		uint count2 = compaction.compact(selected, values, flags);
+
+		DArray<uint> order;
+		uint count3 = compaction.partition(order, flags);
+
+		CArray<uint> hIds, hOrder;
+		CArray<int> hSelected;
+		hIds.assign(ids);
+		hSelected.assign(selected);
+		hOrder.assign(order);
+
+		std::vector<uint> refT, refF;
+		for (uint i = 0; i < n; i++)
+			(hFlags[i] ? refT : refF).push_back(i);
+
+		EXPECT_EQ(count, (uint)refT.size());
+		EXPECT_EQ(count2, (uint)refT.size());
+		EXPECT_EQ(count3, (uint)refT.size());
+		ASSERT_EQ(hIds.size(), refT.size());
+		ASSERT_EQ(hSelected.size(), refT.size());
+		ASSERT_EQ(hOrder.size(), n);
+
+		bool correct = true;
+		for (uint i = 0; i < refT.size(); i++)
+			correct &= hIds[i] == refT[i] && hSelected[i] == int(refT[i]) * 7 && hOrder[i] == refT[i];
+
+		for (uint i = 0; i < refF.size(); i++)
+			correct &= hOrder[count + i] == refF[i];
+
+		EXPECT_TRUE(correct);
+
+		flags.clear();
+		values.clear();
+		ids.clear();
+		selected.clear();
+		order.clear();
+	}
+}
@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "Array/Array.h"
+#include "Algorithm/Sort.h"
+#include "Algorithm/HostSort.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace dyno;
+
+TEST(Sort, Keys)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	std::mt19937 rng(7);
+
+	for (uint n : { 0u, 1u, 100u, 65537u, 1000000u })
+	{
+		std::vector<int> ref(n);
+		for (uint i = 0; i < n; i++)
+			ref[i] = int(rng() % 2000001) - 1000000;
+
+		DArray<int> keys;
+		keys.assign(ref);
+
+		Sort<int> sort;
+		sort.sort(keys);
+
+		CArray<int> hKeys;
+		hKeys.assign(keys);
+
+		std::sort(ref.begin(), ref.end());
+		EXPECT_TRUE(std::equal(ref.begin(), ref.end(), hKeys.begin()));
+
+		keys.clear();
+	}
+}
+
+TEST(Sort, SortByKey)
+{
+	std::mt19937_64 rng(11);
+
+	uint n = 300000;
+
+	//Morton codes using the lower 48 bits only, the upper passes are skipped
+	CArray<unsigned long long> hKeys(n);
+	CArray<uint> hIds(n);
+	CArray<Vec3f> hPos(n);
+	for (uint i = 0; i < n; i++)
+	{
+		hKeys[i] = rng() & 0xFFFFFFFFFFFFull;
+		hIds[i] = i;
+		hPos[i] = Vec3f(float(i));
+	}
+
+	CArray<unsigned long long> hOrigin;
+	hOrigin.assign(hKeys);
+
+	DArray<unsigned long long> dKeys;
+	DArray<uint> dIds;
+	DArray<Vec3f> dPos;
+	dKeys.assign(hKeys);
+	dIds.assign(hIds);
+	dPos.assign(hPos);
+
+	Sort<unsigned long long> sort;
+	sort.sortByKey(dKeys, dIds);
+
+	dKeys.assign(hKeys);
+	sort.sortByKey(dKeys, dPos);
+
+	hKeys.assign(dKeys);
+	hIds.assign(dIds);
+	hPos.assign(dPos);
+
+	bool sorted = true;
+	bool matched = true;
+	for (uint i = 0; i < n; i++)
+	{
+		sorted &= i == 0 || hKeys[i - 1] <= hKeys[i];
+		matched &= hOrigin[hIds[i]] == hKeys[i];
+		matched &= hPos[i][0] == float(hIds[i]);
+	}
+	EXPECT_TRUE(sorted);
+	EXPECT_TRUE(matched);
+
+	dKeys.clear();
+	dIds.clear();
+	dPos.clear();
+}
+
+TEST(HostSort, Stable)
+{
+	uint n = 200000;
+
+	CArray<uint> keys(n);
+	CArray<uint> vals(n);
+	for (uint i = 0; i < n; i++)
+	{
+		keys[i] = (i * 2654435761u) % 100u;
+		vals[i] = i;
+	}
+
+	HostSort<uint> sort;
+	sort.sortByKey(keys, vals);
+
+	bool stable = true;
+	for (uint i = 1; i < n; i++)
+	{
+		stable &= keys[i - 1] < keys[i] || (keys[i - 1] == keys[i] && vals[i - 1] < vals[i]);
+	}
+	EXPECT_TRUE(stable);
+}
@@ -0,0 +1,249 @@
+#include "gtest/gtest.h"
+#include "Matrix/CSRMatrix.h"
+#include "Matrix/BSRMatrix.h"
+#include "Matrix/Preconditioner.h"
+#include "Matrix/KrylovSolver.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace dyno;
+
+//5-point Laplacian of a grid x grid domain plus shift * I, every diagonal entry is assembled from 4 duplicated triplets.
+//	A nonzero convection makes the matrix nonsymmetric.
+static void buildLaplacian(CSRMatrix<double>& A, uint grid, double shift, double convection = 0.0)
+{
+	std::vector<uint> rows, cols;
+	std::vector<double> vals;
+
+	auto add = [&](uint i, uint j, double v) { rows.push_back(i); cols.push_back(j); vals.push_back(v); };
+
+	for (uint y = 0; y < grid; y++)
+	{
+		for (uint x = 0; x < grid; x++)
+		{
+			uint i = y * grid + x;
+			for (int k = 0; k < 4; k++)
+				add(i, i, 1.0 + shift / 4.0);
+
+			if (x > 0) add(i, i - 1, -1.0 - convection);
+			if (x + 1 < grid) add(i, i + 1, -1.0 + convection);
+			if (y > 0) add(i, i - grid, -1.0);
+			if (y + 1 < grid) add(i, i + grid, -1.0);
+		}
+	}
+
+	DArray<uint> dRows, dCols;
+	DArray<double> dVals;
+	dRows.assign(rows);
+	dCols.assign(cols);
+	dVals.assign(vals);
+
+	A.assemble(grid * grid, grid * grid, dRows, dCols, dVals);
+
+	dRows.clear();
+	dCols.clear();
+	dVals.clear();
+}
+
+static double residualNorm(const LinearOperator<double>& A, const DArray<double>& x, const DArray<double>& b)
+{
+	DArray<double> Ax;
+	A.apply(Ax, x);
+
+	CArray<double> hAx, hB;
+	hAx.assign(Ax);
+	hB.assign(b);
+
+	double sum = 0;
+	for (uint i = 0; i < hB.size(); i++)
+		sum += (hB[i] - hAx[i]) * (hB[i] - hAx[i]);
+
+	Ax.clear();
+	return std::sqrt(sum);
+}
+
+static void buildRhs(DArray<double>& b, uint n)
+{
+	std::vector<double> hB(n);
+	for (uint i = 0; i < n; i++)
+		hB[i] = std::sin(0.1 * i) + 1.0;
+
+	b.assign(hB);
+}
+
+TEST(CSRMatrix, Assemble)
+{
+	CSRMatrix<double> A;
+	buildLaplacian(A, 4, 0.0);
+
+	EXPECT_EQ(A.rows(), 16u);
+	EXPECT_EQ(A.nonZeros(), 16u + 2u * 24u);
+
+	CArray<uint> offsets, columns;
+	CArray<double> values;
+	offsets.assign(A.rowOffsets());
+	columns.assign(A.columns());
+	values.assign(A.values());
+
+	//Row 5 is an interior point: columns 1, 4, 5, 6, 9
+	ASSERT_EQ(offsets[6] - offsets[5], 5u);
+	uint expected[5] = { 1, 4, 5, 6, 9 };
+	for (uint k = 0; k < 5; k++)
+		EXPECT_EQ(columns[offsets[5] + k], expected[k]);
+	EXPECT_DOUBLE_EQ(values[offsets[5] + 2], 4.0);
+
+	A.clear();
+}
+
+TEST(KrylovSolver, ConjugateGradient)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	uint grid = 32;
+	CSRMatrix<double> A;
+	buildLaplacian(A, grid, 0.01);
+
+	DArray<double> b, x;
+	buildRhs(b, A.rows());
+
+	ConjugateGradient<double> cg;
+	cg.setTolerance(1e-8);
+	cg.setMaxIterations(2000);
+
+	EXPECT_TRUE(cg.solve(A, x, b));
+	EXPECT_LT(residualNorm(A, x, b), 1e-6);
+	uint plain = cg.iterations();
+
+	JacobiPreconditioner<double> jacobi;
+	jacobi.update(A);
+	cg.setPreconditioner(&jacobi);
+
+	x.reset();
+	EXPECT_TRUE(cg.solve(A, x, b));
+	EXPECT_LT(residualNorm(A, x, b), 1e-6);
+
+	IncompleteCholeskyPreconditioner<double> ic;
+	ic.update(A);
+	cg.setPreconditioner(&ic);
+
+	x.reset();
+	EXPECT_TRUE(cg.solve(A, x, b));
+	EXPECT_LT(residualNorm(A, x, b), 1e-6);
+	EXPECT_LT(cg.iterations(), plain);
+
+	//Warm start from the solution converges immediately
+	EXPECT_TRUE(cg.solve(A, x, b));
+	EXPECT_LE(cg.iterations(), 1u);
+
+	A.clear();
+	b.clear();
+	x.clear();
+}
+
+TEST(KrylovSolver, MINRES)
+{
+	uint grid = 24;
+
+	//Shifted into an indefinite matrix
+	CSRMatrix<double> A;
+	buildLaplacian(A, grid, -0.5);
+
+	DArray<double> b, x;
+	buildRhs(b, A.rows());
+
+	MINRES<double> minres;
+	minres.setTolerance(1e-10);
+	minres.setMaxIterations(5000);
+
+	EXPECT_TRUE(minres.solve(A, x, b));
+	EXPECT_LT(residualNorm(A, x, b), 1e-6);
+
+	A.clear();
+	b.clear();
+	x.clear();
+}
+
+TEST(KrylovSolver, BiCGSTAB)
+{
+	uint grid = 24;
+
+	CSRMatrix<double> A;
+	buildLaplacian(A, grid, 0.1, 0.4);
+
+	DArray<double> b, x;
+	buildRhs(b, A.rows());
+
+	JacobiPreconditioner<double> jacobi;
+	jacobi.update(A);
+
+	BiCGSTAB<double> bicg;
+	bicg.setTolerance(1e-10);
+	bicg.setPreconditioner(&jacobi);
+
+	EXPECT_TRUE(bicg.solve(A, x, b));
+	EXPECT_LT(residualNorm(A, x, b), 1e-6);
+
+	A.clear();
+	b.clear();
+	x.clear();
+}
+
+TEST(KrylovSolver, BlockJacobi)
+{
+	//Chain of 3D nodes coupled by stiff springs, every node has an anisotropic diagonal block
+	typedef BSRMatrix<double>::Block Block;
+
+	uint nodes = 200;
+
+	std::vector<uint> rows, cols;
+	std::vector<Block> blocks;
+	for (uint i = 0; i < nodes; i++)
+	{
+		Block d(0.0);
+		d(0, 0) = 3.0; d(1, 1) = 30.0; d(2, 2) = 300.0;
+		d(0, 1) = d(1, 0) = 1.0;
+
+		rows.push_back(i); cols.push_back(i); blocks.push_back(d);
+
+		if (i + 1 < nodes)
+		{
+			Block k = Block::identityMatrix() * 1.0;
+
+			rows.push_back(i); cols.push_back(i); blocks.push_back(k);
+			rows.push_back(i + 1); cols.push_back(i + 1); blocks.push_back(k);
+			rows.push_back(i); cols.push_back(i + 1); blocks.push_back(-k);
+			rows.push_back(i + 1); cols.push_back(i); blocks.push_back(-k);
+		}
+	}
+
+	DArray<uint> dRows, dCols;
+	DArray<Block> dBlocks;
+	dRows.assign(rows);
+	dCols.assign(cols);
+	dBlocks.assign(blocks);
+
+	BSRMatrix<double> A;
+	A.assemble(nodes, nodes, dRows, dCols, dBlocks);
+	EXPECT_EQ(A.nonZeroBlocks(), nodes + 2 * (nodes - 1));
+
+	DArray<double> b, x;
+	buildRhs(b, 3 * nodes);
+
+	BlockJacobiPreconditioner<double> precond;
+	precond.update(A);
+
+	ConjugateGradient<double> cg;
+	cg.setTolerance(1e-10);
+	cg.setPreconditioner(&precond);
+
+	EXPECT_TRUE(cg.solve(A, x, b));
+	EXPECT_LT(residualNorm(A, x, b), 1e-6);
+
+	A.clear();
+	b.clear();
+	x.clear();
+	dRows.clear();
+	dCols.clear();
+	dBlocks.clear();
+}
@@ -0,0 +1,282 @@
+#include "gtest/gtest.h"
+
+#include "SceneGraph.h"
+#include "Checkpoint.h"
+#include "Module/OutputQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+
+using namespace dyno;
+
+class CheckpointNode : public Node
+{
+	DECLARE_CLASS(CheckpointNode)
+public:
+	CheckpointNode() {};
+	~CheckpointNode() override {};
+
+	DEF_VAR(uint, Number, 64, "");
+
+	DEF_VAR_STATE(float, Energy, 0.0f, "");
+
+	DEF_ARRAY_STATE(Vec3f, Position, DeviceType::GPU, "");
+	DEF_ARRAY_STATE(Vec3f, Velocity, DeviceType::GPU, "");
+
+	DEF_ARRAYLIST_STATE(int, Neighbors, DeviceType::GPU, "");
+
+	DEF_ARRAY2D_STATE(float, Height, DeviceType::GPU, "");
+
+	DEF_NODE_PORTS(Node, Upstream, "");
+
+protected:
+	void resetStates() override
+	{
+		uint num = this->varNumber()->getValue();
+
+		CArray<Vec3f> pos(num);
+		CArray<Vec3f> vel(num);
+		for (uint i = 0; i < num; i++)
+		{
+			pos[i] = Vec3f(0.1f * i, 0.05f * (i % 7), 0.0f);
+			vel[i] = Vec3f(0.0f, 1.0f + 0.01f * i, 0.3f);
+		}
+
+		this->statePosition()->assign(pos);
+		this->stateVelocity()->assign(vel);
+
+		CArray2D<float> height(8, 4);
+		height.reset();
+		this->stateHeight()->assign(height);
+
+		this->stateNeighbors()->resize(num);
+	}
+
+	void updateStates() override
+	{
+		float dt = this->stateTimeStep()->getValue();
+
+		CArray<Vec3f> pos;
+		CArray<Vec3f> vel;
+		pos.assign(this->statePosition()->getData());
+		vel.assign(this->stateVelocity()->getData());
+
+		float energy = 0.0f;
+		for (uint i = 0; i < pos.size(); i++)
+		{
+			vel[i] += dt * Vec3f(0.0f, -9.8f, 0.0f) - 0.01f * vel[i] * vel[i].norm();
+			pos[i] += dt * vel[i];
+			energy += vel[i].normSquared();
+		}
+
+		CArrayList<int> lists;
+		CArray<uint> counts(pos.size());
+		for (uint i = 0; i < pos.size(); i++)
+			counts[i] = 4;
+		lists.resize(counts);
+
+		for (uint i = 0; i < pos.size(); i++)
+		{
+			uint num = uint(std::fabs(pos[i][1]) * 100) % 5;
+			for (uint j = 0; j < num && j < 4; j++)
+				lists[i].insert((i + j + 1) % pos.size());
+		}
+
+		CArray2D<float> height;
+		height.assign(this->stateHeight()->getData());
+		for (uint i = 0; i < height.size(); i++)
+			height[i] += pos[i % pos.size()][1];
+
+		this->statePosition()->assign(pos);
+		this->stateVelocity()->assign(vel);
+		this->stateNeighbors()->assign(lists);
+		this->stateHeight()->assign(height);
+		this->stateEnergy()->setValue(energy);
+	}
+};
+
+IMPLEMENT_CLASS(CheckpointNode);
+
+static std::shared_ptr<SceneGraph> createCheckpointScene()
+{
+	auto scn = std::make_shared<SceneGraph>();
+
+	auto n0 = scn->addNode(std::make_shared<CheckpointNode>());
+	auto n1 = scn->addNode(std::make_shared<CheckpointNode>());
+	n1->varNumber()->setValue(10);
+
+	n0->connect(n1->importUpstreams());
+
+	return scn;
+}
+
+template<typename T>
+static bool bitwiseEqual(const CArray<T>& a, const CArray<T>& b)
+{
+	return a.size() == b.size() && std::memcmp(a.begin(), b.begin(), sizeof(T) * a.size()) == 0;
+}
+
+static void expectIdentical(std::shared_ptr<SceneGraph> a, std::shared_ptr<SceneGraph> b)
+{
+	EXPECT_EQ(a->getFrameNumber(), b->getFrameNumber());
+	EXPECT_EQ(a->getElapsedTime(), b->getElapsedTime());
+
+	std::vector<CheckpointNode*> na, nb;
+	for (auto it = a->begin(); it != a->end(); it++)
+		na.push_back(dynamic_cast<CheckpointNode*>(it.get().get()));
+	for (auto it = b->begin(); it != b->end(); it++)
+		nb.push_back(dynamic_cast<CheckpointNode*>(it.get().get()));
+
+	ASSERT_EQ(na.size(), nb.size());
+	for (size_t i = 0; i < na.size(); i++)
+	{
+		ASSERT_NE(na[i], nullptr);
+		ASSERT_NE(nb[i], nullptr);
+
+		EXPECT_EQ(na[i]->varNumber()->getValue(), nb[i]->varNumber()->getValue());
+		EXPECT_GT(na[i]->stateEnergy()->getValue(), 0.0f);
+		EXPECT_EQ(na[i]->stateEnergy()->getValue(), nb[i]->stateEnergy()->getValue());
+
+		CArray<Vec3f> pa, pb;
+		pa.assign(na[i]->statePosition()->getData());
+		pb.assign(nb[i]->statePosition()->getData());
+		EXPECT_TRUE(bitwiseEqual(pa, pb));
+
+		CArrayList<int> la, lb;
+		la.assign(na[i]->stateNeighbors()->getData());
+		lb.assign(nb[i]->stateNeighbors()->getData());
+		EXPECT_TRUE(bitwiseEqual(la.index(), lb.index()));
+		ASSERT_EQ(la.size(), lb.size());
+		EXPECT_GT(la.size(), 0);
+		for (uint j = 0; j < la.size(); j++)
+		{
+			ASSERT_EQ(la[j].size(), lb[j].size());
+			EXPECT_EQ(std::memcmp(la[j].begin(), lb[j].begin(), sizeof(int) * la[j].size()), 0);
+		}
+
+		CArray2D<float> ha, hb;
+		ha.assign(na[i]->stateHeight()->getData());
+		hb.assign(nb[i]->stateHeight()->getData());
+		EXPECT_EQ(ha.nx(), hb.nx());
+		EXPECT_EQ(ha.ny(), hb.ny());
+		EXPECT_EQ(std::memcmp(ha.begin(), hb.begin(), sizeof(float) * ha.size()), 0);
+	}
+}
+
+TEST(Checkpoint, restart)
+{
+	auto reference = createCheckpointScene();
+	reference->setCheckpointInterval(3, "Test_Checkpoint_", true);
+	reference->reset();
+	for (int i = 0; i < 6; i++)
+		reference->takeOneFrame();
+
+	EXPECT_TRUE(reference->waitForCheckpoint());
+
+	std::string filename = "Test_Checkpoint_000003.ckpt";
+
+	Checkpoint checkpoint;
+	ASSERT_TRUE(checkpoint.read(filename));
+	EXPECT_EQ(checkpoint.frameNumber(), 3);
+
+	//Restart a scene built the same way
+	auto rebuilt = createCheckpointScene();
+	rebuilt->reset();
+	ASSERT_TRUE(rebuilt->loadCheckpoint(filename));
+	EXPECT_EQ(rebuilt->getFrameNumber(), 3);
+	for (int i = 0; i < 3; i++)
+		rebuilt->takeOneFrame();
+
+	expectIdentical(reference, rebuilt);
+
+	//Nodes and connections are created from the checkpoint for an empty scene
+	auto restored = std::make_shared<SceneGraph>();
+	ASSERT_TRUE(restored->loadCheckpoint(filename));
+	for (int i = 0; i < 3; i++)
+		restored->takeOneFrame();
+
+	expectIdentical(reference, restored);
+
+	//A scene with a different node graph is rejected
+	auto other = std::make_shared<SceneGraph>();
+	other->addNode(std::make_shared<CheckpointNode>());
+	other->reset();
+	EXPECT_FALSE(other->loadCheckpoint(filename));
+
+	std::remove(filename.c_str());
+	std::remove("Test_Checkpoint_000006.ckpt");
+}
+
+TEST(Checkpoint, compression)
+{
+	auto scn = createCheckpointScene();
+	scn->reset();
+	scn->takeOneFrame();
+
+	ASSERT_TRUE(scn->saveCheckpoint("Test_Checkpoint_raw.ckpt", false));
+	ASSERT_TRUE(scn->saveCheckpoint("Test_Checkpoint_packed.ckpt", true));
+	EXPECT_TRUE(scn->waitForCheckpoint());
+
+	auto fileSize = [](const char* name) -> long {
+		FILE* fp = fopen(name, "rb");
+		if (fp == nullptr) return -1;
+		fseek(fp, 0, SEEK_END);
+		long size = ftell(fp);
+		fclose(fp);
+		return size;
+	};
+
+	long raw = fileSize("Test_Checkpoint_raw.ckpt");
+	long packed = fileSize("Test_Checkpoint_packed.ckpt");
+	EXPECT_GT(raw, 0);
+	EXPECT_GT(packed, 0);
+	EXPECT_LT(packed, raw);
+
+	auto a = createCheckpointScene();
+	auto b = createCheckpointScene();
+	ASSERT_TRUE(a->loadCheckpoint("Test_Checkpoint_raw.ckpt"));
+	ASSERT_TRUE(b->loadCheckpoint("Test_Checkpoint_packed.ckpt"));
+
+	expectIdentical(a, b);
+	expectIdentical(scn, a);
+
+	std::remove("Test_Checkpoint_raw.ckpt");
+	std::remove("Test_Checkpoint_packed.ckpt");
+}
+
+TEST(Checkpoint, ordering)
+{
+	auto scn = createCheckpointScene();
+	scn->reset();
+	scn->takeOneFrame();
+
+	//An output of an earlier frame that is still being written
+	std::atomic<bool> finished(false);
+	OutputQueue::instance()->submit([&finished]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		finished = true;
+	});
+
+	//Neither capturing blocks on the output nor on the checkpoint before
+	auto start = std::chrono::steady_clock::now();
+	ASSERT_TRUE(scn->saveCheckpoint("Test_Checkpoint_first.ckpt", true));
+	scn->takeOneFrame();
+	ASSERT_TRUE(scn->saveCheckpoint("Test_Checkpoint_second.ckpt", true));
+	double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	EXPECT_LT(elapsed, 100.0);
+
+	//The checkpoints are only written after the earlier output
+	EXPECT_TRUE(scn->waitForCheckpoint());
+	EXPECT_TRUE(finished);
+
+	auto a = createCheckpointScene();
+	ASSERT_TRUE(a->loadCheckpoint("Test_Checkpoint_second.ckpt"));
+	expectIdentical(scn, a);
+
+	std::remove("Test_Checkpoint_first.ckpt");
+	std::remove("Test_Checkpoint_second.ckpt");
+}
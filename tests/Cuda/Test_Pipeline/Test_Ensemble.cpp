@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include "SceneGraphEnsemble.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+
+using namespace dyno;
+
+class FallingNode : public Node
+{
+	DECLARE_CLASS(FallingNode)
+public:
+	FallingNode() {};
+
+	DEF_VAR_STATE(float, Height, 0.0f, "");
+	DEF_VAR_STATE(float, Velocity, 0.0f, "");
+
+	DEF_ARRAY_STATE(float, Samples, DeviceType::GPU, "");
+
+protected:
+	void resetStates() override
+	{
+		this->stateHeight()->setValue(100.0f);
+		this->stateVelocity()->setValue(0.0f);
+		this->stateSamples()->resize(256);
+	}
+
+	void updateStates() override
+	{
+		//Each node only reads the scene graph it belongs to
+		float g = this->getSceneGraph()->getGravity()[1];
+		float dt = this->stateTimeStep()->getValue();
+
+		float v = this->stateVelocity()->getValue() + dt * g;
+		float h = this->stateHeight()->getValue() + dt * v;
+
+		CArray<float> samples(256);
+		for (uint i = 0; i < samples.size(); i++)
+			samples[i] = h * i;
+		this->stateSamples()->assign(samples);
+
+		this->stateVelocity()->setValue(v);
+		this->stateHeight()->setValue(h);
+	}
+};
+
+IMPLEMENT_CLASS(FallingNode);
+
+static std::shared_ptr<SceneGraph> createFallingScene(uint i)
+{
+	auto scn = std::make_shared<SceneGraph>();
+	scn->setGravity(Vec3f(0.0f, -1.0f - i, 0.0f));
+
+	auto n0 = scn->addNode(std::make_shared<FallingNode>());
+	auto n1 = scn->addNode(std::make_shared<FallingNode>());
+	n1->setDt(0.004f);
+
+	return scn;
+}
+
+static float height(std::shared_ptr<SceneGraph> scn)
+{
+	float sum = 0.0f;
+	for (auto it = scn->begin(); it != scn->end(); it++)
+	{
+		auto node = dynamic_cast<FallingNode*>(it.get().get());
+		sum += node->stateHeight()->getValue();
+	}
+	return sum;
+}
+
+TEST(SceneGraphEnsemble, run)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	const uint num = 12;
+	const uint frames = 8;
+
+	SceneGraphEnsemble ensemble(num, createFallingScene);
+	ASSERT_EQ(ensemble.size(), num);
+
+	std::atomic<uint> callbacks(0);
+	ensemble.setFrameCallback([&](uint i, SceneGraph* scn) {
+		EXPECT_EQ(scn, ensemble.getScene(i).get());
+		callbacks++;
+	});
+
+	ensemble.reset();
+	ensemble.takeOneFrame();
+	for (uint i = 0; i < num; i++)
+		EXPECT_EQ(ensemble.getScene(i)->getFrameNumber(), 1);
+
+	ensemble.run(frames - 1);
+	EXPECT_EQ(callbacks.load(), num * frames);
+
+	//Concurrent results must match scenes simulated one after another
+	for (uint i = 0; i < num; i++)
+	{
+		auto reference = createFallingScene(i);
+		reference->reset();
+		for (uint f = 0; f < frames; f++)
+			reference->takeOneFrame();
+
+		auto scn = ensemble.getScene(i);
+		EXPECT_EQ(scn->getFrameNumber(), frames);
+		EXPECT_EQ(height(scn), height(reference));
+
+		if (i > 0) {
+			EXPECT_LT(height(scn), height(ensemble.getScene(i - 1)));
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+
+#include "IncrementalDAG.h"
+
+#include <random>
+#include <algorithm>
+
+using namespace dyno;
+
+bool isTopological(IncrementalDAG& g)
+{
+	auto& order = g.topologicalOrder();
+
+	std::vector<uint> pos(order.size() == 0 ? 0 : *std::max_element(order.begin(), order.end()) + 1, 0);
+	for (uint i = 0; i < order.size(); i++)
+		pos[order[i]] = i;
+
+	for (auto u : order)
+		for (auto v : g.successors(u))
+			if (pos[u] >= pos[v])
+				return false;
+
+	return true;
+}
+
+TEST(IncrementalDAG, insertion)
+{
+	IncrementalDAG g;
+	std::vector<uint> v(6);
+	for (auto& id : v)
+		id = g.addVertex();
+
+	//Insert edges against the initial order
+	EXPECT_EQ(g.addEdge(v[5], v[4]), true);
+	EXPECT_EQ(g.addEdge(v[4], v[3]), true);
+	EXPECT_EQ(g.addEdge(v[3], v[0]), true);
+	EXPECT_EQ(g.addEdge(v[1], v[0]), true);
+	EXPECT_EQ(g.addEdge(v[2], v[5]), true);
+
+	EXPECT_EQ(isTopological(g), true);
+	EXPECT_EQ(g.topologicalOrder().size(), 6);
+	EXPECT_EQ(g.topologicalOrder().back(), v[0]);
+	EXPECT_EQ(g.hasPath(v[2], v[0]), true);
+	EXPECT_EQ(g.hasPath(v[0], v[2]), false);
+
+	//Cycles are rejected on insertion and leave the graph unchanged
+	EXPECT_EQ(g.addEdge(v[0], v[2]), false);
+	EXPECT_EQ(g.addEdge(v[3], v[3]), false);
+	EXPECT_EQ(g.sizeOfEdge(), 5);
+
+	//The edge can be inserted once the path is broken
+	EXPECT_EQ(g.removeEdge(v[4], v[3]), true);
+	EXPECT_EQ(g.addEdge(v[0], v[2]), true);
+	EXPECT_EQ(isTopological(g), true);
+}
+
+TEST(IncrementalDAG, revision)
+{
+	IncrementalDAG g;
+	uint a = g.addVertex();
+	uint b = g.addVertex();
+
+	//Edges consistent with the current order change the graph without reordering it
+	uint rev = g.revision();
+	EXPECT_EQ(g.addEdge(a, b), true);
+	EXPECT_NE(g.revision(), rev);
+
+	rev = g.revision();
+	EXPECT_EQ(g.removeEdge(a, b), true);
+	EXPECT_NE(g.revision(), rev);
+
+	//Rejected insertions and missing edges leave it unchanged
+	g.addEdge(a, b);
+	rev = g.revision();
+	EXPECT_EQ(g.addEdge(b, a), false);
+	EXPECT_EQ(g.removeEdge(b, a), false);
+	EXPECT_EQ(g.revision(), rev);
+}
+
+TEST(IncrementalDAG, removeVertex)
+{
+	IncrementalDAG g;
+	uint a = g.addVertex();
+	uint b = g.addVertex();
+	uint c = g.addVertex();
+
+	g.addEdge(c, b);
+	g.addEdge(b, a);
+
+	g.removeVertex(b);
+	EXPECT_EQ(g.sizeOfVertex(), 2);
+	EXPECT_EQ(g.sizeOfEdge(), 0);
+	EXPECT_EQ(g.hasPath(c, a), false);
+
+	//The id of a removed vertex is reused
+	uint d = g.addVertex();
+	EXPECT_EQ(d, b);
+	EXPECT_EQ(g.topologicalOrder().back(), d);
+
+	EXPECT_EQ(g.addEdge(a, c), true);
+	EXPECT_EQ(isTopological(g), true);
+}
+
+TEST(IncrementalDAG, random)
+{
+	const uint num = 200;
+
+	IncrementalDAG g;
+	for (uint i = 0; i < num; i++)
+		g.addVertex();
+
+	std::mt19937 gen(7);
+	std::uniform_int_distribution<uint> dist(0, num - 1);
+
+	for (uint i = 0; i < 2000; i++)
+	{
+		uint u = dist(gen);
+		uint v = dist(gen);
+
+		bool cycle = u == v || g.hasPath(v, u);
+		EXPECT_EQ(g.addEdge(u, v), !cycle);
+
+		//Remove edges from time to time
+		if (i % 5 == 0 && g.successors(v).size() > 0)
+			g.removeEdge(v, g.successors(v)[0]);
+	}
+
+	EXPECT_EQ(isTopological(g), true);
+}
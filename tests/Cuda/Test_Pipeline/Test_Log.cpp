@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+
+#include "Log.h"
+#include "ThreadPool.h"
+
+#include <map>
+
+using namespace dyno;
+
+static std::vector<Log::Message> sReceived;
+
+static void receive(const Log::Message& m)
+{
+	sReceived.push_back(m);
+}
+
+TEST(Log, Format)
+{
+	//Drain messages left behind by other tests
+	Log::flush();
+	sReceived.clear();
+	Log::setUserReceiver(&receive);
+	Log::setLevel(Log::DebugInfo);
+
+	Log::sendMessage(Log::Info, "plain text");
+	Log::sendMessage(Log::Info, std::string("text"));
+	Log::sendMessage(Log::Warning, "{} {} {} {} {}", -3, 7u, 0.5, true, "str");
+	Log::sendMessage(Log::Info, "[{:6}] {}ms {}", std::string("abc"), 1.25f, std::string(300, 'x'));
+	Log::sendMessage(Log::Error, "{} {} {}", 1);
+
+	Log::setLevel(Log::Warning);
+	Log::sendMessage(Log::Info, "filtered {}", 1);
+	Log::sendMessage(Log::DebugInfo, "filtered");
+	EXPECT_FALSE(Log::isEnabled(Log::Info));
+	EXPECT_TRUE(Log::isEnabled(Log::Error));
+
+	Log::flush();
+	Log::setLevel(Log::DebugInfo);
+	Log::setUserReceiver(nullptr);
+
+	ASSERT_EQ(sReceived.size(), 5);
+	EXPECT_EQ(sReceived[0].text, "plain text");
+	EXPECT_EQ(sReceived[1].text, "text");
+	EXPECT_EQ(sReceived[2].text, "-3 7 0.5 true str");
+	EXPECT_EQ(sReceived[2].type, Log::Warning);
+	EXPECT_EQ(sReceived[3].text, "[   abc] 1.25ms " + std::string(300, 'x'));
+	EXPECT_EQ(sReceived[4].text, "1 {} {}");
+}
+
+TEST(Log, Threads)
+{
+	sReceived.clear();
+	Log::setUserReceiver(&receive);
+
+	ThreadPool::instance()->setThreadNumber(4);
+
+	unsigned long long dropped = Log::droppedMessages();
+
+	const unsigned int num = 20000;
+	ThreadPool::instance()->parallelFor(0, num, [&](unsigned int first, unsigned int last) {
+		for (unsigned int i = first; i < last; i++)
+			Log::sendMessage(Log::Info, "message {}", i);
+	}, 100);
+
+	Log::flush();
+	Log::setUserReceiver(nullptr);
+
+	dropped = Log::droppedMessages() - dropped;
+
+	//Messages are either delivered exactly once or counted as dropped
+	std::map<std::string, int> counts;
+	size_t messages = 0;
+	for (auto& m : sReceived)
+	{
+		if (m.type == Log::Info) {
+			counts[m.text]++;
+			messages++;
+		}
+	}
+
+	EXPECT_EQ(messages + dropped, num);
+	for (auto& c : counts)
+		EXPECT_EQ(c.second, 1);
+}
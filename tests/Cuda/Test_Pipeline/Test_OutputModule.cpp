@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+
+#include "Module/OutputModule.h"
+#include "Module/OutputQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+using namespace dyno;
+
+static std::mutex sWrittenMutex;
+static std::map<std::string, std::vector<float>> sWritten;
+
+class SlowWriter : public OutputModule
+{
+	DECLARE_CLASS(SlowWriter)
+public:
+	SlowWriter() {};
+
+	DEF_VAR(float, Value, 0.0f, "");
+
+	uint snapshotCreated = 0;
+	uint outputCalled = 0;
+
+protected:
+	class Snapshot : public OutputSnapshot
+	{
+	public:
+		void write(const std::string& filename) override
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+			std::lock_guard<std::mutex> lock(sWrittenMutex);
+			sWritten[filename] = values;
+		}
+
+		std::vector<float> values;
+	};
+
+	void output() override
+	{
+		outputCalled++;
+
+		std::lock_guard<std::mutex> lock(sWrittenMutex);
+		sWritten[this->constructFileName()] = std::vector<float>(1000, this->varValue()->getValue());
+	}
+
+	std::shared_ptr<OutputSnapshot> createSnapshot() override
+	{
+		snapshotCreated++;
+		return std::make_shared<Snapshot>();
+	}
+
+	bool takeSnapshot(OutputSnapshot* snapshot) override
+	{
+		auto s = static_cast<Snapshot*>(snapshot);
+		s->values.assign(1000, this->varValue()->getValue());
+		return true;
+	}
+};
+
+IMPLEMENT_CLASS(SlowWriter);
+
+TEST(OutputModule, asynchronous)
+{
+	sWritten.clear();
+
+	auto writer = std::make_shared<SlowWriter>();
+	writer->varPrefix()->setValue("slow_");
+
+	const uint frames = 10;
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint i = 0; i < frames; i++)
+	{
+		writer->inFrameNumber()->setValue(i);
+		writer->varValue()->setValue(float(i));
+		writer->update();
+	}
+
+	//Double buffered by default, the simulation only waits for the writer once both snapshots are in flight
+	EXPECT_EQ(writer->snapshotCreated, 2);
+	EXPECT_EQ(writer->outputCalled, 0);
+
+	writer->flush();
+	OutputQueue::instance()->flush();
+	EXPECT_EQ(OutputQueue::instance()->pendingJobs(), 0);
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	EXPECT_GE(elapsed, 20.0 * frames / OutputQueue::instance()->workerNumber() - 1.0);
+
+	//Each file has the value of the frame it was taken in, even though the module has moved on
+	ASSERT_EQ(sWritten.size(), frames);
+	for (auto& w : sWritten)
+	{
+		size_t pos = w.first.find("slow_");
+		ASSERT_NE(pos, std::string::npos);
+		float frame = std::stof(w.first.substr(pos + 5));
+
+		ASSERT_EQ(w.second.size(), 1000);
+		EXPECT_EQ(w.second.front(), frame);
+		EXPECT_EQ(w.second.back(), frame);
+	}
+
+	//Synchronous output
+	sWritten.clear();
+	writer->varAsynchronous()->setValue(false);
+	writer->inFrameNumber()->setValue(frames);
+	writer->update();
+	EXPECT_EQ(writer->outputCalled, 1);
+	EXPECT_EQ(sWritten.size(), 1);
+}
+
+TEST(OutputModule, backpressure)
+{
+	OutputQueue queue(1, 2);
+
+	std::atomic<int> done(0);
+	std::atomic<int> maxPending(0);
+
+	for (int i = 0; i < 8; i++)
+	{
+		queue.submit([&]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			done++;
+		});
+
+		int pending = (int)queue.pendingJobs();
+		if (pending > maxPending)
+			maxPending = pending;
+	}
+
+	EXPECT_LE(maxPending.load(), 2);
+
+	queue.flush();
+	EXPECT_EQ(done.load(), 8);
+
+	//Without workers, jobs are executed in place
+	queue.setWorkerNumber(0);
+	queue.submit([&]() { done++; });
+	EXPECT_EQ(done.load(), 9);
+}
+
+TEST(OutputModule, owners)
+{
+	OutputQueue queue(2, 8);
+
+	int sceneA = 0;
+	int sceneB = 0;
+
+	std::atomic<bool> slowDone(false);
+	std::atomic<int> fastDone(0);
+
+	queue.submit([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		slowDone = true;
+	}, &sceneB);
+
+	//Failing jobs are logged and do not stop the writer threads
+	queue.submit([]() { throw 1; }, &sceneA);
+	queue.submit([]() { throw std::runtime_error("disk full"); }, &sceneA);
+	queue.submit([&]() { fastDone++; }, &sceneA);
+
+	//Only the jobs of scene A are waited for
+	queue.flush(&sceneA);
+	EXPECT_EQ(fastDone.load(), 1);
+	EXPECT_FALSE(slowDone.load());
+
+	queue.flush();
+	EXPECT_TRUE(slowDone.load());
+	EXPECT_EQ(queue.pendingJobs(), 0);
+}
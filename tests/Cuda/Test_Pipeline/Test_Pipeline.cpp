@@ -3,6 +3,11 @@
 #include "SceneGraph.h"
 #include "SceneGraphFactory.h"
 #include "Module/Pipeline.h"
+#include "Module/AnimationPipeline.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
 
 using namespace dyno;
 
@@ -13,3 +18,298 @@ TEST(Pipeline, connect)
 	SceneGraphFactory::instance()->pushScene(scn);
 	SceneGraphFactory::instance()->popScene();
 }
+
+
+class PortNode : public Node {
+public:
+	PortNode() {};
+	~PortNode() override {};
+
+	DEF_NODE_PORTS(Node, Upstream, "");
+};
+
+TEST(Pipeline, executionOrder)
+{
+	std::shared_ptr<SceneGraph> scn = std::make_shared<SceneGraph>();
+
+	auto na = scn->addNode(std::make_shared<PortNode>());
+	auto nb = scn->addNode(std::make_shared<PortNode>());
+	auto nc = scn->addNode(std::make_shared<PortNode>());
+
+	auto order = [&]() {
+		std::vector<Node*> nodes;
+		for (auto it = scn->begin(); it != scn->end(); it++)
+			nodes.push_back(it.get().get());
+		return nodes;
+	};
+
+	//Without any connection, nodes are executed in the order they are added
+	auto list = order();
+	ASSERT_EQ(list.size(), 3);
+	EXPECT_EQ(list[0], na.get());
+	EXPECT_EQ(list[2], nc.get());
+
+	//c -> b -> a
+	nc->connect(nb->importUpstreams());
+	nb->connect(na->importUpstreams());
+
+	list = order();
+	EXPECT_EQ(list[0], nc.get());
+	EXPECT_EQ(list[1], nb.get());
+	EXPECT_EQ(list[2], na.get());
+
+	//A connection closing a cycle is ignored when ordering nodes
+	na->connect(nc->importUpstreams());
+	list = order();
+	EXPECT_EQ(list[0], nc.get());
+	EXPECT_EQ(list[2], na.get());
+
+	na->disconnect(nc->importUpstreams());
+	nb->disconnect(na->importUpstreams());
+	na->connect(nc->importUpstreams());
+
+	list = order();
+	EXPECT_EQ(list[0], na.get());
+	EXPECT_EQ(list[1], nc.get());
+	EXPECT_EQ(list[2], nb.get());
+
+	//Nodes connected before being added are ordered as well
+	auto nd = std::make_shared<PortNode>();
+	nd->connect(na->importUpstreams());
+	scn->addNode(nd);
+
+	list = order();
+	ASSERT_EQ(list.size(), 4);
+	EXPECT_EQ(list[0], nd.get());
+}
+
+TEST(Pipeline, rejectedConnection)
+{
+	std::shared_ptr<SceneGraph> scn = std::make_shared<SceneGraph>();
+
+	auto na = scn->addNode(std::make_shared<PortNode>());
+	auto nb = scn->addNode(std::make_shared<PortNode>());
+	auto nc = scn->addNode(std::make_shared<PortNode>());
+
+	auto order = [&]() {
+		std::vector<Node*> nodes;
+		for (auto it = scn->begin(); it != scn->end(); it++)
+			nodes.push_back(it.get().get());
+		return nodes;
+	};
+
+	//a -> b -> c, the connection c -> a is rejected
+	na->connect(nb->importUpstreams());
+	nb->connect(nc->importUpstreams());
+	nc->connect(na->importUpstreams());
+
+	//Breaking the cycle by removing an edge takes the rejected connection into account
+	nb->disconnect(nc->importUpstreams());
+
+	auto list = order();
+	ASSERT_EQ(list.size(), 3);
+	EXPECT_EQ(list[0], nc.get());
+	EXPECT_EQ(list[1], na.get());
+	EXPECT_EQ(list[2], nb.get());
+
+	//Same for deleting a node on the cycle, b -> c is rejected until a is deleted
+	nb->connect(nc->importUpstreams());
+
+	scn->deleteNode(na);
+
+	list = order();
+	ASSERT_EQ(list.size(), 2);
+	EXPECT_EQ(list[0], nb.get());
+	EXPECT_EQ(list[1], nc.get());
+}
+
+
+class CountingNode : public PortNode {
+public:
+	CountingNode(std::atomic<int>* counter) : mCounter(counter) {};
+	~CountingNode() override {};
+
+	int order = -1;
+	int active = 0;
+
+protected:
+	bool requireUpdate() override { return true; }
+
+	void updateStates() override {
+		static std::atomic<int> running(0);
+
+		int n = ++running;
+		active = n;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		order = (*mCounter)++;
+		--running;
+	}
+
+private:
+	std::atomic<int>* mCounter;
+};
+
+TEST(Pipeline, concurrentExecution)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	std::atomic<int> counter(0);
+
+	std::shared_ptr<SceneGraph> scn = std::make_shared<SceneGraph>();
+	scn->setConcurrentExecution(true);
+
+	//Two independent chains a0 -> a1 and b0 -> b1, node c depends on both of them
+	auto a0 = scn->addNode(std::make_shared<CountingNode>(&counter));
+	auto a1 = scn->addNode(std::make_shared<CountingNode>(&counter));
+	auto b0 = scn->addNode(std::make_shared<CountingNode>(&counter));
+	auto b1 = scn->addNode(std::make_shared<CountingNode>(&counter));
+	auto c = scn->addNode(std::make_shared<CountingNode>(&counter));
+
+	a0->connect(a1->importUpstreams());
+	b0->connect(b1->importUpstreams());
+	a1->connect(c->importUpstreams());
+	b1->connect(c->importUpstreams());
+
+	scn->advance(0.01f);
+
+	EXPECT_EQ(counter, 5);
+	EXPECT_LT(a0->order, a1->order);
+	EXPECT_LT(b0->order, b1->order);
+	EXPECT_LT(a1->order, c->order);
+	EXPECT_LT(b1->order, c->order);
+
+	//Independent nodes overlap
+	EXPECT_EQ(std::max(a0->active, b0->active), 2);
+	EXPECT_EQ(c->active, 1);
+
+	//A node opting out never runs together with other nodes
+	b0->setThreadSafe(false);
+	scn->advance(0.01f);
+
+	EXPECT_EQ(counter, 10);
+	EXPECT_EQ(b0->active, 1);
+	EXPECT_LT(b0->order, b1->order);
+
+	ThreadPool::instance()->setThreadNumber(0);
+}
+
+TEST(Pipeline, concurrentExecutionAfterConnect)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	std::atomic<int> counter(0);
+
+	std::shared_ptr<SceneGraph> scn = std::make_shared<SceneGraph>();
+	scn->setConcurrentExecution(true);
+
+	auto x = scn->addNode(std::make_shared<CountingNode>(&counter));
+	auto y = scn->addNode(std::make_shared<CountingNode>(&counter));
+
+	scn->advance(0.01f);
+	EXPECT_EQ(std::max(x->active, y->active), 2);
+
+	//x is already ranked before y, the connection must still split them into two levels
+	x->connect(y->importUpstreams());
+	scn->advance(0.01f);
+
+	EXPECT_LT(x->order, y->order);
+	EXPECT_EQ(x->active, 1);
+	EXPECT_EQ(y->active, 1);
+
+	//Both run together again once disconnected
+	x->disconnect(y->importUpstreams());
+	scn->advance(0.01f);
+
+	EXPECT_EQ(std::max(x->active, y->active), 2);
+
+	ThreadPool::instance()->setThreadNumber(0);
+}
+
+
+struct ModuleLog
+{
+	std::atomic<int> counter{ 0 };
+	std::atomic<int> running{ 0 };
+	std::atomic<int> maxRunning{ 0 };
+};
+
+class SleepingModule : public Module {
+public:
+	SleepingModule(ModuleLog* log) : mLog(log) {
+		this->varForceUpdate()->setValue(true);
+	};
+
+	DEF_VAR_IN(float, A, "");
+	DEF_VAR_IN(float, B, "");
+	DEF_VAR_OUT(float, C, "");
+
+	int order = -1;
+
+protected:
+	void updateImpl() override {
+		int n = ++mLog->running;
+		int m = mLog->maxRunning;
+		while (n > m && !mLog->maxRunning.compare_exchange_weak(m, n)) {}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		order = mLog->counter++;
+		--mLog->running;
+
+		this->outC()->setValue(1.0f);
+	}
+
+private:
+	ModuleLog* mLog;
+};
+
+class StateNode : public Node {
+public:
+	DEF_VAR_STATE(float, X, 1.0f, "");
+	DEF_VAR_STATE(float, Y, 2.0f, "");
+	DEF_VAR_STATE(float, Z, 3.0f, "");
+	DEF_VAR_STATE(float, W, 4.0f, "");
+};
+
+TEST(Pipeline, taskGraph)
+{
+	ThreadPool::instance()->setThreadNumber(4);
+
+	ModuleLog log;
+
+	auto node = std::make_shared<StateNode>();
+	auto pipeline = node->animationPipeline();
+	pipeline->setConcurrentExecution(true);
+
+	//m0 and m1 read disjoint states, m2 depends on both of them, m3 shares states with m0
+	auto m0 = std::make_shared<SleepingModule>(&log);
+	auto m1 = std::make_shared<SleepingModule>(&log);
+	auto m2 = std::make_shared<SleepingModule>(&log);
+	auto m3 = std::make_shared<SleepingModule>(&log);
+
+	node->stateX()->connect(m0->inA());
+	node->stateZ()->connect(m0->inB());
+	node->stateY()->connect(m1->inA());
+	node->stateW()->connect(m1->inB());
+	m0->outC()->connect(m2->inA());
+	m1->outC()->connect(m2->inB());
+	node->stateX()->connect(m3->inA());
+	node->stateZ()->connect(m3->inB());
+
+	pipeline->pushModule(m0);
+	pipeline->pushModule(m1);
+	pipeline->pushModule(m2);
+	pipeline->pushModule(m3);
+
+	pipeline->update();
+
+	EXPECT_EQ(log.counter, 4);
+	EXPECT_LT(m0->order, m2->order);
+	EXPECT_LT(m1->order, m2->order);
+	EXPECT_LT(m0->order, m3->order);
+	EXPECT_EQ(log.maxRunning, 2);
+
+	ThreadPool::instance()->setThreadNumber(0);
+}
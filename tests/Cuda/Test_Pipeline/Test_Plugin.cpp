@@ -0,0 +1,167 @@
+#include "gtest/gtest.h"
+
+#include "Object.h"
+#include "Plugin/PluginManager.h"
+
+#include <ghc/fs_std.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+using namespace dyno;
+
+static std::vector<std::string> sRequested;
+
+static bool requestClass(const std::string& name)
+{
+	sRequested.push_back(name);
+	return false;
+}
+
+TEST(Plugin, ClassLoader)
+{
+	sRequested.clear();
+	Object::setClassLoader(&requestClass);
+
+	Object* obj = Object::createObject("Object");
+	EXPECT_NE(obj, nullptr);
+	delete obj;
+
+	EXPECT_EQ(Object::createObject("UnknownClass"), nullptr);
+
+	Object::setClassLoader(nullptr);
+
+	ASSERT_EQ(sRequested.size(), 1);
+	EXPECT_EQ(sRequested[0], "UnknownClass");
+}
+
+TEST(Plugin, Manifest)
+{
+	std::string pluginName = "plugin-Test-1.0.0" + PluginManager::instance()->getExtension();
+	EXPECT_EQ(PluginManager::manifestName(pluginName), "plugin-Test-1.0.0.manifest");
+
+	//Not a shared library, and without a manifest it has to be loaded at once
+	{
+		std::ofstream output(pluginName);
+		output << "not a library";
+	}
+
+	EXPECT_FALSE(PluginManager::instance()->registerPlugin(pluginName));
+	EXPECT_EQ(PluginManager::instance()->getPlugin(pluginName.c_str()), nullptr);
+	EXPECT_EQ(PluginManager::instance()->providerOf("UnknownClass"), "");
+
+	bool found = false;
+	for (auto& stat : PluginManager::instance()->statistics())
+	{
+		if (stat.file == pluginName)
+		{
+			found = true;
+			EXPECT_FALSE(stat.loaded);
+			EXPECT_FALSE(stat.deferred);
+		}
+	}
+	EXPECT_TRUE(found);
+
+	std::remove(pluginName.c_str());
+}
+
+static Object* createTestObject()
+{
+	return new Object;
+}
+
+TEST(Plugin, ClassModules)
+{
+	EXPECT_TRUE(Object::isRegistered("Object"));
+	EXPECT_FALSE(Object::isRegistered("UnknownClass"));
+
+#if defined(__unix__) || defined(_WIN32)
+	auto modules = Object::getClassModules();
+	ASSERT_NE(modules.find("Object"), modules.end());
+	EXPECT_FALSE(modules["Object"].empty());
+#endif
+}
+
+TEST(Plugin, ConcurrentRegistration)
+{
+	const int num = 200;
+
+	std::atomic<int> registered(0);
+	std::atomic<int> failures(0);
+
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 4; t++)
+	{
+		readers.emplace_back([&]() {
+			int seen = 0;
+			while (seen < num)
+			{
+				seen = registered.load();
+				for (int i = 0; i < seen; i++)
+				{
+					Object* obj = Object::createObject("ConcurrentClass" + std::to_string(i));
+					if (obj == nullptr)
+						failures++;
+					delete obj;
+				}
+			}
+		});
+	}
+
+	//Registration behaves like the static initializers of a plugin loaded on another thread
+	for (int i = 0; i < num; i++)
+	{
+		new ClassInfo("ConcurrentClass" + std::to_string(i), &createTestObject);
+		registered++;
+	}
+
+	for (auto& reader : readers)
+		reader.join();
+
+	EXPECT_EQ(failures.load(), 0);
+	EXPECT_TRUE(Object::isRegistered("ConcurrentClass" + std::to_string(num - 1)));
+}
+
+//Same format as the stamps written by PluginManager
+static std::string stampOf(const std::string& file)
+{
+	return std::to_string(fs::file_size(file)) + " " + std::to_string(fs::last_write_time(file).time_since_epoch().count());
+}
+
+TEST(Plugin, ManifestDependencies)
+{
+	std::string pluginName = "plugin-Deferred-1.0.0" + PluginManager::instance()->getExtension();
+	std::string dependencyName = "libDeferredDependency" + PluginManager::instance()->getExtension();
+
+	{
+		std::ofstream plugin(pluginName);
+		plugin << "not a library";
+
+		std::ofstream dependency(dependencyName);
+		dependency << "dependency";
+	}
+
+	{
+		std::ofstream manifest(PluginManager::manifestName(pluginName));
+		manifest << "stamp " << stampOf(pluginName) << std::endl;
+		manifest << "depends " << stampOf(dependencyName) << " " << dependencyName << std::endl;
+		manifest << "class DeferredClass" << std::endl;
+	}
+
+	//A valid manifest defers loading
+	EXPECT_TRUE(PluginManager::instance()->registerPlugin(pluginName));
+	EXPECT_EQ(PluginManager::instance()->providerOf("DeferredClass"), pluginName);
+
+	//Changing a dependency outdates the manifest, so the plugin has to be loaded, which fails here
+	{
+		std::ofstream dependency(dependencyName, std::ios::app);
+		dependency << " changed";
+	}
+
+	EXPECT_FALSE(PluginManager::instance()->registerPlugin(pluginName));
+
+	std::remove(pluginName.c_str());
+	std::remove(dependencyName.c_str());
+	std::remove(PluginManager::manifestName(pluginName).c_str());
+}
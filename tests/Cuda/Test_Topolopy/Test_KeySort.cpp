@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+
+#include "Topology/KeySort.h"
+
+#include <random>
+
+using namespace dyno;
+
+template<typename TKey>
+static bool lexicographicLess(const TKey& a, const TKey& b, int arity)
+{
+	for (int i = 0; i < arity; i++)
+	{
+		if ((int)a[i] != (int)b[i])
+			return (int)a[i] < (int)b[i];
+	}
+
+	return false;
+}
+
+TEST(KeySort, TKey)
+{
+	std::mt19937 gen(7);
+	std::uniform_int_distribution<int> dist(0, 20);
+
+	std::vector<TKey> hKeys;
+	std::vector<int> hIds;
+	for (int i = 0; i < 5000; i++)
+	{
+		hKeys.push_back(TKey(dist(gen), dist(gen), dist(gen)));
+		hIds.push_back(i);
+	}
+
+	DArray<TKey> keys;
+	DArray<int> ids;
+	keys.assign(hKeys);
+	ids.assign(hIds);
+
+	KeySort<TKey> sort;
+	sort.sortByKey(keys, ids);
+
+	CArray<TKey> sortedKeys;
+	CArray<int> sortedIds;
+	sortedKeys.assign(keys);
+	sortedIds.assign(ids);
+
+	for (uint i = 0; i < sortedKeys.size(); i++)
+	{
+		//Values follow their keys
+		TKey origin = hKeys[sortedIds[i]];
+		EXPECT_TRUE(origin[0] == sortedKeys[i][0] && origin[1] == sortedKeys[i][1] && origin[2] == sortedKeys[i][2]);
+
+		if (i > 0)
+		{
+			EXPECT_FALSE(lexicographicLess(sortedKeys[i], sortedKeys[i - 1], 3));
+
+			//Stable for equal keys
+			if (!lexicographicLess(sortedKeys[i - 1], sortedKeys[i], 3))
+				EXPECT_LT(sortedIds[i - 1], sortedIds[i]);
+		}
+	}
+
+	keys.clear();
+	ids.clear();
+}
+
+TEST(KeySort, EKeyWithEmptyIds)
+{
+	std::vector<EKey> hKeys;
+	hKeys.push_back(EKey(3, 1));
+	hKeys.push_back(EKey());
+	hKeys.push_back(EKey(0, 2));
+	hKeys.push_back(EKey(1, 3));
+
+	DArray<EKey> keys;
+	keys.assign(hKeys);
+
+	KeySort<EKey> sort;
+	sort.sortByKey(keys, nullptr, 0);
+
+	CArray<EKey> sortedKeys;
+	sortedKeys.assign(keys);
+
+	//EMPTY ids are ordered first
+	EXPECT_EQ(sortedKeys[0][0], EMPTY);
+	EXPECT_EQ(sortedKeys[1][0], 0);
+	EXPECT_EQ(sortedKeys[2][0], 1);
+	EXPECT_EQ(sortedKeys[3][0], 1);
+	EXPECT_EQ(sortedKeys[3][1], 3);
+
+	keys.clear();
+}